@@ -10,6 +10,8 @@
 #     CORE_MATH_CHECK_STD=true CORE_MATH_LAUNCHER="/tmp/lib/ld-2.27.so --library-path /tmp/lib" LDFLAGS="-L /tmp/lib" ./check.sh --worst --rndn exp
 #     for newer versions of the GNU libc, installed in say /tmp:
 #     CORE_MATH_CHECK_STD=true CORE_MATH_LAUNCHER="/tmp/lib/ld-linux-x86-64.so.2 --library-path /tmp/lib:/usr/lib/x86_64-linux-gnu" LDFLAGS="-L /tmp/lib" ./check.sh exp
+# (4) to check the code compiled without -frounding-math:
+#     CORE_MATH_NO_ROUNDING_MATH=1 ./check.sh exp
 
 # ensures CI fails in case of an error
 set -e
@@ -58,6 +60,20 @@ DIR="$TMP_DIR/toto/$(basename "$ORIG_DIR")"
 mkdir "$TMP_DIR/toto"
 cp -a "$ORIG_DIR" "$ORIG_DIR/../support" "$TMP_DIR/toto"
 cp -a "$ORIG_DIR/../../generic" "$TMP_DIR"
+# other directories of the same format the function is built from, given
+# by DEPENDS in its Makefile (for example pownl is built with ../pow/powl.c)
+for DEP in $(sed -n 's/^DEPENDS := //p' "$ORIG_DIR/Makefile"); do
+    cp -a "$ORIG_DIR/../$DEP" "$TMP_DIR/toto"
+done
+
+# worst cases, by default xxx.wc, or the concatenation of the files given by
+# WORST_CASES in the Makefile (for example sinhcosh uses those of sinh and cosh)
+WC="${FILE%.c}.wc"
+WORST_CASES="$(sed -n 's/^WORST_CASES := //p' "$ORIG_DIR/Makefile")"
+if [ -n "$WORST_CASES" ]; then
+    WC="$TMP_DIR/$FUN.wc"
+    (cd "$ORIG_DIR" && cat $WORST_CASES) > "$WC"
+fi
 
 if [ -n "${ARGS[0]}" ]; then
     KIND="${ARGS[0]}"
@@ -79,10 +95,14 @@ else
 		     KIND=--worst;;
 		atan2pif)
 		     KIND=--worst;;
+		cart2polf)
+		     KIND=--worst;;
 		compoundf)
 		     KIND=--worst;;
 		hypotf)
 		     KIND=--worst;;
+		norm3f)
+		     KIND=--worst;;
 		powf)
 		     KIND=--worst;;
 		*)
@@ -136,6 +156,14 @@ else
    export ROUNDING_MATH="-frounding-math"
 fi
 
+# with CORE_MATH_NO_ROUNDING_MATH=1, the code is compiled without
+# -frounding-math, to check that it is correct in all rounding modes
+# with the default compiler options
+if [[ -n "$CORE_MATH_NO_ROUNDING_MATH" ]]; then
+   export CFLAGS="${CFLAGS//-frounding-math/}"
+   export ROUNDING_MATH=
+fi
+
 # define CORE_MATH_NO_OPENMP if you don't want OpenMP
 if [[ -z "$CORE_MATH_NO_OPENMP" ]]; then
    if [ "$CC" == "icx" ]; then
@@ -169,22 +197,31 @@ case "$KIND" in
     --worst)
         "$MAKE" --quiet -C "$DIR" clean
         OPENMP=$OPENMP "$MAKE" $QUIET -C "$DIR" check_worst
+        # use the binary worst cases (see src/generic/support/wc2bin.c)
+        # when they are up-to-date, since they need no parsing
+        if [ -f "${WC}b" ] && ! [ "$WC" -nt "${WC}b" ]; then
+            WC="${WC}b"
+        fi
         if [[ -z "$DRY" ]]; then
         for MODE in "${MODES[@]}"; do
             echo "Running worst cases check in $MODE mode..."
-            $CORE_MATH_LAUNCHER "$DIR/check_worst" "$MODE" "${ARGS[@]}" < "${FILE%.c}.wc"
+            $CORE_MATH_LAUNCHER "$DIR/check_worst" "$MODE" "${ARGS[@]}" < "$WC"
         done
         fi
         ;;
     --special)
         "$MAKE" --quiet -C "$DIR" clean
         OPENMP=$OPENMP "$MAKE" $QUIET -C "$DIR" check_special
+        # functions checked exhaustively (like sinhcoshf) have no worst cases
+        if ! [ -f "$WC" ]; then
+            WC=/dev/null
+        fi
         if [[ -z "$DRY" ]]; then
         for MODE in "${MODES[@]}"; do
             echo "Running special checks in $MODE mode..."
             # we also give xxx.wc in input to check --special since some
 	    # functions use it (for example log2)
-            $CORE_MATH_LAUNCHER "$DIR/check_special" "$MODE" "${ARGS[@]}" < "${FILE%.c}.wc"
+            $CORE_MATH_LAUNCHER "$DIR/check_special" "$MODE" "${ARGS[@]}" < "$WC"
         done
         fi
         ;;
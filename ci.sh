@@ -4,6 +4,7 @@
 # FORCE=true DRY=--dry ./ci.sh to only try compilation (of all functions)
 # FORCE_FUNCTIONS="xxx yyy" ./ci.sh to force checking xxx and yyy
 # CC=clang CFLAGS=-Werror ./ci.sh
+# CORE_MATH_NO_ROUNDING_MATH=1 ./ci.sh to check without -frounding-math
 # SKIP16=1 ./ci.sh to avoid _Float16 tests
 # SKIPBF16=1 ./ci.sh to avoid __bf16 tests (clang 19 does not properly support them)
 
@@ -17,9 +18,9 @@ if [ -z "$LAST_COMMIT" ]; then
 fi
 
 # use the same order as on https://core-math.gitlabpages.inria.fr/
-FUNCTIONS_EXHAUSTIVE=(acosf acosf16 acos_bf16 acoshf acoshf16 acosh_bf16 acospif acospif16 acospi_bf16 asinf asinf16 asin_bf16 asinhf asinhf16 asinh_bf16 asinpif asinpif16 asinpi_bf16 atanf atanf16 atan_bf16 atan2f16 atan2_bf16 atan2pif16 atan2pi_bf16 atanhf atanhf16 atanh_bf16 atanpif atanpif16 atanpi_bf16 cbrtf cbrtf16 cbrt_bf16 compoundf16 compound_bf16 cosf cosf16 cos_bf16 coshf coshf16 cosh_bf16 cospif cospif16 cospi_bf16 erff erff16 erf_bf16 erfcf erfcf16 erfc_bf16 expf expf16 exp_bf16 exp10f exp10_bf16 exp10f16 exp10m1f exp10m1f16 exp2f exp2_bf16 exp2f16 exp2m1f exp2m1f16 exp2m1_bf16 expm1f expm1f16 expm1_bf16 hypotf16 hypot_bf16 lgammaf lgammaf16 lgamma_bf16 logf logf16 log_bf16 log10f log10f16 log10_bf16 log10p1f log10p1f16 log1pf log1pf16 log2f log2f16 log2_bf16 log2p1f log2p1f16 powf16 pow_bf16 rsqrtf rsqrtf16 rsqrt_bf16 sincosf sincosf16 sincos_bf16 sinf sinf16 sin_bf16 sinhf sinhf16 sinh_bf16 sinpif sinpif16 sinpi_bf16 sqrtf16 sqrt_bf16 tanf tanf16 tan_bf16 tanhf tanhf16 tanh_bf16 tanpif tanpif16 tanpi_bf16 tgammaf tgammaf16 tgamma_bf16)
-FUNCTIONS_WORST=(acos acosh acospi asin asinh asinpi atan atan2 atan2f atan2pi atan2pif atanh atanpi cbrt cbrtl cbrtq compoundf cos cosh cospi erf erfc exp expl expq exp10 exp10q exp10m1 exp2 exp2l exp2q exp2m1 expm1 expm1q hypot hypotf hypotl hypotq lgamma log logq log10 log10p1 log1p log2 log2l log2p1 pow powf powl rsqrt rsqrtl rsqrtq sin sincos sinh sinpi sqrtq tan tanh tanpi tgamma)
-FUNCTIONS_SPECIAL=(acos acosf acosh acospi acospif asin asinh asinpi asinpif atan atanf atan2 atan2f atan2pi atan2pif atanh atanpi atanpif cbrt cbrtl compoundf cos cosh cospi cospif erf erfc erfcf exp expf expl expq exp10 exp10q exp10m1 exp2 exp2l exp2q exp2m1 exp2m1f expm1 expm1q hypot hypotf hypotl hypotq lgamma lgammaf log log10 log10p1 log1p log2 log2l log2p1 pow powf powl rsqrt rsqrtl rsqrtq sin sincos sinh sinpi tan tanh tanpi tanpif tgamma)
+FUNCTIONS_EXHAUSTIVE=(acosf acosf16 acos_bf16 acoshf acoshf16 acosh_bf16 acospif acospif16 acospi_bf16 asinf asinf16 asin_bf16 asinhf asinhf16 asinh_bf16 asinpif asinpif16 asinpi_bf16 atanf atanf16 atan_bf16 atan2f16 atan2_bf16 atan2pif16 atan2pi_bf16 atanhf atanhf16 atanh_bf16 atanpif atanpif16 atanpi_bf16 cbrtf cbrtf16 cbrt_bf16 compoundf16 compound_bf16 cosf cosf16 cos_bf16 coshf coshf16 cosh_bf16 cospif cospif16 cospi_bf16 erff erff16 erf_bf16 erfcf erfcf16 erfc_bf16 expf expf16 exp_bf16 exp10f exp10_bf16 exp10f16 exp10m1f exp10m1f16 exp2f exp2_bf16 exp2f16 exp2m1f exp2m1f16 exp2m1_bf16 expm1f expm1f16 expm1_bf16 hypotf16 hypot_bf16 lgammaf lgammaf16 lgamma_bf16 logf logf16 log_bf16 log10f log10f16 log10_bf16 log10p1f log10p1f16 log1pf log1pf16 log2f log2f16 log2_bf16 log2p1f log2p1f16 powf16 pow_bf16 rsqrtf rsqrtf16 rsqrt_bf16 sincosf sincosf16 sincos_bf16 sinf sinf16 sin_bf16 sinhf sinhf16 sinh_bf16 sinhcoshf sinpif sinpif16 sinpi_bf16 sqrtf16 sqrt_bf16 tanf tanf16 tan_bf16 tanhf tanhf16 tanh_bf16 tanpif tanpif16 tanpi_bf16 tgammaf tgammaf16 tgamma_bf16)
+FUNCTIONS_WORST=(acos acosh acospi asin asinh asinpi atan atan2 atan2f atan2pi atan2pif atanh atanpi cart2pol cart2polf cbrt cbrtl cbrtq compound compoundf cos cosh cospi erf erfc exp expl expq exp10 exp10q exp10m1 exp2 exp2l exp2q exp2m1 expm1 expm1q hypot hypotf hypotl hypotq hypot_n lgamma log logq log10 log10p1 log1p log2 log2l log2p1 norm3f pow powf powl pown pownf pownl rootn rsqrt rsqrtl rsqrtq sin sincos sinh sinhcosh sinpi sqrtq tan tanh tanpi tgamma)
+FUNCTIONS_SPECIAL=(acos acosf acosh acospi acospif asin asinh asinpi asinpif atan atanf atan2 atan2f atan2pi atan2pif atanh atanpi atanpif cart2pol cart2polf cbrt cbrtl compound compoundf cos cosh cospi cospif erf erfc erfcf exp expf expl expq exp10 exp10q exp10m1 exp2 exp2l exp2q exp2m1 exp2m1f expm1 expm1q hypot hypotf hypotl hypotq hypot_n lgamma lgammaf log logf log10 log10p1 log1p log2 log2l log2p1 norm3f pow powf powl pown pownf pownl rootn rsqrt rsqrtl rsqrtq sin sincos sinh sinhcosh sinhcoshf sinpi tan tanh tanpi tanpif tgamma)
 
 echo "Reference commit is $LAST_COMMIT"
 
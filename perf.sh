@@ -135,12 +135,13 @@ fi
 # for clang we might want to add -ffp-contract=on to enable FMA
 if [ "$CFLAGS" == "" ]; then
    CFLAGS="-O3 -march=native"
-   ROUNDING_MATH="-frounding-math"
+   # the code is correct in all rounding modes without -frounding-math
+   # (which does slow down acoshf for example), see CORE_MATH_NO_ROUNDING_MATH
+   # in check.sh
+   ROUNDING_MATH=
    if [ "$CC" == "icx" ]; then
       # for icx we need to add -fp-model=strict for full IEEE 754 support
-      # and we don't need -frounding-math (which does slow down acoshf for example)
       CFLAGS="-O3 -fp-model=strict"
-      ROUNDING_MATH=
    fi
 fi
 CFLAGS="$CFLAGS $EXTRA_CFLAGS"
@@ -169,10 +170,16 @@ cd $dir
 make -s clean
 make -s perf
 
-# prepare random arguments for performance test
-./perf --file ${RANDOMS_FILE} --count ${N} --reference
+if [ -n "$PERF_WORST" ]; then
+    # take the arguments from a binary worst-case file (absolute path),
+    # see src/generic/support/wc2bin.c
+    PERF_ARGS="${PERF_ARGS} --worst ${PERF_WORST} --count ${N} --repeat ${M}"
+else
+    # prepare random arguments for performance test
+    ./perf --file ${RANDOMS_FILE} --count ${N} --reference
 
-PERF_ARGS="${PERF_ARGS} --file ${RANDOMS_FILE} --count ${N} --repeat ${M}"
+    PERF_ARGS="${PERF_ARGS} --file ${RANDOMS_FILE} --count ${N} --repeat ${M}"
+fi
 
 if [ "$CORE_MATH_PERF_MODE" = perf ]; then
     proc_perf
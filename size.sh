@@ -0,0 +1,45 @@
+#!/bin/bash
+# Usage: ./size.sh [functions...]
+# Example: ./size.sh expf16 sinf16 exp pow
+
+# For each function (all functions by default), print the size in bytes of
+# its code (.text sections) and of its tables (.rodata and .data sections,
+# and the core_math_tables_* sections of -DCORE_MATH_TABLE_SECTION), in the
+# default build and with -DCORE_MATH_SMALL. The functions without a
+# CORE_MATH_SMALL variant have the same sizes in both builds.
+
+OBJ_FILE="$(mktemp /tmp/core-math.XXXXXX)"
+trap "rm -f $OBJ_FILE" 0
+
+# for clang we might want to add -ffp-contract=on to enable FMA
+if [ "$CFLAGS" == "" ]; then
+   export CFLAGS="-O3 -march=native"
+fi
+
+if [ $# -eq 0 ]; then
+    set -- $(sed -n 's/^FUNCTION_UNDER_TEST := //p' src/*/*/Makefile | sort)
+fi
+
+# print the code and table sizes of $1 compiled with $2, or "-" on failure
+sizes () {
+    if ${CC:-cc} $CFLAGS $2 -I"${1%/*}" -c "$1" -o $OBJ_FILE 2> /dev/null
+    then
+        size -A $OBJ_FILE | awk '
+          $1 ~ /^\.text/ { code += $2 }
+          $1 ~ /^\.(rodata|data)/ || $1 ~ /^core_math_tables_/ { tab += $2 }
+          END { printf "%10d %10d", code, tab }'
+    else
+        printf "%10s %10s" - -
+    fi
+}
+
+printf "%-16s %21s %21s\n" "" "default" "CORE_MATH_SMALL"
+printf "%-16s %10s %10s %10s %10s\n" "" code tables code tables
+for f in "$@"; do
+    u="$(echo src/binary*/*/$f.c)"
+    if [ ! -f "$u" ]; then
+        echo "Unknown function: $f"
+        exit 2
+    fi
+    printf "%-16s %s %s\n" $f "$(sizes $u)" "$(sizes $u -DCORE_MATH_SMALL)"
+done
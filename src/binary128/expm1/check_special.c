@@ -36,6 +36,8 @@ SOFTWARE.
 #include <omp.h>
 #endif
 
+#include "../../generic/support/philox.h"
+
 typedef union {
   unsigned __int128 a;
   __float128 f;
@@ -52,9 +54,7 @@ int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
 int rnd = 0;
 int verbose = 0;
 
-#define MAX_THREADS 192
-
-static unsigned int Seed[MAX_THREADS];
+static uint64_t Seed;
 
 /* define our own is_nan function to avoid depending from math.h */
 static inline int is_nan(__float128 x){
@@ -93,13 +93,11 @@ static void check(__float128 x){
   }
 }
 
-static __float128 get_random(int tid){
+static __float128 get_random(philox_t *s){
   b128u128_u v = {.a = 0};
-  v.a |= (__int128)rand_r(Seed + tid) << 31*0;
-  v.a |= (__int128)rand_r(Seed + tid) << 31*1;
-  v.a |= (__int128)rand_r(Seed + tid) << 31*2;
-  v.a |= (__int128)rand_r(Seed + tid) << 31*3;
-  v.a |= (__int128)rand_r(Seed + tid) << 31*4;
+  uint64_t r[2];
+  philox_next (s, r);
+  v.a = (__int128) r[1] << 64 | r[0];
   v.a &= ~((__int128)1<<127);
   return v.f;
 }
@@ -116,7 +114,7 @@ check_subnormal (void)
   __int128 m0 = 1;
   __int128 m1 = (__int128) 1 << 112;
   __int128 step = (m1 - m0) / (CORE_MATH_TESTS / 10);
-  m0 += rand_r (Seed);
+  m0 += Seed % step;
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
 #pragma omp parallel for
 #endif
@@ -160,9 +158,7 @@ int main(int argc, char *argv[]){
   ref_fesetround(rnd);
   fesetround(rnd1[rnd]);
 
-  unsigned int seed = getpid();
-  for(int i = 0; i < MAX_THREADS; i++)
-    Seed[i] = seed + i;
+  Seed = philox_seed ();
 
   printf("Checking random values in subnormal range\n");
   check_subnormal ();
@@ -175,13 +171,9 @@ int main(int argc, char *argv[]){
   for(uint64_t n = 0; n < CORE_MATH_TESTS; n++){
     ref_init();
     ref_fesetround(rnd);
-    int tid;
-#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
-    tid = omp_get_thread_num();
-#else
-    tid = 0;
-#endif
-    __float128 x = get_random(tid);
+    philox_t s;
+    philox_init (&s, Seed, n);
+    __float128 x = get_random(&s);
     check(x);
   }
   return 0;
@@ -37,6 +37,17 @@ SOFTWARE.
 
 typedef union {float f; uint32_t u;} b32u32_u;
 
+/* Return y rounded to binary16. Through the volatile variable, the rounding
+   is done at run time in the current rounding mode, even if y is a constant:
+   without -frounding-math, the compiler would do it at compile time, thus
+   to nearest. */
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 // the following polynomials were generated using Sollya (cf acos.sollya)
 
 /* degree-4 minimax polynomial for acos(x) over [0,0.25], with relative error
@@ -64,7 +75,7 @@ _Float16 cr_acosf16 (_Float16 x)
 
   if (au >= 0x3f800000u) { // NaN, Inf, or |x| >= 1
     if (au == 0x3f800000u)
-      return (u == 0x3f800000u) ? 0.0f16 : 0x1.921fb6p+1f;
+      return (u == 0x3f800000u) ? 0.0f16 : round_f16 (0x1.921fb6p+1f);
 #ifdef CORE_MATH_SUPPORT_ERRNO
     errno = EDOM;
 #endif
@@ -89,11 +100,11 @@ _Float16 cr_acosf16 (_Float16 x)
       /* below we deal with a few exceptions that we were unable to remove
          by tuning the coefficients of p0 */
       if (0x36960000 <= au && au <= 0x369a0000)
-        y = 0x1.922002p+0f; // x = -0x1.2cp-18 or -0x1.3p-18 or -0x1.34p-18
+        return round_f16 (0x1.922002p+0f); // x = -0x1.2cp-18 or -0x1.3p-18 or -0x1.34p-18
       if (u == 0xbcf80000)
-        y = 0x1.99e002p+0f; // x = -0x1.fp-6
+        return round_f16 (0x1.99e002p+0f); // x = -0x1.fp-6
       if (u == 0xbcfc0000)
-        y = 0x1.9a0006p+0f; // -0x1.f8p-6
+        return round_f16 (0x1.9a0006p+0f); // -0x1.f8p-6
     }
   }
   else if (au < 0x3f000000u) { // 0.25 <= |x| < 0.5
@@ -37,6 +37,14 @@ SOFTWARE.
 
 typedef union {float f; uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 /* The following polynomials were generated using Sollya (cf acosh.sollya).
    For 0 <= i < 16, P[i] is a degree-5 polynomial approximating
    acosh(x)/sqrt(x-1) for 0 <= i < 5, and acosh(x) for 5 <= i < 16.
@@ -99,41 +107,41 @@ _Float16 cr_acoshf16 (_Float16 x)
   // deal with exceptions
   switch (i) {
   case 1:
-    if (u == 0x40422000) y = 0x1.c63ffcp+0f; // x = 0x1.844p+1
+    if (u == 0x40422000) return round_f16 (0x1.c63ffcp+0f); // x = 0x1.844p+1
     break;
   case 3:
-    if (u == 0x411c0000) y = 0x1.7be006p+1f; // x = 0x1.38p+3
-    if (u == 0x415f6000) y = 0x1.aa0002p+1f; // x = 0x1.becp+3
+    if (u == 0x411c0000) return round_f16 (0x1.7be006p+1f); // x = 0x1.38p+3
+    if (u == 0x415f6000) return round_f16 (0x1.aa0002p+1f); // x = 0x1.becp+3
     break;
   case 4 :
-    if (u == 0x41bfe000) y = 0x1.ef5fecp+1f; // x = 0x1.7fcp+4
-    if (u == 0x41c04000) y = 0x1.ef9ff6p+1f; // x = 0x1.808p+4
-    if (u == 0x41dbc000) y = 0x1.006016p+2f; // x = 0x1.b78p+4
-    if (u == 0x41d3c000) y = 0x1.fc002ap+1f; // x = 0x1.a78p+4
+    if (u == 0x41bfe000) return round_f16 (0x1.ef5fecp+1f); // x = 0x1.7fcp+4
+    if (u == 0x41c04000) return round_f16 (0x1.ef9ff6p+1f); // x = 0x1.808p+4
+    if (u == 0x41dbc000) return round_f16 (0x1.006016p+2f); // x = 0x1.b78p+4
+    if (u == 0x41d3c000) return round_f16 (0x1.fc002ap+1f); // x = 0x1.a78p+4
     break;
   case 5:
-    if (u == 0x42374000) y = 0x1.21201cp+2f; // x = 0x1.6e8p+5
-    if (u == 0x4245c000) y = 0x1.260012p+2f; // x = 0x1.8b8p+5
+    if (u == 0x42374000) return round_f16 (0x1.21201cp+2f); // x = 0x1.6e8p+5
+    if (u == 0x4245c000) return round_f16 (0x1.260012p+2f); // x = 0x1.8b8p+5
     break;
   case 6:
-    if (u == 0x42890000) y = 0x1.3ae018p+2f; // x = 0x1.12p+6
-    if (u == 0x429d6000) y = 0x1.43bff4p+2f; // x = 0x1.3acp+6
+    if (u == 0x42890000) return round_f16 (0x1.3ae018p+2f); // x = 0x1.12p+6
+    if (u == 0x429d6000) return round_f16 (0x1.43bff4p+2f); // x = 0x1.3acp+6
     break;
   case 7:
-    if (u == 0x433d2000) y = 0x1.7be006p+2f; // x = 0x1.7a4p+7
+    if (u == 0x433d2000) return round_f16 (0x1.7be006p+2f); // x = 0x1.7a4p+7
     break;
   case 8:
-    if (u == 0x43884000) y = 0x1.934004p+2f; // x = 0x1.108p+8
-    if (u == 0x43f9a000) y = 0x1.ba000ep+2f; // x = 0x1.f34p+8
+    if (u == 0x43884000) return round_f16 (0x1.934004p+2f); // x = 0x1.108p+8
+    if (u == 0x43f9a000) return round_f16 (0x1.ba000ep+2f); // x = 0x1.f34p+8
     break;
   case 9:
-    if (u == 0x443b0000) y = 0x1.d3e00cp+2f; // x = 0x1.76p+9
+    if (u == 0x443b0000) return round_f16 (0x1.d3e00cp+2f); // x = 0x1.76p+9
     break;
   case 12:
-    if (u == 0x45b78000) y = 0x1.2be008p+3f; // x = 0x1.6fp+12
+    if (u == 0x45b78000) return round_f16 (0x1.2be008p+3f); // x = 0x1.6fp+12
     break;
   case 13:
-    if (u == 0x4673a000) y = 0x1.4b2008p+3f; // x = 0x1.e74p+13
+    if (u == 0x4673a000) return round_f16 (0x1.4b2008p+3f); // x = 0x1.e74p+13
   }
 
   return y;
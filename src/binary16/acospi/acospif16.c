@@ -37,6 +37,14 @@ SOFTWARE.
 
 typedef union {float f; uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 // the following polynomials were generated using Sollya (cf acos.sollya)
 
 /* degree-4 minimax polynomial for acos(x) over [0,0.25], with relative error
@@ -83,13 +91,13 @@ _Float16 cr_acospif16 (_Float16 x)
   if (au < 0x3e800000u) { // |x| < 0.25
     if (au == 0) return 0.5f; // would be inexact with the code below
     if (au == 0x3c55a000u) // |x| = 0x1.ab4p-7
-      return (au == u) ? 0x1.fbbffcp-2f : 0x1.022002p-1f;
+      return round_f16 ((au == u) ? 0x1.fbbffcp-2f : 0x1.022002p-1f);
     if (au == 0x3d8a2000u) // |x| = 0x1.144p-4
-      return (au == u) ? 0x1.ea0002p-2f : 0x1.0afffep-1f;
+      return round_f16 ((au == u) ? 0x1.ea0002p-2f : 0x1.0afffep-1f);
     if (u == 0x3d21c000u) // x = 0x1.438p-5
-      return 0x1.f31ffep-2f;
+      return round_f16 (0x1.f31ffep-2f);
     if (u == 0x3db3a000u) // x = 0x1.674p-4
-      return 0x1.e36002p-2f;
+      return round_f16 (0x1.e36002p-2f);
     c1 = __builtin_fmaf (p0[2], t, p0[1]);
     c3 = __builtin_fmaf (p0[4], t, p0[3]);
     y = __builtin_fmaf (c3, tt, c1);
@@ -109,7 +117,7 @@ _Float16 cr_acospif16 (_Float16 x)
   }
   else { // 0.5 <= |x| <= 1
     if (au == 0x3f3ca000u) // |x| = 0x1.794p-1
-      return (au == u) ? 0x1.e4000ap-3f : 0x1.86fffep-1f;
+      return round_f16 ((au == u) ? 0x1.e4000ap-3f : 0x1.86fffep-1f);
     c1 = __builtin_fmaf (p2[2], t, p2[1]);
     c3 = __builtin_fmaf (p2[4], t, p2[3]);
     y = __builtin_fmaf (c3, tt, c1);
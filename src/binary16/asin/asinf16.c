@@ -37,6 +37,14 @@ SOFTWARE.
 
 typedef union {float f; uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 // the following polynomials were generated using Sollya (cf asin.sollya)
 
 /* degree-5 minimax polynomial for asin(x) over [0,0.25], with relative error
@@ -61,7 +69,7 @@ _Float16 cr_asinf16 (_Float16 x)
 
   if (au >= 0x3f800000u) { // NaN, Inf, or |x| >= 1
     if (au == 0x3f800000u) // |x| = 1
-      return (u == 0x3f800000u) ? HALF_PI : -HALF_PI;
+      return round_f16 ((u == 0x3f800000u) ? HALF_PI : -HALF_PI);
 #ifdef CORE_MATH_SUPPORT_ERRNO
     errno = EDOM;
 #endif
@@ -101,11 +109,11 @@ _Float16 cr_asinf16 (_Float16 x)
       return (au == u) ? v.f + 0x1p-26f : v.f - 0x1p-26f;
     }
     if (au == 0x3dd30000u) // |x| = 0x1.a6p-4
-      return (au == u) ? 0x1.a6c00ap-4f : -0x1.a6c00ap-4f;
+      return round_f16 ((au == u) ? 0x1.a6c00ap-4f : -0x1.a6c00ap-4f);
     if (au == 0x3d688000u) // |x| = 0x1.d1p-5
-      return (au == u) ? 0x1.d14004p-5f : -0x1.d14004p-5f;
+      return round_f16 ((au == u) ? 0x1.d14004p-5f : -0x1.d14004p-5f);
     if (au == 0x3dfa0000u) // |x| = 0x1.f4p-4
-      return (au == u) ? 0x1.f5400ap-4f : -0x1.f5400ap-4f;
+      return round_f16 ((au == u) ? 0x1.f5400ap-4f : -0x1.f5400ap-4f);
     /* Warning for rounding toward -Inf: let p0(t) = t*q(t). If we first
        compute q(t) and then multiply by t, for tiny t and rounding we will
        get q(t)=1, and then t, whereas the correct result is nextbelow(t). */
@@ -114,11 +122,11 @@ _Float16 cr_asinf16 (_Float16 x)
   }
   else { // 0.25 <= t <= 0.5
     if (au == 0x3eb24000u) // |x| = 0x1.648p-2
-      return (au == u) ? 0x1.6c2012p-2f : -0x1.6c2012p-2f;
+      return round_f16 ((au == u) ? 0x1.6c2012p-2f : -0x1.6c2012p-2f);
     if (au == 0x3ed96000u) // |x| = 0x1.b2cp-2
-      return (au == u) ? 0x1.c0fffap-2f : -0x1.c0fffap-2f;
+      return round_f16 ((au == u) ? 0x1.c0fffap-2f : -0x1.c0fffap-2f);
     if (au == 0x3ef0a000u) // |x| = 0x1.e14p-2
-      return (au == u) ? 0x1.f4fffp-2f : -0x1.f4fffp-2f;
+      return round_f16 ((au == u) ? 0x1.f4fffp-2f : -0x1.f4fffp-2f);
     c5 = __builtin_fmaf (p1[3], tt, p1[2]);
     c1 = __builtin_fmaf (p1[1], tt, p1[0]);
     y = __builtin_fmaf (c5, tt * tt, c1);
@@ -37,6 +37,14 @@ SOFTWARE.
 
 typedef union {float f; uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 // the following polynomials were generated using Sollya (cf asin.sollya)
 
 /* degree-7 minimax polynomial for asin(x) over [0,0.25], with relative error
@@ -81,11 +89,11 @@ _Float16 cr_asinpif16 (_Float16 x)
   int reduce = au >= 0x3f000000u; // |x| >= 0.5
   if (reduce) {
     if (au == 0x3f10a000u) // |x|=0x1.214p-1
-      return (au == u) ? 0x1.876016p-3f : -0x1.876016p-3f;
+      return round_f16 ((au == u) ? 0x1.876016p-3f : -0x1.876016p-3f);
     if (au == 0x3f208000u) // |x|=0x1.41p-1
-      return (au == u) ? 0x1.b9c002p-3f : -0x1.b9c002p-3f;
+      return round_f16 ((au == u) ? 0x1.b9c002p-3f : -0x1.b9c002p-3f);
     if (au == 0x3f3ca000u) // |x|=0x1.794p-1
-      return (au == u) ? 0x1.0dfffap-2f : -0x1.0dfffap-2f;
+      return round_f16 ((au == u) ? 0x1.0dfffap-2f : -0x1.0dfffap-2f);
     if (u >> 31) // x < 0
       t = -t;
     // argument reduction: asin(x) = pi/2 - 2*asin(sqrt((1-x)/2))
@@ -109,16 +117,16 @@ _Float16 cr_asinpif16 (_Float16 x)
       return __builtin_fmaf (t, INV_PI, 0x1p-25f * t);
     }
     if (au == 0x3e002000) // |x| = 0x1.004p-3
-      return (au == u) ? 0x1.472002p-5f : -0x1.472002p-5f;
+      return round_f16 ((au == u) ? 0x1.472002p-5f : -0x1.472002p-5f);
     c5 = __builtin_fmaf (p0[3], tt, p0[2]); // degree 5
     c3 = __builtin_fmaf (c5, tt, p0[1]);    // degree 3
     y = __builtin_fmaf (c3, tt * t, t);
   }
   else { // 0.25 <= t <= 0.5
     if (au == 0x3eb7a000u) // |x|=0x1.6f4p-2
-      return (au == u) ? 0x1.de400ep-4f : -0x1.de400ep-4f;
+      return round_f16 ((au == u) ? 0x1.de400ep-4f : -0x1.de400ep-4f);
     if (au == 0x3ec4c000u) // |x|=0x1.898p-2
-      return (au == u) ? 0x1.012006p-3f : -0x1.012006p-3f;
+      return round_f16 ((au == u) ? 0x1.012006p-3f : -0x1.012006p-3f);
     c5 = __builtin_fmaf (p1[3], tt, p1[2]);
     c1 = __builtin_fmaf (p1[1], tt, p1[0]);
     y = __builtin_fmaf (c5, tt * tt, c1);
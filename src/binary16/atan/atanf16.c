@@ -37,6 +37,14 @@ SOFTWARE.
 
 typedef union {float f; uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 // the following polynomials were generated using Sollya (cf atan.sollya)
 
 /* Degree-7 minimax polynomial for atan(x) over [0,0.25], with relative error
@@ -72,7 +80,7 @@ _Float16 cr_atanf16 (_Float16 x)
 
   if (au >= 0x7f800000u) { // NaN or Inf
     if (au == 0x7f800000u) // +/-Inf
-      return (u == 0x7f800000u) ? HALF_PI : -HALF_PI;
+      return round_f16 ((u == 0x7f800000u) ? HALF_PI : -HALF_PI);
 #ifdef CORE_MATH_SUPPORT_ERRNO
     errno = EDOM;
 #endif
@@ -114,11 +122,11 @@ _Float16 cr_atanf16 (_Float16 x)
     
     // deal with exceptional cases
     if (au == 0x3e56a000u) // |x| = 0x1.ad4p-3
-      return (au == u) ? 0x1.a72002p-3f : -0x1.a72002p-3f;
+      return round_f16 ((au == u) ? 0x1.a72002p-3f : -0x1.a72002p-3f);
     if (au == 0x4115c000u) // |x| = 0x1.2b8p+3
-      return (au == u) ? 0x1.76dffep+0f : -0x1.76dffep+0f;
+      return round_f16 ((au == u) ? 0x1.76dffep+0f : -0x1.76dffep+0f);
     if (au == 0x42c32000u) // |x| = 0x1.864p+6
-      return (au == u) ? 0x1.8f7ffep+0f : -0x1.8f7ffep+0f;
+      return round_f16 ((au == u) ? 0x1.8f7ffep+0f : -0x1.8f7ffep+0f);
 
     p = p0;
     c5 = __builtin_fmaf (p[3], tt, p[2]);
@@ -57,6 +57,14 @@ typedef union {_Float16 f; uint16_t u;} b16u16_u;
 typedef union {float f; uint32_t u;} b32u32_u;
 typedef union {double f; uint64_t u;} b64u64_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 /* don't use MXCSR (_mm_getcsr/_mm_setcsr) since it does not deal with
    _Float16 exceptions */
 static FLAG_T
@@ -484,7 +492,7 @@ static _Float16 exp2_1 (double t, __attribute__((unused)) int exact)
 #ifdef CORE_MATH_SUPPORT_ERRNO
     errno = ERANGE; // underflow
 #endif
-    return 0x1p-25f;
+    return round_f16 (0x1p-25f);
   }
   double k = roundeven_finite (t); // 0 <= |k| <= 150
   double r = t - k; // |r| <= 1/2, exact
@@ -1044,7 +1052,8 @@ _Float16 cr_compoundf16 (_Float16 xf16, _Float16 yf16)
 #ifdef CORE_MATH_SUPPORT_ERRNO
       errno = ERANGE; // underflow
 #endif
-      return 0x1p-126f * 0x1p-126f;
+      volatile float z = 0x1p-126f;
+      return z * z;
     } else if (!(t.u >> 63)) { // t >= 128: overflow
 #ifdef CORE_MATH_SUPPORT_ERRNO
       errno = ERANGE; // overflow
@@ -1057,8 +1066,10 @@ _Float16 cr_compoundf16 (_Float16 xf16, _Float16 yf16)
      150*2^-47.909 < 2^-40.680 */
 
   // 2^t rounds to 1 to nearest when |t| <= 0x1.715476ba97f14p-25
-  if (__builtin_expect ((t.u << 1) <= 0x3e6715476ba97f14ull, 0))
-    return (t.u >> 63) ? 1.0f - 0x1p-25f : 1.0f + 0x1p-25f;
+  if (__builtin_expect ((t.u << 1) <= 0x3e6715476ba97f14ull, 0)) {
+    volatile float one = 1.0f;
+    return (t.u >> 63) ? one - 0x1p-25f : one + 0x1p-25f;
+  }
 
   int midpoint = 0;
   int exact = is_exact_or_midpoint (x, y, &midpoint);
@@ -38,6 +38,47 @@ SOFTWARE.
 typedef union {_Float16 f; uint16_t u;} b16u16_u;
 typedef union {float f;    uint32_t u;} b32u32_u;
 
+/* With -DCORE_MATH_SMALL, the tables S1, C1, S2 and C2 (32KB) are replaced
+   by an argument reduction and two polynomials, see sincos_small(). */
+#ifdef CORE_MATH_SMALL
+/* Return an approximation of sin(x) for c = 0, of cos(x) for c = 1, where
+   0 < x <= 65504, with relative error less than 2^-44: this is enough to
+   round correctly cos(x) for all binary16 inputs (checked exhaustively). */
+static inline double
+sincos_small (double x, int c)
+{
+  /* Taylor coefficients of (sin(r)/r - 1)/r^2 and (cos(r) - 1)/r^2 in r^2:
+     for |r| <= pi/4, the truncation errors are less than 2^-45 and 2^-49
+     (relative) */
+  static const double s[] =
+    {-0x1.5555555555555p-3, 0x1.1111111111111p-7, -0x1.a01a01a01a01ap-13,
+     0x1.71de3a556c734p-19, -0x1.ae64567f544e4p-26, 0x1.6124613a86d09p-33};
+  static const double cs[] =
+    {-0x1p-1, 0x1.5555555555555p-5, -0x1.6c16c16c16c17p-10,
+     0x1.a01a01a01a01ap-16, -0x1.27e4fb7789f5cp-22, 0x1.1eed8eff8d898p-29,
+     -0x1.93974a8c07c9dp-37};
+  /* Write x = k*pi/2 + r with |r| <= pi/4 (up to rounding errors), where
+     pi/2 = P1 + P2 + P3, P1 and P2 being binary64 numbers, and
+     |P3| < 2^-109. Since k < 2^16, k*P3 < 2^-93 is neglected, and t and r
+     below are computed with one rounding each. Since |r| > 2^-16.1 for
+     x a non-zero binary16 number (and r = x for k = 0), the relative error
+     on r is less than 2^-52. The conversion to k raises inexact, which is
+     fine since sin(x) and cos(x) are not exact for x <> 0. */
+  int64_t k = x * 0x1.45f306dc9c883p-1 + 0.5;
+  double kd = k;
+  double t = __builtin_fma (-kd, 0x1.921fb54442d18p+0, x);
+  double r = __builtin_fma (-kd, 0x1.1a62633145c07p-54, t);
+  double r2 = r * r, r4 = r2 * r2, p;
+  k += c; // cos(x) = sin(x + pi/2)
+  if (k & 1) // sin(x) = (-1)^((k-1)/2) * cos(r)
+    p = 1.0 + r2 * ((cs[0] + r2 * cs[1]) + r4 * ((cs[2] + r2 * cs[3])
+                     + r4 * ((cs[4] + r2 * cs[5]) + r4 * cs[6])));
+  else // sin(x) = (-1)^(k/2) * sin(r)
+    p = r + (r * r2) * ((s[0] + r2 * s[1]) + r4 * ((s[2] + r2 * s[3])
+                         + r4 * (s[4] + r2 * s[5])));
+  return (k & 2) ? -p : p;
+}
+#else
 static const b32u32_u S1[] = {
  {0x0p+0}, {0x1p-19}, {0x1p-18}, {0x1.8p-18}, {0x1p-17}, {0x1.4p-17},
  {0x1.8p-17}, {0x1.cp-17}, {0x1p-16}, {0x1.2p-16}, {0x1.4p-16}, {0x1.6p-16},
@@ -2006,9 +2047,20 @@ static const b32u32_u C2[] = {
  {.u = 0x0}, {.u = 0x0}, {.u = 0x0}, {.u = 0x0}, {.u = 0x0}, {.u = 0x0},
  {.u = 0x0}, {.u = 0x0}, {.u = 0x0}, {.u = 0x0}, {.u = 0x0},
 };
+#endif
 
 _Float16 cr_cosf16(_Float16 x){
   b16u16_u v = {.f = x};
+#ifdef CORE_MATH_SMALL
+  double az = __builtin_fabs ((double) v.f);
+  if (__builtin_expect (!(az <= 0x1.ffcp+15), 0)) // x = Inf or NaN
+    return x - x; // NaN, with invalid raised for Inf or sNaN
+  if (az == 0) return 1.0f; // cos(+/-0) = 1, exact
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  uint16_t m = v.u & 0x7fff;
+#endif
+  double res = sincos_small (az, 1);
+#else
   /* We decompose x into x1 + x2, and use
      cos(x1+x2) = cos(x1)*cos(x2) - sin(x1)*sin(x2), where binary32
      approximations of sin(x1), cos(x1), sin(x2) and cos(x2) are tabulated. */
@@ -2019,6 +2071,7 @@ _Float16 cr_cosf16(_Float16 x){
   // we use a FMA to fix the evaluation order
   if (m == 0) return 1.0f; // only exceptional case
   float res = __builtin_fmaf (C1[i1].f, C2[i2].f, S1[i1].f * S2[i2].f);
+#endif
 #ifdef CORE_MATH_SUPPORT_ERRNO
   /* There are only two values that yield underflow (up to sign):
      0x1.63p+7 and 0x1.0a4p+9 */
@@ -28,6 +28,18 @@ SOFTWARE.
 #include <errno.h>
 #include <math.h> // only used during performance tests
 
+/* With -DCORE_MATH_TABLE_SECTION, the tables below are put in the section
+   core_math_tables_exp, aligned on cache lines, see
+   src/generic/support/warmup.h. */
+#ifndef CORE_MATH_TABLE
+#ifdef CORE_MATH_TABLE_SECTION
+#define CORE_MATH_TABLE(family) \
+  __attribute__((section ("core_math_tables_" #family), aligned (64)))
+#else
+#define CORE_MATH_TABLE(family)
+#endif
+#endif
+
 // Warning: clang also defines __GNUC__
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic ignored "-Wunknown-pragmas"
@@ -42,7 +54,7 @@ typedef union {float f;    uint32_t u;} b32u32_u;
    to nearest, where the float16 encoding of x1 is i1*2^5.
    Table generated by table1sinh() from cosh.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u S1[] = {
+static const b32u32_u S1[] CORE_MATH_TABLE (exp) = {
  {0x0p+0}, {0x1.000002p-19}, {0x1.000002p-18}, {0x1.800002p-18},
  {0x1.000002p-17}, {0x1.400002p-17}, {0x1.800002p-17}, {0x1.c00002p-17},
  {0x1.000002p-16}, {0x1.200002p-16}, {0x1.400002p-16}, {0x1.600002p-16},
@@ -562,7 +574,7 @@ static const b32u32_u S1[] = {
    to nearest, where the float16 encoding of x1 is i1*2^5.
    Table generated by table1cosh() from cosh.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u C1[] = {
+static const b32u32_u C1[] CORE_MATH_TABLE (exp) = {
  {0x1.000000p+0}, {0x1.000002p+0}, {0x1.000002p+0}, {0x1.000002p+0},
  {0x1.000002p+0}, {0x1.000002p+0}, {0x1.000002p+0}, {0x1.000002p+0},
  {0x1.000002p+0}, {0x1.000002p+0}, {0x1.000002p+0}, {0x1.000002p+0},
@@ -1084,7 +1096,7 @@ static const b32u32_u C1[] = {
    into x1 + x2, where x1 is defined along S1.
    Table generated by table2sinh() from cosh.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u S2[] = {
+static const b32u32_u S2[] CORE_MATH_TABLE (exp) = {
  {0x0p+0}, {0x1.000002p-24}, {0x1.000002p-23}, {0x1.800002p-23},
  {0x1.000002p-22}, {0x1.400002p-22}, {0x1.800002p-22}, {0x1.c00002p-22},
  {0x1.000002p-21}, {0x1.200002p-21}, {0x1.400002p-21}, {0x1.600002p-21},
@@ -1606,7 +1618,7 @@ static const b32u32_u S2[] = {
    manually edited to decrease the number of exceptional values, in
    particular when cosh(x2) rounds to 1, we replace by nextabove(1) to
    avoid that cosh(x) rounds to 1 instead of nextabove(1) for RNDU. */
-static const b32u32_u C2[] = {
+static const b32u32_u C2[] CORE_MATH_TABLE (exp) = {
  {0x1.000002p+0}, {0x1.000002p+0}, {0x1.000002p+0}, {0x1.000002p+0},
  {0x1.000002p+0}, {0x1.000002p+0}, {0x1.000002p+0}, {0x1.000002p+0},
  {0x1.000002p+0}, {0x1.000002p+0}, {0x1.000002p+0}, {0x1.000002p+0},
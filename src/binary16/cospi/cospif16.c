@@ -27,6 +27,18 @@ SOFTWARE.
 #include <stdint.h>
 #include <math.h> // only used during performance tests
 
+/* With -DCORE_MATH_TABLE_SECTION, the tables below are put in the section
+   core_math_tables_trig, aligned on cache lines, see
+   src/generic/support/warmup.h. */
+#ifndef CORE_MATH_TABLE
+#ifdef CORE_MATH_TABLE_SECTION
+#define CORE_MATH_TABLE(family) \
+  __attribute__((section ("core_math_tables_" #family), aligned (64)))
+#else
+#define CORE_MATH_TABLE(family)
+#endif
+#endif
+
 // Warning: clang also defines __GNUC__
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic ignored "-Wunknown-pragmas"
@@ -41,7 +53,7 @@ typedef union {float f;    uint32_t u;} b32u32_u;
    to nearest, where the float16 encoding of x1 is i1*2^5.
    Table generated by table1sin() from cospi.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u S1[] = {
+static const b32u32_u S1[] CORE_MATH_TABLE (trig) = {
  {0x0p+0}, {0x1.921fb6p-18}, {0x1.921fb6p-17}, {0x1.2d97c8p-16},
  {0x1.921fb6p-16}, {0x1.f6a7a2p-16}, {0x1.2d97c8p-15}, {0x1.5fdbbep-15},
  {0x1.921fb6p-15}, {0x1.c463acp-15}, {0x1.f6a7a2p-15}, {0x1.1475ccp-14},
@@ -472,7 +484,7 @@ static const b32u32_u S1[] = {
    to nearest, where the float16 encoding of x1 is i1*2^5.
    Table generated by table1cos() from cospi.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u C1[] = {
+static const b32u32_u C1[] CORE_MATH_TABLE (trig) = {
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
@@ -897,7 +909,7 @@ static const b32u32_u C1[] = {
    into x1 + x2, where x1 is defined along S1.
    Table generated by table2sin() from cospi.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u S2[] = {
+static const b32u32_u S2[] CORE_MATH_TABLE (trig) = {
  {-0x0p+3}, {-0x1.921fb6p-23}, {-0x1.921fb6p-22}, {-0x1.2d97c8p-21},
  {-0x1.921fb6p-21}, {-0x1.f6a7a2p-21}, {-0x1.2d97c8p-20}, {-0x1.5fdbbep-20},
  {-0x1.921fb6p-20}, {-0x1.c463acp-20}, {-0x1.f6a7a2p-20}, {-0x1.1475ccp-19},
@@ -1360,7 +1372,7 @@ static const b32u32_u S2[] = {
    into x1 + x2, where x1 is defined along C1.
    Table generated by table2cos() from cospi.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u C2[] = {
+static const b32u32_u C2[] CORE_MATH_TABLE (trig) = {
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
@@ -39,6 +39,48 @@ SOFTWARE.
 typedef union {_Float16 f; uint16_t u;} b16u16_u;
 typedef union {float f; uint32_t u;} b32u32_u;
 
+/* With -DCORE_MATH_SMALL, the tables T1 and T2 (16KB) are replaced by a
+   32-entry table and a polynomial, see exp2_small(). */
+#ifdef CORE_MATH_SMALL
+typedef union {double f; uint64_t u;} b64u64_u;
+
+/* For 0 <= i < 32, tb[i] is the binary64 encoding of 2^(i/32) rounded to
+   nearest. */
+static const uint64_t tb[] =
+  {0x3ff0000000000000, 0x3ff059b0d3158574, 0x3ff0b5586cf9890f, 0x3ff11301d0125b51,
+   0x3ff172b83c7d517b, 0x3ff1d4873168b9aa, 0x3ff2387a6e756238, 0x3ff29e9df51fdee1,
+   0x3ff306fe0a31b715, 0x3ff371a7373aa9cb, 0x3ff3dea64c123422, 0x3ff44e086061892d,
+   0x3ff4bfdad5362a27, 0x3ff5342b569d4f82, 0x3ff5ab07dd485429, 0x3ff6247eb03a5585,
+   0x3ff6a09e667f3bcd, 0x3ff71f75e8ec5f74, 0x3ff7a11473eb0187, 0x3ff82589994cce13,
+   0x3ff8ace5422aa0db, 0x3ff93737b0cdc5e5, 0x3ff9c49182a3f090, 0x3ffa5503b23e255d,
+   0x3ffae89f995ad3ad, 0x3ffb7f76f2fb5e47, 0x3ffc199bdd85529c, 0x3ffcb720dcef9069,
+   0x3ffd5818dcfba487, 0x3ffdfc97337b9b5f, 0x3ffea4afa2a490da, 0x3fff50765b6e4540};
+
+/* Return an approximation of 2^y for |y| < 32, with relative error less
+   than 2^-42: this is enough to round correctly 10^x for all binary16
+   inputs (checked exhaustively). */
+static inline double
+exp2_small (double y)
+{
+  /* c[i] = log(2)^(i+1)/(i+1)!, the degree-5 Taylor polynomial of 2^r
+     being 1 + r*P(r) with P(r) = c[0] + c[1]*r + ... + c[4]*r^4: for
+     |r| <= 2^-5, the truncation error is less than (log(2)/32)^6/720
+     < 2^-42.7 */
+  static const double c[] =
+    {0x1.62e42fefa39efp-1, 0x1.ebfbdff82c58fp-3, 0x1.c6b08d704a0c0p-5,
+     0x1.3b2ab6fba4e77p-7, 0x1.5d87fe78a6731p-10};
+  const double big = 0x1.8p+47; // ulp(big) = 2^-5
+  b64u64_u u = {.f = y + big};
+  /* u.f - big = k/32 is exact, and r = y - k/32 is exact, with |r| <= 2^-6
+     to nearest, |r| < 2^-5 for directed roundings */
+  double r = y - (u.f - big);
+  /* the low bits of u.u encode k, as in cr_expf() */
+  b64u64_u sv = {.u = tb[u.u & 0x1f] + ((u.u >> 5) << 52)};
+  double r2 = r * r;
+  double p = (c[0] + r * c[1]) + r2 * ((c[2] + r * c[3]) + r2 * c[4]);
+  return sv.f + (sv.f * r) * p;
+}
+#else
 /* For 0 <= i1 < 2^11, T1[i1] stores the binary32 approximation of y1=exp10(x1)
    to nearest, where the float16 encoding of x1 is i1*2^5.
    Values y1 that overflow/underflow in binary32 are capped to the
@@ -1032,21 +1074,41 @@ static const b32u32_u T2[] = {
  {.u = 0x7f834000}, {.u = 0x7f836000}, {.u = 0x7f838000}, {.u = 0x7f83a000},
  {.u = 0x7f83c000}, {.u = 0x7f83e000},
 };
+#endif
 
 _Float16 cr_exp10f16(_Float16 x){
   b16u16_u v = {.f = x};
 #ifdef CORE_MATH_SUPPORT_ERRNO
   if (v.f > 0x1.344p+2f || v.f <= -0x1.0dcp+2f)
     errno = ERANGE;
-  if (v.f == 0x1.344p+2f && 0x1p0f + 0x1.8p-24f != 0x1p0f)
+  /* the result overflows for rounding to nearest or upward: the volatile
+     variable prevents the compiler from evaluating the sum to nearest */
+  static volatile float tiny = 0x1.8p-24f;
+  if (v.f == 0x1.344p+2f && 0x1p0f + tiny != 0x1p0f)
     errno = ERANGE;
 #endif
+#ifdef CORE_MATH_SMALL
+  double z = v.f;
+  if (__builtin_expect (!(z > -0x1p+3 && z < 0x1.4p+2), 0)) {
+    // x <= -8 or x >= 5 or x = NaN
+    if (z != z) return x + x; // NaN
+    /* the result is rounded at run time, and overflow or underflow
+       raised, except for x = +Inf (result +Inf) and x = -Inf (result +0) */
+    return (z > 0) ? z * 0x1p17 : -0x1p-40 / z;
+  }
+  /* 10^x is exact for x = 1, 2, 3, 4 (and 0, which is exact below) */
+  static const double p10[] = {1e1, 1e2, 1e3, 1e4};
+  if (z >= 1 && z == (int) z)
+    return p10[(int) z - 1];
+  return exp2_small (z * 0x1.a934f0979a371p+1);
+#else
   /* We decompose x into x1 + x2, and use exp10(x) = exp10(x1) * exp10(x2),
      where binary32 approximations of exp10(x1) and exp10(x2) are tabulated. */
   uint16_t u = v.u;
   uint16_t i1 = u >> 5;
   uint16_t i2 = ((u >> 10) << 5) | (u & 0x1f);
   return T1[i1].f * T2[i2].f;
+#endif
 }
 
 // dummy function since GNU libc does not provide it
@@ -40,6 +40,14 @@ SOFTWARE.
 typedef union {_Float16 f; uint16_t u;} b16u16_u;
 typedef union {float f;    uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 /* For 0 <= i1 < 2^11, T1[i1] stores the binary32 approximation of y1=10^x1
    to nearest, where the float16 encoding of x1 is i1*2^5.
    Values y1 that overflow/underflow in binary32 are capped to the
@@ -1043,12 +1051,12 @@ _Float16 cr_exp10m1f16(_Float16 x){
   {
     // exceptional cases
     switch (u) {
-    case 0x8757: return -0x1.0e5ffep-12f; // x = -0x1.d5cp-14
-    case 0x9788: return -0x1.14dffep-8f;  // x = -0x1.e2p-10
-    case 0xa1fe: return -0x1.b39feap-6f;  // x = -0x1.7f8p-7
-    case 0x2147: return 0x1.89800ap-6f;   // x = 0x1.51cp-7
-    case 0x2394: return 0x1.1c001ap-5f;   // x = 0x1.e5p-7
-    case 0x23fc: return 0x1.2b801p-5f;    // x = 0x1.ffp-7
+    case 0x8757: return round_f16 (-0x1.0e5ffep-12f); // x = -0x1.d5cp-14
+    case 0x9788: return round_f16 (-0x1.14dffep-8f);  // x = -0x1.e2p-10
+    case 0xa1fe: return round_f16 (-0x1.b39feap-6f);  // x = -0x1.7f8p-7
+    case 0x2147: return round_f16 (0x1.89800ap-6f);   // x = 0x1.51cp-7
+    case 0x2394: return round_f16 (0x1.1c001ap-5f);   // x = 0x1.e5p-7
+    case 0x23fc: return round_f16 (0x1.2b801p-5f);    // x = 0x1.ffp-7
     }
     /* the Taylor approximation of 10^x-1 around 0 is
        log(10)*x + 1/2*log(10)^2*x^2 + 1/6*log(10)^3*x^3 */
@@ -1064,15 +1072,15 @@ _Float16 cr_exp10m1f16(_Float16 x){
 
   // exceptional cases (switch is faster than consecutive if's)
   switch (u) {
-  case 0xa4a8: return -0x1.50000ap-5f; // x = -0x1.2ap-6
-  case 0xa4f6: return -0x1.658004p-5f; // x = -0x1.3d8p-6
-  case 0x286c: return 0x1.531ff4p-4f;  // x = 0x1.1bp-5
-  case 0x24e6: return 0x1.70ffd6p-5f;  // x = 0x1.398p-6
-  case 0x2ce8: return 0x1.8b5ffap-3f;  // x = 0x1.3ap-4
-  case 0x2d71: return 0x1.badffcp-3f;  // x = 0x1.5c4p-4
-  case 0x2615: return 0x1.cc9ffap-5f;  // x = 0x1.854p-6
-  case 0x2633: return 0x1.d5bffcp-5f;  // x = 0x1.8ccp-6
-  case 0x2ffa: return 0x1.545ffep-2f;  // x = 0x1.fe8p-4
+  case 0xa4a8: return round_f16 (-0x1.50000ap-5f); // x = -0x1.2ap-6
+  case 0xa4f6: return round_f16 (-0x1.658004p-5f); // x = -0x1.3d8p-6
+  case 0x286c: return round_f16 (0x1.531ff4p-4f);  // x = 0x1.1bp-5
+  case 0x24e6: return round_f16 (0x1.70ffd6p-5f);  // x = 0x1.398p-6
+  case 0x2ce8: return round_f16 (0x1.8b5ffap-3f);  // x = 0x1.3ap-4
+  case 0x2d71: return round_f16 (0x1.badffcp-3f);  // x = 0x1.5c4p-4
+  case 0x2615: return round_f16 (0x1.cc9ffap-5f);  // x = 0x1.854p-6
+  case 0x2633: return round_f16 (0x1.d5bffcp-5f);  // x = 0x1.8ccp-6
+  case 0x2ffa: return round_f16 (0x1.545ffep-2f);  // x = 0x1.fe8p-4
   }
 
   /* We decompose x into x1 + x2, and use 2^x = 2^x1 * 2^x2,
@@ -38,6 +38,14 @@ SOFTWARE.
 typedef union {_Float16 f; uint16_t u;} b16u16_u;
 typedef union {float f;    uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 /* For 0 <= i1 < 2^11, T1[i1] stores the binary32 approximation of y1=2^x1
    to nearest, where the float16 encoding of x1 is i1*2^5.
    Values y1 that overflow/underflow in binary32 are capped to the
@@ -998,15 +1006,15 @@ _Float16 cr_exp2m1f16(_Float16 x){
   {
     // exceptional cases
     if (au <= 0x21bc) {
-      if (u == 0x118c) return 0x1.ec4002p-12f;  // x = 0x1.63p-11
-      if (u == 0x21bc) return 0x1.febffep-8f;   // x = 0x1.6fp-7
-      if (u == 0x8da9) return -0x1.f62002p-13f; // x = -0x1.6a4p-12
-      if (u == 0x973f) return -0x1.414002p-10f; // x = -0x1.cfcp-10
+      if (u == 0x118c) return round_f16 (0x1.ec4002p-12f);  // x = 0x1.63p-11
+      if (u == 0x21bc) return round_f16 (0x1.febffep-8f);   // x = 0x1.6fp-7
+      if (u == 0x8da9) return round_f16 (-0x1.f62002p-13f); // x = -0x1.6a4p-12
+      if (u == 0x973f) return round_f16 (-0x1.414002p-10f); // x = -0x1.cfcp-10
       if (u == 0x8461) {
 #ifdef CORE_MATH_SUPPORT_ERRNO
         errno = ERANGE; // underflow
 #endif
-        return -0x1.847ffep-15f; // x = -0x1.184p-14
+        return round_f16 (-0x1.847ffep-15f); // x = -0x1.184p-14
       }
     }
     /* the Taylor approximation of 2^x-1 around 0 is
@@ -38,6 +38,14 @@ SOFTWARE.
 typedef union {_Float16 f; uint16_t u;} b16u16_u;
 typedef union {float f;    uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 /* For 0 <= i1 < 2^11, T1[i1] stores the binary32 approximation of y1=exp(x1)
    to nearest, where the float16 encoding of x1 is i1*2^5.
    For example for i1=5, we have x1=0x1.4p-17, which yields 0x1.0000ap+0.
@@ -1038,14 +1046,17 @@ _Float16 cr_expm1f16(_Float16 x){
 #ifdef CORE_MATH_SUPPORT_ERRNO
     if (0 < au && au < 0x400) errno = ERANGE; // underflow
     // special case for x=-0x1p-14 and rounding towards zero or upwar
-    if (u == 0x8400 && -1.0f + 0x1p-26f > -1.0f) errno = ERANGE; // underflow
+    if (u == 0x8400) {
+      volatile float one = 1.0f; // prevents constant folding
+      if (-one + 0x1p-26f > -one) errno = ERANGE; // underflow
+    }
 #endif
     if (au <= 0x11a8) {
-      if (u == 0x11a8) return 0x1.6a2002p-11f; // x = 0x1.6ap-11
+      if (u == 0x11a8) return round_f16 (0x1.6a2002p-11f); // x = 0x1.6ap-11
       // the following avoids a missing underflow exception for |x| = 0x1p-24
-      if (au == 0x1) return (u == au) ? 0x1.000002p-24f : -0x1.fffffep-25f;
+      if (au == 0x1) return round_f16 ((u == au) ? 0x1.000002p-24f : -0x1.fffffep-25f);
       // the following avoids a missing underflow exception for |x| = 0x1p-23
-      if (au == 0x2) return (u == au) ? 0x1.000002p-23f : -0x1.fffffep-24f;
+      if (au == 0x2) return round_f16 ((u == au) ? 0x1.000002p-23f : -0x1.fffffep-24f);
     }
     float t = x;
     float c2 = __builtin_fmaf (t, 0x1.555556p-3f, 0.5f);
@@ -138,9 +138,11 @@ _Float16 cr_lgammaf16 (_Float16 xf16){
       if(__builtin_expect(x >= 0x1.ff4p+12f, 0)){ // specific lgammaf16
         /* for x=0x1.ff4p+12, lgamma(x) ~ 0x1.ffd3p+15, thus there is no
            overflow for rounding towards zero, downwards or to nearest */
+        // the volatile variable prevents constant folding
+        volatile _Float16 big = 0x1p15f16;
 #ifndef __clang__
-	_Float16 r = (x > 0x1.ff4p+12f) ? 0x1p15f16 * 0x1p15f16
-          : 0x1.ffcp+15f16 + 1.0f16;
+	_Float16 r = (x > 0x1.ff4p+12f) ? big * 0x1p15f16
+          : big * 0x1.ffcp+0f16 + 1.0f16;
 #else
         /* clang 19 raises a spurious overflow with the above code
            for x=0x1.ff4p+12 and RNDN with -frounding-math: apparently it
@@ -149,12 +151,12 @@ _Float16 cr_lgammaf16 (_Float16 xf16){
            We thus use a workaround. */
         _Float16 r;
         if (x > 0x1.ff4p+12f)
-          r = 0x1p15f16 * 0x1p15f16;
+          r = big * 0x1p15f16;
         else
-          r = 0x1.ffcp+15f16 + 1.0f16;
+          r = big * 0x1.ffcp+0f16 + 1.0f16;
 #endif
 #ifdef CORE_MATH_SUPPORT_ERRNO
-	if (x > 0x1.ff4p+12f || (x == 0x1.ff4p+12f && x + 0x1p-12f > x))
+	if (x > 0x1.ff4p+12f || (x == 0x1.ff4p+12f && r > 0x1.ffcp+15f16))
           errno = ERANGE; // overflow
 #endif
 	return r;
@@ -38,6 +38,14 @@ SOFTWARE.
 typedef union {_Float16 f; uint16_t u;} b16u16_u;
 typedef union {float f; uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 /* For 0 <= i < 224, R[i] stores {r,logr} where r approximates 1/x
    and logr approximates -log10(r), where i is related to the binary32
    encoding of x. Table generated by table1() from log10p1.sage. */
@@ -197,16 +205,20 @@ _Float16 cr_log10p1f16(_Float16 x){
 #ifdef CORE_MATH_SUPPORT_ERRNO
     /* we have underflow for |x| < 0x1.26cp-13 (x non-zero)
        and for x = 0x1.26cp-13 and rndz/rndd */
-    if (au != 0 && (au < 0x39136000u ||
-                    (u == 0x39136000u && 1.0f - 0x1p-25f < 1.0f)))
+    if (au != 0 && au < 0x39136000u)
       errno = ERANGE; // underflow
+    if (u == 0x39136000u) {
+      volatile float one = 1.0f; // prevents constant folding
+      if (one - 0x1p-25f < one)
+        errno = ERANGE; // underflow
+    }
 #endif
 
     // deal with exceptional cases
-    if (u == 0xbba10000u) return -0x1.185ffep-9f;  // x = -0x1.42p-8
-    if (u == 0xb93b8000u) return -0x1.45bffep-14f; // x = -0x1.77p-13
-    if (u == 0x3c278000u) return 0x1.217ffep-8f;   // x = 0x1.4fp-7
-    if (u == 0x39700000u) return 0x1.a0dffep-14f;  // x = 0x1.ep-13
+    if (u == 0xbba10000u) return round_f16 (-0x1.185ffep-9f);  // x = -0x1.42p-8
+    if (u == 0xb93b8000u) return round_f16 (-0x1.45bffep-14f); // x = -0x1.77p-13
+    if (u == 0x3c278000u) return round_f16 (0x1.217ffep-8f);   // x = 0x1.4fp-7
+    if (u == 0x39700000u) return round_f16 (0x1.a0dffep-14f);  // x = 0x1.ep-13
 
     return (au == 0) ? x : res;
   }
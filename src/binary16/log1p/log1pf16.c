@@ -38,6 +38,14 @@ SOFTWARE.
 typedef union {_Float16 f; uint16_t u;} b16u16_u;
 typedef union {float f; uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 /* For 0 <= i < 224, R[i] stores {r,logr} where r approximates 1/x
    and logr approximates -log(r), where i is related to the binary32
    encoding of x. Table generated by table1() from log1p.sage. */
@@ -194,14 +202,18 @@ _Float16 cr_log1pf16(_Float16 x){
 #ifdef CORE_MATH_SUPPORT_ERRNO
     /* we have underflow for |x| < 2^-14 (x non-zero),
        for x = 2^-14 and rndz/rndd */
-    if (au != 0 && (au < 0x38800000 ||
-                    (u == 0x38800000 && 1.0f - 0x1p-25f < 1.0f)))
+    if (au != 0 && au < 0x38800000)
       errno = ERANGE; // underflow
+    if (u == 0x38800000) {
+      volatile float one = 1.0f; // prevents constant folding
+      if (one - 0x1p-25f < one)
+        errno = ERANGE; // underflow
+    }
 #endif
     // deal with exceptional cases
-    if (u == 0xbbbfa000u) return -0x1.805ffep-8f; // x = -0x1.7f4p-8
-    if (u == 0xbcfb6000u) return -0x1.fea004p-6f; // x = -0x1.f6cp-6
-    if (u == 0x3bc06000u) return 0x1.7fa002p-8f;  // x = 0x1.80cp-8
+    if (u == 0xbbbfa000u) return round_f16 (-0x1.805ffep-8f); // x = -0x1.7f4p-8
+    if (u == 0xbcfb6000u) return round_f16 (-0x1.fea004p-6f); // x = -0x1.f6cp-6
+    if (u == 0x3bc06000u) return round_f16 (0x1.7fa002p-8f);  // x = 0x1.80cp-8
     // deal with missing underflow for |x|=2^-24 and |x|=2^-23
     if (au <= 0x34000000) // |x| <= 2^-23
       return (au == 0) ? x : x - 0x1p-45f;
@@ -210,7 +222,7 @@ _Float16 cr_log1pf16(_Float16 x){
   }
 
   // deal with exceptional case
-  if (u == 0x3dec8000) return 0x1.bfa006p-4f; // x = 0x1.d9p-4
+  if (u == 0x3dec8000) return round_f16 (0x1.bfa006p-4f); // x = 0x1.d9p-4
 
   v.f += 1.0f; // exact
   /* for x = -0x1.ffcp-1, which is the smallest x > 1, we have v.f = 0x1p-11;
@@ -38,6 +38,14 @@ SOFTWARE.
 typedef union {_Float16 f; uint16_t u;} b16u16_u;
 typedef union {float f; uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 /* For 0 <= i < 224, R[i] stores {r,logr} where r approximates 1/x
    and logr approximates -log2(r), where i is related to the binary32
    encoding of x. Table generated by table1() from log10p1.sage. */
@@ -201,15 +209,15 @@ _Float16 cr_log2p1f16(_Float16 x){
 #endif
 
     // deal with exceptional cases
-    if (u == 0xb99ec000u) return -0x1.ca2002p-12f; // x = -0x1.3d8p-12
-    if (u == 0xbaa0a000u) return -0x1.cfbffep-10f; // x = -0x1.414p-10
-    if (u == 0xbcb9e000u) return -0x1.0f4002p-5f;  // x = -0x1.73cp-6
-    if (u == 0xb8424000u) return -0x1.184002p-14f; // x = -0x1.848p-15
-    if (u == 0x38966000u) return  0x1.b1dffep-14f; // x = 0x1.2ccp-14
-    if (u == 0x3968c000u) return  0x1.4fc002p-12f; // x = 0x1.d18p-13
-    if (u == 0x3cbfe000u) return  0x1.11a002p-5f;  // x = 0x1.7fcp-6
-    if (u == 0x39f62000u) return  0x1.62fffep-11f; // x = 0x1.ec4p-12
-    if (u == 0x3bff6000u) return  0x1.6f0002p-7f;  // x = 0x1.fecp-8
+    if (u == 0xb99ec000u) return round_f16 (-0x1.ca2002p-12f); // x = -0x1.3d8p-12
+    if (u == 0xbaa0a000u) return round_f16 (-0x1.cfbffep-10f); // x = -0x1.414p-10
+    if (u == 0xbcb9e000u) return round_f16 (-0x1.0f4002p-5f);  // x = -0x1.73cp-6
+    if (u == 0xb8424000u) return round_f16 (-0x1.184002p-14f); // x = -0x1.848p-15
+    if (u == 0x38966000u) return round_f16 (0x1.b1dffep-14f);  // x = 0x1.2ccp-14
+    if (u == 0x3968c000u) return round_f16 (0x1.4fc002p-12f);  // x = 0x1.d18p-13
+    if (u == 0x3cbfe000u) return round_f16 (0x1.11a002p-5f);   // x = 0x1.7fcp-6
+    if (u == 0x39f62000u) return round_f16 (0x1.62fffep-11f);  // x = 0x1.ec4p-12
+    if (u == 0x3bff6000u) return round_f16 (0x1.6f0002p-7f);   // x = 0x1.fecp-8
 
     return (au == 0) ? x : res;
   }
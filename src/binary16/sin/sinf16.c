@@ -38,6 +38,55 @@ SOFTWARE.
 typedef union {_Float16 f; uint16_t u;} b16u16_u;
 typedef union {float f;    uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
+/* With -DCORE_MATH_SMALL, the tables S1, C1, S2 and C2 (32KB) are replaced
+   by an argument reduction and two polynomials, see sincos_small(). */
+#ifdef CORE_MATH_SMALL
+/* Return an approximation of sin(x) for c = 0, of cos(x) for c = 1, where
+   0 < x <= 65504, with relative error less than 2^-44: this is enough to
+   round correctly sin(x) for all binary16 inputs (checked exhaustively). */
+static inline double
+sincos_small (double x, int c)
+{
+  /* Taylor coefficients of (sin(r)/r - 1)/r^2 and (cos(r) - 1)/r^2 in r^2:
+     for |r| <= pi/4, the truncation errors are less than 2^-45 and 2^-49
+     (relative) */
+  static const double s[] =
+    {-0x1.5555555555555p-3, 0x1.1111111111111p-7, -0x1.a01a01a01a01ap-13,
+     0x1.71de3a556c734p-19, -0x1.ae64567f544e4p-26, 0x1.6124613a86d09p-33};
+  static const double cs[] =
+    {-0x1p-1, 0x1.5555555555555p-5, -0x1.6c16c16c16c17p-10,
+     0x1.a01a01a01a01ap-16, -0x1.27e4fb7789f5cp-22, 0x1.1eed8eff8d898p-29,
+     -0x1.93974a8c07c9dp-37};
+  /* Write x = k*pi/2 + r with |r| <= pi/4 (up to rounding errors), where
+     pi/2 = P1 + P2 + P3, P1 and P2 being binary64 numbers, and
+     |P3| < 2^-109. Since k < 2^16, k*P3 < 2^-93 is neglected, and t and r
+     below are computed with one rounding each. Since |r| > 2^-16.1 for
+     x a non-zero binary16 number (and r = x for k = 0), the relative error
+     on r is less than 2^-52. The conversion to k raises inexact, which is
+     fine since sin(x) and cos(x) are not exact for x <> 0. */
+  int64_t k = x * 0x1.45f306dc9c883p-1 + 0.5;
+  double kd = k;
+  double t = __builtin_fma (-kd, 0x1.921fb54442d18p+0, x);
+  double r = __builtin_fma (-kd, 0x1.1a62633145c07p-54, t);
+  double r2 = r * r, r4 = r2 * r2, p;
+  k += c; // cos(x) = sin(x + pi/2)
+  if (k & 1) // sin(x) = (-1)^((k-1)/2) * cos(r)
+    p = 1.0 + r2 * ((cs[0] + r2 * cs[1]) + r4 * ((cs[2] + r2 * cs[3])
+                     + r4 * ((cs[4] + r2 * cs[5]) + r4 * cs[6])));
+  else // sin(x) = (-1)^(k/2) * sin(r)
+    p = r + (r * r2) * ((s[0] + r2 * s[1]) + r4 * ((s[2] + r2 * s[3])
+                         + r4 * (s[4] + r2 * s[5])));
+  return (k & 2) ? -p : p;
+}
+#else
 /* For 0 <= i1 < 2^11, S1[i1] stores the binary32 approximation of y1=sin(x1)
    to nearest, where the float16 encoding of x1 is i1*2^5.
    Table generated by table1sin() from sin.sage, where some values were
@@ -2006,9 +2055,21 @@ static const b32u32_u C2[] = {
  {.u = 0x0}, {.u = 0x0}, {.u = 0x0}, {.u = 0x0}, {.u = 0x0}, {.u = 0x0},
  {.u = 0x0}, {.u = 0x0}, {.u = 0x0}, {.u = 0x0}, {.u = 0x0},
 };
+#endif
 
 _Float16 cr_sinf16(_Float16 x){
   b16u16_u v = {.f = x};
+#ifdef CORE_MATH_SMALL
+  double z = v.f, az = __builtin_fabs (z);
+  if (__builtin_expect (!(az <= 0x1.ffcp+15), 0)) // x = Inf or NaN
+    return x - x; // NaN, with invalid raised for Inf or sNaN
+  if (az == 0) return x; // sin(+/-0) = +/-0
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  uint16_t m = v.u & 0x7fff;
+#endif
+  double res = sincos_small (az, 0);
+  res = (z < 0) ? -res : res;
+#else
   /* We decompose x into x1 + x2, and use
      sin(x1+x2) = sin(x1)*cos(x2) + cos(x1)*sin(x2), where binary32
      approximations of sin(x1), cos(x1), sin(x2) and cos(x2) are tabulated. */
@@ -2018,13 +2079,14 @@ _Float16 cr_sinf16(_Float16 x){
      exceptional cases (up to sign). FIXME: can we further optimize the tables
      to avoid these exceptional cases? */
   if (m == 0x658c) // |x|=0x1.63p+10 whose sine is tiny
-    return (x > 0) ? 0x1.f9bd02p-14f : -0x1.f9bd02p-14f;
+    return round_f16 ((x > 0) ? 0x1.f9bd02p-14f : -0x1.f9bd02p-14f);
   if (m == 0x6429) // |x|=0x1.0a4p+10 whose sine is tiny
-    return (x > 0) ? -0x1.7b4dc2p-14f : 0x1.7b4dc2p-14f;
+    return round_f16 ((x > 0) ? -0x1.7b4dc2p-14f : 0x1.7b4dc2p-14f);
   uint16_t i1 = u >> 5;
   uint16_t i2 = ((u >> 10) << 5) | (u & 0x1f);
   // we use a FMA to fix the evaluation order
   float res = __builtin_fmaf (S1[i1].f, C2[i2].f, C1[i1].f * S2[i2].f);
+#endif
 #ifdef CORE_MATH_SUPPORT_ERRNO
   /* we have underflow when x != 0 and |res| < 0x1.fffffep-15,
      and for |x| = 2^-14 and rounding towards zero */
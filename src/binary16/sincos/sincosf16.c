@@ -28,6 +28,18 @@ SOFTWARE.
 #include <errno.h>
 #include <math.h> // only used during performance tests
 
+/* With -DCORE_MATH_TABLE_SECTION, the tables below are put in the section
+   core_math_tables_trig, aligned on cache lines, see
+   src/generic/support/warmup.h. */
+#ifndef CORE_MATH_TABLE
+#ifdef CORE_MATH_TABLE_SECTION
+#define CORE_MATH_TABLE(family) \
+  __attribute__((section ("core_math_tables_" #family), aligned (64)))
+#else
+#define CORE_MATH_TABLE(family)
+#endif
+#endif
+
 // Warning: clang also defines __GNUC__
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic ignored "-Wunknown-pragmas"
@@ -38,11 +50,19 @@ SOFTWARE.
 typedef union {_Float16 f; uint16_t u;} b16u16_u;
 typedef union {float f;    uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 /* For 0 <= i1 < 2^11, S1[i1] stores the binary32 approximation of y1=sin(x1)
    to nearest, where the float16 encoding of x1 is i1*2^5.
    Table generated by table1sin() from sincos.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u S1[] = {
+static const b32u32_u S1[] CORE_MATH_TABLE (trig) = {
  {0x0p+0}, {0x1.fffffcp-20}, {0x1.fffffcp-19}, {0x1.7ffffep-18},
  {0x1.fffffcp-18}, {0x1.3ffffep-17}, {0x1.7ffffep-17}, {0x1.bffffep-17},
  {0x1.fffffcp-17}, {0x1.1ffffep-16}, {0x1.3ffffep-16}, {0x1.5ffffep-16},
@@ -561,7 +581,7 @@ static const b32u32_u S1[] = {
    to nearest, where the float16 encoding of x1 is i1*2^5.
    Table generated by table1cos() from sincos.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u C1[] = {
+static const b32u32_u C1[] CORE_MATH_TABLE (trig) = {
  {0x1.fffffep-1}, {0x1.fffffep-1}, {0x1.fffffep-1}, {0x1.fffffep-1},
  {0x1.fffffep-1}, {0x1.fffffep-1}, {0x1.fffffep-1}, {0x1.fffffep-1},
  {0x1.fffffep-1}, {0x1.fffffep-1}, {0x1.fffffep-1}, {0x1.fffffep-1},
@@ -1083,7 +1103,7 @@ static const b32u32_u C1[] = {
    into x1 + x2, where x1 is defined along S1.
    Table generated by table2sin() from sincos.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u S2[] = {
+static const b32u32_u S2[] CORE_MATH_TABLE (trig) = {
  {0x0p+0}, {0x1.fffffep-25}, {0x1.fffffep-24}, {0x1.7ffffep-23},
  {0x1.fffffep-23}, {0x1.3ffffep-22}, {0x1.7ffffep-22}, {0x1.bffffep-22},
  {0x1.fffffep-22}, {0x1.1ffffep-21}, {0x1.3ffffep-21}, {0x1.5ffffep-21},
@@ -1597,7 +1617,7 @@ static const b32u32_u S2[] = {
    into x1 + x2, where x1 is defined along C1.
    Table generated by table2cos() from sincos.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u C2[] = {
+static const b32u32_u C2[] CORE_MATH_TABLE (trig) = {
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
@@ -2039,28 +2059,28 @@ void cr_sincosf16(_Float16 x, _Float16 *s, _Float16 *c){
   // deal with exceptional cases
   switch (m) {
   case 0x658c: // |x|=0x1.63p+10
-    *s = (x > 0) ? 0x1.f9bd02p-14f : -0x1.f9bd02p-14f;
-    *c = 0x1.fffffep-1f;
+    *s = round_f16 ((x > 0) ? 0x1.f9bd02p-14f : -0x1.f9bd02p-14f);
+    *c = round_f16 (0x1.fffffep-1f);
     break;
   case 0x6429: // |x|=0x1.0a4p+10
-    *s = (x > 0) ? -0x1.7b4dc2p-14f : 0x1.7b4dc2p-14f;
-    *c = -0x1.fffffep-1f;
+    *s = round_f16 ((x > 0) ? -0x1.7b4dc2p-14f : 0x1.7b4dc2p-14f);
+    *c = round_f16 (-0x1.fffffep-1f);
     break;
   case 0x7aa1: // |x|=0x1.a84p+15
-    *s = (x > 0) ? -0x1.fffffep-1f : 0x1.fffffep-1f;
-    *c = 0x1.86da94p-13f;
+    *s = round_f16 ((x > 0) ? -0x1.fffffep-1f : 0x1.fffffep-1f);
+    *c = round_f16 (0x1.86da94p-13f);
     break;
   case 0x5d8c: // |x|=0x1.63p+8
-    *s = (x > 0) ? -0x1.f9bd04p-16f : 0x1.f9bd04p-16f;
-    *c = -0x1.fffffep-1f;
+    *s = round_f16 ((x > 0) ? -0x1.f9bd04p-16f : 0x1.f9bd04p-16f);
+    *c = round_f16 (-0x1.fffffep-1f);
     break;
   case 0x698c: // |x|=0x1.63p+11
-    *s = (x > 0) ? 0x1.f9bd02p-13f : -0x1.f9bd02p-13f;
-    *c = 0x1.fffffep-1f;
+    *s = round_f16 ((x > 0) ? 0x1.f9bd02p-13f : -0x1.f9bd02p-13f);
+    *c = round_f16 (0x1.fffffep-1f);
     break;
   case 0x618c: // |x|=0x1.63p+9
-    *s = (x > 0) ? 0x1.f9bd04p-15f : -0x1.f9bd04p-15f;
-    *c = 0x1.fffffep-1f;
+    *s = round_f16 ((x > 0) ? 0x1.f9bd04p-15f : -0x1.f9bd04p-15f);
+    *c = round_f16 (0x1.fffffep-1f);
     break;
   case 0: // |x|=0
     *s = x;
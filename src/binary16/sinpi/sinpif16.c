@@ -28,6 +28,18 @@ SOFTWARE.
 #include <math.h> // only used during performance tests
 #include <errno.h>
 
+/* With -DCORE_MATH_TABLE_SECTION, the tables below are put in the section
+   core_math_tables_trig, aligned on cache lines, see
+   src/generic/support/warmup.h. */
+#ifndef CORE_MATH_TABLE
+#ifdef CORE_MATH_TABLE_SECTION
+#define CORE_MATH_TABLE(family) \
+  __attribute__((section ("core_math_tables_" #family), aligned (64)))
+#else
+#define CORE_MATH_TABLE(family)
+#endif
+#endif
+
 // Warning: clang also defines __GNUC__
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic ignored "-Wunknown-pragmas"
@@ -38,11 +50,19 @@ SOFTWARE.
 typedef union {_Float16 f; uint16_t u;} b16u16_u;
 typedef union {float f;    uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 /* For 0 <= i1 < 2^11, S1[i1] stores the binary32 approximation of y1=sinpi(x1)
    to nearest, where the float16 encoding of x1 is i1*2^5.
    Table generated by table1sin() from cospi.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u S1[] = {
+static const b32u32_u S1[] CORE_MATH_TABLE (trig) = {
  {0x0p+0}, {0x1.921fb6p-18}, {0x1.921fb6p-17}, {0x1.2d97c8p-16},
  {0x1.921fb6p-16}, {0x1.f6a7a2p-16}, {0x1.2d97c8p-15}, {0x1.5fdbbep-15},
  {0x1.921fb6p-15}, {0x1.c463acp-15}, {0x1.f6a7a2p-15}, {0x1.1475ccp-14},
@@ -473,7 +493,7 @@ static const b32u32_u S1[] = {
    to nearest, where the float16 encoding of x1 is i1*2^5.
    Table generated by table1cos() from cospi.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u C1[] = {
+static const b32u32_u C1[] CORE_MATH_TABLE (trig) = {
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
@@ -898,7 +918,7 @@ static const b32u32_u C1[] = {
    into x1 + x2, where x1 is defined along S1.
    Table generated by table2sin() from cospi.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u S2[] = {
+static const b32u32_u S2[] CORE_MATH_TABLE (trig) = {
  {0x0p+0}, {0x1.921fb6p-23}, {0x1.921fb6p-22}, {0x1.2d97c8p-21},
  {0x1.921fb6p-21}, {0x1.f6a7a2p-21}, {0x1.2d97c8p-20}, {0x1.5fdbbep-20},
  {0x1.921fb6p-20}, {0x1.c463acp-20}, {0x1.f6a7a2p-20}, {0x1.1475ccp-19},
@@ -1359,7 +1379,7 @@ static const b32u32_u S2[] = {
    into x1 + x2, where x1 is defined along C1.
    Table generated by table2cos() from cospi.sage, where some values were
    manually edited to decrease the number of exceptional values. */
-static const b32u32_u C2[] = {
+static const b32u32_u C2[] CORE_MATH_TABLE (trig) = {
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
  {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0}, {0x1p+0},
@@ -1774,7 +1794,7 @@ _Float16 cr_sinpif16(_Float16 x){
 
   // deal with exceptional cases
   if (au == 0) return x;
-  if (au == 0x3bf7) return (au == u) ? 0x1.c45ffep-7f : -0x1.c45ffep-7f;
+  if (au == 0x3bf7) return round_f16 ((au == u) ? 0x1.c45ffep-7f : -0x1.c45ffep-7f);
 
   uint16_t i1 = u >> 5;
   uint16_t i2 = ((u >> 10) << 5) | (u & 0x1f);
@@ -38,6 +38,14 @@ SOFTWARE.
 typedef union {_Float16 f; uint16_t u;} b16u16_u;
 typedef union {float f;    uint32_t u;} b32u32_u;
 
+// see round_f16() in ../acos/acosf16.c
+static inline _Float16
+round_f16 (float y)
+{
+  volatile float t = y;
+  return t;
+}
+
 /* For 0 <= i1 < 2^11, S1[i1] stores the binary32 approximation of y1=sin(x1)
    to nearest, where the float16 encoding of x1 is i1*2^5.
    Table generated by table1sin() from tan.sage, where some values were
@@ -2031,15 +2039,15 @@ _Float16 cr_tanf16(_Float16 x){
 
   // deal with exceptional cases
   if (au == 0x55ed) // |x| = 0x1.7b4p+6
-    return (au == u) ? 0x1.445ffep-1f : -0x1.445ffep-1f;
+    return round_f16 ((au == u) ? 0x1.445ffep-1f : -0x1.445ffep-1f);
   if (au == 0x658c) // |x| = 0x1.63p+10
-    return (au == u) ? 0x1.f9bd04p-14f : -0x1.f9bd04p-14f;
+    return round_f16 ((au == u) ? 0x1.f9bd04p-14f : -0x1.f9bd04p-14f);
   if (au == 0x6429) // |x| = 0x1.0a4p+10
-    return (au == u) ? 0x1.7b4dc2p-14f : -0x1.7b4dc2p-14f;
-  if (u == 0x681e) return -0x1.1c1fbep-7f; // x = 0x1.078p+11
-  if (u == 0xe74e) return -0x1.df4002p-1f; // x = -0x1.d38p+10
-  if (u == 0xe807) return -0x1.053ffep+1f; // x = -0x1.01cp+11
-  if (u == 0x6f4d) return -0x1.867ffep+0f; // x = 0x1.d34p+12
+    return round_f16 ((au == u) ? 0x1.7b4dc2p-14f : -0x1.7b4dc2p-14f);
+  if (u == 0x681e) return round_f16 (-0x1.1c1fbep-7f); // x = 0x1.078p+11
+  if (u == 0xe74e) return round_f16 (-0x1.df4002p-1f); // x = -0x1.d38p+10
+  if (u == 0xe807) return round_f16 (-0x1.053ffep+1f); // x = -0x1.01cp+11
+  if (u == 0x6f4d) return round_f16 (-0x1.867ffep+0f); // x = 0x1.d34p+12
 
   // we use a FMA to fix the evaluation order
   float s = __builtin_fmaf (S1[i1].f, C2[i2].f, C1[i1].f * S2[i2].f);
@@ -0,0 +1,307 @@
+/* Generate special cases for cart2polf testing.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fenv.h>
+#include <mpfr.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+#include <math.h>
+
+#include "../../generic/support/philox.h"
+
+extern void cr_cart2polf (float, float, float *, float *);
+extern void cr_cart2polf_n (const float *, const float *, float *, float *, size_t);
+extern int ref_fesetround (int);
+extern void ref_init (void);
+extern void ref_cart2polf (float, float, float *, float *);
+
+int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
+
+int rnd;
+int verbose = 0;
+
+static uint64_t Seed;
+
+typedef union {float f; uint32_t u;} b32u32_u;
+
+static float
+get_random (philox_t *s)
+{
+  b32u32_u v;
+  v.u = philox_u64 (s);
+  return v.f;
+}
+
+static inline uint32_t
+asuint (float f)
+{
+  b32u32_u u = {.f = f};
+  return u.u;
+}
+
+/* define our own is_nan function to avoid depending from math.h */
+static inline int
+is_nan (float x)
+{
+  uint32_t u = asuint (x);
+  int e = u >> 23;
+  return (e == 0xff || e == 0x1ff) && (u << 9) != 0;
+}
+
+static inline int
+is_equal (float x, float y)
+{
+  if (is_nan (x))
+    return is_nan (y);
+  if (is_nan (y))
+    return is_nan (x);
+  return asuint (x) == asuint (y);
+}
+
+// compare (r,theta) given by cr_cart2polf for (x,y) with the reference (r1,t1)
+static void
+check_result (float x, float y, float r, float theta, float r1, float t1)
+{
+  if (!is_equal (r, r1) || !is_equal (theta, t1))
+  {
+    printf ("cr_cart2polf and ref_cart2polf differ for x=%a y=%a\n", x, y);
+    printf ("cr_cart2polf  gives r=%a theta=%a\n", r, theta);
+    printf ("ref_cart2polf gives r=%a theta=%a\n", r1, t1);
+    exit (1);
+  }
+}
+
+static void
+check_aux (float x, float y)
+{
+  float r, theta, r1, t1;
+  ref_cart2polf (x, y, &r1, &t1);
+  cr_cart2polf (x, y, &r, &theta);
+  check_result (x, y, r, theta, r1, t1);
+}
+
+void
+check (float x, float y)
+{
+  check_aux (x, y);
+  check_aux (x, -y);
+  check_aux (-x, y);
+  check_aux (-x, -y);
+  check_aux (y, x);
+  check_aux (y, -x);
+  check_aux (-y, x);
+  check_aux (-y, -x);
+}
+
+#ifndef CORE_MATH_TESTS
+#define CORE_MATH_TESTS 100000000ul // total number of tests
+#endif
+
+#define BATCH 1000
+
+/* check random values with the batch version: if close is non-zero, the
+   exponents of x and y differ by less than 32 */
+static void
+check_random (int close)
+{
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t n = 0; n < CORE_MATH_TESTS / BATCH; n++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround(rnd1[rnd]);
+    float x[BATCH], y[BATCH], r[BATCH], theta[BATCH];
+    philox_t s;
+    // the batches with close exponents use other counters
+    philox_init (&s, Seed, 2 * n + close);
+    for (int j = 0; j < BATCH; j++)
+    {
+      x[j] = get_random (&s);
+      y[j] = get_random (&s);
+      if (close && !is_nan (x[j]) && !is_nan (y[j]))
+      {
+        int e;
+        y[j] = frexpf (y[j], &e);
+        frexpf (x[j], &e);
+        y[j] = ldexpf (y[j], e - (int) (philox_u64 (&s) % 32));
+      }
+    }
+    cr_cart2polf_n (x, y, r, theta, BATCH);
+    for (int j = 0; j < BATCH; j++)
+    {
+      float r1, t1;
+      ref_cart2polf (x[j], y[j], &r1, &t1);
+      check_result (x[j], y[j], r[j], theta[j], r1, t1);
+    }
+  }
+}
+
+/* check values near (x,y), with k numbers on each side for each variable,
+   for x = 2^ex, y = 2^ey and -k0 <= ex, ey <= k0 */
+static void
+check_near_power_two (int k, int k0)
+{
+  float min, max;
+  min = max = 1.0f;
+  for (int i = 0; i < k; i++)
+  {
+    min = nextafterf (min, 0.5f);
+    max = nextafterf (max, 2.0f);
+  }
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int ex = -k0; ex <= k0; ex++)
+  {
+    // since emin,emax are thread-local, we need to initialize them here
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround(rnd1[rnd]);
+    // since "check" also checks y,x, we only test for ey <= ex
+    for (int ey = -k0; ey <= ex; ey++)
+    {
+      float x, y;
+      for (x = min; x <= max; x = nextafterf (x, 2.0f))
+        for (y = min; y <= max; y = nextafterf (y, 2.0f))
+          check (ldexpf (x, ex), ldexpf (y, ey));
+    }
+  }
+}
+
+/* check values in the subnormal and overflow ranges */
+static void
+check_extreme (void)
+{
+  static const float x0[] = {0x1p-149f, 0x1.fffffep+127f,
+                             0x1.fffffep+127f, 0x1p-126f};
+  static const float y0[] = {0x1p-149f, 0x1p-149f,
+                             0x1.fffffep+127f, 0x1p-139f};
+#define N 300
+  for (int k = 0; k < 4; k++)
+  {
+    float y = y0[k];
+    for (int i = 0; i < N; i++)
+    {
+      float x = x0[k];
+      for (int j = 0; j < N; j++)
+      {
+        check (x, y);
+        x = (x0[k] < 1) ? nextafterf (x, 2 * x) : nextafterf (x, 0.5f * x);
+      }
+      y = (y0[k] < 1) ? nextafterf (y, 2 * y) : nextafterf (y, 0.5f * y);
+    }
+  }
+#undef N
+}
+
+/* check all Pythagorean triples (x,y,z) with x, y > 0 and p < q < 2^12,
+   where x = q^2-p^2 and y = 2pq: hypot(x,y) = z is exact */
+static void
+check_triples (void)
+{
+  for (int q = 2; q < 4096; q++)
+    for (int p = 1; p < q; p++)
+      check ((float) (q * q - p * p), (float) (2 * p * q));
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--rndn") == 0)
+        {
+          rnd = 0;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndz") == 0)
+        {
+          rnd = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndu") == 0)
+        {
+          rnd = 2;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndd") == 0)
+        {
+          rnd = 3;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--verbose") == 0)
+        {
+          verbose = 1;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  ref_init ();
+  ref_fesetround (rnd);
+  fesetround(rnd1[rnd]);
+
+  Seed = philox_seed ();
+
+  printf ("Checking special values\n");
+  static const float s[] = {0.0f, 0x1p-149f, 0x1p-126f, 1.0f, 0x1.fffffep+127f,
+                            INFINITY, NAN};
+  for (unsigned i = 0; i < sizeof (s) / sizeof (s[0]); i++)
+    for (unsigned j = 0; j < sizeof (s) / sizeof (s[0]); j++)
+      check (s[i], s[j]);
+
+  printf ("Checking Pythagorean triples\n");
+  check_triples ();
+
+  printf ("Checking values near 2^e\n");
+  check_near_power_two (2, 60);
+
+  printf ("Checking in subnormal and overflow ranges\n");
+  check_extreme ();
+
+  printf ("Checking random values with close exponents\n");
+  check_random (1);
+
+  printf ("Checking random values\n");
+  check_random (0);
+  return 0;
+}
@@ -0,0 +1,251 @@
+/* Check correctness of cart2polf on worst cases.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* The input contains pairs "a,b", one per line: cart2polf.wc, and the worst
+   cases of hypotf and atan2f (see WORST_CASES in the Makefile). Since the
+   worst cases of atan2f are given as "y,x", each pair is checked both as
+   (x,y) = (a,b) and (x,y) = (b,a), with cr_cart2polf and cr_cart2polf_n. */
+
+#ifndef __APPLE__
+#define _POSIX_C_SOURCE 200809L  /* for getline */
+#endif /* !__APPLE */
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fenv.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+
+void cr_cart2polf (float, float, float *, float *);
+void cr_cart2polf_n (const float *, const float *, float *, float *, size_t);
+void ref_cart2polf (float, float, float *, float *);
+int ref_fesetround (int);
+void ref_init (void);
+
+int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
+
+int rnd;
+
+typedef struct {
+  float x;
+  float y;
+} testcase;
+
+typedef union { float f; uint32_t i; } f32u32;
+
+/* scanf %a from buf, allowing snan, +snan and -snan */
+static int
+sscanf_snan (char *buf, float *x)
+{
+  if (sscanf(buf, "%a", x) == 1)
+    return 1;
+  else if (strncmp (buf, "snan", 4) == 0 || strncmp (buf, "+snan", 5) == 0)
+  {
+    f32u32 u = {.i = 0x7fa00000};
+    *x = u.f;
+    return 1;
+  }
+  else if (strncmp (buf, "-snan", 5) == 0)
+  {
+    f32u32 u = {.i = 0xffa00000};
+    *x = u.f;
+    return 1;
+  }
+  return 0;
+}
+
+static void
+readstdin(testcase **result, int *count)
+{
+  char *buf = NULL;
+  size_t buflength = 0;
+  ssize_t n;
+  int allocated = 512;
+
+  *count = 0;
+  if (NULL == (*result = malloc(allocated * sizeof(testcase)))) {
+    fprintf(stderr, "malloc failed\n");
+    exit(1);
+  }
+
+  while ((n = getline(&buf, &buflength, stdin)) >= 0) {
+    if (n > 0 && buf[0] == '#') continue;
+    if (*count >= allocated) {
+      int newsize = 2 * allocated;
+      testcase *newresult = realloc(*result, newsize * sizeof(testcase));
+      if (NULL == newresult) {
+        fprintf(stderr, "realloc(%d) failed\n", newsize);
+        exit(1);
+      }
+      allocated = newsize;
+      *result = newresult;
+    }
+    testcase *item = *result + *count;
+    char *tbuf = strchr (buf, ',');
+    if (tbuf != NULL && sscanf_snan (buf, &item->x) == 1
+        && sscanf_snan (tbuf + 1, &item->y) == 1)
+      (*count)++;
+  }
+  free (buf);
+}
+
+static inline uint32_t
+asuint (float f)
+{
+  f32u32 u = {.f = f};
+  return u.i;
+}
+
+/* define our own is_nan function to avoid depending from math.h */
+static inline int
+is_nan (float x)
+{
+  return (asuint (x) << 1) > 0xff000000u;
+}
+
+static inline int
+is_equal (float x, float y)
+{
+  if (is_nan (x))
+    return is_nan (y);
+  if (is_nan (y))
+    return is_nan (x);
+  return asuint (x) == asuint (y);
+}
+
+int tests = 0, failures = 0;
+
+// return 1 if failure, 0 otherwise
+static int
+check (float x, float y, float r, float theta)
+{
+  float r1, t1;
+  ref_cart2polf (x, y, &r1, &t1);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp atomic update
+#endif
+  tests ++;
+  if (!is_equal (r, r1) || !is_equal (theta, t1))
+  {
+    printf ("FAIL x,y=%a,%a ref=%a,%a r,theta=%a,%a\n",
+            x, y, r1, t1, r, theta);
+    fflush (stdout);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp atomic update
+#endif
+    failures ++;
+#ifndef DO_NOT_ABORT
+    exit (1);
+#endif
+    return 1;
+  }
+  return 0;
+}
+
+#define BATCH 1000
+
+void
+doloop (void)
+{
+  testcase *items;
+  int count;
+
+  readstdin (&items, &count);
+
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < count; i += BATCH)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround (rnd1[rnd]);
+    int n = (count - i < BATCH) ? count - i : BATCH;
+    float x[2 * BATCH], y[2 * BATCH], r[2 * BATCH], theta[2 * BATCH];
+    for (int j = 0; j < n; j++)
+    {
+      x[2 * j] = y[2 * j + 1] = items[i + j].x;
+      y[2 * j] = x[2 * j + 1] = items[i + j].y;
+    }
+    cr_cart2polf_n (x, y, r, theta, 2 * n);
+    for (int j = 0; j < 2 * n; j++)
+    {
+      if (check (x[j], y[j], r[j], theta[j]))
+        continue;
+      float r2, t2;
+      cr_cart2polf (x[j], y[j], &r2, &t2);
+      check (x[j], y[j], r2, t2);
+    }
+  }
+
+  free (items);
+  printf ("%d tests passed, %d failure(s)\n", tests, failures);
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--rndn") == 0)
+        {
+          rnd = 0;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndz") == 0)
+        {
+          rnd = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndu") == 0)
+        {
+          rnd = 2;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndd") == 0)
+        {
+          rnd = 3;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  doloop ();
+
+  return failures != 0;
+}
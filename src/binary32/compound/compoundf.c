@@ -1095,7 +1095,8 @@ float cr_compoundf (float x, float y)
 #ifdef CORE_MATH_SUPPORT_ERRNO
       errno = ERANGE; // underflow
 #endif
-      return 0x1p-126f * 0x1p-126f;
+      volatile float z = 0x1p-126f;
+      return z * z;
     } else if (!(t.u >> 63)) { // t >= 128: overflow
 #ifdef CORE_MATH_SUPPORT_ERRNO
       errno = ERANGE; // overflow
@@ -1108,8 +1109,10 @@ float cr_compoundf (float x, float y)
      150*2^-47.909 < 2^-40.680 */
 
   // 2^t rounds to 1 to nearest when |t| <= 0x1.715476af0d4d9p-25
-  if (__builtin_expect ((t.u << 1) <= 0x7cce2a8ed5e1a9b2ull, 0))
-    return (t.u >> 63) ? 1.0f - 0x1p-25f : 1.0f + 0x1p-25f;
+  if (__builtin_expect ((t.u << 1) <= 0x7cce2a8ed5e1a9b2ull, 0)) {
+    volatile float one = 1.0f;
+    return (t.u >> 63) ? one - 0x1p-25f : one + 0x1p-25f;
+  }
 
   int midpoint = 0;
   int exact = is_exact_or_midpoint (x, y, &midpoint);
@@ -183,7 +183,8 @@ float cr_cosf(float x){
     if (__builtin_expect(ax<0x73000000, 1)){
       if (__builtin_expect(ax<0x66000000u, 0)){
 	if(__builtin_expect(ax==0u, 0)) return 1.0f;
-	return 1.0f - 0x1p-25f;
+	volatile float one = 1.0f; // prevents constant folding
+	return one - 0x1p-25f;
       }
       return -0x1p-1f*x*x + 1.0f;
     }
@@ -83,7 +83,8 @@ float cr_erfcf(float x){
       if(t.u == 0xff800000) return 2.0f;        // -Inf
       return x + x;                             // NaN
     }
-    return 2.0f - 0x1p-25f;                     // rounds to 2 or nextbelow(2)
+    volatile float two = 2.0f; // prevents constant folding
+    return two - 0x1p-25f;                      // rounds to 2 or nextbelow(2)
   }
   /* at is the absolute value of x
      for x >= 0x1.41bbf8p+3, erfc(x) < 2^-150, thus rounds to 0 or to 2^-149
@@ -97,11 +98,14 @@ float cr_erfcf(float x){
     errno = ERANGE; // underflow
 #endif
     // 0x1p-149f * 0.25f rounds to 0 or 2^-149 depending on rounding
-    return 0x1p-149f * 0.25f;
+    volatile float tiny = 0x1p-149f;
+    return tiny * 0.25f;
   }
   if(__builtin_expect(at <= 0x3db80000u, 0)){ // |x| <= 0x1.7p-4
-    if(__builtin_expect(t.u == 0xb76c9f62u, 0)) // x = -0x1.d93ec4p-17
-      return 0x1.00010ap+0f + 0x1p-25f; // exceptional case
+    if(__builtin_expect(t.u == 0xb76c9f62u, 0)){ // x = -0x1.d93ec4p-17
+      volatile float y = 0x1.00010ap+0f;
+      return y + 0x1p-25f; // exceptional case
+    }
     /* for |x| <= 0x1.c5bf88p-26. erfc(x) rounds to 1 (to nearest) */
     if(__builtin_expect(at <= 0x32e2dfc4, 0)){ // |x| <= 0x1.c5bf88p-26
       if(__builtin_expect(at == 0, 0)) return 1.0f;
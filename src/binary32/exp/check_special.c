@@ -39,6 +39,10 @@ SOFTWARE.
 #include <mpfr.h>
 
 float cr_expf (float);
+float ref_exp (float);
+void cr_expf_interval (float, float *, float *);
+float cr_expf_r (float, int);
+int ref_fesetround (int);
 void ref_init (void);
 
 int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
@@ -130,6 +134,123 @@ check_near_overflow (void)
   }
 }
 
+typedef union { float f; uint32_t u; } b32u32_u;
+
+static inline int
+is_equal (float x, float y)
+{
+  if (isnan (x) || isnan (y))
+    return isnan (x) && isnan (y);
+  b32u32_u v = {.f = x}, w = {.f = y};
+  return v.u == w.u;
+}
+
+/* The exceptions compared between cr_expf_r(x,rnd1[rnd]) and cr_expf(x) in the
+   rounding mode rnd1[rnd]. Inexact is only checked with
+   CORE_MATH_CHECK_INEXACT. */
+#ifdef CORE_MATH_CHECK_INEXACT
+#define CHECKED_FLAGS (FE_INEXACT | FE_UNDERFLOW | FE_OVERFLOW | FE_INVALID \
+                       | FE_DIVBYZERO)
+#else
+#define CHECKED_FLAGS (FE_UNDERFLOW | FE_OVERFLOW | FE_INVALID | FE_DIVBYZERO)
+#endif
+
+/* Check cr_expf_interval(x) and cr_expf_r(x,rnd1[rnd]), which assume the
+   rounding mode is to nearest (and should not change it): lo and hi should
+   be cr_expf(x) rounded toward -Inf and +Inf, and cr_expf_r(x,rnd1[rnd])
+   should be cr_expf(x) rounded according to rnd1[rnd]. If mpfr is non-zero,
+   the latter should also be the MPFR value, which lies in [lo,hi]. The
+   exceptions (and errno) of cr_expf_r(x,rnd1[rnd]) should be those of
+   cr_expf(x) in the rounding mode rnd1[rnd], and cr_expf_interval(x) should
+   raise invalid and divide-by-zero as cr_expf(x), and inexact exactly when
+   lo <> hi (see README.md). */
+static void
+check_interval (float x, int mpfr)
+{
+  float lo, hi, lo1, hi1, y1, z;
+  int flags0, flags1, flags2, flags3, err1, err3;
+  fesetround (FE_DOWNWARD);
+  lo1 = cr_expf (x);
+  fesetround (FE_UPWARD);
+  hi1 = cr_expf (x);
+  fesetround (FE_TONEAREST);
+  feclearexcept (FE_ALL_EXCEPT);
+  cr_expf (x);
+  flags0 = fetestexcept (FE_INVALID | FE_DIVBYZERO);
+  fesetround (rnd1[rnd]);
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  y1 = cr_expf (x);
+  flags1 = fetestexcept (CHECKED_FLAGS);
+  err1 = errno;
+  fesetround (FE_TONEAREST);
+  feclearexcept (FE_ALL_EXCEPT);
+  cr_expf_interval (x, &lo, &hi);
+  flags2 = fetestexcept (FE_ALL_EXCEPT);
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  z = cr_expf_r (x, rnd1[rnd]);
+  flags3 = fetestexcept (CHECKED_FLAGS);
+  err3 = errno;
+  if (fegetround () != FE_TONEAREST)
+  {
+    printf ("Rounding mode changed by cr_expf_interval or cr_expf_r for x=%a\n",
+            x);
+    exit (1);
+  }
+  if (!is_equal (lo, lo1) || !is_equal (hi, hi1))
+  {
+    printf ("FAIL x=%a cr_expf_interval=[%a,%a] cr_expf=[%a,%a]\n",
+            x, lo, hi, lo1, hi1);
+    exit (1);
+  }
+  if (!is_equal (z, y1))
+  {
+    printf ("FAIL x=%a cr_expf=%a cr_expf_r=%a\n", x, y1, z);
+    exit (1);
+  }
+  if (mpfr)
+  {
+    float r = ref_exp (x);
+    if (!is_equal (z, r) || (!isnan (r) && !(lo <= r && r <= hi)))
+    {
+      printf ("FAIL x=%a ref=%a cr_expf_interval=[%a,%a] cr_expf_r=%a\n",
+              x, r, lo, hi, z);
+      exit (1);
+    }
+  }
+  if (flags3 != flags1)
+  {
+    printf ("FAIL x=%a cr_expf_r raises exceptions %#x instead of %#x\n",
+            x, flags3, flags1);
+    exit (1);
+  }
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  if (err3 != err1)
+  {
+    printf ("FAIL x=%a cr_expf_r sets errno=%d instead of %d\n", x, err3, err1);
+    exit (1);
+  }
+#else
+  (void) err1;
+  (void) err3;
+#endif
+  if ((flags2 & (FE_INVALID | FE_DIVBYZERO)) != flags0)
+  {
+    printf ("FAIL x=%a cr_expf_interval raises exceptions %#x instead of %#x\n",
+            x, flags2 & (FE_INVALID | FE_DIVBYZERO), flags0);
+    exit (1);
+  }
+#ifdef CORE_MATH_CHECK_INEXACT
+  if (((flags2 & FE_INEXACT) != 0) == is_equal (lo, hi))
+  {
+    printf ("%s inexact exception for x=%a cr_expf_interval=[%a,%a]\n",
+            (flags2 & FE_INEXACT) ? "Spurious" : "Missing", x, lo, hi);
+    exit (1);
+  }
+#endif
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -174,5 +295,20 @@ main (int argc, char *argv[])
 
   check_near_overflow ();
 
+  /* check cr_expf_interval and cr_expf_r for all inputs, and against MPFR
+     for one input out of 257 */
+  printf ("Checking cr_expf_interval and cr_expf_r\n");
+  ref_init ();
+  ref_fesetround (rnd);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t n = 0; n < 0x100000000ull; n++)
+  {
+    ref_init ();
+    b32u32_u v = {.u = n};
+    check_interval (v.f, n % 257 == 0);
+  }
+
   return 0;
 }
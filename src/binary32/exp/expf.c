@@ -26,6 +26,7 @@ SOFTWARE.
 
 #include <stdint.h>
 #include <errno.h>
+#include <fenv.h> // for fegetround, fesetround
 
 // Warning: clang also defines __GNUC__
 #if defined(__GNUC__) && !defined(__clang__)
@@ -37,29 +38,30 @@ SOFTWARE.
 typedef union {float f; uint32_t u;} b32u32_u;
 typedef union {double f; uint64_t u;} b64u64_u;
 
+static const double b[] =
+  {1, 0x1.62e42fef4c4e7p-1, 0x1.ebfd1b232f475p-3, 0x1.c6b19384ecd93p-5};
+static const uint64_t tb[] =
+  {0x3ff0000000000000, 0x3ff02c9a3e778061, 0x3ff059b0d3158574, 0x3ff0874518759bc8,
+   0x3ff0b5586cf9890f, 0x3ff0e3ec32d3d1a2, 0x3ff11301d0125b51, 0x3ff1429aaea92de0,
+   0x3ff172b83c7d517b, 0x3ff1a35beb6fcb75, 0x3ff1d4873168b9aa, 0x3ff2063b88628cd6,
+   0x3ff2387a6e756238, 0x3ff26b4565e27cdd, 0x3ff29e9df51fdee1, 0x3ff2d285a6e4030b,
+   0x3ff306fe0a31b715, 0x3ff33c08b26416ff, 0x3ff371a7373aa9cb, 0x3ff3a7db34e59ff7,
+   0x3ff3dea64c123422, 0x3ff4160a21f72e2a, 0x3ff44e086061892d, 0x3ff486a2b5c13cd0,
+   0x3ff4bfdad5362a27, 0x3ff4f9b2769d2ca7, 0x3ff5342b569d4f82, 0x3ff56f4736b527da,
+   0x3ff5ab07dd485429, 0x3ff5e76f15ad2148, 0x3ff6247eb03a5585, 0x3ff6623882552225,
+   0x3ff6a09e667f3bcd, 0x3ff6dfb23c651a2f, 0x3ff71f75e8ec5f74, 0x3ff75feb564267c9,
+   0x3ff7a11473eb0187, 0x3ff7e2f336cf4e62, 0x3ff82589994cce13, 0x3ff868d99b4492ed,
+   0x3ff8ace5422aa0db, 0x3ff8f1ae99157736, 0x3ff93737b0cdc5e5, 0x3ff97d829fde4e50,
+   0x3ff9c49182a3f090, 0x3ffa0c667b5de565, 0x3ffa5503b23e255d, 0x3ffa9e6b5579fdbf,
+   0x3ffae89f995ad3ad, 0x3ffb33a2b84f15fb, 0x3ffb7f76f2fb5e47, 0x3ffbcc1e904bc1d2,
+   0x3ffc199bdd85529c, 0x3ffc67f12e57d14b, 0x3ffcb720dcef9069, 0x3ffd072d4a07897c,
+   0x3ffd5818dcfba487, 0x3ffda9e603db3285, 0x3ffdfc97337b9b5f, 0x3ffe502ee78b3ff6,
+   0x3ffea4afa2a490da, 0x3ffefa1bee615a27, 0x3fff50765b6e4540, 0x3fffa7c1819e90d8};
+
 float cr_expf(float x){
   static const double c[] =
     {0x1.62e42fefa39efp-1, 0x1.ebfbdff82c58fp-3, 0x1.c6b08d702e0edp-5,
      0x1.3b2ab6fb92e5ep-7, 0x1.5d886e6d54203p-10, 0x1.430976b8ce6efp-13};
-  static const double b[] =
-    {1, 0x1.62e42fef4c4e7p-1, 0x1.ebfd1b232f475p-3, 0x1.c6b19384ecd93p-5};
-  static const uint64_t tb[] =
-    {0x3ff0000000000000, 0x3ff02c9a3e778061, 0x3ff059b0d3158574, 0x3ff0874518759bc8,
-     0x3ff0b5586cf9890f, 0x3ff0e3ec32d3d1a2, 0x3ff11301d0125b51, 0x3ff1429aaea92de0,
-     0x3ff172b83c7d517b, 0x3ff1a35beb6fcb75, 0x3ff1d4873168b9aa, 0x3ff2063b88628cd6,
-     0x3ff2387a6e756238, 0x3ff26b4565e27cdd, 0x3ff29e9df51fdee1, 0x3ff2d285a6e4030b,
-     0x3ff306fe0a31b715, 0x3ff33c08b26416ff, 0x3ff371a7373aa9cb, 0x3ff3a7db34e59ff7,
-     0x3ff3dea64c123422, 0x3ff4160a21f72e2a, 0x3ff44e086061892d, 0x3ff486a2b5c13cd0,
-     0x3ff4bfdad5362a27, 0x3ff4f9b2769d2ca7, 0x3ff5342b569d4f82, 0x3ff56f4736b527da,
-     0x3ff5ab07dd485429, 0x3ff5e76f15ad2148, 0x3ff6247eb03a5585, 0x3ff6623882552225,
-     0x3ff6a09e667f3bcd, 0x3ff6dfb23c651a2f, 0x3ff71f75e8ec5f74, 0x3ff75feb564267c9,
-     0x3ff7a11473eb0187, 0x3ff7e2f336cf4e62, 0x3ff82589994cce13, 0x3ff868d99b4492ed,
-     0x3ff8ace5422aa0db, 0x3ff8f1ae99157736, 0x3ff93737b0cdc5e5, 0x3ff97d829fde4e50,
-     0x3ff9c49182a3f090, 0x3ffa0c667b5de565, 0x3ffa5503b23e255d, 0x3ffa9e6b5579fdbf,
-     0x3ffae89f995ad3ad, 0x3ffb33a2b84f15fb, 0x3ffb7f76f2fb5e47, 0x3ffbcc1e904bc1d2,
-     0x3ffc199bdd85529c, 0x3ffc67f12e57d14b, 0x3ffcb720dcef9069, 0x3ffd072d4a07897c,
-     0x3ffd5818dcfba487, 0x3ffda9e603db3285, 0x3ffdfc97337b9b5f, 0x3ffe502ee78b3ff6,
-     0x3ffea4afa2a490da, 0x3ffefa1bee615a27, 0x3fff50765b6e4540, 0x3fffa7c1819e90d8};
   const double iln2 = 0x1.71547652b82fep+0, big = 0x1.8p46;
   b32u32_u t = {.f = x};
   double z = x, a = iln2*z;
@@ -111,3 +113,121 @@ float cr_expf(float x){
 #endif
   return ub;
 }
+
+/* Set *lo and *hi to the roundings downwards and upwards of y, where
+   |y - r| <= e, assuming y is not a binary32 number, and return 1, or return
+   0 if a binary32 number lies in [r - e, r + e]. This works whatever the
+   current rounding mode. */
+static inline int as_interval_f(double r, double e, float *lo, float *hi){
+  double rl = r - e, rh = r + e;
+  b32u32_u c = {.f = rl}; // rounding of rl in the current rounding mode
+  if(!(c.u<<1)) c.u = 0; // -0 -> +0
+  if((double)c.f >= rl) // replace c by its predecessor, which is < rl
+    c.u = c.u ? c.u + ((c.u>>31) ? 1 : -1) : 0x80000001u;
+  // now c < rl, and d is the successor of c
+  b32u32_u d = {.u = c.u + ((c.u>>31) ? -1 : 1)};
+  if((double)d.f <= rh) return 0;
+  *lo = c.f;
+  *hi = d.f;
+  return 1;
+}
+
+static __attribute__((noinline)) void
+as_expf_interval_slow(float x, float *lo, float *hi){
+  volatile float vx = x; // see as_exp_interval_slow() in ../../binary64/exp/exp.c
+  int rm = fegetround();
+  fesetround(FE_DOWNWARD);
+  *lo = cr_expf(vx);
+  fesetround(FE_UPWARD);
+  *hi = cr_expf(vx);
+  fesetround(rm);
+}
+
+/* Put in lo and hi the values of exp(x) rounded toward -Inf and +Inf
+   respectively. The current rounding mode is only changed (and restored)
+   in the rare cases where the fast path does not decide the roundings.
+   Inexact is raised when lo <> hi, overflow and underflow are unspecified
+   (see README.md). */
+void cr_expf_interval(float x, float *lo, float *hi){
+  const double iln2 = 0x1.71547652b82fep+0, big = 0x1.8p46;
+  b32u32_u t = {.f = x};
+  double z = x, a = iln2*z;
+  b64u64_u u = {.f = a + big};
+  uint32_t ux = t.u<<1;
+  if (__builtin_expect(ux>0x8562e42eu || ux<0x6f93813eu, 0)){
+    if(__builtin_expect(ux<0x6f93813eu, 1)){ // |x| < 0x1.93813ep-16
+      /* exp(x) might be very close to a binary32 number (for example for
+         x = 0x1.fffffep-24), thus we write 1 + z = h + l exactly (the error
+         of a rounded addition is representable in all rounding modes), and
+         d approximates exp(x) - h with absolute error less than 2^-83 */
+      double h = 1.0 + z, l = (1.0 - h) + z, z2 = z*z;
+      double d = l + z2*(0.5 + z*(0x1.5555555555555p-3 + z*(0x1.5555555555555p-5
+                                                  + z*0x1.1111111111111p-7)));
+      /* c is a binary32 number at distance at most one ulp from exp(x),
+         h - c is exact, and e approximates exp(x) - c with the sign of
+         exp(x) - c (checked exhaustively in all rounding modes) */
+      float c = h + d;
+      double e = (h - c) + d;
+      b32u32_u v = {.f = c};
+      v.u += (e > 0) ? 1 : -1; // c is in [1/2,2], thus v.f > 0
+      *lo = (e < 0) ? v.f : c;
+      *hi = (e > 0) ? v.f : c;
+      return;
+    }
+    if(ux >= 0xffu<<24) { // x is inf or nan
+      *lo = *hi = cr_expf(x);
+      return;
+    }
+    if(t.u>0xc2ce8ec0u){ // x < -0x1.9d1d8p+6 thus 0 < exp(x) < 2^-148
+      // exp(x) < 2^-149 for x < log(2^-149)
+      int tiny = z < -0x1.9d1d9fccf477p+6;
+      feraiseexcept(FE_INEXACT);
+      *lo = tiny ? 0.0f : 0x1p-149f;
+      *hi = tiny ? 0x1p-149f : 0x1p-148f;
+      return;
+    }
+    if(!(t.u>>31) && t.u>0x42b17217u){ // x > 0x1.62e42ep+6
+      feraiseexcept(FE_INEXACT);
+      *lo = 0x1.fffffep127f;
+      *hi = __builtin_inff();
+      return;
+    }
+  }
+  double ia = big - u.f, h = a + ia;
+  b64u64_u sv = {.u = tb[u.u&0x3f] + ((u.u>>6)<<52)};
+  double h2 = h*h, r = ((b[0] + h*b[1]) + h2*(b[2] + h*(b[3])))*sv.f;
+  /* the relative error of r is less than 1.45e-10 (see cr_expf), we take
+     twice this bound to account for the rounding errors in directed modes */
+  if(__builtin_expect(as_interval_f(r, r*0x1.4p-32, lo, hi), 1))
+    return;
+  as_expf_interval_slow(x, lo, hi);
+}
+
+/* Return cr_expf(x) evaluated in the rounding mode rnd, which raises the
+   same exceptions (and sets errno) as cr_expf() in that mode. */
+static __attribute__((noinline)) float
+as_expf_r_slow(float x, int rnd){
+  volatile float vx = x; // see as_exp_interval_slow() in ../../binary64/exp/exp.c
+  int rm = fegetround();
+  fesetround(rnd);
+  volatile float r = cr_expf(vx);
+  fesetround(rm);
+  return r;
+}
+
+/* Return exp(x) rounded according to rnd, assuming the current rounding
+   mode is to nearest (see cr_exp_r() in ../../binary64/exp/exp.c). For
+   NaN, Inf, x > 0x1.62e42ep+6 and x <= -87, where exp(x) might overflow or
+   underflow, cr_expf() is called in the rounding mode rnd, so that the
+   exceptions are those of cr_expf() in that mode. */
+float cr_expf_r(float x, int rnd){
+  if(rnd != FE_DOWNWARD && rnd != FE_UPWARD && rnd != FE_TOWARDZERO)
+    return cr_expf(x); // FE_TONEAREST
+  b32u32_u t = {.f = x};
+  // |x| > 0x1.62e42ep+6 (including NaN and Inf) or x <= -87
+  if(__builtin_expect((t.u<<1) > 0x8562e42eu || t.u >= 0xc2ae0000u, 0))
+    return as_expf_r_slow(x, rnd);
+  float lo, hi;
+  cr_expf_interval(x, &lo, &hi);
+  return (rnd == FE_UPWARD) ? hi : lo; // exp(x) > 0
+}
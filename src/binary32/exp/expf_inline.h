@@ -0,0 +1,183 @@
+/* Header-only inlinable fast path of the correctly-rounded binary32 exponential.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* This header can be included in any translation unit, and provides:
+
+     static inline float cr_expf_inline (float x);
+     static inline void cr_expf_inline_n (float *r, const float *x, size_t n);
+
+   cr_expf_inline(x) gives exactly the same result as cr_expf(x) (defined in
+   expf.c, which must be linked), with the same exceptions. The fast path of
+   cr_expf() is inlined in the caller, so that the compiler can hoist its
+   constants out of loops. The special inputs, those for which exp(x)
+   underflows or overflows, and those for which the rounding test fails
+   call cr_expf() out of line (the rounding test fails for about 0.2% of
+   random inputs).
+
+   cr_expf_inline_n(r,x,n) sets r[i] = cr_expf(x[i]) for 0 <= i < n, where
+   r may be equal to x. The fast path is evaluated without branches on
+   blocks of inputs by cr_expf_inline_fast(), so that the compiler can
+   vectorize it, then cr_expf() is called for the inputs for which it
+   failed (about 1.5% of random inputs, since its rounding test does not
+   depend on the rounding mode). As for cr_powf_with_exponent_n (see
+   ../pow/powf_exponent.h), gcc does not vectorize it with -frounding-math.
+   When OpenMP is enabled (-fopenmp), or with -fopenmp-simd and
+   -DCORE_MATH_DECLARE_SIMD, cr_expf_inline_fast() is declared with "omp
+   declare simd", so that it can also be called from other "omp simd"
+   loops. The scalar function cr_expf_inline() is not: since it calls
+   cr_expf(), the vector version generated by gcc would process the
+   elements one at a time.
+
+   See src/binary32/support/perf_inline.c for a benchmark. */
+
+#ifndef CORE_MATH_EXPF_INLINE_H
+#define CORE_MATH_EXPF_INLINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef CORE_MATH_OMP_SIMD
+#if defined(_OPENMP) || defined(CORE_MATH_DECLARE_SIMD)
+#define CORE_MATH_OMP_DECLARE_SIMD \
+  _Pragma ("omp declare simd notinbranch linear (bad)")
+#define CORE_MATH_OMP_SIMD _Pragma ("omp simd")
+#else
+#define CORE_MATH_OMP_DECLARE_SIMD
+#define CORE_MATH_OMP_SIMD
+#endif
+#endif
+
+float cr_expf (float);
+
+// for 0 <= i < 64, cr_expf_inline_tb[i] encodes 2^(i/64) (same as tb[] in expf.c)
+static const uint64_t cr_expf_inline_tb[] =
+  {0x3ff0000000000000, 0x3ff02c9a3e778061, 0x3ff059b0d3158574, 0x3ff0874518759bc8,
+   0x3ff0b5586cf9890f, 0x3ff0e3ec32d3d1a2, 0x3ff11301d0125b51, 0x3ff1429aaea92de0,
+   0x3ff172b83c7d517b, 0x3ff1a35beb6fcb75, 0x3ff1d4873168b9aa, 0x3ff2063b88628cd6,
+   0x3ff2387a6e756238, 0x3ff26b4565e27cdd, 0x3ff29e9df51fdee1, 0x3ff2d285a6e4030b,
+   0x3ff306fe0a31b715, 0x3ff33c08b26416ff, 0x3ff371a7373aa9cb, 0x3ff3a7db34e59ff7,
+   0x3ff3dea64c123422, 0x3ff4160a21f72e2a, 0x3ff44e086061892d, 0x3ff486a2b5c13cd0,
+   0x3ff4bfdad5362a27, 0x3ff4f9b2769d2ca7, 0x3ff5342b569d4f82, 0x3ff56f4736b527da,
+   0x3ff5ab07dd485429, 0x3ff5e76f15ad2148, 0x3ff6247eb03a5585, 0x3ff6623882552225,
+   0x3ff6a09e667f3bcd, 0x3ff6dfb23c651a2f, 0x3ff71f75e8ec5f74, 0x3ff75feb564267c9,
+   0x3ff7a11473eb0187, 0x3ff7e2f336cf4e62, 0x3ff82589994cce13, 0x3ff868d99b4492ed,
+   0x3ff8ace5422aa0db, 0x3ff8f1ae99157736, 0x3ff93737b0cdc5e5, 0x3ff97d829fde4e50,
+   0x3ff9c49182a3f090, 0x3ffa0c667b5de565, 0x3ffa5503b23e255d, 0x3ffa9e6b5579fdbf,
+   0x3ffae89f995ad3ad, 0x3ffb33a2b84f15fb, 0x3ffb7f76f2fb5e47, 0x3ffbcc1e904bc1d2,
+   0x3ffc199bdd85529c, 0x3ffc67f12e57d14b, 0x3ffcb720dcef9069, 0x3ffd072d4a07897c,
+   0x3ffd5818dcfba487, 0x3ffda9e603db3285, 0x3ffdfc97337b9b5f, 0x3ffe502ee78b3ff6,
+   0x3ffea4afa2a490da, 0x3ffefa1bee615a27, 0x3fff50765b6e4540, 0x3fffa7c1819e90d8};
+
+// fast path approximation of exp(z) in cr_expf(), for |z| < 0x1.62e42fp+6
+static inline double
+cr_expf_inline_approx (double z)
+{
+  static const double b[] =
+    {1, 0x1.62e42fef4c4e7p-1, 0x1.ebfd1b232f475p-3, 0x1.c6b19384ecd93p-5};
+  const double iln2 = 0x1.71547652b82fep+0, big = 0x1.8p46;
+  double a = iln2 * z;
+  union {double f; uint64_t u;} u = {.f = a + big};
+  double ia = big - u.f, h = a + ia;
+  union {double f; uint64_t u;} sv =
+    {.u = cr_expf_inline_tb[u.u & 0x3f] + ((u.u >> 6) << 52)};
+  double h2 = h * h;
+  return ((b[0] + h * b[1]) + h2 * (b[2] + h * (b[3]))) * sv.f;
+}
+
+/* Return the fast path approximation r of exp(x) (see cr_expf), and set
+   *bad to 1 when x is out of the range of the fast path or when r might not
+   round to cr_expf(x), otherwise to 0. When *bad is 0, r rounded to binary32
+   (in the current rounding mode) is cr_expf(x). There is neither branch nor
+   floating-point comparison, so that the caller can be vectorized: x is
+   replaced by 0 when it is out of range (x <= -0x1.5d58ap+6 where exp(x)
+   underflows, x > 0x1.62e42ep+6 where it overflows, or NaN), which avoids
+   spurious exceptions. */
+CORE_MATH_OMP_DECLARE_SIMD
+static inline double
+cr_expf_inline_fast (float x, int64_t *bad)
+{
+  union {float f; uint32_t u;} t = {.f = x};
+  // -0x1.5d58ap+6 < x <= 0x1.62e42ep+6
+  int64_t out = (t.u > 0x42b17217u) & (t.u - 0x80000000u >= 0x42aeac50u);
+  t.u &= (uint32_t) out - 1;
+  double z = t.f;
+  union {double f; uint64_t u;} r = {.f = cr_expf_inline_approx (z)};
+  /* The relative error of r is less than 1.45e-10 < 2^20.3 ulps, and
+     exp(x) is in the binary32 normal range: the rounding of r is that of
+     exp(x) when no binary32 number nor midpoint lies within 2^21 ulps of r,
+     whatever the rounding mode. */
+  uint64_t off = 1 << 21;
+  int64_t hard = ((r.u + off) & 0xfffffff) <= 2 * off;
+  // for |x| < 0x1.93813ep-16, cr_expf() returns 1 + z*(1 + z*0.5)
+  uint64_t tiny = -(uint64_t) ((t.u << 1) < 0x6f93813eu);
+  union {double f; uint64_t u;} s = {.f = 1.0 + z * (1 + z * 0.5)};
+  *bad = out | (hard & ~tiny);
+  r.u = (s.u & tiny) | (r.u & ~tiny);
+  return r.f;
+}
+
+/* Scalar version, with branches: this needs fewer instructions than
+   cr_expf_inline_fast(), whose rounding test is more pessimistic. */
+static inline float
+cr_expf_inline (float x)
+{
+  union {float f; uint32_t u;} t = {.f = x};
+  /* x <= -0x1.5d58ap+6, x > 0x1.62e42ep+6, NaN, or |x| < 0x1.93813ep-16
+     (with & and | instead of && and ||, gcc emits a single branch, instead
+     of one depending on the sign of x, which is mispredicted) */
+  if (__builtin_expect (((t.u > 0x42b17217u)
+                         & (t.u - 0x80000000u >= 0x42aeac50u))
+                        | ((t.u << 1) < 0x6f93813eu), 0))
+    return cr_expf (x);
+  double r = cr_expf_inline_approx (x);
+  float ub = r, lb = r - r * 1.45e-10;
+  if (__builtin_expect (ub != lb, 0))
+    return cr_expf (x);
+  return ub;
+}
+
+#ifndef CORE_MATH_INLINE_BLOCK
+#define CORE_MATH_INLINE_BLOCK 64
+#endif
+
+static inline void
+cr_expf_inline_n (float *r, const float *x, size_t n)
+{
+  for (size_t i0 = 0; i0 < n; i0 += CORE_MATH_INLINE_BLOCK) {
+    size_t m = (n - i0 < CORE_MATH_INLINE_BLOCK) ? n - i0
+      : CORE_MATH_INLINE_BLOCK;
+    double res[CORE_MATH_INLINE_BLOCK];
+    int64_t slow[CORE_MATH_INLINE_BLOCK];
+    CORE_MATH_OMP_SIMD
+    for (size_t i = 0; i < m; i++)
+      res[i] = cr_expf_inline_fast (x[i0 + i], slow + i);
+    // r may be equal to x, thus x[i0 + i] is read before r[i0 + i] is set
+    for (size_t i = 0; i < m; i++)
+      r[i0 + i] = slow[i] ? cr_expf (x[i0 + i]) : (float) res[i];
+  }
+}
+
+#endif /* CORE_MATH_EXPF_INLINE_H */
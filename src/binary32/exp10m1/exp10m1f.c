@@ -46,7 +46,8 @@ float cr_exp10m1f(float x){
      0x1.306fe0a31b715p+0, 0x1.3dea64c123422p+0, 0x1.4bfdad5362a27p+0, 0x1.5ab07dd485429p+0,
      0x1.6a09e667f3bcdp+0, 0x1.7a11473eb0187p+0, 0x1.8ace5422aa0dap+0, 0x1.9c49182a3f09p+0,
      0x1.ae89f995ad3adp+0, 0x1.c199bdd85529cp+0, 0x1.d5818dcfba487p+0, 0x1.ea4afa2a490dap+0};
-  static const float q[][2] = {{0x1.fffffep127f, 0x1.fffffep127f}, {-1.0f, 0x1p-26f}};
+  // q is volatile so that q[i][0] + q[i][1] is rounded at run time
+  static const volatile float q[][2] = {{0x1.fffffep127f, 0x1.fffffep127f}, {-1.0f, 0x1p-26f}};
   const double iln10h = 0x1.a934f09p+1*16, iln10l = 0x1.e68dc57f2496p-29*16;
   b32u32_u t = {.f = x};
   double z = x;
@@ -81,11 +82,13 @@ float cr_exp10m1f(float x){
 #endif
 		    r = 0x1.26bb1bbb55516p+1;
 		  } else {
-		    if (__builtin_expect(ux == 0x2c994b7bu, 0)) return 0x1.60f974p-37f - 0x1p-90f;
+		    volatile float one = 1.0f; // prevents constant folding
+		    if (__builtin_expect(ux == 0x2c994b7bu, 0)) return 0x1.60f974p-37f - one*0x1p-90f;
 		    r = 0x1.26bb1bbb55516p+1 + z * 0x1.53524c73cea69p+1;
 		  }
 		} else {
-		  if (__builtin_expect(ux == 0xb6fa215bu, 0)) return -0x1.1ff87ep-16f + 0x1p-68f;
+		  volatile float one = 1.0f; // prevents constant folding
+		  if (__builtin_expect(ux == 0xb6fa215bu, 0)) return -0x1.1ff87ep-16f + one*0x1p-68f;
 		  r = 0x1.26bb1bbb55516p+1 + z * (0x1.53524c73ea62fp+1 + z * 0x1.0470591de2c75p+1);
 		}
 	      } else {
@@ -117,9 +117,10 @@ float cr_exp2f(float x){
   float ub = r, lb = r - r*eps;
   if(__builtin_expect(ub != lb, 1)){
     if(__builtin_expect(ux<=0x79e7526eu, 0)){
-      if(t.u == 0x3b429d37u) return 0x1.00870ap+0f - 0x1p-25f;
-      if(t.u == 0xbcf3a937u) return 0x1.f58d62p-1f - 0x1p-26f;
-      if(t.u == 0xb8d3d026u) return 0x1.fff6d2p-1f + 0x1p-26f;
+      volatile float tiny = 0x1p-26f; // prevents constant folding
+      if(t.u == 0x3b429d37u) return 0x1.00870ap+0f - 2*tiny;
+      if(t.u == 0xbcf3a937u) return 0x1.f58d62p-1f - tiny;
+      if(t.u == 0xb8d3d026u) return 0x1.fff6d2p-1f + tiny;
     }
     static const double c[] =
       {0x1.62e42fefa39efp-1, 0x1.ebfbdff82c58fp-3, 0x1.c6b08d702e0edp-5, 0x1.3b2ab6fb92e5ep-7,
@@ -38,9 +38,10 @@ typedef union {float f; uint32_t u;} b32u32_u;
 typedef union {double f; uint64_t u;} b64u64_u;
 
 float cr_exp2m1f(float x){
-  static const float q[][2] = {{0x1.fffffep127f, 0x1.fffffep127f},
-                               {0x1.fffffep127f, 0x1p+103f},
-                               {-1.0f, 0x1p-26f}};
+  // q is volatile so that q[i][0] + q[i][1] is rounded at run time
+  static const volatile float q[][2] = {{0x1.fffffep127f, 0x1.fffffep127f},
+                                        {0x1.fffffep127f, 0x1p+103f},
+                                        {-1.0f, 0x1p-26f}};
   b32u32_u t = {.f = x};
   double z = x;
   uint32_t ux = t.u, ax = ux&(~0u>>1);
@@ -81,14 +82,16 @@ float cr_exp2m1f(float x){
 		  r = 0x1.62e42fefa39fp-1 + z * 0x1.ebfbdff82c58fp-3;
 		}
 	      } else {
-		if (__builtin_expect(ux == 0xb3d85005u, 0)) return -0x1.2bdf76p-24 - 0x1.8p-77;
-		if (__builtin_expect(ux == 0x3338428du, 0)) return 0x1.fee08ap-26 + 0x1p-80;
+		volatile double one = 1.0; // prevents constant folding
+		if (__builtin_expect(ux == 0xb3d85005u, 0)) return -0x1.2bdf76p-24 - one*0x1.8p-77;
+		if (__builtin_expect(ux == 0x3338428du, 0)) return 0x1.fee08ap-26 + one*0x1p-80;
 		static const double c[] =
 		  {0x1.62e42fefa39efp-1, 0x1.ebfbdff8548fdp-3, 0x1.c6b08d704a06dp-5};
 		r = c[0] + z * (c[1] + z * c[2]);
 	      }
 	    } else {
-	      if (__builtin_expect(ux == 0x388bca4fu, 0)) return 0x1.839702p-15 - 0x1.8p-68;
+	      volatile double one = 1.0; // prevents constant folding
+	      if (__builtin_expect(ux == 0x388bca4fu, 0)) return 0x1.839702p-15 - one*0x1.8p-68;
 	      static const double c[] =
 		{0x1.62e42fefa39efp-1, 0x1.ebfbdff82c58fp-3, 0x1.c6b08dc82b347p-5, 0x1.3b2ab6fbad172p-7};
 	      r = (c[0] + z * c[1]) + z2 * (c[2] + z * c[3]);
@@ -113,7 +113,8 @@ float cr_expm1f(float x){
     if(ax>(0xffu<<24)) return x + x; // nan
     if(__builtin_expect(ux>>31, 0)){ // x < 0
       if(ax==(0xffu<<24)) return -1.0f;
-      return -1.0f + 0x1p-26f;
+      volatile float one = 1.0f; // prevents constant folding
+      return -one + 0x1p-26f;
     }
     if(ax==(0xffu<<24)) return 1.0f/0.0f;
 #ifdef CORE_MATH_SUPPORT_ERRNO
@@ -130,8 +131,10 @@ float cr_expm1f(float x){
   double r = (c0 + h2*c2)*sv.f - 1.0;
   float ub = r, lb = r - sv.f*0x1.3b3p-33;
   if(__builtin_expect(ub != lb, 0)){
-    if(__builtin_expect(ux>0xc18aa123u, 0)) // x < -17.32
-      return -1.0f + 0x1p-26f;
+    if(__builtin_expect(ux>0xc18aa123u, 0)){ // x < -17.32
+      volatile float one = 1.0f; // prevents constant folding
+      return -one + 0x1p-26f;
+    }
     const double iln2h = 0x1.7154765p+5, iln2l = 0x1.5c17f0bbbe88p-26;
     double s = sv.f;
     h = (iln2h*z - ia) + iln2l*z;
@@ -0,0 +1,220 @@
+/* Check cr_logf_interval and cr_logf_r.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fenv.h>
+#include <math.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+
+float cr_logf (float);
+float ref_log (float);
+void cr_logf_interval (float, float *, float *);
+float cr_logf_r (float, int);
+int ref_fesetround (int);
+void ref_init (void);
+
+int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
+
+int rnd = 0;
+
+int verbose = 0;
+
+typedef union { float f; uint32_t u; } b32u32_u;
+
+static inline int
+is_equal (float x, float y)
+{
+  if (isnan (x) || isnan (y))
+    return isnan (x) && isnan (y);
+  b32u32_u v = {.f = x}, w = {.f = y};
+  return v.u == w.u;
+}
+
+/* The exceptions compared between cr_logf_r(x,rnd1[rnd]) and cr_logf(x) in the
+   rounding mode rnd1[rnd]. Inexact is only checked with
+   CORE_MATH_CHECK_INEXACT. */
+#ifdef CORE_MATH_CHECK_INEXACT
+#define CHECKED_FLAGS (FE_INEXACT | FE_UNDERFLOW | FE_OVERFLOW | FE_INVALID \
+                       | FE_DIVBYZERO)
+#else
+#define CHECKED_FLAGS (FE_UNDERFLOW | FE_OVERFLOW | FE_INVALID | FE_DIVBYZERO)
+#endif
+
+/* Check cr_logf_interval(x) and cr_logf_r(x,rnd1[rnd]) in the rounding mode
+   to nearest they assume, with their exceptions and errno, see
+   check_interval() in ../exp/check_special.c. */
+static void
+check_interval (float x, int mpfr)
+{
+  float lo, hi, lo1, hi1, y1, z;
+  int flags0, flags1, flags2, flags3, err1, err3;
+  fesetround (FE_DOWNWARD);
+  lo1 = cr_logf (x);
+  fesetround (FE_UPWARD);
+  hi1 = cr_logf (x);
+  fesetround (FE_TONEAREST);
+  feclearexcept (FE_ALL_EXCEPT);
+  cr_logf (x);
+  flags0 = fetestexcept (FE_INVALID | FE_DIVBYZERO);
+  fesetround (rnd1[rnd]);
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  y1 = cr_logf (x);
+  flags1 = fetestexcept (CHECKED_FLAGS);
+  err1 = errno;
+  fesetround (FE_TONEAREST);
+  feclearexcept (FE_ALL_EXCEPT);
+  cr_logf_interval (x, &lo, &hi);
+  flags2 = fetestexcept (FE_ALL_EXCEPT);
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  z = cr_logf_r (x, rnd1[rnd]);
+  flags3 = fetestexcept (CHECKED_FLAGS);
+  err3 = errno;
+  if (fegetround () != FE_TONEAREST)
+  {
+    printf ("Rounding mode changed by cr_logf_interval or cr_logf_r for x=%a\n",
+            x);
+    exit (1);
+  }
+  if (!is_equal (lo, lo1) || !is_equal (hi, hi1))
+  {
+    printf ("FAIL x=%a cr_logf_interval=[%a,%a] cr_logf=[%a,%a]\n",
+            x, lo, hi, lo1, hi1);
+    exit (1);
+  }
+  if (!is_equal (z, y1))
+  {
+    printf ("FAIL x=%a cr_logf=%a cr_logf_r=%a\n", x, y1, z);
+    exit (1);
+  }
+  if (mpfr)
+  {
+    float r = ref_log (x);
+    if (!is_equal (z, r) || (!isnan (r) && !(lo <= r && r <= hi)))
+    {
+      printf ("FAIL x=%a ref=%a cr_logf_interval=[%a,%a] cr_logf_r=%a\n",
+              x, r, lo, hi, z);
+      exit (1);
+    }
+  }
+  if (flags3 != flags1)
+  {
+    printf ("FAIL x=%a cr_logf_r raises exceptions %#x instead of %#x\n",
+            x, flags3, flags1);
+    exit (1);
+  }
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  if (err3 != err1)
+  {
+    printf ("FAIL x=%a cr_logf_r sets errno=%d instead of %d\n", x, err3, err1);
+    exit (1);
+  }
+#else
+  (void) err1;
+  (void) err3;
+#endif
+  if ((flags2 & (FE_INVALID | FE_DIVBYZERO)) != flags0)
+  {
+    printf ("FAIL x=%a cr_logf_interval raises exceptions %#x instead of %#x\n",
+            x, flags2 & (FE_INVALID | FE_DIVBYZERO), flags0);
+    exit (1);
+  }
+#ifdef CORE_MATH_CHECK_INEXACT
+  if (((flags2 & FE_INEXACT) != 0) == is_equal (lo, hi))
+  {
+    printf ("%s inexact exception for x=%a cr_logf_interval=[%a,%a]\n",
+            (flags2 & FE_INEXACT) ? "Spurious" : "Missing", x, lo, hi);
+    exit (1);
+  }
+#endif
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--rndn") == 0)
+        {
+          rnd = 0;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndz") == 0)
+        {
+          rnd = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndu") == 0)
+        {
+          rnd = 2;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndd") == 0)
+        {
+          rnd = 3;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--verbose") == 0)
+        {
+          verbose = 1;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  /* check cr_logf_interval and cr_logf_r for all inputs, and against MPFR
+     for one input out of 257 */
+  printf ("Checking cr_logf_interval and cr_logf_r\n");
+  ref_init ();
+  ref_fesetround (rnd);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t n = 0; n < 0x100000000ull; n++)
+  {
+    ref_init ();
+    b32u32_u v = {.u = n};
+    check_interval (v.f, n % 257 == 0);
+  }
+
+  return 0;
+}
@@ -26,6 +26,7 @@ SOFTWARE.
 
 #include <stdint.h>
 #include <errno.h>
+#include <fenv.h> // for fegetround, fesetround
 
 // Warning: clang also defines __GNUC__
 #if defined(__GNUC__) && !defined(__clang__)
@@ -60,43 +61,44 @@ static __attribute__((noinline)) float as_special(float x){
   return 0.0f/0.0f; // to raise FE_INVALID and return nan
 }
 
+static const double tr[] = {
+  0x1p+0, 0x1.f81f82p-1, 0x1.f07c1fp-1, 0x1.e9131acp-1,
+  0x1.e1e1e1ep-1, 0x1.dae6077p-1, 0x1.d41d41dp-1, 0x1.cd85689p-1,
+  0x1.c71c71cp-1, 0x1.c0e0704p-1, 0x1.bacf915p-1, 0x1.b4e81b5p-1,
+  0x1.af286bdp-1, 0x1.a98ef6p-1, 0x1.a41a41ap-1, 0x1.9ec8e95p-1,
+  0x1.999999ap-1, 0x1.948b0fdp-1, 0x1.8f9c19p-1, 0x1.8acb90fp-1,
+  0x1.8618618p-1, 0x1.8181818p-1, 0x1.7d05f41p-1, 0x1.78a4c81p-1,
+  0x1.745d174p-1, 0x1.702e05cp-1, 0x1.6c16c17p-1, 0x1.6816817p-1,
+  0x1.642c859p-1, 0x1.605816p-1, 0x1.5c9882cp-1, 0x1.58ed231p-1,
+  0x1.5555555p-1, 0x1.51d07ebp-1, 0x1.4e5e0a7p-1, 0x1.4afd6ap-1,
+  0x1.47ae148p-1, 0x1.446f865p-1, 0x1.4141414p-1, 0x1.3e22cbdp-1,
+  0x1.3b13b14p-1, 0x1.3813814p-1, 0x1.3521cfbp-1, 0x1.323e34ap-1,
+  0x1.2f684bep-1, 0x1.2c9fb4ep-1, 0x1.29e412ap-1, 0x1.27350b9p-1,
+  0x1.2492492p-1, 0x1.21fb781p-1, 0x1.1f7047ep-1, 0x1.1cf06aep-1,
+  0x1.1a7b961p-1, 0x1.1811812p-1, 0x1.15b1e5fp-1, 0x1.135c811p-1,
+  0x1.1111111p-1, 0x1.0ecf56cp-1, 0x1.0c9715p-1, 0x1.0a6810ap-1,
+  0x1.0842108p-1, 0x1.0624dd3p-1, 0x1.041041p-1, 0x1.0204081p-1, 0.5};
+static const double tl[] = {
+  -0x1.3b40815cd0628p-45, 0x1.fc0a890fbb514p-7, 0x1.f829b1e780b98p-6, 0x1.77458f532c948p-5,
+  0x1.f0a30c2114ef2p-5, 0x1.341d793bbc7f7p-4, 0x1.6f0d28d256172p-4, 0x1.a926d3a6acb89p-4,
+  0x1.e2707722ae90cp-4, 0x1.0d77e7a90896cp-3, 0x1.29552f6fff036p-3, 0x1.44d2b6c5b7831p-3,
+  0x1.5ff306ee78ee7p-3, 0x1.7ab890410d41cp-3, 0x1.9525a9e3451c7p-3, 0x1.af3c94ed0bb06p-3,
+  0x1.c8ff7c59a9535p-3, 0x1.e27076d5aedf9p-3, 0x1.fb9186b5e393ep-3, 0x1.0a324e38b8e6dp-2,
+  0x1.1675cacaba398p-2, 0x1.22941fc0f76efp-2, 0x1.2e8e2bc311abap-2, 0x1.3a64c56b14373p-2,
+  0x1.4618bc31c5c4cp-2, 0x1.51aad874df5b7p-2, 0x1.5d1bdbea80754p-2, 0x1.686c81d331238p-2,
+  0x1.739d7f6dbcd9p-2, 0x1.7eaf83c82ad4dp-2, 0x1.89a3385813fe4p-2, 0x1.947941aa91484p-2,
+  0x1.9f323edbf95d5p-2, 0x1.a9cec9a4205d3p-2, 0x1.b44f77c5c8cecp-2, 0x1.beb4d9ea71905p-2,
+  0x1.c8ff7c69a97abp-2, 0x1.d32fe7f38e95fp-2, 0x1.dd46a0501c22ap-2, 0x1.e7442617e8511p-2,
+  0x1.f128f5eaf0476p-2, 0x1.faf588dd8f0a8p-2, 0x1.02552a5edcfc4p-1, 0x1.0723e5c64de05p-1,
+  0x1.0be72e3852947p-1, 0x1.109f39d554b5cp-1, 0x1.154c3d2c4d4aep-1, 0x1.19ee6b38bc834p-1,
+  0x1.1e85f5ef03f95p-1, 0x1.23130d7fabe07p-1, 0x1.2795e1219afep-1, 0x1.2c0e9ec9c8d5p-1,
+  0x1.307d7337f0f83p-1, 0x1.34e289cb4e098p-1, 0x1.393e0d42e28dep-1, 0x1.3d9026ad555bfp-1,
+  0x1.41d8fe8667173p-1, 0x1.4618bc1ec5d87p-1, 0x1.4a4f85d303d8p-1, 0x1.4e7d8127f5a75p-1,
+  0x1.52a2d26dbc47p-1, 0x1.56bf9d597f25ep-1, 0x1.5ad404cb59df2p-1, 0x1.5ee02a928153ap-1,
+  0x1.62e42fefa38b4p-1};
+static const double b[] = {0x1.00000006342eap+0, -0x1.0001f7fdc3977p-1, 0x1.554a4e5cae9cfp-2};
+
 float cr_logf(float x){
-  static const double tr[] = {
-    0x1p+0, 0x1.f81f82p-1, 0x1.f07c1fp-1, 0x1.e9131acp-1,
-    0x1.e1e1e1ep-1, 0x1.dae6077p-1, 0x1.d41d41dp-1, 0x1.cd85689p-1,
-    0x1.c71c71cp-1, 0x1.c0e0704p-1, 0x1.bacf915p-1, 0x1.b4e81b5p-1,
-    0x1.af286bdp-1, 0x1.a98ef6p-1, 0x1.a41a41ap-1, 0x1.9ec8e95p-1,
-    0x1.999999ap-1, 0x1.948b0fdp-1, 0x1.8f9c19p-1, 0x1.8acb90fp-1,
-    0x1.8618618p-1, 0x1.8181818p-1, 0x1.7d05f41p-1, 0x1.78a4c81p-1,
-    0x1.745d174p-1, 0x1.702e05cp-1, 0x1.6c16c17p-1, 0x1.6816817p-1,
-    0x1.642c859p-1, 0x1.605816p-1, 0x1.5c9882cp-1, 0x1.58ed231p-1,
-    0x1.5555555p-1, 0x1.51d07ebp-1, 0x1.4e5e0a7p-1, 0x1.4afd6ap-1,
-    0x1.47ae148p-1, 0x1.446f865p-1, 0x1.4141414p-1, 0x1.3e22cbdp-1,
-    0x1.3b13b14p-1, 0x1.3813814p-1, 0x1.3521cfbp-1, 0x1.323e34ap-1,
-    0x1.2f684bep-1, 0x1.2c9fb4ep-1, 0x1.29e412ap-1, 0x1.27350b9p-1,
-    0x1.2492492p-1, 0x1.21fb781p-1, 0x1.1f7047ep-1, 0x1.1cf06aep-1,
-    0x1.1a7b961p-1, 0x1.1811812p-1, 0x1.15b1e5fp-1, 0x1.135c811p-1,
-    0x1.1111111p-1, 0x1.0ecf56cp-1, 0x1.0c9715p-1, 0x1.0a6810ap-1,
-    0x1.0842108p-1, 0x1.0624dd3p-1, 0x1.041041p-1, 0x1.0204081p-1, 0.5};
-  static const double tl[] = {
-    -0x1.3b40815cd0628p-45, 0x1.fc0a890fbb514p-7, 0x1.f829b1e780b98p-6, 0x1.77458f532c948p-5,
-    0x1.f0a30c2114ef2p-5, 0x1.341d793bbc7f7p-4, 0x1.6f0d28d256172p-4, 0x1.a926d3a6acb89p-4,
-    0x1.e2707722ae90cp-4, 0x1.0d77e7a90896cp-3, 0x1.29552f6fff036p-3, 0x1.44d2b6c5b7831p-3,
-    0x1.5ff306ee78ee7p-3, 0x1.7ab890410d41cp-3, 0x1.9525a9e3451c7p-3, 0x1.af3c94ed0bb06p-3,
-    0x1.c8ff7c59a9535p-3, 0x1.e27076d5aedf9p-3, 0x1.fb9186b5e393ep-3, 0x1.0a324e38b8e6dp-2,
-    0x1.1675cacaba398p-2, 0x1.22941fc0f76efp-2, 0x1.2e8e2bc311abap-2, 0x1.3a64c56b14373p-2,
-    0x1.4618bc31c5c4cp-2, 0x1.51aad874df5b7p-2, 0x1.5d1bdbea80754p-2, 0x1.686c81d331238p-2,
-    0x1.739d7f6dbcd9p-2, 0x1.7eaf83c82ad4dp-2, 0x1.89a3385813fe4p-2, 0x1.947941aa91484p-2,
-    0x1.9f323edbf95d5p-2, 0x1.a9cec9a4205d3p-2, 0x1.b44f77c5c8cecp-2, 0x1.beb4d9ea71905p-2,
-    0x1.c8ff7c69a97abp-2, 0x1.d32fe7f38e95fp-2, 0x1.dd46a0501c22ap-2, 0x1.e7442617e8511p-2,
-    0x1.f128f5eaf0476p-2, 0x1.faf588dd8f0a8p-2, 0x1.02552a5edcfc4p-1, 0x1.0723e5c64de05p-1,
-    0x1.0be72e3852947p-1, 0x1.109f39d554b5cp-1, 0x1.154c3d2c4d4aep-1, 0x1.19ee6b38bc834p-1,
-    0x1.1e85f5ef03f95p-1, 0x1.23130d7fabe07p-1, 0x1.2795e1219afep-1, 0x1.2c0e9ec9c8d5p-1,
-    0x1.307d7337f0f83p-1, 0x1.34e289cb4e098p-1, 0x1.393e0d42e28dep-1, 0x1.3d9026ad555bfp-1,
-    0x1.41d8fe8667173p-1, 0x1.4618bc1ec5d87p-1, 0x1.4a4f85d303d8p-1, 0x1.4e7d8127f5a75p-1,
-    0x1.52a2d26dbc47p-1, 0x1.56bf9d597f25ep-1, 0x1.5ad404cb59df2p-1, 0x1.5ee02a928153ap-1,
-    0x1.62e42fefa38b4p-1};
-  static const double b[] = {0x1.00000006342eap+0, -0x1.0001f7fdc3977p-1, 0x1.554a4e5cae9cfp-2};
   static const double c[] =
     {-0x1p-1, 0x1.55555555571cap-2, -0x1.0000000002d85p-2, 0x1.9999987d0c963p-3,
      -0x1.555554059a8bbp-3, 0x1.24aebcf71a38fp-3, -0x1.001c73915d758p-3};
@@ -136,3 +138,94 @@ float cr_logf(float x){
   }
   return ub;
 }
+
+/* Set *lo and *hi to the roundings downwards and upwards of y, where
+   |y - r| <= e, and return 1, or return 0 if a binary32 number lies in
+   [r - e, r + e] (see as_interval_f() in ../exp/expf.c). */
+static inline int as_interval_f(double r, double e, float *lo, float *hi){
+  double rl = r - e, rh = r + e;
+  b32u32_u c = {.f = rl};
+  if(!(c.u<<1)) c.u = 0; // -0 -> +0
+  if((double)c.f >= rl)
+    c.u = c.u ? c.u + ((c.u>>31) ? 1 : -1) : 0x80000001u;
+  b32u32_u d = {.u = c.u + ((c.u>>31) ? -1 : 1)};
+  if((double)d.f <= rh) return 0;
+  *lo = c.f;
+  *hi = d.f;
+  return 1;
+}
+
+static __attribute__((noinline)) void
+as_logf_interval_slow(float x, float *lo, float *hi){
+  volatile float vx = x; // see as_exp_interval_slow() in ../../binary64/exp/exp.c
+  int rm = fegetround();
+  fesetround(FE_DOWNWARD);
+  *lo = cr_logf(vx);
+  fesetround(FE_UPWARD);
+  *hi = cr_logf(vx);
+  fesetround(rm);
+}
+
+/* Put in lo and hi the values of log(x) rounded toward -Inf and +Inf
+   respectively. The current rounding mode is only changed (and restored)
+   when the fast path of cr_logf() does not decide the roundings, which
+   happens in particular for |x - 1| < 2^-10 (where the absolute error of
+   the fast path is too large). Inexact is raised when lo <> hi (see
+   README.md). */
+void cr_logf_interval(float x, float *lo, float *hi){
+  b32u32_u t = {.f = x};
+  uint32_t ux = t.u;
+  if(__builtin_expect(ux<(1<<23) || ux >= 0x7f800000u, 0)){
+    if(ux==0 || ux >= 0x7f800000u){ // <=0, nan, inf
+      *lo = *hi = as_special(x);
+      return;
+    }
+    // subnormal
+    int n = __builtin_clz(ux) - 8;
+    ux <<= n;
+    ux -= n<<23;
+  }
+  if(__builtin_expect(ux == 127u<<23, 0)){
+    *lo = *hi = 0.0f;
+    return;
+  }
+  uint32_t m = ux&((1<<23)-1), j = (m + (1<<(23-7)))>>(23-6);
+  int32_t e = ((int32_t)ux>>23)-127;
+  b64u64_u tz = {.u = ((uint64_t)m|((int64_t)1023<<23))<<(52-23)};
+  double z = tz.f*tr[j] - 1, z2 = z*z;
+  double r = ((e*0x1.62e42fefa39efp-1 + tl[j]) + z*b[0]) + z2*(b[1] + z*b[2]);
+  /* the absolute error of r is less than 0x1.f06p-33 (see cr_logf), we take
+     twice this bound to account for the rounding errors in directed modes */
+  if(__builtin_expect(as_interval_f(r, 0x1.f06p-32, lo, hi), 1))
+    return;
+  as_logf_interval_slow(x, lo, hi);
+}
+
+/* Return cr_logf(x) evaluated in the rounding mode rnd, which raises the
+   same exceptions (and sets errno) as cr_logf() in that mode. */
+static __attribute__((noinline)) float
+as_logf_r_slow(float x, int rnd){
+  volatile float vx = x; // see as_exp_interval_slow() in ../../binary64/exp/exp.c
+  int rm = fegetround();
+  fesetround(rnd);
+  volatile float r = cr_logf(vx);
+  fesetround(rm);
+  return r;
+}
+
+/* Return log(x) rounded according to rnd, assuming the current rounding
+   mode is to nearest (see cr_exp_r() in ../../binary64/exp/exp.c). For
+   x <= 0, x = 1, Inf or NaN, cr_logf() is called in the rounding mode rnd,
+   so that the exceptions are those of cr_logf() in that mode. */
+float cr_logf_r(float x, int rnd){
+  if(rnd != FE_DOWNWARD && rnd != FE_UPWARD && rnd != FE_TOWARDZERO)
+    return cr_logf(x); // FE_TONEAREST
+  b32u32_u t = {.f = x};
+  if(__builtin_expect(t.u - 1 >= 0x7f7fffffu || t.u == 0x3f800000u, 0))
+    return as_logf_r_slow(x, rnd); // x <= 0, NaN, Inf or x = 1
+  float lo, hi;
+  cr_logf_interval(x, &lo, &hi);
+  if(rnd == FE_DOWNWARD) return lo;
+  if(rnd == FE_UPWARD) return hi;
+  return (t.u > 0x3f800000u) ? lo : hi; // FE_TOWARDZERO
+}
@@ -136,9 +136,10 @@ float cr_log10p1f(float x){
   float ub = r, lb = r + 0x1.5cp-42;
   if(__builtin_expect(ub != lb, 0)){
     if(__builtin_expect(ax<0x3d32743eu, 0)){ // |x| < 0x1.64e87cp-5f
-      if(__builtin_expect(ux==0xa6aba8afu,0)) return -0x1.2a33bcp-51f + 0x1p-76f;
-      if(__builtin_expect(ux==0xaf39b9a7u,0)) return -0x1.42a342p-34f + 0x1p-59f;
-      if(__builtin_expect(ux==0x399a7c00u,0)) return  0x1.0c53cap-13f + 0x1p-38f;
+      volatile float one = 1.0f; // prevents constant folding
+      if(__builtin_expect(ux==0xa6aba8afu,0)) return -0x1.2a33bcp-51f + one*0x1p-76f;
+      if(__builtin_expect(ux==0xaf39b9a7u,0)) return -0x1.42a342p-34f + one*0x1p-59f;
+      if(__builtin_expect(ux==0x399a7c00u,0)) return  0x1.0c53cap-13f + one*0x1p-38f;
       z /= 2.0 + z;
       double z2 = z*z, z4 = z2*z2;
       static const double c[] = {0x1.bcb7b1526e50fp-1, 0x1.287a76370129dp-2, 0x1.63c62378fa3dbp-3, 0x1.fca4139a42374p-4};
@@ -149,8 +150,9 @@ float cr_log10p1f(float x){
 #endif
       return r;
     }
-    if(__builtin_expect(ux==0x7956ba5eu,0)) return 0x1.16bebap+5f + 0x1p-20f;
-    if(__builtin_expect(ux==0xbd86ffb9u,0)) return -0x1.e53536p-6f + 0x1p-31f;
+    volatile float one = 1.0f; // prevents constant folding
+    if(__builtin_expect(ux==0x7956ba5eu,0)) return 0x1.16bebap+5f + one*0x1p-20f;
+    if(__builtin_expect(ux==0xbd86ffb9u,0)) return -0x1.e53536p-6f + one*0x1p-31f;
     static const double c[] =
       {0x1.bcb7b1526e50ep-2, -0x1.bcb7b1526e53dp-3, 0x1.287a7636f3fa2p-3, -0x1.bcb7b146a14b3p-4,
        0x1.63c627d5219cbp-4, -0x1.2880736c8762dp-4, 0x1.fc1ecf913961ap-5};
@@ -140,16 +140,18 @@ float cr_log2p1f(float x) {
 #endif
 	  return res;
 	} else {
-	  if(__builtin_expect(ux == 0x32ff7045u, 0)) return 0x1.70851ap-25f - 0x1.8p-80f;
-	  if(__builtin_expect(ux == 0xb395efbbu, 0)) return -0x1.b0a00ap-24f + 0x1p-76f;
-	  if(__builtin_expect(ux == 0x35a14df7u, 0)) return 0x1.d16d2p-20f + 0x1p-72f;
-	  if(__builtin_expect(ux == 0x3841cb81u, 0)) return 0x1.17949ep-14f + 0x1p-67f;
+	  volatile float one = 1.0f; // prevents constant folding
+	  if(__builtin_expect(ux == 0x32ff7045u, 0)) return 0x1.70851ap-25f - one*0x1.8p-80f;
+	  if(__builtin_expect(ux == 0xb395efbbu, 0)) return -0x1.b0a00ap-24f + one*0x1p-76f;
+	  if(__builtin_expect(ux == 0x35a14df7u, 0)) return 0x1.d16d2p-20f + one*0x1p-72f;
+	  if(__builtin_expect(ux == 0x3841cb81u, 0)) return 0x1.17949ep-14f + one*0x1p-67f;
 	  static const double c[] =
 	    {0x1.71547652b82fep+0, -0x1.71547652b82fdp-1, 0x1.ec709ead0c9a7p-2, -0x1.7154773c1cb29p-2};
 	  return z*((c[0] + z*c[1]) + z2*(c[2] + z*c[3]));
 	}
       } else {
-	if(__builtin_expect(ux == 0xbac9363du, 0)) return -0x1.2282aap-9f + 0x1p-61f;
+	volatile float one = 1.0f; // prevents constant folding
+	if(__builtin_expect(ux == 0xbac9363du, 0)) return -0x1.2282aap-9f + one*0x1p-61f;
 	static const double c[] =
 	  {0x1.71547652b82fep+0, -0x1.71547652b83p-1, 0x1.ec709dc28f51bp-2, -0x1.7154765157748p-2,
 	   0x1.2778a510a3682p-2, -0x1.ec745df1551fcp-3};
@@ -162,11 +164,14 @@ float cr_log2p1f(float x) {
       return z*((c[0] + z*c[1]) + z2*(c[2] + z*c[3]) + z4*((c[4] + z*c[5]) + z2*(c[6] + z*c[7])));
     }
   } else { // |x| >= 0x1.6f544cp-6
-    float h, l;
+    volatile float h;
+    float l;
     /* On cfarm117 with gcc 6.3.0, if we return 0x1.e90026p+4f + 0x1.fp-21
        in the second exceptional case, with rounding up it yields 0x1.e90026p+4
        which is incorrect, thus we use this workaround.
-       See https://gcc.gnu.org/bugzilla/show_bug.cgi?id=112367. */
+       See https://gcc.gnu.org/bugzilla/show_bug.cgi?id=112367.
+       Since h is volatile, h + l is not evaluated at compile time, which
+       would round to nearest without -frounding-math. */
     if(__builtin_expect(ux == 0x52928e33u, 0)) {
         h = 0x1.318ffap+5f;
         l = 0x1.fp-20f;
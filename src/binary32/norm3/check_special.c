@@ -0,0 +1,311 @@
+/* Generate special cases for norm3f testing.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fenv.h>
+#include <mpfr.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+#include <unistd.h>
+#include <math.h>
+#include "../../generic/support/philox.h"
+
+extern float cr_norm3f (float, float, float);
+extern int ref_fesetround (int);
+extern void ref_init (void);
+extern float ref_norm3f (float, float, float);
+
+int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
+
+int rnd;
+int verbose = 0;
+uint64_t Seed;
+
+typedef union {float f; uint32_t u;} b32u32_u;
+
+static float
+get_random (philox_t *s)
+{
+  b32u32_u v = {.u = philox_u64 (s)};
+  return v.f;
+}
+
+static inline uint32_t
+asuint (float f)
+{
+  b32u32_u u = {.f = f};
+  return u.u;
+}
+
+/* define our own is_nan function to avoid depending from math.h */
+static inline int
+is_nan (float x)
+{
+  uint32_t u = asuint (x);
+  int e = u >> 23;
+  return (e == 0xff || e == 0x1ff) && (u << 9) != 0;
+}
+
+static inline int
+is_equal (float x, float y)
+{
+  if (is_nan (x))
+    return is_nan (y);
+  if (is_nan (y))
+    return is_nan (x);
+  return asuint (x) == asuint (y);
+}
+
+static void
+check_aux (float x, float y, float z)
+{
+  float r1 = ref_norm3f (x, y, z);
+  float r = cr_norm3f (x, y, z);
+  if (!is_equal (r, r1))
+  {
+    printf ("cr_norm3f and ref_norm3f differ for x=%a y=%a z=%a\n", x, y, z);
+    printf ("ref_norm3f gives %a\n", r1);
+    printf ("cr_norm3f  gives %a\n", r);
+    exit (1);
+  }
+}
+
+// check the permutations of (x,y,z), with sign changes
+static void
+check (float x, float y, float z)
+{
+  check_aux (x, y, z);
+  check_aux (-x, z, y);
+  check_aux (y, -x, z);
+  check_aux (y, z, -x);
+  check_aux (z, x, -y);
+  check_aux (z, -y, x);
+}
+
+#ifndef CORE_MATH_TESTS
+#define CORE_MATH_TESTS 100000000ul // total number of tests
+#endif
+
+/* check random values: if close is non-zero, the exponents of x, y and z
+   differ by less than 16 */
+static void
+check_random (int close)
+{
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t n = 0; n < CORE_MATH_TESTS; n++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround (rnd1[rnd]);
+    philox_t s;
+    philox_init (&s, Seed, n);
+    float t[3];
+    int e0 = philox_u64 (&s) % 277 - 149;
+    for (int i = 0; i < 3; i++)
+    {
+      t[i] = get_random (&s);
+      if (close && !is_nan (t[i]))
+      {
+        int e;
+        t[i] = ldexpf (frexpf (t[i], &e), e0 - (int) (philox_u64 (&s) % 16));
+      }
+    }
+    check_aux (t[0], t[1], t[2]);
+  }
+}
+
+/* return z' such that sqrt(x^2+y^2+z'^2) is closest to the 25-bit number
+   closest to sqrt(x^2+y^2+z^2) */
+static float
+z_worst (float x, float y, float z)
+{
+  mpfr_t S, T, Z;
+  mpfr_init2 (S, 600);
+  mpfr_init2 (T, 600);
+  mpfr_init2 (Z, 25);
+  mpfr_set_flt (S, x, MPFR_RNDN);
+  mpfr_sqr (S, S, MPFR_RNDN);
+  mpfr_set_flt (T, y, MPFR_RNDN);
+  mpfr_sqr (T, T, MPFR_RNDN);
+  mpfr_add (S, S, T, MPFR_RNDN);
+  mpfr_set_flt (T, z, MPFR_RNDN);
+  mpfr_sqr (T, T, MPFR_RNDN);
+  mpfr_add (T, S, T, MPFR_RNDN);
+  mpfr_sqrt (Z, T, MPFR_RNDN);
+  mpfr_prec_round (Z, 600, MPFR_RNDN);
+  mpfr_sqr (Z, Z, MPFR_RNDN);
+  mpfr_sub (Z, Z, S, MPFR_RNDN);
+  mpfr_sqrt (Z, Z, MPFR_RNDN);
+  z = mpfr_get_flt (Z, MPFR_RNDN);
+  mpfr_clear (S);
+  mpfr_clear (T);
+  mpfr_clear (Z);
+  return z;
+}
+
+/* check hard cases where the exponents of x, y and z are in e0-(0..m-1) */
+static void
+check_worst (int m, int e0)
+{
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < 10000; i++)
+  {
+    // the MPFR computations in z_worst() need the full exponent range
+    mpfr_set_emin (mpfr_get_emin_min ());
+    mpfr_set_emax (mpfr_get_emax_max ());
+    philox_t s;
+    philox_init (&s, Seed, ((uint64_t) m << 40) + ((uint64_t) (e0 + 149) << 32) + i);
+    float t[3];
+    for (int j = 0; j < 3; j++)
+    {
+      int e;
+      t[j] = frexpf (get_random (&s), &e);
+      t[j] = ldexpf (isfinite (t[j]) ? t[j] : 0.5f,
+                     e0 - (int) (philox_u64 (&s) % m));
+    }
+    t[2] = z_worst (t[0], t[1], t[2]);
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround (rnd1[rnd]);
+    check (t[0], t[1], t[2]);
+  }
+}
+
+/* check k Pythagorean quadruples (a*2^e,b*2^e,c*2^e) whose norm d*2^e is
+   exact, with a = m^2+n^2-p^2-q^2, b = 2(mq+np), c = 2(nq-mp) and
+   d = m^2+n^2+p^2+q^2: the inexact flag should not be raised */
+static void
+check_quadruples (int k)
+{
+  philox_t s;
+  philox_init (&s, Seed, 0);
+  while (k--)
+  {
+    // if m, n, p, q < 2^11 then d < 2^24
+    int m = philox_u64 (&s) % (1 << 11), n = philox_u64 (&s) % (1 << 11);
+    int p = philox_u64 (&s) % (1 << 11), q = philox_u64 (&s) % (1 << 11);
+    int e = philox_u64 (&s) % 253 - 149; // the values are representable
+    float x = ldexpf ((float) (m * m + n * n - p * p - q * q), e);
+    float y = ldexpf ((float) (2 * (m * q + n * p)), e);
+    float z = ldexpf ((float) (2 * (n * q - m * p)), e);
+    if (ldexpf (x, -e) != (float) (m * m + n * n - p * p - q * q)
+        || ldexpf (y, -e) != (float) (2 * (m * q + n * p))
+        || ldexpf (z, -e) != (float) (2 * (n * q - m * p)))
+      continue; // some value is not exact in the subnormal range
+    check (x, y, z);
+    feclearexcept (FE_INEXACT);
+    float r = cr_norm3f (x, y, z);
+    if (fetestexcept (FE_INEXACT))
+    {
+      printf ("Spurious inexact exception for x=%a y=%a z=%a\n", x, y, z);
+      exit (1);
+    }
+    if (r != ldexpf ((float) (m * m + n * n + p * p + q * q), e))
+    {
+      printf ("Wrong result for x=%a y=%a z=%a\n", x, y, z);
+      exit (1);
+    }
+  }
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--rndn") == 0)
+        {
+          rnd = 0;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndz") == 0)
+        {
+          rnd = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndu") == 0)
+        {
+          rnd = 2;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndd") == 0)
+        {
+          rnd = 3;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--verbose") == 0)
+        {
+          verbose = 1;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  ref_init ();
+  ref_fesetround (rnd);
+  fesetround(rnd1[rnd]);
+  Seed = philox_seed ();
+
+  printf ("Checking special values\n");
+  static const float s[] = {0.0f, 0x1p-149f, 0x1p-126f, 1.0f, 0x1.fffffep+127f,
+                            INFINITY, NAN};
+#define NS (sizeof (s) / sizeof (s[0]))
+  for (unsigned i = 0; i < NS * NS * NS; i++)
+    check (s[i % NS], s[(i / NS) % NS], s[i / (NS * NS)]);
+
+  printf ("Checking Pythagorean quadruples\n");
+  check_quadruples (1000000);
+
+  printf ("Checking hard cases\n");
+  static const int e0[] = {0, -126, -140, -149, 128};
+  for (int m = 1; m <= 24; m++)
+    for (int i = 0; i < 5; i++)
+      check_worst (m, e0[i]);
+
+  printf ("Checking random values with close exponents\n");
+  check_random (1);
+
+  printf ("Checking random values\n");
+  check_random (0);
+  return 0;
+}
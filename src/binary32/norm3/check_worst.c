@@ -0,0 +1,243 @@
+/* Check correctness of norm3f on worst cases.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* The input contains triples "x,y,z", one per line: norm3f.wc, and the worst
+   cases of hypotf as pairs "x,y", for which z = 0 (see WORST_CASES in the
+   Makefile). Each triple is checked with its rotations and their opposites. */
+
+#ifndef __APPLE__
+#define _POSIX_C_SOURCE 200809L  /* for getline */
+#endif /* !__APPLE */
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fenv.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+
+float cr_norm3f (float, float, float);
+float ref_norm3f (float, float, float);
+int ref_fesetround (int);
+void ref_init (void);
+
+int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
+
+int rnd;
+
+typedef struct {
+  float x[3];
+} testcase;
+
+typedef union { float f; uint32_t i; } f32u32;
+
+/* scanf %a from buf, allowing snan, +snan and -snan */
+static int
+sscanf_snan (char *buf, float *x)
+{
+  if (sscanf(buf, "%a", x) == 1)
+    return 1;
+  else if (strncmp (buf, "snan", 4) == 0 || strncmp (buf, "+snan", 5) == 0)
+  {
+    f32u32 u = {.i = 0x7fa00000};
+    *x = u.f;
+    return 1;
+  }
+  else if (strncmp (buf, "-snan", 5) == 0)
+  {
+    f32u32 u = {.i = 0xffa00000};
+    *x = u.f;
+    return 1;
+  }
+  return 0;
+}
+
+static void
+readstdin(testcase **result, int *count)
+{
+  char *buf = NULL;
+  size_t buflength = 0;
+  ssize_t n;
+  int allocated = 512;
+
+  *count = 0;
+  if (NULL == (*result = malloc(allocated * sizeof(testcase)))) {
+    fprintf(stderr, "malloc failed\n");
+    exit(1);
+  }
+
+  while ((n = getline(&buf, &buflength, stdin)) >= 0) {
+    if (n > 0 && buf[0] == '#') continue;
+    if (*count >= allocated) {
+      int newsize = 2 * allocated;
+      testcase *newresult = realloc(*result, newsize * sizeof(testcase));
+      if (NULL == newresult) {
+        fprintf(stderr, "realloc(%d) failed\n", newsize);
+        exit(1);
+      }
+      allocated = newsize;
+      *result = newresult;
+    }
+    testcase *item = *result + *count;
+    int k = 0;
+    for (char *tbuf = buf; tbuf != NULL && k < 3; k++)
+    {
+      if (sscanf_snan (tbuf, item->x + k) != 1)
+        break;
+      tbuf = strchr (tbuf, ',');
+      if (tbuf != NULL)
+        tbuf++;
+    }
+    if (k >= 2)
+    {
+      if (k == 2) // worst case of hypotf
+        item->x[2] = 0;
+      (*count)++;
+    }
+  }
+  free (buf);
+}
+
+static inline uint32_t
+asuint (float f)
+{
+  f32u32 u = {.f = f};
+  return u.i;
+}
+
+/* define our own is_nan function to avoid depending from math.h */
+static inline int
+is_nan (float x)
+{
+  return (asuint (x) << 1) > 0xff000000u;
+}
+
+static inline int
+is_equal (float x, float y)
+{
+  if (is_nan (x))
+    return is_nan (y);
+  if (is_nan (y))
+    return is_nan (x);
+  return asuint (x) == asuint (y);
+}
+
+int tests = 0, failures = 0;
+
+static void
+check (float x, float y, float z)
+{
+  float r1 = ref_norm3f (x, y, z);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp atomic update
+#endif
+  tests ++;
+  float r = cr_norm3f (x, y, z);
+  if (!is_equal (r, r1))
+  {
+    printf ("FAIL x,y,z=%a,%a,%a ref=%a r=%a\n", x, y, z, r1, r);
+    fflush (stdout);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp atomic update
+#endif
+    failures ++;
+#ifndef DO_NOT_ABORT
+    exit (1);
+#endif
+  }
+}
+
+void
+doloop (void)
+{
+  testcase *items;
+  int count;
+
+  readstdin (&items, &count);
+
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < count; i++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround (rnd1[rnd]);
+    const float *x = items[i].x;
+    for (int j = 0; j < 3; j++)
+    {
+      check (x[j], x[(j + 1) % 3], x[(j + 2) % 3]);
+      check (-x[j], -x[(j + 1) % 3], -x[(j + 2) % 3]);
+    }
+  }
+
+  free (items);
+  printf ("%d tests passed, %d failure(s)\n", tests, failures);
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--rndn") == 0)
+        {
+          rnd = 0;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndz") == 0)
+        {
+          rnd = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndu") == 0)
+        {
+          rnd = 2;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndd") == 0)
+        {
+          rnd = 3;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  doloop ();
+
+  return failures != 0;
+}
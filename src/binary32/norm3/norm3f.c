@@ -0,0 +1,236 @@
+/* Correctly-rounded Euclidean norm of three binary32 values.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* cr_norm3f(x,y,z) returns sqrt(x^2+y^2+z^2) correctly rounded.
+
+   As in ../hypot/hypotf.c, the squares are exact in binary64 (including
+   for subnormal inputs), and the square root of their sum is computed in
+   binary64, with an error of a few ulps. When it is close to a rounding
+   boundary (a binary32 number or the middle of two consecutive ones), the
+   sum of the squares is compared exactly (as a big integer) with the
+   square of that boundary. */
+
+#include <stdint.h>
+#include <errno.h>
+#include <fenv.h> // for fexcept_t
+
+#ifdef __x86_64__
+#include <x86intrin.h>
+#endif
+
+// Warning: clang also defines __GNUC__
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#endif
+
+#pragma STDC FENV_ACCESS ON
+
+// This code emulates the _mm_getcsr SSE intrinsic by reading the FPCR register.
+// fegetexceptflag accesses the FPSR register, which seems to be much slower
+// than accessing FPCR, so it should be avoided if possible.
+// Adapted from sse2neon: https://github.com/DLTcollab/sse2neon
+#if (defined(__arm64__) || defined(_M_ARM64)) && !defined(__aarch64__)
+#if defined(_MSC_VER)
+#include <arm64intr.h>
+#endif
+
+typedef struct
+{
+  uint16_t res0;
+  uint8_t  res1  : 6;
+  uint8_t  bit22 : 1;
+  uint8_t  bit23 : 1;
+  uint8_t  bit24 : 1;
+  uint8_t  res2  : 7;
+  uint32_t res3;
+} fpcr_bitfield;
+
+inline static unsigned int _mm_getcsr(void)
+{
+  union
+  {
+    fpcr_bitfield field;
+    uint64_t value;
+  } r;
+
+#if defined(_MSC_VER) && !defined(__clang__)
+  r.value = _ReadStatusReg(ARM64_FPCR);
+#else
+  __asm__ __volatile__("mrs %0, FPCR" : "=r"(r.value));
+#endif
+  static const unsigned int lut[2][2] = {{0x0000, 0x2000}, {0x4000, 0x6000}};
+  return lut[r.field.bit22][r.field.bit23];
+}
+#endif  // (defined(__arm64__) || defined(_M_ARM64)) && !defined(__aarch64__)
+
+static inline fexcept_t get_flags (void)
+{
+  /* Warning: on __aarch64__ (for example cfarm103), FE_UPWARD=0x400000
+     instead of 0x800. */
+#if (defined(__x86_64__) || defined(__arm64__) || defined(_M_ARM64)) && !defined(__aarch64__)
+  return _mm_getcsr ();
+#else
+  fexcept_t flag;
+  fegetexceptflag (&flag, FE_ALL_EXCEPT);
+  return flag;
+#endif
+}
+
+static inline void set_flags (fexcept_t flag)
+{
+#if (defined(__x86_64__) || defined(__arm64__) || defined(_M_ARM64)) && !defined(__aarch64__)
+  _mm_setcsr (flag);
+#else
+  fesetexceptflag (&flag, FE_ALL_EXCEPT);
+#endif
+}
+
+typedef uint64_t u64;
+typedef union {float f; uint32_t u;} b32u32_u;
+typedef union {double f; u64 u;} b64u64_u;
+
+// case where x, y or z is NaN or Inf, with the same rules as for hypotf()
+static float __attribute__((noinline)) as_norm3f_special (float x, float y, float z){
+  b32u32_u t[3] = {{.f = x}, {.f = y}, {.f = z}};
+  int inf = 0;
+  for (int i = 0; i < 3; i++){
+    uint32_t a = t[i].u & 0x7fffffff;
+    if (a > 0xffu<<23 && !((a >> 22) & 1))
+      return x + y + z; // will return qNaN
+    inf |= a == 0xffu<<23;
+  }
+  if (inf) return __builtin_inff ();
+  return x + y + z; // qNaN
+}
+
+/* Return r rounded to binary32, where r is not exactly the result, thus
+   the rounding is inexact. Set errno as in hypotf() in case of overflow or
+   underflow. */
+static inline float as_norm3f_round (double r){
+  float c = r;
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  b64u64_u t = {.f = r};
+  if (t.u > 0x47efffffe0000000ull){ // r > 0x1.fffffep+127
+    b32u32_u v = {.f = c};
+    if (v.u > 0x7f7fffffu || r >= 0x1p128) errno = ERANGE; // overflow
+  } else {
+    // same thresholds as in hypotf()
+    double thres = (fegetround () == FE_TONEAREST) ? 0x1.ffffffp-127
+      : (fegetround () == FE_UPWARD) ? 0x1.fffffep-127
+      : 0x1p-126;
+    if (r < thres)
+      errno = ERANGE; // underflow
+  }
+#endif
+  return c;
+}
+
+/* The exact sum of the squares is stored in NW 64-bit words, in units of
+   2^-POS0. The square of a binary32 number m*2^e is m^2*2^(2e+POS0) with
+   2e+POS0 >= 52, and the square of a boundary b = cb*2^q (see below) is
+   cb^2*2^(2q+POS0) with 2q+POS0 >= 2. */
+#define NW 10
+#define POS0 350
+
+// W += v*2^pos
+static inline void acc_add (u64 *W, u64 v, int pos){
+  int w = pos >> 6, s = pos & 63;
+  u64 a0 = v << s, a1 = s ? v >> (64 - s) : 0;
+  W[w] += a0;
+  u64 c = W[w] < a0;
+  W[w+1] += c;
+  c = W[w+1] < c;
+  W[w+1] += a1;
+  c += W[w+1] < a1;
+  for (int i = w + 2; c; i++) // propagate the carry
+    c = ++W[i] == 0;
+}
+
+// return the sign of W - v*2^pos
+static inline int acc_cmp (const u64 *W, u64 v, int pos){
+  int w = pos >> 6, s = pos & 63;
+  u64 a[2] = {v << s, s ? v >> (64 - s) : 0};
+  for (int i = NW - 1; i > w + 1; i--)
+    if (W[i]) return 1;
+  for (int i = 1; i >= 0; i--)
+    if (W[w+i] != a[i]) return (W[w+i] > a[i]) ? 1 : -1;
+  for (int i = w - 1; i >= 0; i--)
+    if (W[i]) return 1;
+  return 0;
+}
+
+/* Hard case: r is within 8 ulps of the multiple b of 2^28 ulps (in
+   binary64) closest to it, which might be a binary32 number or the middle
+   of two consecutive ones. The sign s of x^2+y^2+z^2-b^2 tells on which
+   side of b the result lies, thus the result rounds like b+s*ulp(b).
+   In the subnormal range, b might not be a rounding boundary, but then the
+   closest boundary is at least 2^28 ulps away from b. */
+static float __attribute__((noinline))
+as_norm3f_hard (float x, float y, float z, double r, const fexcept_t flag){
+  u64 W[NW] = {0};
+  const float t[3] = {x, y, z};
+  for (int i = 0; i < 3; i++){
+    b32u32_u v = {.f = t[i]};
+    u64 m = v.u & 0x7fffff;
+    int e = (v.u >> 23) & 0xff;
+    if (e) m |= 1 << 23; else e = 1;
+    // |t[i]| = m*2^(e-150)
+    if (m) acc_add (W, m * m, 2 * (e - 150) + POS0);
+  }
+  b64u64_u b = {.f = r};
+  b.u = (b.u + 0x8000000) & ~0xfffffffull;
+  // b = cb*2^q with 2^24 <= cb < 2^25
+  u64 cb = ((b.u & 0xfffffffffffffull) | 1ull << 52) >> 28;
+  int q = (int) (b.u >> 52) - 1075 + 28;
+  int s = acc_cmp (W, cb * cb, 2 * q + POS0);
+  b.u += s;
+  float c = b.f;
+  if (!s && c == b.f){ // exact result
+    set_flags (flag);
+    return c;
+  }
+  return as_norm3f_round (b.f);
+}
+
+float cr_norm3f (float x, float y, float z){
+  b32u32_u tx = {.f = x}, ty = {.f = y}, tz = {.f = z};
+  if(__builtin_expect((tx.u & 0x7fffffff) >= (0xffu<<23) ||
+                      (ty.u & 0x7fffffff) >= (0xffu<<23) ||
+                      (tz.u & 0x7fffffff) >= (0xffu<<23), 0))
+    return as_norm3f_special (x, y, z);
+  fexcept_t flag = get_flags ();
+  double xd = x, yd = y, zd = z;
+  /* The squares are exact, and the two additions and the square root have
+     a total relative error less than 2^-51, i.e., less than 4 ulps of r:
+     the rounding test below checks that r is more than 8 ulps away from a
+     multiple of 2^28 ulps. */
+  double r = __builtin_sqrt (xd * xd + yd * yd + zd * zd);
+  b64u64_u t = {.f = r};
+  if(__builtin_expect(((t.u + 8) & 0xfffffff) > 16, 1))
+    return as_norm3f_round (r);
+  if(__builtin_expect(r == 0, 0)) return 0;
+  return as_norm3f_hard (x, y, z, r, flag);
+}
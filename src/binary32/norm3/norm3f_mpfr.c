@@ -0,0 +1,78 @@
+/* Correctly-rounded mpfr-based Euclidean norm of three binary32 values.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <mpfr.h>
+#include "fenv_mpfr.h"
+#include <stdint.h>
+
+typedef union {float f; uint32_t u;} b32u32;
+
+/* reference code using MPFR: return sqrt(x^2+y^2+z^2), with the same rules
+   as hypotf() for NaN and Inf inputs */
+float
+ref_norm3f (float x, float y, float z)
+{
+  const float t[3] = {x, y, z};
+  int inf = 0, nan = 0;
+  for (int i = 0; i < 3; i++)
+  {
+    b32u32 v = {.f = t[i]};
+    uint32_t a = v.u & 0x7fffffff;
+    if (a > 0xffu<<23 && !((a >> 22) & 1)) // sNaN
+      return x + y + z; // will return qNaN
+    inf |= a == 0xffu<<23;
+    nan |= a > 0xffu<<23;
+  }
+  if (inf) return __builtin_inff ();
+  if (nan) return __builtin_nanf ("");
+
+  /* The sum of the squares is computed exactly: each square has at most
+     48 bits, and is between 2^-298 and 2^256, thus 600 bits are enough. */
+  mpfr_exp_t emin = mpfr_get_emin (), emax = mpfr_get_emax ();
+  mpfr_set_emin (mpfr_get_emin_min ());
+  mpfr_set_emax (mpfr_get_emax_max ());
+  mpfr_t s, u, zm;
+  mpfr_init2 (s, 600);
+  mpfr_init2 (u, 48);
+  mpfr_init2 (zm, 24);
+  mpfr_set_ui (s, 0, MPFR_RNDN);
+  for (int i = 0; i < 3; i++)
+  {
+    mpfr_set_flt (u, t[i], MPFR_RNDN);
+    mpfr_sqr (u, u, MPFR_RNDN);
+    mpfr_add (s, s, u, MPFR_RNDN);
+  }
+  int inex = mpfr_sqrt (zm, s, rnd2[rnd]);
+  mpfr_set_emin (emin);
+  mpfr_set_emax (emax);
+  inex = mpfr_check_range (zm, inex, rnd2[rnd]);
+  mpfr_subnormalize (zm, inex, rnd2[rnd]);
+  float ret = mpfr_get_flt (zm, MPFR_RNDN);
+  mpfr_clear (s);
+  mpfr_clear (u);
+  mpfr_clear (zm);
+  return ret;
+}
@@ -37,6 +37,10 @@ SOFTWARE.
 #endif
 
 float cr_powf (float, float);
+#ifndef cr_powf
+#include "powf_base.h"
+#include "powf_exponent.h"
+#endif
 float ref_pow (float, float);
 int ref_fesetround (int);
 void ref_init (void);
@@ -159,6 +163,25 @@ check (float x, float y)
 #endif
   }
 #endif
+#ifndef cr_powf
+  // the fixed-base and fixed-exponent interfaces should give the same result
+  cr_powf_base_t b;
+  cr_powf_prepare_base (x, &b);
+  z1 = cr_powf_with_base (&b, y);
+  if (!is_equal (z1, z2)) {
+    printf("FAIL x,y=%a,%a cr_powf=%a cr_powf_with_base=%a\n", x, y, z2, z1);
+    fflush(stdout);
+    exit(1);
+  }
+  cr_powf_exponent_t e;
+  cr_powf_prepare_exponent (y, &e);
+  z1 = cr_powf_with_exponent (&e, x);
+  if (!is_equal (z1, z2)) {
+    printf("FAIL x,y=%a,%a cr_powf=%a cr_powf_with_exponent=%a\n", x, y, z2, z1);
+    fflush(stdout);
+    exit(1);
+  }
+#endif
 }
 
 #ifndef CORE_MATH_TESTS
@@ -27,6 +27,8 @@ SOFTWARE.
 #include <stdint.h>
 #include <errno.h>
 #include <fenv.h> // for fegetround, FE_TONEAREST, FE_UPWARD
+#include "powf_base.h"
+#include "powf_exponent.h"
 #ifdef __x86_64__
 #include <x86intrin.h>
 #define FLAG_T uint32_t
@@ -363,8 +365,11 @@ is_exact (float x, float y)
   return -149 <= e * (int) n && e * (int) n + t <= 128;
 }
 
-float cr_powf(float x0, float y0){
-  volatile FLAG_T flag = get_flag ();
+/* Return l and put in lh values such that lh + l approximates log2|x|,
+   for x finite and non-zero given by its binary64 encoding t.
+   The value lh = e - lix[j][0] is exact. */
+static inline double
+log2_1 (double *lh, uint64_t t) {
   static const double ix[] = {
     0x1p+0, 0x1.f07c1f07cp-1, 0x1.e1e1e1e1ep-1, 0x1.d41d41d42p-1,
     0x1.c71c71c72p-1, 0x1.bacf914c2p-1, 0x1.af286bca2p-1, 0x1.a41a41a42p-1,
@@ -394,6 +399,118 @@ float cr_powf(float x0, float y0){
     {0x1.7ep-4, -0x1.3f6d2636c101ep-13}, {0x1.1cp-4, -0x1.33567f1b193a4p-14},
     {0x1.78p-5, -0x1.8d66c5313a71dp-14}, {0x1.74p-6, 0x1.f7430ee200ep-17}, {0x0p+0, 0x0p+0}
   };
+  uint64_t m = t & ~(uint64_t)0>>12;
+  // j is an int64_t so that gcc vectorizes the table lookups
+  int64_t j = (m + ((int64_t)1<<(52-6)))>>(52-5), k = j>13;
+  int e = ((t>>52)&0x7ff) - 0x3ff;
+  e += k;
+  b64u64_u xd = {.u = m | (uint64_t)0x3ff<<52};
+  double z = __builtin_fma(xd.f, ix[j], -1.0);
+  static const double c[] =
+    {0x1.71547652b82fep+0, -0x1.71547652b82fep-1, 0x1.ec709dc3a2d0bp-2, -0x1.71547652bc4a9p-2,
+     0x1.2776c441b72ep-2, -0x1.ec709bdf453ecp-3, 0x1.a6406efd4b877p-3, -0x1.717d824a520f7p-3};
+  double z2 = z*z, z4 = z2*z2;
+  double c6 = c[6] + z*c[7];
+  double c4 = c[4] + z*c[5];
+  double c2 = c[2] + z*c[3];
+  double c0 = c[0] + z*c[1];
+  c0 += z2*c2;
+  c4 += z2*c6;
+  c0 += z4*c4;
+  *lh = e - lix[j][0];
+  return z*c0 - lix[j][1];
+}
+
+/* Return an approximation of 2^((il + h)/16), with 0 <= h < 1 and
+   -2400 <= il <= 2048. */
+static inline double
+exp2_1 (double h, int64_t il){
+  static const double ce[] =
+    {0x1.62e42fefa398bp-5, 0x1.ebfbdff84555ap-11, 0x1.c6b08d4ad86d3p-17,
+     0x1.3b2ad1b1716a2p-23, 0x1.5d7472718ce9dp-30, 0x1.4a1d7f457ac56p-37};
+  static const double tb[] =
+    {0x1p+0, 0x1.0b5586cf9890fp+0, 0x1.172b83c7d517bp+0, 0x1.2387a6e756238p+0,
+     0x1.306fe0a31b715p+0, 0x1.3dea64c123422p+0, 0x1.4bfdad5362a27p+0, 0x1.5ab07dd485429p+0,
+     0x1.6a09e667f3bcdp+0, 0x1.7a11473eb0187p+0, 0x1.8ace5422aa0dbp+0, 0x1.9c49182a3f09p+0,
+     0x1.ae89f995ad3adp+0, 0x1.c199bdd85529cp+0, 0x1.d5818dcfba487p+0, 0x1.ea4afa2a490dap+0};
+  int64_t jl = il&0xf, el = il - jl;
+  el >>= 4;
+  double s = tb[jl];
+  b64u64_u su = {.u = (el + (uint64_t)0x3ff)<<52};
+  s *= su.f;
+  double h2 = h*h;
+  double c0 = ce[0] + h*ce[1];
+  double c2 = ce[2] + h*ce[3];
+  double c4 = ce[4] + h*ce[5];
+  c0 += h2*(c2 + h2*c4);
+  double w = s*h;
+  return s + w*c0;
+}
+
+/* Return x0^y0 given lh + l approximating log2|x0| (see log2_1), where y is
+   16*y0, for x0 and y0 not handled by the special cases of powf_with_log().
+   The value flag is the inexact flag on entry. */
+static inline float
+powf_fast (float x0, float y0, double y, double lh, double l, FLAG_T flag){
+  double x = x0;
+  b64u64_u ty = {.f = y0};
+  double zt = lh*y;
+  double z = l*y + zt;
+  if(__builtin_expect(z>2048, 0)){
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    errno = ERANGE; // overflow
+#endif
+    if(isodd(y0))
+      return __builtin_copysignf(0x1p127f, x0)*0x1p127f;
+    else {
+      return 0x1p127f*0x1p127f;
+    }
+  }
+  if(__builtin_expect(z<-2400, 0)){
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    errno = ERANGE; // underflow
+#endif
+    volatile float tiny = 0x1p-126f; // prevents constant folding
+    if(isodd(y0))
+      return __builtin_copysignf(tiny, x0)*0x1p-126f;
+    else
+      return tiny*0x1p-126f;
+  }
+  if(__builtin_fabs(z)<0x1p-26) return 1.0 + z;
+  double ia = __builtin_floor(z), h = __builtin_fma(l, y, zt - ia);
+  b64u64_u rr = {.f = exp2_1 (h, ia)};
+  // with off=467, fails for x,y=0x1.fd12b4p-1,-0x1.d0b058p+13 and RNDZ
+  uint64_t off = 468;
+  if(((rr.u+off)&0xfffffff) <= 2*off)
+    return as_powf_accurate2 (x0, y0, is_exact (x0, y0), flag);
+  int et = ((ty.u>>52)&0x7ff) - 0x3ff;
+  uint64_t kk = (et >= -11) ? ty.u<<(11+et) : ty.u>>(-11-et);
+  if(!(kk<<1)&&kk) rr.f = __builtin_copysign(rr.f,x);
+  float res = rr.f;
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  /* It is not enough to check if res is infinite, since for rounding towards
+     zero, we have overflow for x^y >= 2^128, but res = MAX_FLT.
+     It is also not enough to check if rr >= 2^128, since for rounding upwards,
+     we have overflow for MAX_DBL < rr < 2^128. */
+  // For RNDN, we have underflow when |x^y| < 2^-126*(1-2^-25)
+  // FOR RNDZ/RNDD, we have underflow when |x^y| < 2^-126
+  // For RNDU, we have underflow when |x^y| < 2^-126*(1-2^-24)
+  double thres = (fegetround () == FE_TONEAREST) ? 0x1.ffffffp-127
+    : (fegetround () == FE_UPWARD) ? 0x1.fffffep-127
+    : 0x1p-126;
+  if (is_inf (res) || __builtin_fabs (rr.f) >= 0x1p128 ||
+      __builtin_fabs (rr.f) < thres) {
+    errno = ERANGE; // overflow or underflow
+  }
+#endif
+  return res;
+}
+
+/* Compute x0^y0. If b is not NULL, it was initialized by
+   cr_powf_prepare_base() with the same x0, and log2|x0| is taken from b. */
+static inline float
+powf_with_log (float x0, float y0, const cr_powf_base_t *b){
+  volatile FLAG_T flag = get_flag ();
   double x = x0, y = y0;
   b64u64_u tx = {.f = x}, ty = {.f = y};
   if(__builtin_expect (tx.u<<1 == (uint64_t)0x3ff<<53, 0)){ // |x|=1
@@ -452,93 +569,119 @@ float cr_powf(float x0, float y0){
 	return 0.0f;
     }
   }
-  uint64_t m = tx.u & ~(uint64_t)0>>12;
-  int e = ((tx.u>>52)&0x7ff) - 0x3ff;
-  int j = (m + ((int64_t)1<<(52-6)))>>(52-5), k = j>13;
-  e += k;
-  b64u64_u xd = {.u = m | (uint64_t)0x3ff<<52};
-  double z = __builtin_fma(xd.f, ix[j], -1.0);
-  static const double c[] =
-    {0x1.71547652b82fep+0, -0x1.71547652b82fep-1, 0x1.ec709dc3a2d0bp-2, -0x1.71547652bc4a9p-2,
-     0x1.2776c441b72ep-2, -0x1.ec709bdf453ecp-3, 0x1.a6406efd4b877p-3, -0x1.717d824a520f7p-3};
-  double z2 = z*z, z4 = z2*z2;
-  double c6 = c[6] + z*c[7];
-  double c4 = c[4] + z*c[5];
-  double c2 = c[2] + z*c[3];
-  double c0 = c[0] + z*c[1];
-  c0 += z2*c2;
-  c4 += z2*c6;
-  c0 += z4*c4;
-  double l = z*c0 - lix[j][1];
-  y *= 16;
-  double zt = (e - lix[j][0])*y;
-  z = l*y + zt;
-  if(__builtin_expect(z>2048, 0)){
-#ifdef CORE_MATH_SUPPORT_ERRNO
-    errno = ERANGE; // overflow
-#endif
-    if(isodd(y0))
-      return __builtin_copysignf(0x1p127f, x0)*0x1p127f;
-    else {
-      return 0x1p127f*0x1p127f;
-    }
-  }
-  if(__builtin_expect(z<-2400, 0)){
-#ifdef CORE_MATH_SUPPORT_ERRNO
-    errno = ERANGE; // underflow
-#endif
-    if(isodd(y0))
-      return __builtin_copysignf(0x1p-126f, x0)*0x1p-126f;
-    else
-      return 0x1p-126f*0x1p-126f;
+  double lh, l;
+  if (b != NULL) {
+    lh = b->lh;
+    l = b->ll;
   }
-  if(__builtin_fabs(z)<0x1p-26) return 1.0 + z;
-  double ia = __builtin_floor(z), h = __builtin_fma(l, y, zt - ia);
-  static const double ce[] =
-    {0x1.62e42fefa398bp-5, 0x1.ebfbdff84555ap-11, 0x1.c6b08d4ad86d3p-17,
-     0x1.3b2ad1b1716a2p-23, 0x1.5d7472718ce9dp-30, 0x1.4a1d7f457ac56p-37};
-  static const double tb[] =
-    {0x1p+0, 0x1.0b5586cf9890fp+0, 0x1.172b83c7d517bp+0, 0x1.2387a6e756238p+0,
-     0x1.306fe0a31b715p+0, 0x1.3dea64c123422p+0, 0x1.4bfdad5362a27p+0, 0x1.5ab07dd485429p+0,
-     0x1.6a09e667f3bcdp+0, 0x1.7a11473eb0187p+0, 0x1.8ace5422aa0dbp+0, 0x1.9c49182a3f09p+0,
-     0x1.ae89f995ad3adp+0, 0x1.c199bdd85529cp+0, 0x1.d5818dcfba487p+0, 0x1.ea4afa2a490dap+0};
-  int64_t il = ia, jl = il&0xf, el = il - jl;
-  el >>= 4;
-  double s = tb[jl];
-  b64u64_u su = {.u = (el + (uint64_t)0x3ff)<<52};
-  s *= su.f;
-  double h2 = h*h;
-  c0 = ce[0] + h*ce[1];
-  c2 = ce[2] + h*ce[3];
-  c4 = ce[4] + h*ce[5];
-  c0 += h2*(c2 + h2*c4);
-  double w = s*h;
-  b64u64_u rr = {.f = s + w*c0};
-  // with off=467, fails for x,y=0x1.fd12b4p-1,-0x1.d0b058p+13 and RNDZ
-  uint64_t off = 468;
-  if(((rr.u+off)&0xfffffff) <= 2*off)
-    return as_powf_accurate2 (x0, y0, is_exact (x0, y0), flag);
-  int et = ((ty.u>>52)&0x7ff) - 0x3ff;
-  uint64_t kk = (et >= -11) ? ty.u<<(11+et) : ty.u>>(-11-et);
-  if(!(kk<<1)&&kk) rr.f = __builtin_copysign(rr.f,x);
-  float res = rr.f;
-#ifdef CORE_MATH_SUPPORT_ERRNO
-  /* It is not enough to check if res is infinite, since for rounding towards
-     zero, we have overflow for x^y >= 2^128, but res = MAX_FLT.
-     It is also not enough to check if rr >= 2^128, since for rounding upwards,
-     we have overflow for MAX_DBL < rr < 2^128. */
-  // For RNDN, we have underflow when |x^y| < 2^-126*(1-2^-25)
-  // FOR RNDZ/RNDD, we have underflow when |x^y| < 2^-126
-  // For RNDU, we have underflow when |x^y| < 2^-126*(1-2^-24)
-  double thres = (fegetround () == FE_TONEAREST) ? 0x1.ffffffp-127
-    : (fegetround () == FE_UPWARD) ? 0x1.fffffep-127
-    : 0x1p-126;
-  if (is_inf (res) || __builtin_fabs (rr.f) >= 0x1p128 ||
-      __builtin_fabs (rr.f) < thres) {
-    errno = ERANGE; // overflow or underflow
+  else
+    l = log2_1 (&lh, tx.u);
+  return powf_fast (x0, y0, 16*y, lh, l, flag);
+}
+
+float cr_powf(float x0, float y0){
+  return powf_with_log (x0, y0, NULL);
+}
+
+void cr_powf_prepare_base (float x0, cr_powf_base_t *b){
+  b->x = x0;
+  b->lh = b->ll = 0;
+  b64u64_u tx = {.f = x0};
+  /* the logarithm is only used for finite non-zero x0 */
+  if (!(tx.u<<1) || (tx.u<<1) >= (uint64_t)0x7ff<<53)
+    return;
+  /* log2_1() might raise inexact, which should be done by
+     cr_powf_with_base() only, where it is restored if x0^y is exact */
+  FLAG_T flag = get_flag ();
+  b->ll = log2_1 (&b->lh, tx.u);
+  set_flag (flag);
+}
+
+float cr_powf_with_base (const cr_powf_base_t *b, float y0){
+  return powf_with_log (b->x, y0, b);
+}
+
+void cr_powf_prepare_exponent (float y0, cr_powf_exponent_t *e){
+  b32u32_u t = {.f = y0};
+  e->y = y0;
+  e->special = !(t.u<<1) || (t.u<<1) >= (uint32_t)0xff<<24;
+  // avoid converting a signaling NaN
+  e->y16 = e->special ? 0 : 16*(double)y0;
+}
+
+float cr_powf_with_exponent (const cr_powf_exponent_t *e, float x0){
+  b32u32_u t = {.f = x0};
+  // special cases: y = 0, Inf or NaN, or x0 <= 0, x0 = +Inf or NaN
+  if(__builtin_expect(e->special || t.u - 1 >= 0x7f7fffff, 0))
+    return cr_powf (x0, e->y);
+  volatile FLAG_T flag = get_flag ();
+  b64u64_u tx = {.f = x0};
+  double lh, l = log2_1 (&lh, tx.u);
+  return powf_fast (x0, e->y, e->y16, lh, l, flag);
+}
+
+#define POWF_BLOCK 64
+
+void cr_powf_with_exponent_n (const cr_powf_exponent_t *e, float *r,
+                              const float *x, size_t n){
+  /* With -frounding-math, gcc considers fma() as a function call and does
+     not vectorize the loop below, which is then slower than calling
+     cr_powf_with_exponent() for each input. */
+#ifndef __ROUNDING_MATH__
+  if(__builtin_expect(!e->special, 1)){
+    double y = e->y16;
+    for (size_t i0 = 0; i0 < n; i0 += POWF_BLOCK) {
+      size_t m = (n - i0 < POWF_BLOCK) ? n - i0 : POWF_BLOCK;
+      double res[POWF_BLOCK];
+      int64_t slow[POWF_BLOCK];
+      FLAG_T flag = get_flag ();
+      int64_t nfast = 0;
+      /* Fast path of powf_fast() without branches, so that it can be
+         vectorized. The inputs it cannot handle are marked as slow, and
+         replaced by harmless values to avoid spurious exceptions. We also
+         mark the results not in (2^-125, 2^127), to avoid dealing with
+         overflow and underflow. */
+      for (size_t i = 0; i < m; i++) {
+        b32u32_u t = {.f = x[i0 + i]};
+        // x <= 0, subnormal, +Inf or NaN
+        int64_t bad = t.u - 0x800000 >= 0x7f000000;
+        /* binary64 encoding of x for normal x, and of some finite number
+           otherwise (this avoids converting a signaling NaN) */
+        uint64_t tx = ((uint64_t) (t.u & 0x7fffffff) << 29)
+          + ((uint64_t) 896 << 52);
+        double lh, l = log2_1 (&lh, tx);
+        double zt = lh*y, z = l*y + zt;
+        bad |= (__builtin_fabs(z) < 0x1p-26) | (z <= -2000) | (z >= 2032);
+        // the slow inputs get l = zt = z = 0, thus 2^0 = 1 below
+        uint64_t keep = bad - 1;
+        b64u64_u lu = {.f = l}, ztu = {.f = zt}, zu = {.f = z};
+        lu.u &= keep;
+        ztu.u &= keep;
+        zu.u &= keep;
+        // floor(z), since __builtin_floor() is not always vectorized
+        int il = zu.f;
+        il -= zu.f < il;
+        double h = __builtin_fma(lu.f, y, ztu.f - il);
+        b64u64_u rr = {.f = exp2_1 (h, il)};
+        uint64_t off = 468;
+        bad |= ((rr.u+off)&0xfffffff) <= 2*off;
+        res[i] = rr.f;
+        slow[i] = bad;
+        nfast += !bad;
+      }
+      /* If all results of this block come from the slow path, restore the
+         inexact flag since some might be exact. */
+      if (nfast == 0)
+        set_flag (flag);
+      for (size_t i = 0; i < m; i++)
+        r[i0 + i] = slow[i] ? cr_powf_with_exponent (e, x[i0 + i])
+          : (float) res[i];
+    }
+    return;
   }
 #endif
-  return res;
+  for (size_t i = 0; i < n; i++)
+    r[i] = cr_powf_with_exponent (e, x[i]);
 }
 
 // when is_exact is non-zero, flag is the original inexact flag
@@ -0,0 +1,53 @@
+/* Fixed-base interface to the correctly-rounded binary32 power function.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* When x^y is computed for many y and the same x, the logarithm of x can be
+   computed once:
+
+     cr_powf_base_t b;
+     cr_powf_prepare_base (x, &b);
+     for (i = 0; i < n; i++)
+       z[i] = cr_powf_with_base (&b, y[i]);
+
+   cr_powf_with_base (&b, y) returns exactly cr_powf (x, y), with the same
+   exceptions and errno values, in the current rounding mode. Only the
+   approximation of log2|x| of the fast path is stored in b, the accurate
+   path (rarely taken) recomputes it. The content of b should be considered
+   opaque. */
+
+#ifndef CORE_MATH_POWF_BASE_H
+#define CORE_MATH_POWF_BASE_H
+
+typedef struct {
+  float x;       /* the base */
+  double lh;     /* log2|x| = lh + ll, where lh is exact */
+  double ll;
+} cr_powf_base_t;
+
+void cr_powf_prepare_base (float x, cr_powf_base_t *b);
+float cr_powf_with_base (const cr_powf_base_t *b, float y);
+
+#endif /* CORE_MATH_POWF_BASE_H */
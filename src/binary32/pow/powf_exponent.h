@@ -0,0 +1,64 @@
+/* Fixed-exponent interface to the correctly-rounded binary32 power function.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* When x^y is computed for many x and the same y (for example gamma
+   correction), the work depending only on y can be done once:
+
+     cr_powf_exponent_t e;
+     cr_powf_prepare_exponent (y, &e);
+     for (i = 0; i < n; i++)
+       z[i] = cr_powf_with_exponent (&e, x[i]);
+
+   or, processing the whole array at once (r may be equal to x):
+
+     cr_powf_with_exponent_n (&e, r, x, n);
+
+   Each result is exactly cr_powf (x[i], y), with the same exceptions and errno
+   values, in the current rounding mode. The array version evaluates the fast
+   path without branches, so that the compiler can vectorize it, and only the
+   inputs for which it fails (non-positive, subnormal, infinite or NaN x,
+   results which are hard to round or close to the underflow or overflow
+   thresholds) go through cr_powf_with_exponent(). Since gcc does not
+   vectorize it with -frounding-math, it then calls cr_powf_with_exponent()
+   for each input. The content of e should be considered opaque. */
+
+#ifndef CORE_MATH_POWF_EXPONENT_H
+#define CORE_MATH_POWF_EXPONENT_H
+
+#include <stddef.h>
+
+typedef struct {
+  float y;       /* the exponent */
+  int special;   /* y is 0, Inf or NaN */
+  double y16;    /* 16*y */
+} cr_powf_exponent_t;
+
+void cr_powf_prepare_exponent (float y, cr_powf_exponent_t *e);
+float cr_powf_with_exponent (const cr_powf_exponent_t *e, float x);
+void cr_powf_with_exponent_n (const cr_powf_exponent_t *e, float *r,
+                              const float *x, size_t n);
+
+#endif /* CORE_MATH_POWF_EXPONENT_H */
@@ -0,0 +1,262 @@
+/* Special checks for the binary32 integer power function.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fenv.h>
+#include <math.h>
+#include <mpfr.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+#include <unistd.h>
+
+#include "../../generic/support/philox.h"
+
+float cr_pownf (float, long long);
+float ref_pown (float, long long);
+int ref_fesetround (int);
+void ref_init (void);
+
+int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
+
+int rnd = 0;
+int verbose = 0;
+
+static uint64_t Seed;
+
+typedef union {float f; uint32_t u;} b32u32_u;
+
+static inline uint32_t
+asuint (float f)
+{
+  b32u32_u v = {.f = f};
+  return v.u;
+}
+
+/* define our own is_nan function to avoid depending from math.h */
+static inline int
+is_nan (float x)
+{
+  uint32_t u = asuint (x);
+  int e = u >> 23;
+  return (e == 0xff || e == 0x1ff) && (u << 9) != 0;
+}
+
+static inline int
+is_equal (float x, float y)
+{
+  if (is_nan (x))
+    return is_nan (y);
+  if (is_nan (y))
+    return is_nan (x);
+  return asuint (x) == asuint (y);
+}
+
+static void
+check (float x, long long n)
+{
+  float z, t;
+  mpfr_flags_clear (MPFR_FLAGS_INEXACT);
+  t = ref_pown (x, n);
+#ifdef CORE_MATH_CHECK_INEXACT
+  int inex1 = mpfr_flags_test (MPFR_FLAGS_INEXACT) != 0;
+#endif
+  feclearexcept (FE_INEXACT);
+  z = cr_pownf (x, n);
+#ifdef CORE_MATH_CHECK_INEXACT
+  int inex2 = fetestexcept (FE_INEXACT) != 0;
+#endif
+  if (!is_equal (z, t))
+  {
+    printf ("cr_pownf and ref_pown differ for x=%a n=%lld\n", (double) x, n);
+    printf ("cr_pownf gives %a\n", (double) z);
+    printf ("ref_pown gives %a\n", (double) t);
+    exit (1);
+  }
+#ifdef CORE_MATH_CHECK_INEXACT
+  if (inex1 != inex2)
+  {
+    printf ("%s inexact exception for x=%a n=%lld (y=%a)\n",
+            inex1 ? "Missing" : "Spurious", (double) x, n, (double) t);
+    exit (1);
+  }
+#endif
+}
+
+#ifndef CORE_MATH_TESTS
+#define CORE_MATH_TESTS 100000000ul // total number of tests
+#endif
+
+/* Random x, with n uniformly distributed in [-2^k,2^k] for random k < 40,
+   and x either random, or close to 1 so that x^n does not overflow
+   for large |n|. */
+static void
+check_random (void)
+{
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t i = 0; i < CORE_MATH_TESTS; i++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround(rnd1[rnd]);
+    philox_t s;
+    philox_init (&s, Seed, i);
+    uint32_t u = philox_u64 (&s);
+    uint64_t r = philox_u64 (&s);
+    int k = r % 40;
+    long long n = (long long) ((r >> 6) % (2ull << k)) - (1ll << k);
+    b32u32_u x = {.u = u};
+    if (i & 1) {
+      // |x| in [1-2^-d, 1+2^-d] with 2^d about |n|
+      int d = (k < 23) ? k + 1 : 24;
+      x.f = 1.0f + ldexpf ((float) (u >> 9) * 0x1p-22f - 1.0f, -d);
+      x.u |= u & 0x80000000u;
+    }
+    check (x.f, n);
+  }
+}
+
+/* Check all exact and midpoint values x = m*2^e with m odd, where m^n fits
+   in 25 bits, for all values of e such that x^n is in the binary32 range
+   (or near it). */
+static void
+check_exact_or_midpoint (void)
+{
+  // max_pow[n] is the largest x such that x^n fits in 25 bits
+  int max_pow[] = {0, 0, 5792, 322, 76, 31, 17, 11, 8, 6, 5, 4, 4, 3, 3, 3};
+  for (int n = 15; n >= 2; n--)
+  {
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+    for (int m = 3; m <= max_pow[n]; m += 2)
+    {
+      ref_init();
+      ref_fesetround(rnd);
+      fesetround(rnd1[rnd]);
+      int b = 32 - __builtin_clz (m); // number of bits of m
+      // for e < emin, x^n < 2^-151, for e > emax, x^n > 2^128
+      int emin = -151 / n - b, emax = 128 / n + 1;
+      if (emin < -149)
+        emin = -149;
+      for (int e = emin; e <= emax; e++)
+      {
+        check (ldexpf ((float) m, e), n);
+        check (ldexpf (-(float) m, e), n);
+      }
+    }
+  }
+}
+
+/* Check integer powers of 2 and of values just above and below. */
+static void
+check_powers_of_two (void)
+{
+  static const long long N[] = {2, 3, 7, 10, 23, 24, 25, 126, 127, 128, 149, 150, 151, 400, 401, 0xffff, 0x10000, 1ll << 32, 0x7fffffffffffffffll};
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int e = -149; e <= 127; e++)
+  {
+    ref_init();
+    ref_fesetround(rnd);
+    fesetround(rnd1[rnd]);
+    float x = ldexpf (1.0f, e);
+    for (unsigned i = 0; i < sizeof (N) / sizeof (N[0]); i++)
+      for (int s = 0; s < 2; s++)
+      {
+        long long n = s ? -N[i] : N[i];
+        check (x, n);
+        check (-x, n);
+        check (nextafterf (x, 0), n);
+        check (nextafterf (x, INFINITY), n);
+      }
+  }
+  check (1.0f, 0x7fffffffffffffffll);
+  check (-1.0f, 0x7fffffffffffffffll);
+  check (-1.0f, -0x7fffffffffffffffll - 1);
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--rndn") == 0)
+        {
+          rnd = 0;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndz") == 0)
+        {
+          rnd = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndu") == 0)
+        {
+          rnd = 2;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndd") == 0)
+        {
+          rnd = 3;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--verbose") == 0)
+        {
+          verbose = 1;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  printf ("Checking powers of 2\n");
+  check_powers_of_two ();
+
+  printf ("Checking exact/midpoint values\n");
+  check_exact_or_midpoint ();
+
+  Seed = philox_seed ();
+
+  printf ("Checking random values\n");
+  check_random ();
+
+  return 0;
+}
@@ -0,0 +1,26 @@
+/* The generic bivariate checks give the integer exponent n of pownf as a
+   binary32 value, which is converted back below. */
+#define cr_function_under_test cr_pownf_f
+#define ref_function_under_test ref_pown_f
+#define mpfr_function_under_test mpfr_pown_f
+
+float cr_pownf (float, long long);
+float ref_pown (float, long long);
+
+/* y is NaN only in the checks of signaling NaN inputs: the addition is done
+   on the result of cr_pownf, which the compiler cannot fold */
+static inline float cr_pownf_f (float x, float y)
+{
+  return (y != y) ? cr_pownf (x, 0) + y : cr_pownf (x, (long long) y);
+}
+
+static inline float ref_pown_f (float x, float y)
+{
+  return (y != y) ? x + y : ref_pown (x, (long long) y);
+}
+
+static inline int
+mpfr_pown_f (mpfr_ptr r, mpfr_srcptr x, mpfr_srcptr y, mpfr_rnd_t rnd)
+{
+  return mpfr_pow_si (r, x, mpfr_get_si (y, MPFR_RNDN), rnd);
+}
@@ -0,0 +1,345 @@
+/* Correctly-rounded integer power function for a binary32 value.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* cr_pownf(x,n) computes x^n for a binary32 value x and an integer n, as the
+   pownf function from IEEE 754-2019 and C23. Write |x| = m*2^e with
+   0.75 <= m < 1.5: m^|n| is computed by left-to-right binary exponentiation,
+   first in double precision for |n| < 2^16, then in double-double precision.
+   Binary32 numbers and the middles of two consecutive binary32 numbers are
+   all 25-bit numbers: if the approximation of x^n is far enough from the
+   nearest 25-bit number b, any value on the same side of b has the same
+   rounding to binary32. The only inputs for which both rounding tests fail
+   are the exact and midpoint cases, detected with integer arithmetic.
+
+   If e <> 0, |log2|x|| > 0.415, thus x^n is out of the binary32 range for
+   |n| > 400. If e = 0 and |x| <> 1, |log2|x|| > 2^-24, thus x^n is out
+   of range for |n| >= 2^32.
+*/
+
+#include <stdio.h> // needed in case of rounding-test failure
+#include <stdint.h>
+#include <stdlib.h> // for exit
+#include <errno.h>
+#include <math.h> // needed to define pownf since it is not in glibc < 2.41
+#include <fenv.h> // for fegetround, FE_TONEAREST
+#ifdef __x86_64__
+#include <x86intrin.h>
+#define FLAG_T uint32_t
+#else
+#define FLAG_T fexcept_t
+#endif
+
+// Warning: clang also defines __GNUC__
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#endif
+
+#pragma STDC FENV_ACCESS ON
+
+typedef union {float f; uint32_t u;} b32u32_u;
+typedef union {double f; uint64_t u;} b64u64_u;
+
+/* Return 2^F, for |F| <= 1023, as a binary64 number */
+static inline double
+pow2 (int64_t F)
+{
+  b64u64_u r = {.u = (uint64_t) (F + 0x3ff) << 52};
+  return r.f;
+}
+
+static inline FLAG_T
+get_flag (void)
+{
+#ifdef __x86_64__
+  return _mm_getcsr ();
+#else
+  fexcept_t flag;
+  fegetexceptflag (&flag, FE_INEXACT);
+  return flag;
+#endif
+}
+
+static inline void
+set_flag (FLAG_T flag)
+{
+#ifdef __x86_64__
+  _mm_setcsr (flag);
+#else
+  fesetexceptflag (&flag, FE_INEXACT);
+#endif
+}
+
+/* Return the rounding of s*2^e, where |e| is large, with overflow (e > 0)
+   or underflow (e < 0). */
+static float
+out_of_range (float s, int64_t e)
+{
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  errno = ERANGE;
+#endif
+  volatile float t = s; // prevents constant folding when s is known
+  return (e > 0) ? (t * 0x1p127f) * 0x1p127f : (t * 0x1p-126f) * 0x1p-126f;
+}
+
+/* Put in h+l an approximation of (h+l)^2, with relative error less than
+   5*2^-104, and |l| <= ulp(h), assuming |l| <= ulp(h) on input
+   (see d_sqr() in ../../binary64/pown/pown.c). */
+static inline void
+d_sqr (double *h, double *l)
+{
+  double hi = *h * *h;
+  double e = __builtin_fma (*h, *h, -hi); // exact
+  double lo = __builtin_fma (*h + *h, *l, e);
+  *h = hi + lo;
+  *l = lo - (*h - hi);
+}
+
+/* Put in h+l an approximation of (h+l)*m, with relative error less than
+   3*2^-104, and |l| <= ulp(h), assuming |l| <= ulp(h) on input. */
+static inline void
+d_mul1 (double *h, double *l, double m)
+{
+  double hi = *h * m;
+  double e = __builtin_fma (*h, m, -hi); // exact
+  double lo = __builtin_fma (*l, m, e);
+  *h = hi + lo;
+  *l = lo - (*h - hi);
+}
+
+/* Given h+l approximating |x^n|*2^-F with relative error less than err,
+   where h > 0, |l| <= ulp(h) and 2^-300 < h < 2^300, try to round
+   s*(h+l)*2^F to binary32. Return 1 and put the result in *res in case of
+   success, 0 otherwise. */
+static inline int
+round_25 (float *res, float s, double h, double l, double err, int64_t F)
+{
+  b64u64_u b = {.f = h};
+  int64_t k = ((b.u >> 52) & 0x7ff) - 0x3ff + F; // exponent of h*2^F
+  /* since err < 2^-60, (h+l)*2^F > 2^128 for k > 128, and
+     (h+l)*2^F < 2^-151 for k < -152 */
+  if (__builtin_expect (k > 128 || k < -152, 0)) {
+    *res = out_of_range (s, k);
+    return 1;
+  }
+
+  // b is the 25-bit number nearest to h
+  b.u = (b.u + (1ull << 27)) & ~((1ull << 28) - 1);
+  double d = (h - b.f) + l; // h - b.f is exact
+  if (__builtin_expect (__builtin_fabs (d) <= err * h, 0))
+    return 0;
+  /* h+l and w are strictly between b and the next 25-bit number on the side
+     of d (w is b*(1 +/- 2^-30) up to a rounding error less than ulp(b)),
+     thus they round to the same binary32 number */
+  double w = b.f + __builtin_copysign (0x1p-30, d) * b.f;
+  w = s * (w * pow2 (F)); // exact since -153 <= k <= 129
+  *res = w;
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  /* underflow after rounding: |x^n| rounds to 2^-126 with an unbounded
+     exponent range for |x^n| > 2^-126*(1-2^-25) (rounding to nearest)
+     or for |x^n| > 2^-126*(1-2^-24) (rounding away from zero) */
+  double a = __builtin_fabs (w);
+  float ar = __builtin_fabsf (*res);
+  if (ar < 0x1p-126f                                 // RNDZ, RNDD
+      || (ar == 0x1p-126f && a <= 0x1.fffffep-127) // RNDN or RNDU
+      || (ar == 0x1p-126f && a < 0x1.ffffffp-127 && fegetround () == FE_TONEAREST)
+      || ar > 0x1.fffffep+127f || a >= 0x1p128)
+    errno = ERANGE; // underflow or overflow
+#endif
+  return 1;
+}
+
+float
+cr_pownf (float x, long long n)
+{
+  b32u32_u t = {.f = x};
+  uint32_t ax = t.u & 0x7fffffff;
+  uint64_t N = (n < 0) ? -(uint64_t) n : (uint64_t) n;
+  float s = ((t.u >> 31) & N & 1) ? -1.0f : 1.0f; // sign of x^n
+
+  if (__builtin_expect (ax - 1 >= 0x7f7fffff, 0)) {
+    // x = +/-0, +/-Inf or NaN
+    if (ax > 0x7f800000) {
+      // IEEE 754-2019: pown(x,0) = 1 for any x, even a quiet NaN
+      if (n == 0 && (t.u & (1u << 22)))
+        return 1.0f;
+      return x + x; // returns qNaN and raises invalid for sNaN
+    }
+    if (n == 0)
+      return 1.0f;
+    if (ax == 0x7f800000) // x = +/-Inf
+      return (n > 0) ? s * __builtin_inff () : s * 0.0f;
+    // x = +/-0
+    if (n > 0)
+      return s * 0.0f;
+    feraiseexcept (FE_DIVBYZERO);
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    errno = ERANGE; // pole error
+#endif
+    return s * __builtin_inff ();
+  }
+
+  if (__builtin_expect (n == 0 || n == 1, 0))
+    return (n == 0) ? 1.0f : x;
+
+  // write |x| = m*2^e with 0.75 <= m < 1.5 (|x| is normal in binary64)
+  b64u64_u v = {.f = __builtin_fabsf (x)};
+  int64_t e = ((v.u >> 52) & 0x7ff) - 0x3ff;
+  v.u = (v.u & 0xfffffffffffffull) | 0x3ff0000000000000ull;
+
+  if (__builtin_expect (v.f == 1.0, 0)) { // |x| = 2^e
+    if (e == 0)
+      return s;
+    if (N > 400)
+      return out_of_range (s, (e > 0) == (n > 0) ? 1 : -1);
+    int64_t F = (n > 0) ? e * (int64_t) N : -e * (int64_t) N;
+    if (F > 127 || F < -150)
+      return out_of_range (s, F);
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    if (F == -150)
+      errno = ERANGE; // 2^-150 is the middle of 0 and 2^-149
+#endif
+    return s * pow2 (F);
+  }
+
+  // branchless, since v.f >= 1.5 is hard to predict
+  uint64_t adj = v.f >= 1.5;
+  v.u -= adj << 52;
+  e += adj;
+  double m = v.f;
+
+  if (__builtin_expect (N > 400, 0)) {
+    if (e != 0)
+      return out_of_range (s, (e > 0) == (n > 0) ? 1 : -1);
+    if (N >> 32)
+      return out_of_range (s, (m > 1.0) == (n > 0) ? 1 : -1);
+  }
+
+  int64_t F = (n > 0) ? e * (int64_t) N : -e * (int64_t) N; // |F| <= 51200
+  int i0 = 63 - __builtin_clzll (N);
+  float res;
+
+  /* If e <> 0, we have 2^-166 < m^k < 2^234 for all prefixes k of N <= 400,
+     thus m^k > 2^300 or m^k < 2^-300 implies e = 0, and then
+     |x^n| >= |m^k| is out of range. */
+
+  if (__builtin_expect (N < 0x10000, 1)) {
+    /* First phase in double precision. Left-to-right: if h approximates
+       m^k with relative error eta_k, after the squaring and the optional
+       multiplication by m, the relative error is less than
+       2*eta_k + 2*2^-53, thus the final relative error is less than
+       (2N-1)*2^-53. Right-to-left: p = m^(2^j) has relative error less than
+       (2^j-1)*2^-53, and each multiplication by p adds 2^-53, thus the final
+       relative error is less than N*2^-53. Add 2^-53 for the reciprocal.
+       The inexact flag is saved, since it might be raised spuriously for
+       exact x^n (the right-to-left loop always computes m^32). */
+    FLAG_T flag = get_flag ();
+    double h;
+    if (__builtin_expect (N < 64, 1)) {
+      /* right-to-left exponentiation with a fixed number of steps, where
+         the multiplications by 1.0 are exact: this avoids hard-to-predict
+         branches, and since m^63 < 2^37, there is no overflow */
+      double p = m;
+      h = (N & 1) ? m : 1.0;
+      for (int j = 1; j < 6; j++) {
+        p = p * p;
+        h = h * (((N >> j) & 1) ? p : 1.0);
+      }
+    }
+    else {
+      h = m;
+      int i = i0;
+      while (i--) {
+        h = (h * h) * (((N >> i) & 1) ? m : 1.0);
+        if (__builtin_expect (h > 0x1p300 || h < 0x1p-300, 0))
+          return out_of_range (s, (h > 1.0) == (n > 0) ? 1 : -1);
+      }
+    }
+    h = (n < 0) ? 1.0 / h : h;
+    double err = ((double) N + 1.0) * 0x1p-52;
+    if (__builtin_expect (round_25 (&res, s, h, 0, err, F), 1))
+      return res;
+
+    /* x^n is exact or a midpoint only if n > 0 and x = mo*2^f with mo odd
+       and mo^n < 2^25, which implies n <= 15 */
+    if (n > 0 && N <= 15) {
+      b64u64_u a = {.f = __builtin_fabsf (x)};
+      uint64_t M = (a.u & 0xfffffffffffffull) | (1ull << 52);
+      int c = __builtin_ctzll (M);
+      uint64_t mo = M >> c, P = mo;
+      int64_t f = ((a.u >> 52) & 0x7ff) - 0x3ff - 52 + c;
+      for (uint64_t j = 1; j < N && P < (1ull << 25); j++)
+        P *= mo; // P < 2^25 and mo < 2^24, thus no overflow
+      if (P < (1ull << 25)) {
+        /* since round_25() did not return an out-of-range value,
+           2^-153 < x^n < 2^130, thus -178 < f*N < 130 */
+        double z = s * ((double) P * pow2 (f * (int64_t) N)); // exact
+        set_flag (flag);
+        res = z; // raises inexact for a midpoint
+#ifdef CORE_MATH_SUPPORT_ERRNO
+        if ((__builtin_fabs (z) < 0x1p-126 && (double) res != z)
+            || __builtin_fabsf (res) > 0x1.fffffep+127f
+            || __builtin_fabs (z) >= 0x1p128)
+          errno = ERANGE; // underflow or overflow
+#endif
+        return res;
+      }
+    }
+  }
+
+  /* Second phase in double-double precision: the relative error is less
+     than N*2^-101 for m^N, plus 2^-101 for the reciprocal (see the analysis
+     in ../../binary64/pown/pown.c). */
+  double h = m, l = 0;
+  int i = i0;
+  while (i--) {
+    d_sqr (&h, &l);
+    if ((N >> i) & 1)
+      d_mul1 (&h, &l, m);
+    if (__builtin_expect (h > 0x1p300 || h < 0x1p-300, 0))
+      return out_of_range (s, (h > 1.0) == (n > 0) ? 1 : -1);
+  }
+  if (n < 0) {
+    double rh = 1.0 / h;
+    double eps = __builtin_fma (-rh, h, 1.0);
+    l = rh * __builtin_fma (-rh, l, eps);
+    h = rh;
+  }
+  double err = ((double) N + 1.0) * 0x1p-99;
+  if (__builtin_expect (round_25 (&res, s, h, l, err, F), 1))
+    return res;
+
+  printf ("Rounding test of accurate path failed for pownf(%a,%lld)\n",
+          (double) x, n);
+  printf ("Please report the above to core-math@inria.fr\n");
+  exit (1);
+}
+
+#ifndef SKIP_C_FUNC_REDEF
+/* just to compile since glibc < 2.41 does not contain this function */
+float pownf (float x, long long n){
+  return powf (x, (float) n);
+}
+#endif
@@ -0,0 +1,58 @@
+/* Correctly-rounded integer power function for a binary32 value.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <mpfr.h>
+#include "fenv_mpfr.h"
+
+typedef union { float f; uint32_t u; } f32_u;
+
+// return non-zero iff x is a signaling NaN
+static inline int is_snan(float x) {
+  f32_u v = {.f = x};
+  return (v.u << 1) > 0xff000000u && !(v.u & (1u << 22));
+}
+
+/* reference code using MPFR */
+float
+ref_pown (float x, long long n)
+{
+  // since MPFR does not distinguish between qNaN and sNaN, we have to
+  // deal with signaling NaNs separately
+  if (is_snan (x))
+    return x + x;
+
+  mpfr_t xm, zm;
+  mpfr_init2 (xm, 24);
+  mpfr_init2 (zm, 24);
+  mpfr_set_flt (xm, x, MPFR_RNDN);
+  int inex = mpfr_pow_si (zm, xm, n, rnd2[rnd]);
+  mpfr_subnormalize (zm, inex, rnd2[rnd]);
+  float ret = mpfr_get_flt (zm, MPFR_RNDN);
+  mpfr_clear (xm);
+  mpfr_clear (zm);
+  return ret;
+}
@@ -130,7 +130,9 @@ static inline float add_sign(float x, float rh, float rl){
 }
 
 static void __attribute__((noinline)) as_sincosf_database(float x, float *sout, float *cout){
-  static const struct {union{float arg; uint32_t uarg;}; float sh, sl, ch, cl;} st[] = {
+  /* st is volatile, otherwise once the loop below is unrolled, the compiler
+     might evaluate st[i].ch + st[i].cl at compile time (to nearest) */
+  static const volatile struct {union{float arg; uint32_t uarg;}; float sh, sl, ch, cl;} st[] = {
     {{0x1.33333p+13}, -0x1.63f4bap-2, -0x1p-27, -0x1.e01216p-1, -0x1p-26},
     {{0x1.75b8a2p-1}, 0x1.55688ap-1, -0x1p-26, 0x1.7d8e1ep-1, 0x1p-26},
     {{0x1.4f0654p+0}, 0x1.ee836cp-1, -0x1p-26, 0x1.09558p-2, -0x1p-27},
@@ -215,7 +217,8 @@ void cr_sincosf(float x, float *sout, float *cout){
           if (__builtin_fabsf(*sout) < 0x1p-126)
             errno = ERANGE; // underflow
 #endif
-	  *cout = 1.0f - 0x1p-25f;
+	  volatile float one = 1.0f; // prevents constant folding
+	  *cout = one - 0x1p-25f;
 	}
       } else {
 	*sout = (-0x1.555556p-3f*x)*(x*x) + x;
@@ -0,0 +1,3 @@
+#define cr_function_under_test cr_sinhcoshf
+#define ref_function_under_test ref_sinhcosh
+#define mpfr_function_under_test mpfr_sinh_cosh
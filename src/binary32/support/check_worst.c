@@ -41,6 +41,7 @@ SOFTWARE.
 #endif
 
 #include "function_under_test.h"
+#include "../../generic/support/wc_bin.h"
 
 float cr_function_under_test (float, float);
 float ref_function_under_test (float, float);
@@ -77,9 +78,23 @@ sscanf_snan (char *buf, float *x)
   return 0;
 }
 
+/* worst cases mapped from a binary .wcb file, if any */
+static wc_bin_t wc_bin;
+
+/* if non-NULL, only check the given shard "k/n" of the worst cases */
+static const char *shard = NULL;
+
 static void
 readstdin(float2 **result, int *count)
 {
+  // binary worst-case files are used in place, without any parsing
+  if (wc_bin_map (0, sizeof (float), 2, &wc_bin))
+  {
+    *result = (float2 *) wc_bin.data;
+    *count = wc_bin.count;
+    return;
+  }
+
   char *buf = NULL;
   size_t buflength = 0;
   ssize_t n;
@@ -445,10 +460,19 @@ doloop(void)
 
   readstdin(&items, &count);
 
+  int begin = 0, end = count;
+  if (shard != NULL)
+  {
+    uint64_t b, e;
+    wc_bin_shard (shard, count, &b, &e);
+    begin = b;
+    end = e;
+  }
+
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
 #pragma omp parallel for
 #endif
-  for (int i = 0; i < count; i++) {
+  for (int i = begin; i < end; i++) {
     float x = items[i][0], y = items[i][1];
     check (x, y);
 #ifdef WORST_SYMMETRIC_Y
@@ -474,7 +498,10 @@ doloop(void)
 #endif
   }
 
-  free(items);
+  if (wc_bin.map != NULL)
+    wc_bin_unmap (&wc_bin);
+  else
+    free(items);
   printf("%d tests passed, %d failure(s)\n", tests, failures);
 }
 
@@ -671,6 +698,12 @@ main (int argc, char *argv[])
           argc --;
           argv ++;
         }
+      else if (strcmp (argv[1], "--shard") == 0 && argc >= 3)
+        {
+          shard = argv[2];
+          argc -= 2;
+          argv += 2;
+        }
       else
         {
           fprintf (stderr, "Error, unknown option %s\n", argv[1]);
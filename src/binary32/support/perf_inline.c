@@ -0,0 +1,213 @@
+/* Benchmark of the inlinable binary32 functions on typical loops.
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Usage: ./perf_inline [--count n] [--repeat m]
+
+   For expf and logf, this program times three loops over an array of
+   inputs, which compute the dot product of w[] and f(x[]) (a typical loop
+   of an application):
+   - "call": calling cr_expf (resp. cr_logf) for each element;
+   - "inline": calling cr_expf_inline (resp. cr_logf_inline) from
+     ../exp/expf_inline.h (resp. ../log/logf_inline.h);
+   - "array": applying cr_expf_inline_n (resp. cr_logf_inline_n) on blocks
+     of 1024 elements first.
+   It first checks that the three loops give the same results.
+   Compile without -frounding-math to let the compiler vectorize the array
+   versions. Timings are the minimum over the m runs, in cycles (rdtsc) per
+   element on x86_64, in nanoseconds per element otherwise. */
+
+#define _XOPEN_SOURCE 600 /* for drand48 and clock_gettime */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#ifdef __x86_64__
+#include <x86intrin.h>
+#endif
+#include "../exp/expf_inline.h"
+#include "../log/logf_inline.h"
+
+#define BLOCK 1024
+
+static uint64_t
+ticks (void)
+{
+#ifdef __x86_64__
+  return __rdtsc ();
+#else
+  struct timespec t;
+  clock_gettime (CLOCK_MONOTONIC, &t);
+  return (uint64_t) t.tv_sec * 1000000000 + t.tv_nsec;
+#endif
+}
+
+static int count = 1000000, repeat = 100;
+static float *x, *w;
+
+/* The loops for function f (expf or logf): since they are static functions
+   in which f is known, the inline versions are inlined. */
+#define LOOPS(f)                                                        \
+static float                                                            \
+f##_call (void)                                                         \
+{                                                                       \
+  float s = 0;                                                          \
+  for (int i = 0; i < count; i++)                                       \
+    s += w[i] * cr_##f (x[i]);                                          \
+  return s;                                                             \
+}                                                                       \
+                                                                        \
+static float                                                            \
+f##_inline (void)                                                       \
+{                                                                       \
+  float s = 0;                                                          \
+  for (int i = 0; i < count; i++)                                       \
+    s += w[i] * cr_##f##_inline (x[i]);                                 \
+  return s;                                                             \
+}                                                                       \
+                                                                        \
+static float                                                            \
+f##_array (void)                                                        \
+{                                                                       \
+  float s = 0, y[BLOCK];                                                \
+  for (int i0 = 0; i0 < count; i0 += BLOCK)                             \
+  {                                                                     \
+    int m = (count - i0 < BLOCK) ? count - i0 : BLOCK;                  \
+    cr_##f##_inline_n (y, x + i0, m);                                   \
+    for (int i = 0; i < m; i++)                                         \
+      s += w[i0 + i] * y[i];                                            \
+  }                                                                     \
+  return s;                                                             \
+}
+
+LOOPS(expf)
+LOOPS(logf)
+
+typedef float loop_type (void);
+
+/* return the minimum time of repeat runs of loop, which is less sensitive
+   to the other processes than the average */
+static double
+time_loop (loop_type *loop)
+{
+  volatile float sink;
+  uint64_t best = UINT64_MAX;
+  for (int r = 0; r < repeat; r++)
+  {
+    uint64_t start = ticks ();
+    sink = loop ();
+    uint64_t t = ticks () - start;
+    best = (t < best) ? t : best;
+  }
+  (void) sink;
+  return (double) best / (double) count;
+}
+
+/* check that cr_f_inline and cr_f_inline_n give the same results as cr_f
+   on x[] */
+#define CHECK(f)                                                        \
+static void                                                             \
+f##_check (void)                                                        \
+{                                                                       \
+  float y[BLOCK];                                                       \
+  for (int i0 = 0; i0 < count; i0 += BLOCK)                             \
+  {                                                                     \
+    int m = (count - i0 < BLOCK) ? count - i0 : BLOCK;                  \
+    cr_##f##_inline_n (y, x + i0, m);                                   \
+    for (int i = 0; i < m; i++)                                         \
+    {                                                                   \
+      float a = cr_##f (x[i0 + i]), b = cr_##f##_inline (x[i0 + i]);   \
+      if (memcmp (&a, &b, sizeof (float)) != 0                          \
+          || memcmp (&a, &y[i], sizeof (float)) != 0)                   \
+      {                                                                 \
+        fprintf (stderr, "Error, %s(%a): %a %a %a\n", #f, x[i0 + i],   \
+                 a, b, y[i]);                                           \
+        exit (1);                                                       \
+      }                                                                 \
+    }                                                                   \
+  }                                                                     \
+}
+
+CHECK(expf)
+CHECK(logf)
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--count") == 0 && argc >= 3)
+        {
+          count = atoi (argv[2]);
+          argc -= 2;
+          argv += 2;
+        }
+      else if (strcmp (argv[1], "--repeat") == 0 && argc >= 3)
+        {
+          repeat = atoi (argv[2]);
+          argc -= 2;
+          argv += 2;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  x = malloc ((size_t) count * sizeof (float));
+  w = malloc ((size_t) count * sizeof (float));
+  if (x == NULL || w == NULL)
+    {
+      fprintf (stderr, "malloc failed\n");
+      exit (1);
+    }
+  srand48 (1);
+
+  // exp: x uniform in [-80,80]
+  for (int i = 0; i < count; i++)
+    {
+      x[i] = -80.0 + 160.0 * drand48 ();
+      w[i] = drand48 ();
+    }
+  expf_check ();
+  printf ("expf call   %.3f\n", time_loop (expf_call));
+  printf ("expf inline %.3f\n", time_loop (expf_inline));
+  printf ("expf array  %.3f\n", time_loop (expf_array));
+
+  // log: x in [2^-100,2^100] with a logarithmic distribution
+  for (int i = 0; i < count; i++)
+    x[i] = ldexp (1.0 + drand48 (), -100 + (int) (200.0 * drand48 ()));
+  logf_check ();
+  printf ("logf call   %.3f\n", time_loop (logf_call));
+  printf ("logf inline %.3f\n", time_loop (logf_inline));
+  printf ("logf array  %.3f\n", time_loop (logf_array));
+
+  free (x);
+  free (w);
+  return 0;
+}
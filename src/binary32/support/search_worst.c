@@ -0,0 +1,497 @@
+/* Search hard-to-round cases of bivariate binary32 functions.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+This program is generic: it is compiled in the directory of a bivariate
+binary32 function (atan2, hypot, pow, compound...) where function_under_test.h
+defines mpfr_function_under_test, with "make search_worst".
+
+Example (in src/binary32/pow):
+
+./search_worst -m 32 -vary 0 -vmin 0x1p0 -vmax 0x1.fffffep0 -wmin 0x1p4 -wmax 0x1.000100p4 > powf_1.wc
+
+-m 32 looks for at least 32 identical bits after the round bit
+-vary 0 says the first argument varies (x for powf), -vary 1 the second one
+-vmin/-vmax give the (inclusive) range of the varied argument
+-wmin/-wmax give the (inclusive) range of the other argument
+
+The hard-to-round cases are printed on stdout in the .wc format, i.e.,
+"x,y # k" where k is the number of identical bits after the round bit,
+and the throughput (in inputs per second) is printed on stderr.
+
+Algorithm: for each value w of the fixed argument, the varied argument v is
+split into intervals of L consecutive binary32 numbers in the same binade,
+where v_i = v_0 + i*ulp(v). Let F(i) = f(v_i,w)*2^(25-E) where 2^(E-1) <=
+|f| < 2^E on the interval, so that the integer part of F contains the round
+bit, and hard-to-round cases are those i for which F(i) is close to an
+integer. We compute the forward differences D0...D4 of F at i=0 with MPFR,
+and evaluate F(i) mod 1 with a cubic difference table in 64-bit fixed point,
+which costs three additions per input. The error of the difference table is
+bounded by the rounding errors of D0...D3 and by binomial(i,4)*max|D4|,
+where max|D4| is estimated as twice the maximum of |D4| at both ends of the
+interval. The interval length L is chosen such that the total error is at
+most 2^46/2^64 (thus about one candidate every 2^17 inputs); each candidate
+is then checked with MPFR. Intervals where the exponent of f varies are
+split, and the smallest ones are checked exhaustively with MPFR, as well as
+the remaining inputs of an interval with more than MAX_CAND candidates.
+
+Warning: the estimate of max|D4| is a heuristic (it is not a rigorous bound
+since the 4th derivative of f is not known for a generic f), thus the search
+is not guaranteed to be exhaustive, which is recalled in the output.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <mpfr.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+#include <time.h>
+
+#include "function_under_test.h"
+
+#define PREC 192          /* working precision of MPFR evaluations */
+#define LMAX 0x8000       /* maximal length of an interval */
+#define LMIN 64           /* below, intervals are checked with MPFR only */
+#define TMAX 0x1p46       /* maximal error of the difference table */
+#define MAX_CAND 1024     /* maximal number of candidates per interval */
+#define CHUNK 0x100000    /* number of inputs per task */
+
+int target_m = 32; /* number of identical bits after round bit */
+int vary = 0;      /* index of the varied argument */
+int verbose = 0;
+
+uint64_t tot_inputs = 0, tot_cand = 0, nsols = 0, nexact = 0, nmpfr = 0;
+
+typedef union { uint32_t n; float x; } union_t;
+
+static inline uint32_t
+asuint (float x)
+{
+  union_t u = {.x = x};
+  return u.n;
+}
+
+static inline float
+asfloat (uint32_t n)
+{
+  union_t u = {.n = n};
+  return u.x;
+}
+
+/* binary32 numbers are enumerated by a key which is increasing with the
+   value: key(-inf) < key(-0) < key(+0) < key(+inf) */
+static inline uint32_t
+key_of (float x)
+{
+  uint32_t u = asuint (x);
+  return (u >> 31) ? ~u : u | 0x80000000u;
+}
+
+static inline float
+float_of (uint32_t k)
+{
+  return asfloat ((k >> 31) ? k & 0x7fffffffu : ~k);
+}
+
+/* store f(v,w) in t (precision PREC), where v is the varied argument */
+static void
+eval (mpfr_t t, float v, float w)
+{
+  mpfr_t vv, ww;
+  mpfr_init2 (vv, 24);
+  mpfr_init2 (ww, 24);
+  mpfr_set_flt (vv, v, MPFR_RNDN);
+  mpfr_set_flt (ww, w, MPFR_RNDN);
+  if (vary == 0)
+    mpfr_function_under_test (t, vv, ww, MPFR_RNDN);
+  else
+    mpfr_function_under_test (t, ww, vv, MPFR_RNDN);
+  mpfr_clear (vv);
+  mpfr_clear (ww);
+}
+
+/* return the exponent E such that |t| < 2^E, clamped to -125 so that
+   2^(E-25) is half the ulp of t also for subnormals, or a value larger
+   than 129 if t is zero, infinite or NaN */
+static long
+get_E (mpfr_t t)
+{
+  if (!mpfr_regular_p (t))
+    return 1000;
+  long E = mpfr_get_exp (t);
+  return (E < -125) ? -125 : E;
+}
+
+/* return the number of identical bits after the round bit of f(v,w),
+   -1 if f(v,w) is exact on 25 bits, or -2 if it is not a finite number */
+static int
+identical_bits (float v, float w)
+{
+  mpfr_t t, r;
+  int k;
+  mpfr_init2 (t, PREC);
+  mpfr_init2 (r, PREC);
+  eval (t, v, w);
+  long E = get_E (t);
+  if (E > 129)
+  {
+    k = -2;
+    goto end;
+  }
+  mpfr_mul_2si (t, t, 25 - E, MPFR_RNDN); /* exact */
+  mpfr_rint (r, t, MPFR_RNDN);
+  mpfr_sub (t, t, r, MPFR_RNDN);          /* exact */
+  if (mpfr_zero_p (t))
+    k = -1; /* exact on 25 bits, at least up to precision PREC */
+  else
+    k = - mpfr_get_exp (t);
+ end:
+  mpfr_clear (t);
+  mpfr_clear (r);
+  return k;
+}
+
+/* check a candidate input, return 1 if it is a hard-to-round case */
+static int
+check_candidate (float v, float w)
+{
+  int k = identical_bits (v, w);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp atomic update
+#endif
+  nmpfr ++;
+  if (k == -1)
+  {
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp atomic update
+#endif
+    nexact ++;
+    return 0;
+  }
+  if (k < target_m)
+    return 0;
+  float x = (vary == 0) ? v : w, y = (vary == 0) ? w : v;
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp critical
+#endif
+  {
+    printf ("%a,%a # %d\n", x, y, k);
+    fflush (stdout);
+  }
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp atomic update
+#endif
+  nsols ++;
+  return 1;
+}
+
+/* exhaustive search with MPFR for keys k0 <= k < k0 + L */
+static void
+search_mpfr (uint32_t k0, uint32_t L, float w)
+{
+  for (uint32_t i = 0; i < L; i++)
+    check_candidate (float_of (k0 + i), w);
+}
+
+/* store in d[0..4] the forward differences of F at keys k0..k0+4, where
+   F = f*2^(25-E), and return E, or 1000 if E is not constant (or differs
+   from the given E, unless E = E_ANY) */
+#define E_ANY -1000
+static long
+differences (mpfr_t d[5], uint32_t k0, float w, long E)
+{
+  for (int i = 0; i < 5; i++)
+  {
+    eval (d[i], float_of (k0 + i), w);
+    long Ei = get_E (d[i]);
+    if (E == E_ANY)
+      E = Ei;
+    if (Ei != E || E > 129)
+      return 1000;
+    mpfr_mul_2si (d[i], d[i], 25 - E, MPFR_RNDN);
+  }
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp atomic update
+#endif
+  nmpfr += 5;
+  /* at step j, d[i] for i >= j contains the j-th difference at k0+i-j */
+  for (int j = 1; j < 5; j++)
+    for (int i = 4; i >= j; i--)
+      mpfr_sub (d[i], d[i], d[i-1], MPFR_RNDN);
+  return E;
+}
+
+/* return round(frac(d)*2^64) mod 2^64 */
+static uint64_t
+frac64 (mpfr_t d)
+{
+  mpfr_t t;
+  mpfr_init2 (t, PREC);
+  mpfr_floor (t, d);
+  mpfr_sub (t, d, t, MPFR_RNDN);  /* 0 <= t < 1 */
+  mpfr_mul_2ui (t, t, 64, MPFR_RNDN);
+  mpfr_rint (t, t, MPFR_RNDN);
+  uint64_t r = (mpfr_cmp_ui_2exp (t, 1, 64) == 0) ? 0
+    : mpfr_get_ui (t, MPFR_RNDN);
+  mpfr_clear (t);
+  return r;
+}
+
+/* search keys k0 <= k < k0 + L, which all have the same sign and
+   exponent */
+static void
+search_interval (uint32_t k0, uint32_t L, float w)
+{
+  mpfr_t d[5], e[5];
+  long E;
+  double T = 0;
+
+  if (L < LMIN)
+  {
+    search_mpfr (k0, L, w);
+    return;
+  }
+
+  for (int i = 0; i < 5; i++)
+  {
+    mpfr_init2 (d[i], PREC);
+    mpfr_init2 (e[i], PREC);
+  }
+
+  E = differences (d, k0, w, E_ANY);
+  if (E > 129)
+    goto split;
+
+  /* first guess of L from D4 at k0 */
+  double d4 = mpfr_get_d (d[4], MPFR_RNDA);
+  d4 = 2.0 * __builtin_fabs (d4) * 0x1p64;
+  uint32_t L1 = LMAX;
+  while (L1 > LMIN && (double) L1 * L1 * L1 * L1 / 24.0 * d4 > TMAX / 2)
+    L1 /= 2;
+  if (L1 < L)
+  {
+    /* search the first L1 inputs, then the remaining ones */
+    for (int i = 0; i < 5; i++)
+    {
+      mpfr_clear (d[i]);
+      mpfr_clear (e[i]);
+    }
+    search_interval (k0, L1, w);
+    search_interval (k0 + L1, L - L1, w);
+    return;
+  }
+
+  /* check the exponent and D4 at the other end of the interval */
+  if (differences (e, k0 + L - 5, w, E) > 129)
+    goto split;
+  double d4e = 2.0 * __builtin_fabs (mpfr_get_d (e[4], MPFR_RNDA)) * 0x1p64;
+  if (d4e > d4)
+    d4 = d4e;
+  double l = L;
+  /* error of the difference table */
+  T = (1.0 + l + l * l / 2.0 + l * l * l / 6.0) * 0.5 + 4.0
+    + l * l * l * l / 24.0 * d4;
+  if (T > TMAX)
+    goto split;
+  T += 0x1p64 / (double) ((uint64_t) 1 << target_m);
+
+  uint64_t a = frac64 (d[0]), b = frac64 (d[1]), c = frac64 (d[2]),
+    dd = frac64 (d[3]);
+  uint64_t t = T, t2 = 2 * t;
+  uint32_t ncand = 0;
+  for (uint32_t i = 0; i < L; i++)
+  {
+    /* is F(i) mod 1 in [-T, T]? */
+    if (__builtin_expect (a + t <= t2, 0))
+    {
+      if (++ncand > MAX_CAND)
+      {
+        /* degenerate interval (for example f is linear in v): check the
+           remaining inputs with MPFR */
+        ncand --;
+        search_mpfr (k0 + i, L - i, w);
+        break;
+      }
+      check_candidate (float_of (k0 + i), w);
+    }
+    a += b;
+    b += c;
+    c += dd;
+  }
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp atomic update
+#endif
+  tot_cand += ncand;
+  goto end;
+
+ split:
+  if (L / 2 < LMIN)
+    search_mpfr (k0, L, w);
+  else
+  {
+    search_interval (k0, L / 2, w);
+    search_interval (k0 + L / 2, L - L / 2, w);
+  }
+ end:
+  for (int i = 0; i < 5; i++)
+  {
+    mpfr_clear (d[i]);
+    mpfr_clear (e[i]);
+  }
+}
+
+/* search keys k0 <= k <= k1 for the fixed argument w */
+static void
+search (uint32_t k0, uint32_t k1, float w)
+{
+  while (k0 <= k1)
+  {
+    uint32_t u = asuint (float_of (k0));
+    /* skip infinities and NaNs */
+    if ((u & 0x7f800000) == 0x7f800000)
+      break;
+    /* last key with the same sign and exponent as k0 */
+    uint32_t kend = key_of (asfloat ((u >> 31) ? u & 0xff800000 : u | 0x7fffff));
+    if (kend > k1)
+      kend = k1;
+    search_interval (k0, kend - k0 + 1, w);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp atomic update
+#endif
+    tot_inputs += kend - k0 + 1;
+    if (kend == 0xffffffffu)
+      break;
+    k0 = kend + 1;
+  }
+}
+
+int
+main (int argc, char *argv[])
+{
+  float vmin = 0x1p0f, vmax = 0x1.fffffep0f, wmin = 0x1p0f, wmax = 0x1p0f;
+
+  /* print command line */
+  printf ("#");
+  for (int i = 0; i < argc; i++)
+    printf (" %s", argv[i]);
+  printf ("\n");
+  printf ("# non-exhaustive search: the bound on the 4th differences is heuristic\n");
+  fflush (stdout);
+
+  while (argc >= 2 && argv[1][0] == '-')
+  {
+    if (strcmp (argv[1], "-m") == 0 && argc >= 3)
+    {
+      target_m = atoi (argv[2]);
+      argv += 2;
+      argc -= 2;
+    }
+    else if (strcmp (argv[1], "-vary") == 0 && argc >= 3)
+    {
+      vary = atoi (argv[2]) != 0;
+      argv += 2;
+      argc -= 2;
+    }
+    else if (strcmp (argv[1], "-vmin") == 0 && argc >= 3)
+    {
+      vmin = strtof (argv[2], NULL);
+      argv += 2;
+      argc -= 2;
+    }
+    else if (strcmp (argv[1], "-vmax") == 0 && argc >= 3)
+    {
+      vmax = strtof (argv[2], NULL);
+      argv += 2;
+      argc -= 2;
+    }
+    else if (strcmp (argv[1], "-wmin") == 0 && argc >= 3)
+    {
+      wmin = strtof (argv[2], NULL);
+      argv += 2;
+      argc -= 2;
+    }
+    else if (strcmp (argv[1], "-wmax") == 0 && argc >= 3)
+    {
+      wmax = strtof (argv[2], NULL);
+      argv += 2;
+      argc -= 2;
+    }
+    else if (strcmp (argv[1], "-v") == 0)
+    {
+      verbose ++;
+      argv += 1;
+      argc -= 1;
+    }
+    else
+    {
+      fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+      exit (1);
+    }
+  }
+
+  if (target_m < 2 || target_m > 60)
+  {
+    fprintf (stderr, "Error, -m should be in [2,60]\n");
+    exit (1);
+  }
+
+  uint32_t v0 = key_of (vmin), v1 = key_of (vmax);
+  uint32_t w0 = key_of (wmin), w1 = key_of (wmax);
+  if (v0 > v1 || w0 > w1)
+  {
+    fprintf (stderr, "Error, empty range\n");
+    exit (1);
+  }
+
+  /* each task is a chunk of CHUNK consecutive keys of v for one w */
+  uint64_t nchunks = ((uint64_t) v1 - v0) / CHUNK + 1;
+  uint64_t ntasks = ((uint64_t) w1 - w0 + 1) * nchunks;
+  struct timespec start, stop;
+  clock_gettime (CLOCK_MONOTONIC, &start);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+  for (uint64_t n = 0; n < ntasks; n++)
+  {
+    float w = float_of (w0 + n / nchunks);
+    uint64_t k0 = v0 + (n % nchunks) * CHUNK;
+    uint64_t k1 = k0 + CHUNK - 1;
+    if (k1 > v1)
+      k1 = v1;
+    if (verbose)
+      fprintf (stderr, "w=%a v=%a..%a\n", w, float_of (k0), float_of (k1));
+    search (k0, k1, w);
+  }
+  clock_gettime (CLOCK_MONOTONIC, &stop);
+
+  double t = (stop.tv_sec - start.tv_sec) + 1e-9 * (stop.tv_nsec - start.tv_nsec);
+  fprintf (stderr, "%lu inputs in %.3fs (%.3e inputs/s), %lu candidates, "
+           "%lu hard cases, %lu exact cases, %lu MPFR evaluations\n",
+           tot_inputs, t, (double) tot_inputs / t, tot_cand, nsols, nexact,
+           nmpfr);
+  return 0;
+}
@@ -225,7 +225,10 @@ double cr_acos (double x){
     f0l = 0x1.1a62633145c07p-54;
     // for |x| <= 0x1.cb3b399d747f2p-55, acos(x) rounds to pi/2 to nearest
     // this avoids a spurious underflow exception with the code below
-    if(__builtin_expect(ax <= 0x7919676733ae8fe4, 0)) return f0h + f0l;
+    if(__builtin_expect(ax <= 0x7919676733ae8fe4, 0)){
+      volatile double h = f0h; // prevents constant folding
+      return h + f0l;
+    }
 
     // for |x|<=0.5 we use acos(x) = pi/2 - asin(x) so the argument
     // range for asin is the same for both branches to reuse the lookup
@@ -331,13 +334,14 @@ double as_acos_refine(double x, double phi){
   u64 m = ((u64)1<<52)-((u64)1<<e);
   e = (e == 0) ? 64 : e;
   if(__builtin_expect(!((t.u+((u64)1<<(e-1)))&m), 0)){
-    if(x==-0x1.771164bfd1f84p-3 ) return 0x1.c14601daaf657p+0  - 0x1p-54;
-    if(x==-0x1.4510ee8eb4e67p-1 ) return 0x1.211c0e2c2559ep+1  - 0x1p-53;
-    if(x==-0x1.011c543f23a17p-2 ) return 0x1.d318c90d9e8b7p+0  - 0x1p-54;
-    if(x== 0x1.ffffffffffdc0p-1 ) return 0x1.8000000000024p-22 + 0x1p-76;
-    if(x== 0x1.53ea6c7255e88p-4 ) return 0x1.7cdacb6bbe707p+0  + 0x1p-54;
-    if(x== 0x1.fd737be914578p-11) return 0x1.91e006d41d8d8p+0  + 0x1.8p-53;
-    if(x== 0x1.fffffffffff70p-1 ) return 0x1.8000000000009p-23 + 0x1p-77;
+    volatile double one = 1.0; // prevents constant folding
+    if(x==-0x1.771164bfd1f84p-3 ) return 0x1.c14601daaf657p+0 - one*0x1p-54;
+    if(x==-0x1.4510ee8eb4e67p-1 ) return 0x1.211c0e2c2559ep+1 - one*0x1p-53;
+    if(x==-0x1.011c543f23a17p-2 ) return 0x1.d318c90d9e8b7p+0 - one*0x1p-54;
+    if(x== 0x1.ffffffffffdc0p-1 ) return 0x1.8000000000024p-22 + one*0x1p-76;
+    if(x== 0x1.53ea6c7255e88p-4 ) return 0x1.7cdacb6bbe707p+0 + one*0x1p-54;
+    if(x== 0x1.fd737be914578p-11) return 0x1.91e006d41d8d8p+0 + one*0x1.8p-53;
+    if(x== 0x1.fffffffffff70p-1 ) return 0x1.8000000000009p-23 + one*0x1p-77;
     b64u64_u w = {.f = ps};
     if((w.u^t.u)>>63)
       t.u--;
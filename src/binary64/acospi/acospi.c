@@ -887,10 +887,11 @@ accurate_path (double x)
     double h1, l1;
 
     // exceptional cases
+    volatile double one = 1.0; // prevents constant folding
     if (x == 0x1.b32b7ac93ddefp-1)
-      return 0x1.69c0e1dfbf177p-3 - 0x1.16beadd718bafp-108;
+      return 0x1.69c0e1dfbf177p-3 - one * 0x1.16beadd718bafp-108;
     if (x == 0x1.e55a7fa9a24c4p-1)
-      return 0x1.a67c4d04a9236p-4 - 0x1.edc5fcb35e5e3p-110;
+      return 0x1.a67c4d04a9236p-4 - one * 0x1.edc5fcb35e5e3p-110;
 
     h1 = 1.0 - absx; /* exact since |x| >= 0.5 */
     h1 = sqrt_dbl_dbl (h1, &l1);
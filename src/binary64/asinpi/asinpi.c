@@ -311,8 +311,10 @@ static double asinpi_tiny (double x)
   b64u64_u t = {.f = x};
   uint64_t au = t.u & 0x7fffffffffffffffllu;
 
+  /* x == 0 also holds for subnormal x in DAZ mode (see
+     src/generic/support/fenv_ftz.h), where we return zero */
   if (x == 0)
-    return x;
+    return __builtin_copysign (0.0, x);
 
   /* deal with generic exceptional case +/-0x1.59af9a1194efep-xxx */
   if ((au << 12) == 0x59af9a1194efe000llu)
@@ -326,39 +328,56 @@ static double asinpi_tiny (double x)
   }
 
   /* exceptional case +/-0x1.5cba89af1f855p-1020 */
-  if (au == 0x35cba89af1f855llu)
+  if (au == 0x35cba89af1f855llu) {
+    volatile double tiny = 0x1p-600; // prevents constant folding
     return (x > 0)
-      ? __builtin_fma (0x1p-600, -0x1p-600, 0x1.bc03df34e902cp-1022)
-      : __builtin_fma (0x1p-600, 0x1p-600, -0x1.bc03df34e902cp-1022);
+      ? __builtin_fma (tiny, -0x1p-600, 0x1.bc03df34e902cp-1022)
+      : __builtin_fma (tiny, 0x1p-600, -0x1.bc03df34e902cp-1022);
+  }
+
+  /* For the following exceptional cases with subnormal output, the
+     result is a*b -/+ 2^-1021 with a, b normal, whose exact value lies
+     between the subnormal output and the middle of it and its neighbour,
+     so that in FTZ/DAZ mode it is flushed to a zero of the right sign
+     (with a subnormal addend, DAZ would only keep the sign of a*b). */
 
-  /* exceptional case +/-0x1.5cba89af1f855p-1022 */
+  /* exceptional case +/-0x1.5cba89af1f855p-1022:
+     0x1.37807be69d203p-1021*0x1.0000000000002p+0-2^-1021 is in
+     (0x1.bc03df34e902cp-1024 - 2^-1075, 0x1.bc03df34e902cp-1024) */
   if (au == 0x15cba89af1f855llu) {
 #ifdef CORE_MATH_SUPPORT_ERRNO
     errno = ERANGE; // underflow
 #endif
+    volatile double b = 0x1.0000000000002p+0; // prevents constant folding
     return (x > 0)
-      ? __builtin_fma (-0x1p-600, 0x1p-600, 0x1.bc03df34e902cp-1024)
-      : __builtin_fma (0x1p-600, 0x1p-600, -0x1.bc03df34e902cp-1024);
+      ? __builtin_fma (0x1.37807be69d203p-1021, b, -0x1p-1021)
+      : __builtin_fma (-0x1.37807be69d203p-1021, b, 0x1p-1021);
   }
 
-  /* exceptional case +/-0x1.68e6482549db1p-1022 */
+  /* exceptional case +/-0x1.68e6482549db1p-1022:
+     0x1.39705ebb474d3p-1021*0x1.0000000000003p+0-2^-1021 is in
+     (0x1.cb82f5da3a6b4p-1024, 0x1.cb82f5da3a6b4p-1024 + 2^-1075) */
   if (au == 0x168e6482549db1llu) {
 #ifdef CORE_MATH_SUPPORT_ERRNO
     errno = ERANGE; // underflow
 #endif
+    volatile double b = 0x1.0000000000003p+0; // prevents constant folding
     return (x > 0)
-      ? __builtin_fma (0x1p-600, 0x1p-600, 0x1.cb82f5da3a6b4p-1024)
-      : __builtin_fma (-0x1p-600, 0x1p-600, -0x1.cb82f5da3a6b4p-1024);
+      ? __builtin_fma (0x1.39705ebb474d3p-1021, b, -0x1p-1021)
+      : __builtin_fma (-0x1.39705ebb474d3p-1021, b, 0x1p-1021);
   }
 
-  /* exceptional case 0x1.5cba89af1f855p-1021 */
+  /* exceptional case 0x1.5cba89af1f855p-1021:
+     0x1.6f00f7cd3a408p-1021*0x1.0000000000002p+0-2^-1021 is in
+     (0x1.bc03df34e902cp-1023 - 2^-1075, 0x1.bc03df34e902cp-1023) */
   if (au == 0x25cba89af1f855llu) {
 #ifdef CORE_MATH_SUPPORT_ERRNO
     errno = ERANGE; // underflow
 #endif
+    volatile double b = 0x1.0000000000002p+0; // prevents constant folding
     return (x > 0)
-      ? __builtin_fma (-0x1p-600, 0x1p-600, 0x1.bc03df34e902cp-1023)
-      : __builtin_fma (0x1p-600, 0x1p-600, -0x1.bc03df34e902cp-1023);
+      ? __builtin_fma (0x1.6f00f7cd3a408p-1021, b, -0x1p-1021)
+      : __builtin_fma (-0x1.6f00f7cd3a408p-1021, b, 0x1p-1021);
   }
 
   /* we compute h before scaling, so that h is exactly representable */
@@ -36,6 +36,8 @@ SOFTWARE.
 #include <omp.h>
 #endif
 
+#include "../../generic/support/philox.h"
+
 int ref_init (void);
 int ref_fesetround (int);
 
@@ -47,9 +49,7 @@ int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
 int rnd = 0;
 int verbose = 0;
 
-#define MAX_THREADS 192
-
-static unsigned int Seed[MAX_THREADS];
+static uint64_t Seed;
 
 typedef union {double f; uint64_t u;} b64u64_u;
 
@@ -65,12 +65,10 @@ asuint64 (double f)
 }
 
 static double
-get_random (int tid)
+get_random (philox_t *s)
 {
   b64u64_u v;
-  v.u = rand_r (Seed + tid);
-  v.u |= (uint64_t) rand_r (Seed + tid) << 31;
-  v.u |= (uint64_t) rand_r (Seed + tid) << 62;
+  v.u = philox_u64 (s);
   return v.f;
 }
 
@@ -147,9 +145,7 @@ main (int argc, char *argv[])
 
 #define BUF_SIZE 1000
 
-  long seed = getpid ();
-  for (int i = 0; i < MAX_THREADS; i++)
-    Seed[i] = seed + i;
+  Seed = philox_seed ();
   
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
 #pragma omp parallel for
@@ -158,13 +154,9 @@ main (int argc, char *argv[])
   {
     ref_init ();
     ref_fesetround (rnd);
-    int tid;
-#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
-    tid = omp_get_thread_num ();
-#else
-    tid = 0;
-#endif
-    double x = get_random (tid);
+    philox_t s;
+    philox_init (&s, Seed, n);
+    double x = get_random (&s);
     check (x);
   }
 
@@ -229,7 +229,8 @@ double cr_atan(double x){
   int64_t i = (at>>51) - 2030l; // -2030 <= i <= 2065
   if (__builtin_expect(at < 0x3f7b21c475e6362aull, 0)) {
     // |x| < 0x1.b21c475e6362ap-8
-    if(__builtin_expect(at == 0, 0)) return x; // atan(+/-0) = +/-0
+    // atan(+/-0) = +/-0, x == 0 also holds for subnormal x in DAZ mode
+    if(__builtin_expect(x == 0, 0)) return __builtin_copysign(0.0, x);
     static const double ch2[] = {
       -0x1.5555555555555p-2, 0x1.99999999998c1p-3, -0x1.249249176aecp-3, 0x1.c711fd121ae8p-4};
     if (at<(u64)0x3e40000000000000ull) { // |x| < 0x1p-27
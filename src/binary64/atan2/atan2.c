@@ -231,7 +231,8 @@ atan2_accurate (double y, double x)
       feupdateenv(&env);
       return t;
     }
-    res = (y > 0) ? PI_H + PI_L : -PI_H - PI_L;
+    volatile double pi_l = PI_L; // prevents constant folding
+    res = !__builtin_signbit (y) ? PI_H + pi_l : -PI_H - pi_l;
     goto end;
   }
   double corr = __builtin_fma (t, x, -y);
@@ -355,8 +356,9 @@ atan2_accurate (double y, double x)
     err = 524;
   }
   // now -pi/2 < z < pi/2
-  // if x is negative we go to the opposite quadrant
-  if (x < 0) {
+  /* if x is negative we go to the opposite quadrant (we test the sign
+     bit since a subnormal x compares equal to 0 in DAZ mode) */
+  if (__builtin_signbit (x)) {
     if (z->sgn == 0) { // 1st quadrant -> 3rd quadrant (subtract pi)
       z->sgn = 1;
       add_tint (z, &PI, z);
@@ -409,6 +411,9 @@ static inline double fastsum(double xh, double xl, double yh, double yl, double
 static double __attribute__((noinline)) as_atan2_special(double y0, double x0){
   d64u64 iy = {.f = y0}, ix = {.f = x0};
   u64 aiy = iy.u<<1, aix = ix.u<<1;
+  /* pi_l and pi_over2_l are volatile so that PI_H + PI_L and
+     PI_OVER2_H + PI_OVER2_L are rounded at run time */
+  volatile double pi_l = PI_L, pi_over2_l = PI_OVER2_L;
 
   if (__builtin_expect (aiy >= 0x7ffull<<53 || aix >= 0x7ffull<<53, 0)){ // NaN or Inf
     if (aiy > 0x7ffull<<53 || aix > 0x7ffull<<53)
@@ -416,7 +421,7 @@ static double __attribute__((noinline)) as_atan2_special(double y0, double x0){
       return y0 + x0;
     // Now neither y nor x is NaN, but at least one is +Inf or -Inf
     if (aiy == 0x7ffull<<53 && aix == 0x7ffull<<53){ // both y and x are +/-Inf
-      static const double finf[][2] = {{0x1p-55, 0x1.921fb54442d18p-1}, {0x1p-54, 0x1.2d97c7f3321d2p+1}};
+      static const volatile double finf[][2] = {{0x1p-55, 0x1.921fb54442d18p-1}, {0x1p-54, 0x1.2d97c7f3321d2p+1}};
       // atan2 (+/-Inf,-Inf) = +/-3pi/4
       // atan2 (+/-Inf,+Inf) = +/-pi/4
       return __builtin_copysign(finf[ix.u>>63][1], y0) + __builtin_copysign(finf[ix.u>>63][0], y0);
@@ -424,14 +429,14 @@ static double __attribute__((noinline)) as_atan2_special(double y0, double x0){
     // now only one of y and x is +/-Inf
     if (aix == 0x7ffull<<53) {
       if (x0 < 0)
-        return __builtin_copysign (PI_H,y0) + __builtin_copysign (PI_L,y0);
+        return __builtin_copysign (PI_H,y0) + __builtin_copysign (pi_l,y0);
       // atan2(+/-0,x) = +/-0 for x > 0
       // atan2(+/-y,+Inf) = +/-0 for finite y>0
       return __builtin_copysign (0, y0);
     }
     // now y = +/-Inf
     // atan2(+/-Inf,x) = +/-pi/2 for finite x
-    return __builtin_copysign (PI_OVER2_H,y0) + __builtin_copysign (PI_OVER2_L, y0);
+    return __builtin_copysign (PI_OVER2_H,y0) + __builtin_copysign (pi_over2_l, y0);
   }
 
   if (__builtin_expect (aiy == 0 || aix == 0, 0)){
@@ -439,19 +444,19 @@ static double __attribute__((noinline)) as_atan2_special(double y0, double x0){
       if (ix.u == 0) // atan2(+/-0, +0) = +/-0
         return y0;
       // atan2(+/-0, +0) = +/-pi
-      return (iy.u == 0) ? PI_H + PI_L : -PI_H - PI_L;
+      return (iy.u == 0) ? PI_H + pi_l : -PI_H - pi_l;
     }
     // only one of y and x is zero
     if (aiy==0){
       // atan2(+/-0,x) = +/-0 for x>0
-      if (x0 > 0) return y0/x0;
+      if (!(ix.u>>63)) return y0;
       // atan2(+/-0,x) = +/-pi for x<0
-      return (!(iy.u>>63)) ? PI_H + PI_L : -PI_H - PI_L;
+      return (!(iy.u>>63)) ? PI_H + pi_l : -PI_H - pi_l;
     }
     // now only x is zero
     // atan2(y,+/-0) = -pi/2 for y<0
     // atan2(y,+/-0) = +pi/2 for y>0
-    return (y0 > 0) ? PI_OVER2_H + PI_OVER2_L : -PI_OVER2_H - PI_OVER2_L;
+    return (!(iy.u>>63)) ? PI_OVER2_H + pi_over2_l : -PI_OVER2_H - pi_over2_l;
   }
   return 0;
 }
@@ -526,12 +531,19 @@ double cr_atan2 (double y0, double x0){
   double fl = f2[jt][0]*__builtin_copysign(1,sgn.f);
   fh += O[kw][0];
   fl += O[kw][1];
-  if(__builtin_expect(x<0x1p-968, 0)){x *= 0x1p968; y *= 0x1p968;}
-  if(__builtin_expect(x>0x1p1022, 0)){
-    if(__builtin_expect(jt != 0,1)){
-      x *= 0x1p-1; y *= 0x1p-1;
-    }
+  /* we scale tiny inputs so that the error terms computed with fma below
+     (down to about x*2^-159) do not underflow, which matters in
+     flush-to-zero mode (see src/generic/support/fenv_ftz.h) */
+  if(__builtin_expect(x<0x1p-860, 0)){
+    // in DAZ mode, x = 0 when both inputs are subnormal
+    // then we return atan2(+/-0,+/-0)
+    if(x == 0)
+      return as_atan2_special(__builtin_copysign(0.0, y0), __builtin_copysign(0.0, x0));
+    x *= 0x1p968; y *= 0x1p968;
   }
+  /* we also scale huge inputs, so that zd = t0*y + x does not overflow,
+     and 1/dh below does not underflow */
+  if(__builtin_expect(x>0x1p1000, 0)){x *= 0x1p-64; y *= 0x1p-64;}
   double t0 = T2[jt];
   double zn = __builtin_fma(-t0,x,y), zd = __builtin_fma(t0,y,x);
   double z = zn/zd;
@@ -546,17 +558,9 @@ double cr_atan2 (double y0, double x0){
   double rl = (fl + dz) + z;
   double lb = rh + (rl - eps), ub = rh + (rl + eps);
   if(lb!=ub){
-    double dh = y*t0, dl = __builtin_fma(y,t0,-dh), e, rdh;
+    double dh = y*t0, dl = __builtin_fma(y,t0,-dh), e;
     dh = fasttwosum(x, dh, &e);
-    // avoid spurious underflow in 1/dh
-    if (__builtin_expect (__builtin_fabs (dh) <= 0x1p1022, 1))
-      rdh = 1/dh;
-    else {
-      fexcept_t flag;
-      fegetexceptflag (&flag, FE_UNDERFLOW);
-      rdh = 1/dh;
-      fesetexceptflag (&flag, FE_UNDERFLOW);
-    }
+    double rdh = 1/dh;
     dl += e;
     double nh = x*t0, nl = __builtin_fma(x,t0,-nh);
     double dt = y-nh, y1 = dt+nh;
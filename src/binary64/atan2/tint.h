@@ -391,12 +391,13 @@ tint_tod (const tint_t *a, uint64_t err, double y, double x)
     return a->sgn ? -0x1p1023 - 0x1p1023 : 0x1p1023 + 0x1p1023;
   if (a->ex <= -1074) // underflow: |a| < 2^-1074
   {
+    volatile double tiny = a->sgn ? -0x1p-1074 : 0x1p-1074; // prevents constant folding
     if (a->ex < -1074) // |a| < 2^-1075
-      return (a->sgn ? -0x1p-1074 : 0x1p-1074) * 0.5;
+      return tiny * 0.5;
     // 2^-1075 <= |a| < 2^-1074
     int mid = a->h == (1ull << 63) && a->m == 0 && a->l == 0;
     // if mid, |a| = 2^-1075
-    return (a->sgn ? -0x1p-1074 : 0x1p-1074) * (mid ? 0.5 : 0.75);
+    return tiny * (mid ? 0.5 : 0.75);
   }
 #define MASK53 0x1ffffffffffffful
   uint64_t hh = a->h, mm = a->m, ll = a->l;
@@ -453,14 +454,15 @@ tint_tod (const tint_t *a, uint64_t err, double y, double x)
 static inline void inv_tint (tint_t *r, const tint_t *A)
 {
   tint_t q[1];
-  double a = tint_tod (A, 0, 0, 0); // exact
-  // To simplify the error analysis, we assume 0.5 <= a < 1
-  int subnormal = __builtin_fabs (a) < 0x1p-1022;
-  if (subnormal)
-    a *= 0x1p53;
+  /* To simplify the error analysis, we assume 0.5 <= a < 1: we compute
+     the double approximation from A scaled to this range, so that 1/a
+     neither underflows (which would give 0 in flush-to-zero mode) nor
+     is a subnormal with less than 53 bits. */
+  cp_tint (q, A);
+  q->ex = 0;
+  double a = tint_tod (q, 0, 0, 0); // exact
   tint_fromd (r, 1.0 / a); // accurate to about 53 bits
-  if (subnormal)
-    r->ex += 53;
+  r->ex -= A->ex;
   /* We have 1 <= r <= 2, with |r - 1/a| < ulp(r) = 2^-52. */
   /* We use Newton's iteration: r1 = r0 + r0*(1-a*r0).
      Let e0 = 1-a*r0 and e1 = 1-a*r1 then we have e1 = e0^2.
@@ -233,10 +233,11 @@ atan2pi_accurate (double y, double x)
        |y| > |x|, thus ey = ex, and the test below never holds. */
     if (ey - ex > 54) // |y/x| > 2^54
     {
+      volatile double half = 0.5; // prevents constant folding
       if (x > 0)
-        return (y > 0) ? 0.5 - 0x1p-55 : -0.5 + 0x1p-55;
+        return (y > 0) ? half - 0x1p-55 : -half + 0x1p-55;
       else
-        return (y > 0) ? 0.5 + 0x1p-54 : -0.5 - 0x1p-54;
+        return (y > 0) ? half + 0x1p-54 : -half - 0x1p-54;
     }
     // atan2pi_end
     div_tint_d (z, x, y);
@@ -257,7 +258,10 @@ atan2pi_accurate (double y, double x)
          If x is subnormal, then y is subnormal too since we are in the case
          |x| >= |y|, thus ex = ey, and the test below never holds. */
       if (ey - ex < -54) // |y/x| < 2^-54
-        return (y > 0) ? 1.0 - 0x1p-54 : -1.0 + 0x1p-54;
+      {
+        volatile double one = 1.0; // prevents constant folding
+        return (y > 0) ? one - 0x1p-54 : -one + 0x1p-54;
+      }
     }
     // atan2pi_end
     div_tint_d (z, y, x);
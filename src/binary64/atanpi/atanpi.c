@@ -354,15 +354,22 @@ static double
 atanpi_small (double x)
 {
   double h;
+  /* x == 0 also holds for subnormal x in DAZ mode (see
+     src/generic/support/fenv_ftz.h), where we return zero */
   if (x == 0)
-    return x;
+    return __builtin_copysign (0.0, x);
   if (__builtin_fabs (x) == 0x1.5cba89af1f855p-1022) {
 #ifdef CORE_MATH_SUPPORT_ERRNO
     errno = ERANGE; // underflow
 #endif
+    /* 0x1.37807be69d203p-1021*0x1.0000000000002p+0-2^-1021 is in
+       (0x1.bc03df34e902cp-1024 - 2^-1075, 0x1.bc03df34e902cp-1024): with
+       normal operands only, the result is flushed to a zero of the right
+       sign in FTZ/DAZ mode (see src/generic/support/fenv_ftz.h) */
+    volatile double b = 0x1.0000000000002p+0; // prevents constant folding
     return (x > 0)
-      ? __builtin_fma (-0x1p-600, 0x1p-600, 0x1.bc03df34e902cp-1024)
-      :__builtin_fma (0x1p-600, 0x1p-600, -0x1.bc03df34e902cp-1024);
+      ? __builtin_fma (0x1.37807be69d203p-1021, b, -0x1p-1021)
+      : __builtin_fma (-0x1.37807be69d203p-1021, b, 0x1p-1021);
   }
   // generic worst case
   b64u64_u v = {.f = x};
@@ -0,0 +1,376 @@
+/* Generate special cases for cart2pol testing.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fenv.h>
+#include <mpfr.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+#include <math.h>
+
+#include "../../generic/support/philox.h"
+
+extern void cr_cart2pol (double, double, double *, double *);
+extern void cr_cart2pol_n (const double *, const double *, double *, double *, size_t);
+extern int ref_fesetround (int);
+extern void ref_init (void);
+extern void ref_cart2pol (double, double, double *, double *);
+
+int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
+
+int rnd;
+int verbose = 0;
+
+static uint64_t Seed;
+
+typedef union {double f; uint64_t u;} b64u64_u;
+
+static double
+get_random (philox_t *s)
+{
+  b64u64_u v;
+  v.u = philox_u64 (s);
+  return v.f;
+}
+
+static inline uint64_t
+asuint64 (double f)
+{
+  b64u64_u u = {.f = f};
+  return u.u;
+}
+
+/* define our own is_nan function to avoid depending from math.h */
+static inline int
+is_nan (double x)
+{
+  uint64_t u = asuint64 (x);
+  int e = u >> 52;
+  return (e == 0x7ff || e == 0xfff) && (u << 12) != 0;
+}
+
+static inline int
+is_equal (double x, double y)
+{
+  if (is_nan (x))
+    return is_nan (y);
+  if (is_nan (y))
+    return is_nan (x);
+  return asuint64 (x) == asuint64 (y);
+}
+
+// compare (r,theta) given by cr_cart2pol for (x,y) with the reference (r1,t1)
+static void
+check_result (double x, double y, double r, double theta, double r1, double t1)
+{
+  if (!is_equal (r, r1) || !is_equal (theta, t1))
+  {
+    printf ("cr_cart2pol and ref_cart2pol differ for x=%la y=%la\n", x, y);
+    printf ("cr_cart2pol  gives r=%la theta=%la\n", r, theta);
+    printf ("ref_cart2pol gives r=%la theta=%la\n", r1, t1);
+    exit (1);
+  }
+}
+
+static void
+check_aux (double x, double y)
+{
+  double r, theta, r1, t1;
+  ref_cart2pol (x, y, &r1, &t1);
+  cr_cart2pol (x, y, &r, &theta);
+  check_result (x, y, r, theta, r1, t1);
+}
+
+void
+check (double x, double y)
+{
+  check_aux (x, y);
+  check_aux (x, -y);
+  check_aux (-x, y);
+  check_aux (-x, -y);
+  check_aux (y, x);
+  check_aux (y, -x);
+  check_aux (-y, x);
+  check_aux (-y, -x);
+}
+
+#ifndef CORE_MATH_TESTS
+#define CORE_MATH_TESTS 100000000ul // total number of tests
+#endif
+
+#define BATCH 1000
+
+/* check random values with the batch version: if close is non-zero, the
+   exponents of x and y differ by less than 32 */
+static void
+check_random (int close)
+{
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t n = 0; n < CORE_MATH_TESTS / BATCH; n++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround(rnd1[rnd]);
+    double x[BATCH], y[BATCH], r[BATCH], theta[BATCH];
+    philox_t s;
+    // the batches with close exponents use other counters
+    philox_init (&s, Seed, 2 * n + close);
+    for (int j = 0; j < BATCH; j++)
+    {
+      x[j] = get_random (&s);
+      y[j] = get_random (&s);
+      if (close && !is_nan (x[j]) && !is_nan (y[j]))
+      {
+        int e;
+        y[j] = frexp (y[j], &e);
+        frexp (x[j], &e);
+        y[j] = ldexp (y[j], e - (int) (philox_u64 (&s) % 32));
+      }
+    }
+    cr_cart2pol_n (x, y, r, theta, BATCH);
+    for (int j = 0; j < BATCH; j++)
+    {
+      double r1, t1;
+      ref_cart2pol (x[j], y[j], &r1, &t1);
+      check_result (x[j], y[j], r[j], theta[j], r1, t1);
+    }
+  }
+}
+
+/* check values near (x,y), with k numbers on each side for each variable,
+   for x = 2^ex, y = 2^ey and -k0 <= ex, ey <= k0 */
+static void
+check_near_power_two (int k, int k0)
+{
+  double min, max;
+  min = max = 1.0;
+  for (int i = 0; i < k; i++)
+  {
+    min = nextafter (min, 0.5);
+    max = nextafter (max, 2.0);
+  }
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int ex = -k0; ex <= k0; ex++)
+  {
+    // since emin,emax are thread-local, we need to initialize them here
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround(rnd1[rnd]);
+    // since "check" also checks y,x, we only test for ey <= ex
+    for (int ey = -k0; ey <= ex; ey++)
+    {
+      double x, y;
+      for (x = min; x <= max; x = nextafter (x, 2.0))
+        for (y = min; y <= max; y = nextafter (y, 2.0))
+          check (ldexp (x, ex), ldexp (y, ey));
+    }
+  }
+}
+
+/* check values in the subnormal, overflow and large exponent difference
+   ranges */
+static void
+check_extreme (void)
+{
+  static const double x0[] = {0x1p-1074, 0x1.fffffffffffffp+1023,
+                              0x1.fffffffffffffp+1023, 0x1p-1022};
+  static const double y0[] = {0x1p-1074, 0x1p-1074,
+                              0x1.fffffffffffffp+1023, 0x1p-1049};
+#define N 300
+  for (int k = 0; k < 4; k++)
+  {
+    double y = y0[k];
+    for (int i = 0; i < N; i++)
+    {
+      double x = x0[k];
+      for (int j = 0; j < N; j++)
+      {
+        check (x, y);
+        x = (x0[k] < 1) ? nextafter (x, 2 * x) : nextafter (x, 0.5 * x);
+      }
+      y = (y0[k] < 1) ? nextafter (y, 2 * y) : nextafter (y, 0.5 * y);
+    }
+  }
+#undef N
+}
+
+/* return y' such that sqrt(x^2+y'^2) is closest to the 54-bit number
+   closest to sqrt(x^2+y^2) */
+static double y_worst (double x, double y)
+{
+  mpfr_t X, Y, Z;
+  mpfr_init2 (X, 192);
+  mpfr_init2 (Y, 192);
+  mpfr_init2 (Z, 54);
+  mpfr_set_d (X, x, MPFR_RNDN);
+  mpfr_sqr (X, X, MPFR_RNDN);
+  mpfr_set_d (Y, y, MPFR_RNDN);
+  mpfr_sqr (Y, Y, MPFR_RNDN);
+  mpfr_add (Y, X, Y, MPFR_RNDN);
+  mpfr_sqrt (Z, Y, MPFR_RNDN);
+  mpfr_prec_round (Z, 192, MPFR_RNDN);
+  mpfr_sqr (Z, Z, MPFR_RNDN); // square Z
+  mpfr_sub (Z, Z, X, MPFR_RNDN); // subtract X
+  mpfr_sqrt (Z, Z, MPFR_RNDN);
+  y = mpfr_get_d (Z, MPFR_RNDN);
+  mpfr_clear (X);
+  mpfr_clear (Y);
+  mpfr_clear (Z);
+  return y;
+}
+
+// check hard cases of hypot with exp(y) = exp(x) - m
+static void
+check_worst (int m)
+{
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < 1000; i++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround(rnd1[rnd]);
+    philox_t s;
+    // the counters m*2^32+i are not used by check_random
+    philox_init (&s, Seed, ((uint64_t) m << 32) + i);
+    int e;
+    double x = frexp (fabs (get_random (&s)), &e); // 1/2 <= x < 1
+    double y = ldexp (frexp (get_random (&s), &e), -m);
+    check (x, y_worst (x, y));
+  }
+}
+
+/* check k random Pythagorean triples (x,y,z) with x, y > 0: hypot(x,y) = z
+   is exact, but atan2(y,x) is not, thus the inexact flag should be set */
+static void
+check_triples (int k)
+{
+  philox_t s;
+  // a single stream, with a counter not used by check_random and check_worst
+  philox_init (&s, Seed, UINT64_C(1) << 63);
+  while (k--) {
+    // if p,q < 2^(53/2) then x and y are exactly representable
+#define MAXP 0x5a82799l // floor(2^(53/2))
+    int64_t p = 1 + philox_u64 (&s) % MAXP, q = 1 + philox_u64 (&s) % MAXP;
+    if (p == q)
+      continue;
+    double x = fabs ((double) (p * p - q * q)), y = 2.0 * (double) (p * q);
+    check (x, y);
+    double r, theta;
+    feclearexcept (FE_INEXACT);
+    cr_cart2pol (x, y, &r, &theta);
+    if (!fetestexcept (FE_INEXACT))
+    {
+      printf ("Missing inexact exception for x=%la y=%la\n", x, y);
+      exit (1);
+    }
+  }
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--rndn") == 0)
+        {
+          rnd = 0;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndz") == 0)
+        {
+          rnd = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndu") == 0)
+        {
+          rnd = 2;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndd") == 0)
+        {
+          rnd = 3;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--verbose") == 0)
+        {
+          verbose = 1;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  ref_init ();
+  ref_fesetround (rnd);
+  fesetround(rnd1[rnd]);
+
+  Seed = philox_seed ();
+
+  printf ("Checking special values\n");
+  static const double s[] = {0.0, 0x1p-1074, 0x1p-1022, 1.0, 0x1.fffffffffffffp+1023,
+                             INFINITY, NAN};
+  for (unsigned i = 0; i < sizeof (s) / sizeof (s[0]); i++)
+    for (unsigned j = 0; j < sizeof (s) / sizeof (s[0]); j++)
+      check (s[i], s[j]);
+
+  printf ("Checking Pythagorean triples\n");
+  check_triples (100000);
+
+  printf ("Checking values near 2^e\n");
+  check_near_power_two (2, 60);
+
+  printf ("Checking worst cases of hypot with exp(y) = exp(x) - m\n");
+  for (int m = 1; m <= 27; m++)
+    check_worst (m);
+
+  printf ("Checking in subnormal and overflow ranges\n");
+  check_extreme ();
+
+  printf ("Checking random values with close exponents\n");
+  check_random (1);
+
+  printf ("Checking random values\n");
+  check_random (0);
+  return 0;
+}
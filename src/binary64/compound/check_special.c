@@ -0,0 +1,255 @@
+/* Additional tests for the binary64 compound function.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fenv.h>
+#include <math.h>
+#include <mpfr.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+#include <unistd.h>
+
+#include "../../generic/support/philox.h"
+
+extern double cr_compound (double, double);
+extern int ref_fesetround (int);
+extern void ref_init (void);
+extern mpfr_rnd_t rnd2[];
+extern double ref_compound (double, double);
+
+int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
+
+int rnd;
+int verbose = 0;
+
+static uint64_t Seed;
+
+typedef union {double f; uint64_t u;} b64u64_u;
+
+static inline uint64_t
+asuint64 (double f)
+{
+  b64u64_u u = {.f = f};
+  return u.u;
+}
+
+/* define our own is_nan function to avoid depending from math.h */
+static inline int
+is_nan (double x)
+{
+  uint64_t u = asuint64 (x);
+  int e = u >> 52;
+  return (e == 0x7ff || e == 0xfff) && (u << 12) != 0;
+}
+
+static inline int
+is_equal (double x, double y)
+{
+  if (is_nan (x))
+    return is_nan (y);
+  if (is_nan (y))
+    return is_nan (x);
+  return asuint64 (x) == asuint64 (y);
+}
+
+static void
+check (double x, double y)
+{
+  double z, t;
+  z = cr_compound (x, y);
+  t = ref_compound (x, y);
+  if (!is_equal (z, t))
+  {
+    printf ("cr_compound and ref_compound differ for x=%la y=%la\n", x, y);
+    printf ("cr_compound  gives %la\n", z);
+    printf ("ref_compound gives %la\n", t);
+    exit (1);
+  }
+}
+
+#ifndef CORE_MATH_TESTS
+#define CORE_MATH_TESTS 100000000ul // total number of tests
+#endif
+
+/* Random x > -1 and y, where one test out of two uses |x| < 2^-d and
+   |y| about 2^d (interest rates and numbers of periods), the other
+   random binary64 values. */
+static void
+check_random (void)
+{
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t i = 0; i < CORE_MATH_TESTS; i++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround(rnd1[rnd]);
+    philox_t s;
+    philox_init (&s, Seed, i);
+    uint64_t u = philox_u64 (&s);
+    uint64_t v = philox_u64 (&s);
+    b64u64_u x = {.u = u}, y = {.u = v};
+    if (i & 1) {
+      int d = v % 60;
+      x.f = ldexp ((double) (int64_t) (u >> 11) * 0x1p-52 - 1.0, -d);
+      y.f = (v & 64) ? (double) ((int64_t) (v >> 12) % (4ll << d))
+        : ldexp ((double) (int64_t) (v >> 11) * 0x1p-52 - 1.0, d);
+    }
+    if (x.f < -1.0)
+      x.f = -1.0 / x.f - 1.0;
+    check (x.f, y.f);
+  }
+}
+
+/* Check exact and midpoint values: 1+x = t^(2^q) with t = c + m*2^-k,
+   c = 0 or 1, m odd and 1 <= q <= 5, when x is a binary64 number (often
+   1+x is not), and y = p/2^q with p odd and 0 < y < 1, together with the
+   neighbours of x. */
+static void
+check_exact_or_midpoint (void)
+{
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int k = 1; k <= 60; k++)
+  {
+    ref_init();
+    ref_fesetround(rnd);
+    fesetround(rnd1[rnd]);
+    mpfr_t t;
+    mpfr_init2 (t, 4096);
+    for (int q = 1; q <= 5; q++)
+      for (int64_t m = 1; m < 256; m += 2)
+        for (int c = 0; c <= 1; c++)
+        {
+          mpfr_set_si_2exp (t, m, -k, MPFR_RNDN);
+          mpfr_add_ui (t, t, c, MPFR_RNDN);
+          for (int i = 0; i < q; i++)
+            mpfr_sqr (t, t, MPFR_RNDN); // exact
+          mpfr_sub_ui (t, t, 1, MPFR_RNDN); // exact
+          double x = mpfr_get_d (t, MPFR_RNDN);
+          if (mpfr_cmp_d (t, x) != 0 || x <= -1.0 || isinf (x))
+            continue;
+          for (int p = 1; p < (1 << q); p += 2)
+          {
+            double y = ldexp ((double) p, -q);
+            check (x, y);
+            check (nextafter (x, -1.0), y);
+            check (nextafter (x, INFINITY), y);
+          }
+        }
+    mpfr_clear (t);
+  }
+}
+
+/* Check near-exact values: 1+x = h+l where h^y is exact or a midpoint and
+   |l/h| is tiny, for example 1+x = 2^e+1 or 1+x = 3+2^-k. */
+static void
+check_near_exact (void)
+{
+  static const double Y[] = {2, 3, 7, 33, 34, -1, -2, -3, -10, 0.5, 0.75,
+                             0.375, 0.03125, 1.5, 2.5, -0.5, -0.25};
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int e = 54; e <= 1023; e++)
+  {
+    ref_init();
+    ref_fesetround(rnd);
+    fesetround(rnd1[rnd]);
+    double x = ldexp (1.0, e);
+    for (unsigned i = 0; i < sizeof (Y) / sizeof (Y[0]); i++)
+    {
+      check (x, Y[i]);
+      check (nextafter (x, 0), Y[i]);
+      check (3.0 * x, Y[i]);
+      check (2.0 + ldexp (1.0, -e), Y[i]);
+      check (2.0 - ldexp (1.0, -e), Y[i]);
+      check (-0.5 + ldexp (1.0, -e), Y[i]);
+    }
+  }
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--rndn") == 0)
+        {
+          rnd = 0;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndz") == 0)
+        {
+          rnd = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndu") == 0)
+        {
+          rnd = 2;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndd") == 0)
+        {
+          rnd = 3;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--verbose") == 0)
+        {
+          verbose = 1;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  printf ("Checking exact/midpoint values\n");
+  check_exact_or_midpoint ();
+
+  printf ("Checking near-exact values\n");
+  check_near_exact ();
+
+  Seed = philox_seed ();
+
+  printf ("Checking random values\n");
+  check_random ();
+
+  return 0;
+}
@@ -0,0 +1,829 @@
+/* Correctly-rounded compound function for two binary64 values.
+
+Copyright (c) 2022-2025 CERN and Inria
+Authors: Tom Hubrecht and Paul Zimmermann
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* cr_compound(x,y) computes (1+x)^y, as the compound function from IEEE
+   754-2019 (which defines it for integer y only) and cr_compoundf() from
+   ../../binary32/compound/compoundf.c, for any binary64 value y.
+
+   It reuses the three phases of cr_pow() from ../pow/pow.c (shared through
+   ../pow/pow_engine.h, with is_exact() and exact_pow()), with 1+x = h+l
+   written exactly as the sum of two binary64 numbers, thus avoiding the
+   extra rounding of pow(1+x,y):
+   - if y is an integer with |y| <= 64, (h+l)^y is computed by binary
+     exponentiation in double-double arithmetic, as in ../pown/pown.c;
+   - otherwise log(1+x) is computed as x - x^2/2 + ... - x^6/6 for
+     |x| < 2^-12, and as log(h) + log(1+l/h) with the log_1() routine of
+     cr_pow() otherwise, followed by exp_1();
+   - the accurate phases use log(1+x) = log(h) + log(1+l/h) with the
+     log_2()/log_3() and exp_2()/exp_3() routines of cr_pow(), where
+     log(1+l/h) is evaluated by a short series since |l/h| < 2^-52.
+   The exact and midpoint cases are detected by is_exact() and exact_pow()
+   from cr_pow() when 1+x is a binary64 number (l = 0), and by
+   compound_exact() otherwise. */
+
+/* References:
+   [1] Note on FastTwoSum with Directed Rounding, Paul Zimmermann,
+       https://hal.inria.fr/hal-03798376/, 2022.
+   [2] An efficient rounding boundary test for pow(x,y) in double precision,
+       Christoph Lauter, Vincent Lefèvre,
+       https://hal-ens-lyon.archives-ouvertes.fr/ensl-00169409, 2007.
+   [3] Arrondi correct de fonctions mathématiques, Fonctions univariées et
+       bivariées, certification et automatisation, Christoph Quirin Lauter,
+       PhD thesis, 2008, in french,
+       http://www.ens-lyon.fr/LIP/Pub/Rapports/PhD/PhD2008/PhD2008-07.pdf
+   [4] An efficient rounding boundary test for pow(x,y) in double precision,
+       Christoph Lauter, Vincent Lefèvre, IEEE Transactions on Computers,
+       volume 58, number 2, 197-207, 2009.
+   [5] Towards a correctly-rounded and fast power function in binary64
+       arithmetic, Tom Hubrecht, Claude-Pierre Jeannerod, Paul Zimmermann,
+       ARITH 2023 - 30th IEEE Symposium on Computer Arithmetic, 2023.
+       Detailed version (with full proofs) available at
+       https://inria.hal.science/hal-04159652.
+   [6] On Ziv's rounding test, F. De Dinechin, C. Lauter, J.-M. Muller,
+       S. Torres, ACM Trans. Math. Soft., volume 39, number 3, 2013.
+
+   The routines from ../pow/pow_engine.h correspond to reference [5].
+*/
+
+#include <stdio.h> // needed in case of rounding-test failure
+#include <stdint.h>
+#include <stdlib.h> // for exit
+#include <errno.h>
+#include <fenv.h> // for fegetround, FE_TONEAREST, FE_DOWNWARD, FE_UPWARD, ...
+#include <math.h> // needed to define compound since it is not in glibc
+
+double cr_compound (double x, double y);
+
+// Warning: clang also defines __GNUC__
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#endif
+
+#pragma STDC FENV_ACCESS ON
+
+/* the three phases of cr_pow() and the detection of its exact cases */
+#include "../pow/pow_engine.h"
+
+/************************* compound-specific code ****************************/
+
+/* Write 1+x = h+l exactly, for -1 < x < +Inf, with |l| < ulp(h) and h the
+   rounding of 1+x in the current rounding mode for 2^-53 <= |x| < 2^53.
+   Thus l = 0 if and only if 1+x is a binary64 number. */
+static inline void
+one_plus (double *h, double *l, double x)
+{
+  double ax = __builtin_fabs (x);
+  if (__builtin_expect (ax < 0x1p-53, 0)) {
+    *h = 1.0;
+    *l = x;
+  }
+  else if (ax <= 1.0)
+    fast_two_sum (h, l, 1.0, x); // exact since the exponent difference is <= 53
+  else if (__builtin_expect (ax < 0x1p53, 1))
+    fast_two_sum (h, l, x, 1.0); // idem
+  else {
+    *h = x;
+    *l = 1.0;
+  }
+}
+
+/* Put in h+l an approximation of log(1+x) for 0 < |x| < 2^-12, such that
+
+   | h + l - log(1+x) | < 2^-74 * |log(1+x)|
+
+   and |l| < 2^-25 |h|. We use log(1+x) = x - x^2/2 + x^3/3 - ...:
+   for |x| < 2^-60 the terms of degree >= 3 are less than 2^-121 relative to
+   log(1+x), and we avoid a spurious underflow in x^2 for |x| < 2^-500;
+   otherwise the terms of degree >= 7 are less than 2^-74.8 relative to
+   log(1+x), and those of degree 3 to 6 are evaluated in double precision
+   with a relative error less than 2^-50, which gives 2^-75.5 relative
+   to log(1+x). */
+static inline void
+log1p_tiny (double *h, double *l, double x)
+{
+  double ax = __builtin_fabs (x);
+  if (__builtin_expect (ax < 0x1p-60, 0)) {
+    *h = x;
+    *l = (ax < 0x1p-500) ? 0 : -0.5 * (x * x);
+    return;
+  }
+  double x2h, x2l;
+  a_mul (&x2h, &x2l, x, x);
+  static const double c[] = {0x1.5555555555555p-2, -0x1p-2,
+                             0x1.999999999999ap-3, -0x1.5555555555555p-3};
+  double p = __builtin_fma (x, c[3], c[2]);
+  p = __builtin_fma (x, p, c[1]);
+  p = __builtin_fma (x, p, c[0]);
+  p *= x2h * x;
+  fast_two_sum (h, l, x, -0.5 * x2h); // |x| > x^2/2
+  *l += __builtin_fma (-0.5, x2l, p);
+}
+
+/* Put in h+l an approximation of (h+l)^2, with relative error less than
+   5*2^-104, and |l| <= ulp(h), assuming |l| <= ulp(h) on input
+   (see d_sqr() in ../pown/pown.c). */
+static inline void
+d_sqr (double *h, double *l)
+{
+  double hi = *h * *h;
+  double e = __builtin_fma (*h, *h, -hi); // exact
+  double lo = __builtin_fma (*h + *h, *l, e);
+  *h = hi + lo;
+  *l = lo - (*h - hi);
+}
+
+/* Put in h+l an approximation of (h+l)*(bh+bl), with relative error less
+   than 5*2^-104, and |l| <= ulp(h), assuming |l| <= ulp(h) and
+   |bl| <= ulp(bh) on input. */
+static inline void
+d_mul2 (double *h, double *l, double bh, double bl)
+{
+  double hi = *h * bh;
+  double e = __builtin_fma (*h, bh, -hi); // exact
+  double lo = __builtin_fma (*h, bl, __builtin_fma (*l, bh, e));
+  *h = hi + lo;
+  *l = lo - (*h - hi);
+}
+
+/* Fast path for y integer with 2 <= |y| <= 64: if the rounding of
+   (1+x)^y = (h+l)^y can be decided, put it in r and return 1, otherwise
+   return 0. The power is computed by left-to-right binary exponentiation
+   in double-double arithmetic, as in ../pown/pown.c, with relative error
+   less than |y|*2^-100, and less than (|y|+1)*2^-100 after the final
+   division for y < 0. */
+static inline int
+compound_int (double *r, double h, double l, double y)
+{
+  int64_t n = y;
+  uint64_t N = (n < 0) ? -n : n;
+  /* 2^e <= h < 2^(e+1), thus |log2(h)| <= |e|+1; if (|e|+1)*N <= 900,
+     all the powers (h+l)^k with k <= N, and their inverses, are in
+     [2^-901, 2^901], thus the low parts below (of relative size about
+     2^-104) and the error term err*ph stay in the normal range */
+  f64_u v = {.f = h};
+  int64_t e = ((v.u >> 52) & 0x7ff) - 0x3ff;
+  if (__builtin_expect (((e < 0) ? 1 - e : e + 1) * (int64_t) N > 900, 0))
+    return 0;
+  double ph = h, pl = l;
+  int i = 63 - __builtin_clzll (N);
+  while (i--) {
+    d_sqr (&ph, &pl);
+    if ((N >> i) & 1)
+      d_mul2 (&ph, &pl, h, l);
+  }
+  /* If 1+x is a binary64 number and all operations were exact, (1+x)^y
+     might be exact, which the rounding test cannot decide (and we should
+     not raise inexact): this is dealt with by the general path. */
+  if (__builtin_expect (l == 0 && pl == 0, 0))
+    return 0;
+  if (n < 0) {
+    /* 1/(ph+pl) with an additional relative error less than 2^-101
+       (see ../pown/pown.c) */
+    double rh = 1.0 / ph;
+    double eps = __builtin_fma (-rh, ph, 1.0);
+    pl = rh * __builtin_fma (-rh, pl, eps);
+    ph = rh;
+  }
+  /* we use the error bound (N+1)*2^-99 to account for second-order terms */
+  double err = ((double) N + 1.0) * 0x1p-99;
+  double res_min = ph + __builtin_fma (err, -ph, pl);
+  double res_max = ph + __builtin_fma (err, ph, pl);
+  *r = res_max;
+  return res_min == res_max;
+}
+
+/* Limbs of the integers in compound_exact(): the odd part of 1+x, which lies
+   in [2^-1074, 2^1024], has at most 2099 bits. */
+#define NLIMBS 34
+
+/* Put in r[0..2n-1] the square of a[0..n-1]. */
+static void
+sqr_limbs (uint64_t *r, const uint64_t *a, int n)
+{
+  for (int i = 0; i < 2 * n; i++)
+    r[i] = 0;
+  for (int i = 0; i < n; i++) {
+    u128 c = 0;
+    for (int j = 0; j < n; j++) {
+      c += (u128) a[i] * a[j] + r[i + j]; // < 2^128
+      r[i + j] = c;
+      c >>= 64;
+    }
+    r[i + n] = c;
+  }
+}
+
+/* Exact and midpoint cases when 1+x is not a binary64 number.
+
+   Write 1+x = 2^E*M with M odd, and let y = p/2^q with p odd. If 1+x is not
+   a binary64 number, then M >= 2^53, and (1+x)^y can be exact or the middle
+   of two consecutive binary64 numbers only when q >= 1 and 0 < y < 1
+   (if y is an integer or y < 0, (1+x)^y would have more than 54 bits;
+   if y > 1, M^y > M^(1+1/2^q) would have more than 54 bits too).
+   Then w = (1+x)^(1/2^q) is an integer multiple of a power of 2, say
+   w = 2^f*m with m odd, such that m^(2^q) = M and m^p has at most 54 bits,
+   which implies q <= 5. Note that w is not always a binary64 number: for
+   x = 2^108-2^55, 1+x = (2^54-1)^2 and (1+x)^(1/2) is a midpoint.
+
+   Given lh+ll an approximation of log(1+x) with relative error less than
+   2^-66, we compute the number t nearest to exp((lh+ll)/2^q) with at most
+   55 significant bits, and check exactly whether t^(2^q) = 1+x. If so, and
+   if t^p fits in 54 bits, we put in r the rounding of (1+x)^y = t^p,
+   restore the inexact flag (unless (1+x)^y is a midpoint), and return 1.
+   Otherwise we return 0.
+   Here y = 2^F*p with the low 42 bits of the encoding of y equal to zero,
+   and 0 < y < 1. */
+static __attribute__((noinline)) int
+compound_exact (double *r, double x, double y, double lh, double ll,
+                FLAG_T flag)
+{
+  int64_t F;
+  uint64_t p;
+  extract (&F, &p, y); // y = 2^F*p with p odd
+  if (F < -5)
+    return 0;
+  unsigned q = -F;
+
+  double c = 0x1p0;
+  pow2 (&c, F);
+  /* since -36.8 < lh+ll < 709.79, the error on (lh+ll)/2^q is less than
+     709.79*2^-66/2 < 2^-57.5, thus exp_1() returns an approximation wh+wl
+     of w = exp((lh+ll)/2^q) with relative error less than 2^-57.4 */
+  double wh, wl;
+  exp_1 (&wh, &wl, lh * c, ll * c, 1.0);
+  /* Write wh = mw*2^(ew-52) with 2^52 <= mw < 2^53. If w has at most
+     54 bits, it is an integer multiple of 2^(ew-54) since w >= 2^(ew-1),
+     and the error on wh+wl is less than 2^-57.4*2^(ew+1) < 2^-2.4
+     units 2^(ew-54), thus mt*2^(ew-54) below is then exactly w (the
+     truncation of c55 +/- 0.5 rounds c55 = wl*2^(54-ew) to the nearest
+     integer, up to the rounding of the addition, which might only matter
+     when w is not of the above form). */
+  f64_u v = {.f = wh};
+  int64_t ew = ((v.u >> 52) & 0x7ff) - 0x3ff;
+  uint64_t mw = (v.u & 0xfffffffffffffull) | (1ull << 52);
+  double c55 = wl;
+  pow2 (&c55, 54 - ew); // exact since wh >= 2^-37 and |c55| <= 4
+  int64_t mt = 4 * mw + (int64_t) (c55 + ((c55 >= 0) ? 0.5 : -0.5));
+  int64_t et = ew - 54, k = __builtin_ctzll (mt);
+  mt >>= k;
+  et += k;
+
+  // t = 2^et*mt, 1+x = h+l = 2^eh*mh + 2^el*ml with mt, mh, ml odd
+  double h, l;
+  one_plus (&h, &l, x);
+  int64_t eh, el;
+  uint64_t mh, ml;
+  extract (&eh, &mh, h);
+  extract (&el, &ml, l);
+  /* since |l| < ulp(h), we have el < eh, thus 1+x = 2^el*M with
+     M = mh*2^(eh-el) +/- ml odd: t^(2^q) = 1+x requires et*2^q = el */
+  if (et * (1 << q) != el)
+    return 0;
+
+  // check mt^(2^q) = M mod 2^64
+  uint64_t d_e = eh - el, s = mt;
+  for (unsigned i = 0; i < q; i++)
+    s *= s;
+  uint64_t M0 = (d_e < 64) ? mh << d_e : 0;
+  M0 = (l > 0) ? M0 + ml : M0 - ml;
+  if (s != M0)
+    return 0;
+
+  // full check, with eh-el <= 1023+1074 thus M < 2^2151
+  uint64_t M[NLIMBS] = {0}, A[2 * NLIMBS], B[2 * NLIMBS];
+  int n = d_e / 64, na = 1;
+  M[n] = mh << (d_e % 64);
+  if (d_e % 64 > 11)
+    M[++n] = mh >> (64 - d_e % 64);
+  n++; // M has n limbs
+  if (l > 0) {
+    int i = 0;
+    M[0] += ml;
+    while (M[i] < ml && i + 1 < n) { // propagate the carry
+      ml = 1;
+      M[++i] += 1;
+    }
+  }
+  else {
+    int i = 0;
+    uint64_t b = M[0] < ml;
+    M[0] -= ml;
+    while (b) { // propagate the borrow
+      b = M[++i] == 0;
+      M[i] -= 1;
+    }
+  }
+  while (M[n - 1] == 0)
+    n--;
+  A[0] = mt;
+  for (unsigned i = 0; i < q; i++) {
+    if (2 * na - 1 > n)
+      return 0;
+    sqr_limbs (B, A, na);
+    na = 2 * na;
+    while (B[na - 1] == 0)
+      na--;
+    for (int j = 0; j < na; j++)
+      A[j] = B[j];
+  }
+  if (na != n)
+    return 0;
+  for (int j = 0; j < n; j++)
+    if (A[j] != M[j])
+      return 0;
+
+  // (1+x)^y = t^p = 2^(et*p)*mt^p
+  u128 mp = mt;
+  for (uint64_t i = 1; i < p && !(mp >> 54); i++)
+    mp *= mt;
+  if (mp >> 54)
+    return 0;
+  set_flag (flag);
+  /* the conversion rounds mt^p correctly (and raises inexact for a midpoint),
+     and since 2^-53 <= 1+x < 2^1024 and 0 < y < 1, (1+x)^y is in the normal
+     range, thus the multiplication by 2^(et*p) is exact */
+  *r = (double) (uint64_t) mp;
+  pow2 (r, et * (int64_t) p);
+  return 1;
+}
+
+/* Special cases: x <= -1, or x or y is +/-0, +/-Inf or NaN.
+   Rules from IEEE 754-2019 for compound (x, n) with n integer:
+   (a) compound (x, 0) is 1 for x >= -1 or quiet NaN
+   (b) compound (-1, n) is +Inf and signals the divideByZero exception for n < 0
+   (c) compound (-1, n) is +0 for n > 0
+   (d) compound (+/-0, n) is 1
+   (e) compound (+Inf, n) is +Inf for n > 0
+   (f) compound (+Inf, n) is +0 for n < 0
+   (g) compound (x, n) is qNaN and signals the invalid exception for x < -1
+   (h) compound (qNaN, n) is qNaN for n <> 0.
+   We extend them to any y, as cr_compoundf() in
+   ../../binary32/compound/compoundf.c, and for y = +/-Inf we follow
+   pow (1+x, y). */
+static __attribute__((noinline)) double
+compound_special (double x, double y)
+{
+  if (__builtin_isnan (x) || __builtin_isnan (y)) {
+    if (y == 0.0 && !is_signaling (x)) // rule (a)
+      return 1.0;
+    if (x == 0.0 && !is_signaling (y)) // rule (d)
+      return 1.0;
+    return x + y; // rule (h)
+  }
+
+  if (x < -1.0) { // rule (g), including x = -Inf
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    errno = EDOM;
+#endif
+    feraiseexcept (FE_INVALID);
+    return NAN;
+  }
+
+  if (y == 0.0 || x == 0.0) // rules (a) and (d)
+    return 1.0;
+
+  if (x == -1.0) {
+    if (y > 0.0) // rule (c)
+      return 0.0;
+    // rule (b)
+    feraiseexcept (FE_DIVBYZERO);
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    errno = ERANGE;
+#endif
+    return INFINITY;
+  }
+
+  if (x == INFINITY) // rules (e) and (f)
+    return (y > 0.0) ? INFINITY : 0.0;
+
+  // now -1 < x < +Inf, x <> 0 and y = +/-Inf
+  return ((x > 0.0) == (y > 0.0)) ? INFINITY : 0.0;
+}
+
+/* Put in r an approximation of log(1+l/h) = l/h - (l/h)^2/2 + (l/h)^3/3,
+   for |l/h| < 2^-52 (the first neglected term is less than 2^-157
+   relative to log(1+l/h)), with relative error less than 2^-123.5
+   (mostly from the last multiplication, with error bounded by 6 ulps).
+   If h = 1, l/h = l is exact, otherwise l/h is obtained by long division
+   of the significands with relative error less than 2^-127. */
+static void
+log1p_2 (dint64_t *r, double h, double l)
+{
+  static const dint64_t HALF = {.hi = 0x8000000000000000, .lo = 0x0,
+                                .ex = -1, .sgn = 0x0};
+  static const dint64_t THIRD = {.hi = 0xaaaaaaaaaaaaaaaa,
+                                 .lo = 0xaaaaaaaaaaaaaaab, .ex = -2, .sgn = 0x0};
+  dint64_t D, T;
+  if (h == 1.0)
+    dint_fromd (&D, l);
+  else {
+    int64_t el, eh;
+    uint64_t ml, mh;
+    fast_extract (&el, &ml, l); // l and h are normal numbers here
+    fast_extract (&eh, &mh, h);
+    D.ex = el - eh;
+    if (ml < mh) {
+      ml <<= 1;
+      D.ex --;
+    }
+    // now 1 <= ml/mh < 2
+    u128 num = (u128) ml << 63;
+    D.hi = num / mh;
+    num = (num % mh) << 64;
+    D.lo = num / mh;
+    D.sgn = l < 0;
+  }
+  mul_dint (&T, &D, &THIRD);
+  T.sgn ^= 1;
+  add_dint (&T, &HALF, &T);
+  mul_dint (&T, &D, &T);
+  T.sgn ^= 1;
+  add_dint (&T, &ONE, &T);
+  mul_dint (r, &D, &T);
+}
+
+/* Same as log1p_2(), with terms up to (l/h)^5/5 (the first neglected term
+   is less than 2^-265 relative to log(1+l/h)), with qint64_t arithmetic
+   and relative error less than 2^-251 (mostly from the last multiplication,
+   with error bounded by 14 ulps). */
+static void
+log1p_3 (qint64_t *r, double h, double l)
+{
+  static const qint64_t C[] = {
+    {.hh = 0xcccccccccccccccc, .hl = 0xcccccccccccccccc, .lh = 0xcccccccccccccccc,
+     .ll = 0xcccccccccccccccd, .ex = -3, .sgn = 0x0}, /* 1/5 */
+    {.hh = 0x8000000000000000, .hl = 0x0, .lh = 0x0, .ll = 0x0,
+     .ex = -2, .sgn = 0x0}, /* 1/4 */
+    {.hh = 0xaaaaaaaaaaaaaaaa, .hl = 0xaaaaaaaaaaaaaaaa, .lh = 0xaaaaaaaaaaaaaaaa,
+     .ll = 0xaaaaaaaaaaaaaaab, .ex = -2, .sgn = 0x0}, /* 1/3 */
+    {.hh = 0x8000000000000000, .hl = 0x0, .lh = 0x0, .ll = 0x0,
+     .ex = -1, .sgn = 0x0}, /* 1/2 */
+    {.hh = 0x8000000000000000, .hl = 0x0, .lh = 0x0, .ll = 0x0,
+     .ex = 0, .sgn = 0x0}, /* 1 */
+  };
+  qint64_t D, T;
+  if (h == 1.0)
+    qint_fromd (&D, l);
+  else {
+    int64_t el, eh;
+    uint64_t ml, mh;
+    fast_extract (&el, &ml, l);
+    fast_extract (&eh, &mh, h);
+    D.ex = el - eh;
+    if (ml < mh) {
+      ml <<= 1;
+      D.ex --;
+    }
+    u128 num = (u128) ml << 63;
+    D.hh = num / mh;
+    num = (num % mh) << 64;
+    D.hl = num / mh;
+    num = (num % mh) << 64;
+    D.lh = num / mh;
+    num = (num % mh) << 64;
+    D.ll = num / mh;
+    D.sgn = l < 0;
+  }
+  mul_qint (&T, &D, &C[0]);
+  for (int i = 1; i < 5; i++) {
+    T.sgn ^= 1;
+    add_qint (&T, &C[i], &T);
+    mul_qint (&T, &D, &T);
+  }
+  cp_qint (r, &T);
+}
+
+/* Second and third phases, when the rounding test of the first phase fails.
+   exact is non-zero iff (1+x)^y is exactly representable in binary64. */
+static __attribute__((noinline)) double
+compound_accurate (double x, double y, int exact)
+{
+  /* Write 1+x = h+l where h is 1+x rounded toward 1 (if 1+x is not a
+     binary64 number), so that log(h) and log(1+l/h) have the same sign:
+     |log(h)| <= |log(1+x)| and there is no cancellation below. */
+  double h, l;
+  one_plus (&h, &l, x);
+  if (__builtin_expect (l != 0 && __builtin_fabs (x) <= 1.0
+                        && (x > 0.0) != (l > 0.0), 0)) {
+    f64_u v = {.f = h};
+    /* h is on the other side of 1+x, and 1+x is between h and 1:
+       replace h by its neighbour toward 1 (this is exact since
+       2^-53 <= |x| <= 1, see one_plus) */
+    v.u = (x > 0.0) ? v.u - 1 : v.u + 1;
+    l = l + (h - v.f);
+    h = v.f;
+  }
+
+  uint64_t rd; // used in the 2nd and 3rd phases
+
+  dint64_t X, Y, R, P;
+  dint_fromd (&Y, y); /* exact */
+  if (h != 1.0) {
+    dint_fromd (&X, h); /* exact */
+    log_2 (&R, &X); /* relative error bounded by 2^-122.88 */
+    if (l != 0) {
+      log1p_2 (&P, h, l);
+      add_dint (&R, &R, &P);
+    }
+  }
+  else
+    log1p_2 (&R, h, l);
+  /* Since log(h) and log(1+l/h) have the same sign, the relative error on R
+     is bounded by 2^-122.88 + 2^-123.5 + 2*2^-128 < 2^-122.10 */
+
+  mul_dint_21 (&R, &R, &Y);
+  /* R = y*log(1+x) * (1+eps1) with |eps1| < 2^-122.10 + 2*2^-127
+     < 2^-122.01 */
+
+  exp_2 (&R, &R); /* relative error < 2^-121.70 */
+
+  /* As in cr_pow(), since |y*log(1+x)| < 744.45, the relative error is
+     bounded by exp(744.45*2^-122.01)*(1+2^-121.70)-1 < 2^-112.47,
+     which corresponds to an error of at most 2^-112.47*2^128 < 47280 ulps. */
+
+  // 2^R.ex <= R < 2^(R.ex+1)
+
+  /* case R < 2^-1075: underflow case */
+  if (R.ex < -1075) {
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    errno = ERANGE; // underflow
+#endif
+    volatile double tiny = 0x1p-1074; // prevents constant folding
+    return 0.5 * tiny;
+  }
+
+  if (R.ex < -1022) { /* subnormal case, see cr_pow() */
+    uint64_t ex = -(1022 + R.ex); /* 1 <= ex <= 53 */
+    uint64_t m = R.lo >> (10 + ex) | R.hi << (54 - ex);
+    rd = m + 23 > (2*23);
+  } else {
+#define ERR_BND_2 46 /* floor(47280/2^10) */
+    uint64_t lo = R.lo >> 10 | R.hi << 54;
+    rd = lo + ERR_BND_2 > (2*ERR_BND_2);
+  }
+
+  R.sgn = 0;
+  if (rd)
+    return dint_tod (&R, exact);
+
+  // exact and midpoint cases, for 1+x a binary64 number
+  double e;
+  if (l == 0 && exact_pow (&e, h, y, &R, exact))
+    return e;
+
+  qint64_t qX, qY, qR, qP;
+  qint_fromd (&qY, y); /* exact */
+  if (h != 1.0) {
+    qint_fromd (&qX, h); /* exact */
+    log_3 (&qR, &qX); /* relative error bounded by 2^-250.74 */
+    if (l != 0) {
+      log1p_3 (&qP, h, l);
+      add_qint (&qR, &qR, &qP);
+    }
+  }
+  else
+    log1p_3 (&qR, h, l);
+  /* the relative error on qR is bounded by 2^-250.74 + 2^-251 + 2*2^-256
+     < 2^-249.82 */
+
+  mul_qint_41 (&qR, &qR, &qY);
+  /* qR = y*log(1+x) * (1+eps1) with |eps1| < 2^-249.82 + 2*2^-255
+     < 2^-249.74 */
+
+  qint64_t qZ;
+  exp_3 (&qZ, &qR); /* relative error < 2^-241.10 */
+
+  /* The relative error is bounded by exp(744.45*2^-249.74)*(1+2^-241.10)-1
+     < 2^-239.58, which corresponds to at most 2^-239.58*2^256 < 87400 ulps */
+
+#define ERR_BND_3 85 /* floor(87400/2^10) */
+  uint64_t r1 = qZ.hh << 54 | qZ.hl >> 10;
+  uint64_t r2 = qZ.hl << 54 | qZ.lh >> 10;
+  uint64_t r3 = qZ.lh << 54 | qZ.ll >> 10;
+  // the rounding test fails for r1:r2:r3 in [-ERR_BND_3, ERR_BND_3] mod 2^192
+  rd = !((r1 == 0 && r2 == 0 && r3 <= ERR_BND_3) ||
+         (~r1 == 0 && ~r2 == 0 && r3 + ERR_BND_3 < ERR_BND_3));
+
+  if (rd)
+  {
+    qZ.sgn = 0;
+    qZ.ll = qZ.ll & (~0ull << 10);
+    return qint_tod (&qZ);
+  }
+
+  /* For |qR| < 2^-55, (1+x)^y rounds either to nextbelow(1), to 1 or to
+     nextabove(1), see cr_pow() */
+  if (qR.ex < -56) {
+    volatile double one = 1.0; // prevents constant folding
+    return (qR.sgn == 0x0) ? one + 0x1p-100 : one - 0x1p-100;
+  }
+
+  /* Near-exact cases: (1+x)^y = h^y*(1+l/h)^y where h^y is exact or a
+     midpoint, and |l/h| is tiny, for example 1+x = 2^281*t^16+1 or
+     1+x = 3+2^-1000. Since the 3rd phase failed, (1+x)^y is within
+     2^-239 (relatively) of a rounding boundary, which must be
+     h^y = k*2^g, and (1+x)^y - h^y has the sign of y*l: we round
+     k*2^g perturbed by one unit in the last place of a dint64_t. */
+  int64_t k, g;
+  dint64_t Z = {.hi = qZ.hh, .lo = qZ.hl, .ex = qZ.ex, .sgn = 0};
+  if (l != 0 && exact_pow_k (&k, &g, h, y, &Z)) {
+    int cnt = __builtin_clzll (k);
+    dint64_t W = {.hi = (uint64_t) k << cnt, .lo = 0, .ex = g + 63 - cnt,
+                  .sgn = 0};
+    /* check that (1+x)^y is indeed close to k*2^g, since in the cases
+       (a) and x = 2^E of exact_pow_k() the approximation Z is not used */
+    dint64_t D = W;
+    D.sgn = 1;
+    add_dint (&D, &Z, &D); /* exact by Sterbenz theorem */
+    D.ex += 116;
+    if (cmp_dint_abs (&D, &Z) < 0) {
+      if ((y > 0) == (l > 0))
+        W.lo = 1;
+      else if (W.hi == 1ull << 63) { // k*2^g is a power of 2
+        // ones is volatile so that dint_tod() rounds W at run time
+        volatile uint64_t ones = ~0ull;
+        W.hi = W.lo = ones;
+        W.ex --;
+      }
+      else {
+        W.hi --;
+        W.lo = ~0ull;
+      }
+      return dint_tod (&W, 0);
+    }
+  }
+
+  printf ("Unexpected worst-case found.\n");
+  printf ("Please report to core-math@inria.fr:\n");
+  printf ("Worst-case of compound found: x,y=%la,%la\n", x, y);
+  exit (1);
+}
+
+double
+cr_compound (double x, double y)
+{
+  f64_u _x = {.f = x}, _y = {.f = y};
+  uint64_t ax = _x.u & 0x7fffffffffffffffull;
+  uint64_t ay = _y.u & 0x7fffffffffffffffull;
+
+  // x <= -1, x or y is +/-0, +/-Inf or NaN
+  if (__builtin_expect (_x.u >= 0xbff0000000000000ull
+                        || ax - 1 >= 0x7fefffffffffffffull
+                        || ay - 1 >= 0x7fefffffffffffffull, 0))
+    return compound_special (x, y);
+
+  if (__builtin_expect (y == 1.0, 0)) { // 1+x is rounded correctly
+    double r = 1.0 + x;
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    if (r > 0x1.fffffffffffffp+1023)
+      errno = ERANGE; // overflow
+#endif
+    return r;
+  }
+
+  /* (1+x)^y can be exact or a midpoint only when the low 42 bits of the
+     encoding of y are zero (see is_exact() and compound_exact()): in that
+     case the volatile copy of x ensures the compiler does not move the
+     reading of the inexact flag after the first floating-point operations
+     below (which might raise inexact) */
+  FLAG_T flag = get_flag ();
+  if (__builtin_expect ((_y.u << 22) == 0, 0)) {
+    volatile double vx = x;
+    x = vx;
+  }
+
+  double h, l;
+  one_plus (&h, &l, x);
+
+  // fast path for small integer y, for example (1+r)^n with n periods
+  if (ay <= 0x4050000000000000ull && is_int (y)) { // |y| <= 64
+    double r;
+    if (compound_int (&r, h, l, y))
+      return r;
+  }
+
+  // approximate log(1+x), with relative error less than elog
+  double lh, ll, elog;
+  if (ax < 0x3f30000000000000ull) { // |x| < 2^-12
+    log1p_tiny (&lh, &ll, x);
+    elog = 0x1p-74;
+  }
+  else {
+    log_1 (&lh, &ll, h);
+    /* for h >= 2^106, |l| <= 1 and the correction below is less than
+       2^-106 < 2^-112*|log(h)| (and l/h might underflow) */
+    if (l != 0 && h < 0x1p106) {
+      /* log(1+x) = log(h) + log(1+d) with d = l/h, |d| < 2^-52,
+         log(1+d) = d - d^2/2 + O(2^-156), and d = dh + dl with
+         |dl| < 2^-104 up to an error less than 2^-156 */
+      double dh = l / h;
+      double dl = __builtin_fma (-dh, h, l) / h - 0.5 * (dh * dh);
+      double t;
+      fast_two_sum (&lh, &t, lh, dh); // |lh| >= log(1+2^-12) > 2^40*|dh|
+      fast_two_sum (&lh, &ll, lh, t + (ll + dl));
+    }
+    /* Since |log(h)| >= log(1+2^-12) and |log(1+d)| < 2^-52,
+       the error of log_1() (relative error less than 2^-67.05, see
+       cr_pow()) is less than 2^-67.04 relative to log(1+x), and the
+       other errors are less than 2^-100 */
+    elog = 0x1.f8p-68; // 2^-67.04 < 0x1.f8p-68
+  }
+
+  /* Avoid a spurious underflow or overflow in y*log(1+x):
+     |y*lh| >= 2^(ey+el-2046) and |y*lh| < 2^(ey+el-2044),
+     where ey and el are the biased exponents of y and lh */
+  f64_u _l = {.f = lh};
+  int64_t e = ((_y.u >> 52) & 0x7ff) + ((_l.u >> 52) & 0x7ff) - 2046;
+  int pos = (y > 0) == (lh > 0); // sign of y*log(1+x)
+  if (__builtin_expect (e < -900 || e >= 10, 0)) {
+    volatile double one = 1.0; // prevents constant folding
+    if (e < -900) // |y*log(1+x)| < 2^-898
+      return pos ? one + 0x1p-100 : one - 0x1p-100;
+    // |y*log(1+x)| >= 1024: overflow or underflow
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    errno = ERANGE;
+#endif
+    return pos ? 0x1p1023 * 2.0 : one * 0x1p-1074 * 0.25;
+  }
+
+  double rh, rl;
+  s_mul (&rh, &rl, y, lh, ll);
+
+  /* For |y*log(1+x)| < 2^-55, we have 1-2^-54 < (1+x)^y < 1+2^-53, thus
+     (1+x)^y rounds to nextbelow(1), 1 or nextabove(1). Since the relative
+     error on rh is less than 2^-51, |rh| < 2^-56 implies
+     |y*log(1+x)| < 2^-55. */
+  if (__builtin_expect (__builtin_fabs (rh) < 0x1p-56, 0)) {
+    volatile double one = 1.0; // prevents constant folding
+    return pos ? one + 0x1p-100 : one - 0x1p-100;
+  }
+
+  // (1+x)^y might be exact or a midpoint with 1+x not a binary64 number
+  if (__builtin_expect ((_y.u << 22) == 0 && l != 0 && y < 1.0 && y > 0.0, 0))
+  {
+    double r;
+    if (compound_exact (&r, x, y, lh, ll, flag))
+      return r;
+  }
+
+  double res_h, res_l;
+  exp_1 (&res_h, &res_l, rh, rl, 1.0);
+
+  /* The relative error of exp_1() is less than 2^-63.786, and the error on
+     rh+rl is less than |rh|*elog (up to a factor 1+2^-50), thus the
+     relative error on res_h+res_l is less than
+     (1+2^-63.786)*exp(|rh|*elog*(1+2^-50))-1 < 0x1.29p-64 + |rh|*elog*1.01
+     since |rh| < 710. */
+  double err = __builtin_fma (__builtin_fabs (rh), elog * 1.01, 0x1.29p-64);
+  double res_min = res_h + __builtin_fma (err, -res_h, res_l);
+  double res_max = res_h + __builtin_fma (err, res_h, res_l);
+
+  int exact = (l == 0) && is_exact (h, y);
+
+  if (__builtin_expect (res_min == res_max, 1)) {
+    /* restore the inexact flag only now, so that the computation of
+       res_min and res_max cannot be scheduled after it */
+    if (exact)
+      set_flag (flag);
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    if (res_max < 0x1p-1022)
+      errno = ERANGE; // underflow
+#endif
+    return res_max;
+  }
+
+  if (exact)
+    set_flag (flag); // the accurate phases only use integer operations
+  return compound_accurate (x, y, exact);
+}
+
+#ifndef SKIP_C_FUNC_REDEF
+/* just to compile since glibc does not contain this function */
+double compound (double x, double y){
+  return pow (1.0 + x, y);
+}
+#endif
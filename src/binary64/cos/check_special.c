@@ -33,24 +33,30 @@ SOFTWARE.
 #include <sys/types.h>
 #include <unistd.h>
 #include <inttypes.h>
+#include <errno.h>
+#include <mpfr.h>
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
 #include <omp.h>
 #endif
 
+#include "../../generic/support/philox.h"
+
 int ref_init (void);
 int ref_fesetround (int);
 
 double cr_cos (double);
 double ref_cos (double);
+double cr_cos_inrange (double);
+double cr_cos_dd (double, double *);
+void cr_cos_interval (double, double *, double *);
+double cr_cos_r (double, int);
 
 int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
 
 int rnd = 0;
 int verbose = 0;
 
-#define MAX_THREADS 192
-
-static unsigned int Seed[MAX_THREADS];
+static uint64_t Seed;
 
 typedef union { 
   double f; 
@@ -65,12 +71,10 @@ asuint64 (double f)
 }
 
 static double
-get_random (int tid)
+get_random (philox_t *s)
 {
   d64u64 v;
-  v.i = rand_r (Seed + tid);
-  v.i |= (uint64_t) rand_r (Seed + tid) << 31;
-  v.i |= (uint64_t) rand_r (Seed + tid) << 62;
+  v.i = philox_u64 (s);
   return v.f;
 }
 
@@ -111,6 +115,16 @@ is_nan (double x)
   return (e == 0x7ff || e == 0xfff) && (u << 12) != 0;
 }
 
+static inline int
+is_equal (double x, double y)
+{
+  if (is_nan (x))
+    return is_nan (y);
+  if (is_nan (y))
+    return is_nan (x);
+  return asuint64 (x) == asuint64 (y);
+}
+
 // When x is a NaN, returns 1 if x is an sNaN and 0 if it is a qNaN
 static inline int is_signaling(double x) {
   d64u64 _x = {.f = x};
@@ -294,6 +308,179 @@ check_invalid (void)
   }
 }
 
+/* The exceptions compared between cr_cos_r(x,rnd1[rnd]) and cr_cos(x) in the
+   rounding mode rnd1[rnd], and between cr_cos_inrange(x) and cr_cos(x).
+   Inexact is only checked with CORE_MATH_CHECK_INEXACT. */
+#ifdef CORE_MATH_CHECK_INEXACT
+#define CHECKED_FLAGS (FE_INEXACT | FE_UNDERFLOW | FE_OVERFLOW | FE_INVALID \
+                       | FE_DIVBYZERO)
+#else
+#define CHECKED_FLAGS (FE_UNDERFLOW | FE_OVERFLOW | FE_INVALID | FE_DIVBYZERO)
+#endif
+
+/* Check cr_cos_interval(x) and cr_cos_r(x,rnd1[rnd]) in the rounding mode
+   to nearest they assume, with their exceptions and errno, see
+   check_interval() in ../exp/check_special.c. */
+static void
+check_interval (double x)
+{
+  double y1 = ref_cos (x), lo, hi, lo1, hi1, y2, z;
+  int flags0, flags1, flags2, flags3, err1, err3;
+  fesetround (FE_DOWNWARD);
+  lo1 = cr_cos (x);
+  fesetround (FE_UPWARD);
+  hi1 = cr_cos (x);
+  fesetround (FE_TONEAREST);
+  feclearexcept (FE_ALL_EXCEPT);
+  cr_cos (x);
+  flags0 = fetestexcept (FE_INVALID | FE_DIVBYZERO);
+  fesetround (rnd1[rnd]);
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  y2 = cr_cos (x);
+  flags1 = fetestexcept (CHECKED_FLAGS);
+  err1 = errno;
+  fesetround (FE_TONEAREST);
+  feclearexcept (FE_ALL_EXCEPT);
+  cr_cos_interval (x, &lo, &hi);
+  flags2 = fetestexcept (FE_ALL_EXCEPT);
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  z = cr_cos_r (x, rnd1[rnd]);
+  flags3 = fetestexcept (CHECKED_FLAGS);
+  err3 = errno;
+  if (fegetround () != FE_TONEAREST)
+  {
+    printf ("Rounding mode changed by cr_cos_interval or cr_cos_r for x=%la\n",
+            x);
+    exit (1);
+  }
+  if (!is_equal (lo, lo1) || !is_equal (hi, hi1))
+  {
+    printf ("FAIL x=%la cr_cos_interval=[%la,%la] cr_cos=[%la,%la]\n",
+            x, lo, hi, lo1, hi1);
+    exit (1);
+  }
+  if ((!is_nan (y1) && !(lo <= y1 && y1 <= hi)) ||
+      (rnd == 3 && !is_equal (lo, y1)) || (rnd == 2 && !is_equal (hi, y1)))
+  {
+    printf ("FAIL x=%la ref=%la cr_cos_interval=[%la,%la]\n", x, y1, lo, hi);
+    exit (1);
+  }
+  if (!is_equal (z, y1) || !is_equal (z, y2))
+  {
+    printf ("FAIL x=%la ref=%la cr_cos=%la cr_cos_r=%la\n", x, y1, y2, z);
+    exit (1);
+  }
+  if (flags3 != flags1)
+  {
+    printf ("FAIL x=%la cr_cos_r raises exceptions %#x instead of %#x\n",
+            x, flags3, flags1);
+    exit (1);
+  }
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  if (err3 != err1)
+  {
+    printf ("FAIL x=%la cr_cos_r sets errno=%d instead of %d\n", x, err3, err1);
+    exit (1);
+  }
+#else
+  (void) err1;
+  (void) err3;
+#endif
+  if ((flags2 & (FE_INVALID | FE_DIVBYZERO)) != flags0)
+  {
+    printf ("FAIL x=%la cr_cos_interval raises exceptions %#x instead of %#x\n",
+            x, flags2 & (FE_INVALID | FE_DIVBYZERO), flags0);
+    exit (1);
+  }
+#ifdef CORE_MATH_CHECK_INEXACT
+  if (((flags2 & FE_INEXACT) != 0) == is_equal (lo, hi))
+  {
+    printf ("%s inexact exception for x=%la cr_cos_interval=[%la,%la]\n",
+            (flags2 & FE_INEXACT) ? "Spurious" : "Missing", x, lo, hi);
+    exit (1);
+  }
+#endif
+}
+
+/* Check the error bound of cr_cos_dd(x,&l) given in ../sin/sin.c and cos.c:
+   for x finite the absolute error of h + l is less than 0x1.84p-69, otherwise
+   h = cr_cos(x) and l = 0. */
+static void
+check_dd (double x)
+{
+  double l, h = cr_cos_dd (x, &l);
+  if (is_nan (x - x)) // x is NaN or Inf
+  {
+    double y = cr_cos (x);
+    if (!is_equal (h, y) || l != 0)
+    {
+      printf ("FAIL x=%la cr_cos=%la cr_cos_dd=%la,%la\n", x, y, h, l);
+      exit (1);
+    }
+    return;
+  }
+  // use the full exponent range, ref_init() sets that of binary64
+  mpfr_exp_t emin = mpfr_get_emin (), emax = mpfr_get_emax ();
+  mpfr_set_emin (mpfr_get_emin_min ());
+  mpfr_set_emax (mpfr_get_emax_max ());
+  mpfr_t t, y;
+  mpfr_inits2 (256, t, y, NULL);
+  mpfr_set_d (t, x, MPFR_RNDN);
+  mpfr_cos (y, t, MPFR_RNDN);
+  mpfr_sub_d (t, y, h, MPFR_RNDN);
+  mpfr_sub_d (t, t, l, MPFR_RNDN);
+  double err = fabs (mpfr_get_d (t, MPFR_RNDN));
+  mpfr_clears (t, y, NULL);
+  mpfr_set_emin (emin);
+  mpfr_set_emax (emax);
+  if (err >= 0x1.84p-69)
+  {
+    printf ("FAIL x=%la cr_cos_dd=%la,%la absolute error=%la\n",
+            x, h, l, err);
+    exit (1);
+  }
+}
+
+/* Check that cr_cos_inrange(x) = cr_cos(x), with the same exceptions (and
+   errno), for x in the domain of
+   cr_cos_inrange, 0x1.6a09e667f3bccp-27 < |x| < 2^1024. */
+static void
+check_inrange (double x)
+{
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  double y = cr_cos (x);
+  int flags1 = fetestexcept (CHECKED_FLAGS), err1 = errno;
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  double z = cr_cos_inrange (x);
+  int flags2 = fetestexcept (CHECKED_FLAGS), err2 = errno;
+  if (!is_equal (y, z))
+  {
+    printf ("FAIL x=%la cr_cos=%la cr_cos_inrange=%la\n", x, y, z);
+    exit (1);
+  }
+  if (flags2 != flags1)
+  {
+    printf ("FAIL x=%la cr_cos_inrange raises exceptions %#x instead of %#x\n",
+            x, flags2, flags1);
+    exit (1);
+  }
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  if (err2 != err1)
+  {
+    printf ("FAIL x=%la cr_cos_inrange sets errno=%d instead of %d\n",
+            x, err2, err1);
+    exit (1);
+  }
+#else
+  (void) err1;
+  (void) err2;
+#endif
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -344,9 +531,7 @@ main (int argc, char *argv[])
 #define CORE_MATH_TESTS 1000000000UL /* total number of tests */
 #endif
 
-  unsigned int seed = getpid ();
-  for (int i = 0; i < MAX_THREADS; i++)
-    Seed[i] = seed + i;
+  Seed = philox_seed ();
 
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
 #pragma omp parallel for
@@ -355,14 +540,90 @@ main (int argc, char *argv[])
   {
     ref_init ();
     ref_fesetround (rnd);
-    int tid;
+    philox_t s;
+    philox_init (&s, Seed, n);
+    double x = get_random (&s);
+    check (x);
+  }
+
+  printf ("Checking cr_cos_interval and cr_cos_r\n");
+  static const double T[] = {0x0p+0, 0x1p-1074, 0x1p-60, 0x1p-27,
+    0x1.6a09e667f3bccp-27, 0x1.6a09e667f3bcdp-27, 0x1.921fb54442d18p+0,
+    0x1.921fb54442d18p+1, 0x1p+1023, 0x1.fffffffffffffp+1023, INFINITY, NAN};
+  for (unsigned i = 0; i < sizeof (T) / sizeof (T[0]); i++)
+  {
+    check_interval (T[i]);
+    check_interval (-T[i]);
+  }
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t n = 0; n < CORE_MATH_TESTS / 16; n++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    philox_t s;
+    // the counters n + CORE_MATH_TESTS are not used by the other loops
+    philox_init (&s, Seed, n + CORE_MATH_TESTS);
+    d64u64 v = {.f = get_random (&s)};
+    // for half of the values, 2^-30 <= |x| < 2^10
+    if (v.i & 1)
+      v.i = (v.i & 0x800fffffffffffffull) | ((0x3e1 + (v.i >> 52) % 0x28) << 52);
+    check_interval (v.f);
+  }
+
+  printf ("Checking cr_cos_dd\n");
+  static const double D[] = {0x0p+0, 0x1p-1074, 0x1.6a09e667f3bccp-27,
+    0x1.6a09e667f3bcdp-27, 0x1.921fb54442d18p+0, 0x1.921fb54442d18p+1,
+    0x1p+1023, 0x1.fffffffffffffp+1023, INFINITY, NAN};
+  for (unsigned i = 0; i < sizeof (D) / sizeof (D[0]); i++)
+  {
+    check_dd (D[i]);
+    check_dd (-D[i]);
+  }
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
-    tid = omp_get_thread_num ();
-#else
-    tid = 0;
+#pragma omp parallel for
 #endif
-    double x = get_random (tid);
-    check (x);
+  for (uint64_t n = 0; n < CORE_MATH_TESTS / 16; n++)
+  {
+    fesetround (rnd1[rnd]);
+    philox_t s;
+    // the counters n + 2 * CORE_MATH_TESTS are not used by the other loops
+    philox_init (&s, Seed, n + 2 * CORE_MATH_TESTS);
+    d64u64 v = {.f = get_random (&s)};
+    // for half of the values, 2^-30 <= |x| < 2^10
+    if (v.i & 1)
+      v.i = (v.i & 0x800fffffffffffffull) | ((0x3e1 + (v.i >> 52) % 0x28) << 52);
+    check_dd (v.f);
+  }
+
+  printf ("Checking cr_cos_inrange\n");
+  static const double I[] = {0x1.6a09e667f3bcdp-27, -0x1.6a09e667f3bcdp-27,
+    0x1.921fb54442d18p+0, 0x1.921fb54442d18p+1, 0x1.fffffffffffffp+1023,
+    -0x1.fffffffffffffp+1023};
+  fesetround (rnd1[rnd]);
+  for (unsigned i = 0; i < sizeof (I) / sizeof (I[0]); i++)
+    check_inrange (I[i]);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t n = 0; n < CORE_MATH_TESTS / 16; n++)
+  {
+    fesetround (rnd1[rnd]);
+    philox_t s;
+    // the counters n + 3 * CORE_MATH_TESTS are not used by the other loops
+    philox_init (&s, Seed, n + 3 * CORE_MATH_TESTS);
+    d64u64 v;
+    /* |x| > 0x1.6a09e667f3bccp-27 finite, for half of the values with
+       |x| < 2^10 */
+    do
+    {
+      v.i = philox_u64 (&s);
+      if (v.i & 1)
+        v.i = (v.i & 0x800fffffffffffffull) | ((0x3e4 + (v.i >> 52) % 0x25) << 52);
+    }
+    while (!(0x1.6a09e667f3bccp-27 < fabs (v.f) && fabs (v.f) < INFINITY));
+    check_inrange (v.f);
   }
 
   return 0;
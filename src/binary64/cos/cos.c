@@ -27,6 +27,21 @@ SOFTWARE.
 #include <stdint.h>
 #include <fenv.h> // for fegetround, FE_TONEAREST, FE_DOWNWARD, FE_UPWARD
 #include <errno.h>
+#ifdef CORE_MATH_DEBUG
+#include <assert.h>
+#endif
+
+/* With -DCORE_MATH_TABLE_SECTION, the tables below are put in the section
+   core_math_tables_trig, aligned on cache lines, see
+   src/generic/support/warmup.h. */
+#ifndef CORE_MATH_TABLE
+#ifdef CORE_MATH_TABLE_SECTION
+#define CORE_MATH_TABLE(family) \
+  __attribute__((section ("core_math_tables_" #family), aligned (64)))
+#else
+#define CORE_MATH_TABLE(family)
+#endif
+#endif
 
 // Warning: clang also defines __GNUC__
 #if defined(__GNUC__) && !defined(__clang__)
@@ -412,7 +427,7 @@ typedef union {double f; uint64_t u;} b64u64_u;
 /* This table approximates 1/(2pi) downwards with precision 1280:
    1/(2*pi) ~ T[0]/2^64 + T[1]/2^128 + ... + T[i]/2^((i+1)*64) + ...
    Computed with computeT() from sin.sage. */
-static const uint64_t T[20] = {
+static const uint64_t T[20] CORE_MATH_TABLE (trig) = {
   0x28be60db9391054a, // i=0
    0x7f09d5f47d4d3770,
    0x36d8a5664f10e410,
@@ -439,7 +454,7 @@ static const uint64_t T[20] = {
    (to nearest).
    Each entry is to be interpreted as (hi/2^64+lo/2^128)*2^ex*(-1)*sgn.
    Generated with computeS() from sin.sage. */
-static const dint64_t S[256] = {
+static const dint64_t S[256] CORE_MATH_TABLE (trig) = {
   {.hi = 0x0, .lo = 0x0, .ex = 128, .sgn=0},
   {.hi = 0xc90fc5f66525d257, .lo = 0x480f7956b6470765, .ex = -8, .sgn=0},
   {.hi = 0xc90f87f3380388d5, .lo = 0xcb3ff35bd4d81baa, .ex = -7, .sgn=0},
@@ -702,7 +717,7 @@ static const dint64_t S[256] = {
    (to nearest).
    Each entry is to be interpreted as (hi/2^64+lo/2^128)*2^ex*(-1)*sgn.
    Generated with computeC() from sin.sage. */
-static const dint64_t C[256] = {
+static const dint64_t C[256] CORE_MATH_TABLE (trig) = {
   {.hi = 0x8000000000000000, .lo = 0x0, .ex = 1, .sgn=0},
   {.hi = 0xffffb10b10e80e95, .lo = 0x3031437d7eccb9df, .ex = 0, .sgn=0},
   {.hi = 0xfffec42c7454926b, .lo = 0x38e310779edfec68, .ex = 0, .sgn=0},
@@ -1011,7 +1026,7 @@ static const dint64_t PC[] = {
    For each i, 0 <= i < 256, xi=i/2^11+SC[i][0], with
    SC[i][1] and SC[i][2] approximating sin2pi(xi) and cos2pi(xi)
    respectively, both with 53+15 bits of accuracy. */
-static const double SC[256][3] = {
+static const double SC[256][3] CORE_MATH_TABLE (trig) = {
    {0x0p+0, 0x0p+0, 0x1p+0}, /* 0 */
    {-0x1.c0f6cp-35, 0x1.921f892b900fep-9, 0x1.ffff621623fap-1}, /* 1 */
    {-0x1.9c7935ep-35, 0x1.921f0ea27ce01p-8, 0x1.fffd8858eca2ep-1}, /* 2 */
@@ -2018,6 +2033,29 @@ cos_accurate (double x)
   return y;
 }
 
+/* Same as cr_cos(), for 0x1.6a09e667f3bccp-27 < |x| < 2^1024, i.e., x is
+   finite and not tiny: the tests of the special cases of cr_cos() are
+   skipped. The contract is checked with -DCORE_MATH_DEBUG only, other
+   inputs give unspecified results. */
+double
+cr_cos_inrange (double x)
+{
+#ifdef CORE_MATH_DEBUG
+  assert (__builtin_fabs (x) > 0x1.6a09e667f3bccp-27
+          && __builtin_fabs (x) <= 0x1.fffffffffffffp+1023);
+#endif
+  double h, l, err;
+  x = __builtin_fabs (x);
+  err = cos_fast (&h, &l, x);
+  double left  = h + (l - err), right = h + (l + err);
+  /* With SC[] from ./buildSC 15 we get 1100 failures out of 50000000
+     random tests, i.e., about 0.002%. */
+  if (__builtin_expect (left == right, 1))
+    return left;
+
+  return cos_accurate (x);
+}
+
 double
 cr_cos (double x)
 {
@@ -2054,13 +2092,139 @@ cr_cos (double x)
     // |x| <= 0x1.6a09e667f3bccp-27
     return __builtin_fma (t.f, -0x1p-28, 1.0);
 
+  return cr_cos_inrange (t.f);
+}
+
+/* Return h and put in l a double-double approximation h + l of cos(x),
+   with absolute error less than 0x1.84p-69 (see cr_sin_dd() in
+   ../sin/sin.c). For x = NaN or Inf, h is cr_cos(x) and l is 0. */
+double
+cr_cos_dd (double x, double *l)
+{
+  b64u64_u t = {.f = x};
+  int e = (t.u >> 52) & 0x7ff;
+
+  if (__builtin_expect (e == 0x7ff, 0)) /* NaN, +Inf and -Inf. */
+  {
+    *l = 0;
+    return cr_cos (x);
+  }
+
+  t.u &= 0x7fffffffffffffff;
+  if (__builtin_expect (t.u <= 0x3e46a09e667f3bcc, 0)) {
+    // cos(x) = 1 - x^2/2 with an error less than x^4/24 < 2^-110
+    *l = -0.5 * x * x;
+    return 1.0;
+  }
+
+  double h, lo;
+  cos_fast (&h, &lo, t.f);
+  fast_two_sum (&h, l, h, lo); // we might have |lo| > ulp(h)/2
+  return h;
+}
+
+/* Set *lo and *hi to the roundings downwards and upwards of y, where
+   |y - (h+l)| < err and |l| < ulp(h), and return 1, or return 0 if y might
+   be too close to a binary64 number (same as as_interval() in
+   ../exp/exp.c, where the error analysis is given). */
+static inline int
+as_interval (double h, double l, double err, double *lo, double *hi)
+{
+  double v = h + l, d = l - (v - h);
+  b64u64_u t = {.f = v};
+  if (__builtin_expect (!(t.u << 1) || (t.u << 1) >= 0x7ffull << 53, 0))
+    return 0;
+  b64u64_u up = {.u = t.u + 1}, dn = {.u = t.u - 1};
+  double a = __builtin_fabs (up.f - v), b = __builtin_fabs (v - dn.f);
+  double m = err + a * 0x1p-50, sd = (t.u >> 63) ? -d : d;
+  if (sd > m && sd + m < a) // |v| < |y| < |v+|
+  {
+    *lo = (t.u >> 63) ? up.f : v;
+    *hi = (t.u >> 63) ? v : up.f;
+  }
+  else if (sd < -m && sd - m > -b) // |v-| < |y| < |v|
+  {
+    *lo = (t.u >> 63) ? v : dn.f;
+    *hi = (t.u >> 63) ? dn.f : v;
+  }
+  else
+    return 0;
+  return 1;
+}
+
+/* Slow path of cr_cos_interval(): call cr_cos() with both directed
+   rounding modes. */
+static void __attribute__((noinline))
+cos_interval_slow (double x, double *lo, double *hi)
+{
+  volatile double vx = x; // see as_exp_interval_slow() in ../exp/exp.c
+  int rm = fegetround ();
+  fesetround (FE_DOWNWARD);
+  *lo = cr_cos (vx);
+  fesetround (FE_UPWARD);
+  *hi = cr_cos (vx);
+  fesetround (rm);
+}
+
+/* Set *lo and *hi to cos(x) rounded downwards and upwards, with one
+   evaluation of cos_fast(). The rounding mode is only changed when the
+   slow path is used (for about 0.002% of random inputs, and for NaN
+   or Inf). Inexact is raised when lo <> hi (see README.md). */
+void
+cr_cos_interval (double x, double *lo, double *hi)
+{
+  b64u64_u t = {.f = x};
+  int e = (t.u >> 52) & 0x7ff;
+
+  if (__builtin_expect (e == 0x7ff, 0)) /* NaN, +Inf and -Inf. */
+    return cos_interval_slow (x, lo, hi);
+
+  t.u &= 0x7fffffffffffffff;
+  if (__builtin_expect (t.u <= 0x3e46a09e667f3bcc, 0)) {
+    // as shown in cr_cos(), 1 - 2^-54 < cos(x) < 1 for x <> 0
+    if (t.u)
+      feraiseexcept (FE_INEXACT);
+    *lo = (t.u == 0) ? 1.0 : 0x1.fffffffffffffp-1;
+    *hi = 1.0;
+    return;
+  }
+
   double h, l, err;
   err = cos_fast (&h, &l, t.f);
-  double left  = h + (l - err), right = h + (l + err);
-  /* With SC[] from ./buildSC 15 we get 1100 failures out of 50000000
-     random tests, i.e., about 0.002%. */
-  if (__builtin_expect (left == right, 1))
-    return left;
+  if (__builtin_expect (!as_interval (h, l, err, lo, hi), 0))
+    cos_interval_slow (x, lo, hi);
+}
+
+/* Return cr_cos(x) evaluated in the rounding mode rnd, which raises the
+   same exceptions (and sets errno) as cr_cos() in that mode. */
+static double __attribute__((noinline))
+cos_r_slow (double x, int rnd)
+{
+  volatile double vx = x; // see as_exp_interval_slow() in ../exp/exp.c
+  int rm = fegetround ();
+  fesetround (rnd);
+  volatile double r = cr_cos (vx);
+  fesetround (rm);
+  return r;
+}
 
-  return cos_accurate (t.f);
+/* Return cos(x) rounded according to rnd, assuming the current rounding
+   mode is to nearest (see cr_exp_r() in ../exp/exp.c). For NaN and Inf,
+   cr_cos() is called in the rounding mode rnd, so that the exceptions are
+   those of cr_cos() in that mode (cos(x) never underflows). */
+double
+cr_cos_r (double x, int rnd)
+{
+  if (rnd != FE_DOWNWARD && rnd != FE_UPWARD && rnd != FE_TOWARDZERO)
+    return cr_cos (x); // FE_TONEAREST
+  b64u64_u t = {.f = x};
+  if (__builtin_expect (((t.u >> 52) & 0x7ff) == 0x7ff, 0)) // NaN or Inf
+    return cos_r_slow (x, rnd);
+  double lo, hi;
+  cr_cos_interval (x, &lo, &hi);
+  if (rnd == FE_DOWNWARD)
+    return lo;
+  if (rnd == FE_UPWARD)
+    return hi;
+  return __builtin_signbit (lo) ? hi : lo; // FE_TOWARDZERO
 }
@@ -40,6 +40,8 @@ SOFTWARE.
 #include <omp.h>
 #endif
 
+#include "../../generic/support/philox.h"
+
 int ref_init (void);
 int ref_fesetround (int);
 
@@ -53,9 +55,7 @@ int verbose = 0;
 unsigned long tested = 0;
 
 
-#define MAX_THREADS 192
-
-static unsigned int Seed[MAX_THREADS];
+static uint64_t Seed;
 
 static inline double tfun(double x){
   return cr_function_under_test(x);
@@ -76,12 +76,10 @@ asuint64 (double f)
 typedef union {double f; uint64_t u;} b64u64_u;
 
 static double
-get_random (int tid)
+get_random (philox_t *s)
 {
   d64u64 v;
-  v.i = rand_r (Seed + tid);
-  v.i |= (uint64_t) rand_r (Seed + tid) << 31;
-  v.i |= (uint64_t) rand_r (Seed + tid) << 62;
+  v.i = philox_u64 (s);
   return v.f;
 }
 
@@ -312,9 +310,7 @@ main (int argc, char *argv[])
 #define CORE_MATH_TESTS 1000000000UL /* total number of tests */
 #endif
 
-  unsigned int seed = getpid ();
-  for (int i = 0; i < MAX_THREADS; i++)
-    Seed[i] = seed + i;
+  Seed = philox_seed ();
 
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
 #pragma omp parallel for
@@ -324,13 +320,9 @@ main (int argc, char *argv[])
     ref_init ();
     ref_fesetround (rnd);
     double x;
-    int tid;
-#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
-    tid = omp_get_thread_num ();
-#else
-    tid = 0;
-#endif
-    do x = get_random (tid); while (fabs (x) >= 0x1.633ce8fb9f87ep+9);
+    philox_t s;
+    philox_init (&s, Seed, n);
+    do x = get_random (&s); while (fabs (x) >= 0x1.633ce8fb9f87ep+9);
     check (x);
   }
 
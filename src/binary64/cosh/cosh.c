@@ -146,6 +146,13 @@ static __attribute__((noinline)) double as_cosh_database(double x, double f){
   return f;
 }
 
+#ifdef CORE_MATH_SHARED_EXP_TABLES
+// t0 and t1 are shared with exp, see src/binary64/support/exp_tables.c
+extern const double core_math_exp_t0[64][2], core_math_exp_t1[64][2];
+#define t0 core_math_exp_t0
+#define t1 core_math_exp_t1
+#endif
+
 double cr_cosh(double x){
   /*
     The function sinh(x) is approximated by a minimax polynomial
@@ -157,6 +164,7 @@ double cr_cosh(double x){
     higher than double precision. For 36.736801<|x|<710.47586
     exp(-|x|) becomes too small and only exp(|x|) is calculated.
    */
+#ifndef CORE_MATH_SHARED_EXP_TABLES
   static const double t0[][2] = {
     {0x0p+0, 0x1p+0}, {-0x1.19083535b085ep-56, 0x1.02c9a3e778061p+0},
     {0x1.d73e2a475b466p-55, 0x1.059b0d3158574p+0}, {0x1.186be4bb285p-57, 0x1.0874518759bc8p+0},
@@ -225,6 +233,7 @@ double cr_cosh(double x){
     {0x1.64cbba902ca28p-58, 0x1.029ccf99d720ap+0}, {0x1.4383ef231d206p-54, 0x1.02a803f2d170dp+0},
     {0x1.4a47a505b3a46p-54, 0x1.02b338c811703p+0}, {0x1.e47120223468p-54, 0x1.02be6e199c811p+0},
   };
+#endif
 
   const double s = 0x1.71547652b82fep+12;
   double ax = __builtin_fabs(x), v0 = __builtin_fma(ax, s, 0x1.8000002p+26);
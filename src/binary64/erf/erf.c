@@ -662,9 +662,10 @@ cr_erf (double x)
   /* now |x| <= 0x1.7afb48dc96626p+2 */
   if (__builtin_expect (z < 0x1p-61, 0))
   {
-    /* for x=-0 the code below returns +0 which is wrong */
+    /* for x=-0 the code below returns +0 which is wrong; x == 0 also holds
+       for subnormal x in DAZ mode (see src/generic/support/fenv_ftz.h) */
     if (x == 0)
-      return x;
+      return __builtin_copysign (0.0, x);
     /* tiny x: erf(x) ~ 2/sqrt(pi) * x + O(x^3), where the ratio of the O(x^3)
        term to the main term is in x^2/3, thus less than 2^-123 */
     double y = CH * x; /* tentative result */
@@ -36,6 +36,8 @@ SOFTWARE.
 #include <omp.h>
 #endif
 
+#include "../../generic/support/philox.h"
+
 #ifndef CORE_MATH_TESTS
 #define CORE_MATH_TESTS 1000000000UL /* total number of tests */
 #endif
@@ -51,9 +53,7 @@ int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
 int rnd = 0;
 int verbose = 0;
 
-#define MAX_THREADS 192
-
-static unsigned int Seed[MAX_THREADS];
+static uint64_t Seed;
 
 static inline uint64_t
 asuint64 (double f)
@@ -80,12 +80,10 @@ asfloat64 (uint64_t i)
 typedef union {double f; uint64_t u;} b64u64_u;
 
 static double
-get_random (int tid)
+get_random (philox_t *s)
 {
   b64u64_u v;
-  v.u = rand_r (Seed + tid);
-  v.u |= (uint64_t) rand_r (Seed + tid) << 31;
-  v.u |= (uint64_t) rand_r (Seed + tid) << 62;
+  v.u = philox_u64 (s);
   return v.f;
 }
 
@@ -181,9 +179,7 @@ main (int argc, char *argv[])
   check_subnormal ();
 
   printf ("Random tests\n");
-  unsigned int seed = getpid ();
-  for (int i = 0; i < MAX_THREADS; i++)
-    Seed[i] = seed + i;
+  Seed = philox_seed ();
 
 #define XMAX 0x1.b39dc41e48bfdp+4
 #define XMIN -0x1.7744f8f74e94bp2
@@ -196,13 +192,9 @@ main (int argc, char *argv[])
     ref_init ();
     ref_fesetround (rnd);
     double x;
-    int tid;
-#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
-    tid = omp_get_thread_num ();
-#else
-    tid = 0;
-#endif
-    do x = get_random (tid); while (x < XMIN || XMAX < x);
+    philox_t s;
+    philox_init (&s, Seed, n);
+    do x = get_random (&s); while (x < XMIN || XMAX < x);
     check (x);
   }
 
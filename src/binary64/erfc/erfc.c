@@ -1031,7 +1031,11 @@ erfc_asympt_accurate (double x)
 #ifdef CORE_MATH_SUPPORT_ERRNO
     errno = ERANGE; // underflow
 #endif
-    return __builtin_fma (0x1p-1074, -0.25, 0x1.99ef5883f656cp-1024);
+    /* 0x1.99ef5883f656cp-1024 - 2^-1076, as a product of normal numbers,
+       so that in FTZ/DAZ mode the result is flushed to +0
+       (h is volatile to prevent constant folding) */
+    volatile double h = 0x1.99ef5883f656bp-548;
+    return h * 0x1p-476;
   }
 
   double h, l;
@@ -1203,7 +1207,8 @@ cr_erfc (double x)
         if (t.u == 0xfff0000000000000) return 2.0; // -Inf
         return x + x;                              // NaN
       }
-      return 2.0 - 0x1p-54;                        // rounds to 2 or below(2)
+      volatile double two = 2.0;                   // prevents constant folding
+      return two - 0x1p-54;                        // rounds to 2 or below(2)
     }
 
     // for -0x1.c5bf891b4ef6ap-54 <= x <= 0, erfc(x) rounds to 1 (to nearest)
@@ -1223,7 +1228,8 @@ cr_erfc (double x)
 #ifdef CORE_MATH_SUPPORT_ERRNO
       errno = ERANGE;
 #endif
-      return 0x1p-1074 * 0.25;                     // 0 or 2^-1074 wrt rounding
+      volatile double tiny = 0x1p-1074;            // prevents constant folding
+      return tiny * 0.25;                          // 0 or 2^-1074 wrt rounding
     }
 
     // for 0 <= x <= 0x1.c5bf891b4ef6ap-55, erfc(x) rounds to 1 (to nearest)
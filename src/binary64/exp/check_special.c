@@ -25,30 +25,36 @@ SOFTWARE.
 */
 
 #include <stdio.h>
+#include <errno.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
 #include <fenv.h>
 #include <math.h>
 #include <unistd.h>
+#include <mpfr.h>
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
 #include <omp.h>
 #endif
 
+#include "../../generic/support/philox.h"
+
 int ref_fesetround (int);
 void ref_init (void);
 
 double cr_exp (double);
 double ref_exp (double);
+double cr_exp_inrange (double);
+double cr_exp_dd (double, double, double *);
+void cr_exp_interval (double, double *, double *);
+double cr_exp_r (double, int);
 
 int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
 
 int rnd = 0;
 int verbose = 0;
 
-#define MAX_THREADS 192
-
-static unsigned int Seed[MAX_THREADS];
+static uint64_t Seed;
 
 static inline uint64_t
 asuint64 (double f)
@@ -97,15 +103,194 @@ check (double x)
 typedef union {double f; uint64_t u;} b64u64_u;
 
 static double
-get_random (int tid)
+get_random (philox_t *s)
 {
   b64u64_u v;
-  v.u = rand_r (Seed + tid);
-  v.u |= (uint64_t) rand_r (Seed + tid) << 31;
-  v.u |= (uint64_t) rand_r (Seed + tid) << 62;
+  v.u = philox_u64 (s);
   return v.f;
 }
 
+/* The exceptions compared between cr_exp_r(x,rnd1[rnd]) and cr_exp(x) in the
+   rounding mode rnd1[rnd], and between cr_exp_inrange(x) and cr_exp(x).
+   Inexact is only checked with CORE_MATH_CHECK_INEXACT. */
+#ifdef CORE_MATH_CHECK_INEXACT
+#define CHECKED_FLAGS (FE_INEXACT | FE_UNDERFLOW | FE_OVERFLOW | FE_INVALID \
+                       | FE_DIVBYZERO)
+#else
+#define CHECKED_FLAGS (FE_UNDERFLOW | FE_OVERFLOW | FE_INVALID | FE_DIVBYZERO)
+#endif
+
+/* Check cr_exp_interval(x) and cr_exp_r(x,rnd1[rnd]), which assume the
+   rounding mode is to nearest: [lo,hi] should contain the MPFR value of
+   exp(x) rounded according to rnd1[rnd] (and be equal to it for rounding
+   toward -Inf or +Inf), lo and hi should be cr_exp(x) rounded toward -Inf
+   and +Inf, cr_exp_r(x,rnd1[rnd]) should be the MPFR value, and the
+   rounding mode should be unchanged. The exceptions (and errno) of
+   cr_exp_r(x,rnd1[rnd]) should be those of cr_exp(x) in the rounding mode
+   rnd1[rnd], and cr_exp_interval(x) should raise invalid and divide-by-zero
+   as cr_exp(x), and inexact exactly when lo <> hi (see README.md). */
+static void
+check_interval (double x)
+{
+  double y1 = ref_exp (x), lo, hi, lo1, hi1, y2, z;
+  int flags0, flags1, flags2, flags3, err1, err3;
+  fesetround (FE_DOWNWARD);
+  lo1 = cr_exp (x);
+  fesetround (FE_UPWARD);
+  hi1 = cr_exp (x);
+  fesetround (FE_TONEAREST);
+  feclearexcept (FE_ALL_EXCEPT);
+  cr_exp (x);
+  flags0 = fetestexcept (FE_INVALID | FE_DIVBYZERO);
+  fesetround (rnd1[rnd]);
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  y2 = cr_exp (x);
+  flags1 = fetestexcept (CHECKED_FLAGS);
+  err1 = errno;
+  fesetround (FE_TONEAREST);
+  feclearexcept (FE_ALL_EXCEPT);
+  cr_exp_interval (x, &lo, &hi);
+  flags2 = fetestexcept (FE_ALL_EXCEPT);
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  z = cr_exp_r (x, rnd1[rnd]);
+  flags3 = fetestexcept (CHECKED_FLAGS);
+  err3 = errno;
+  if (fegetround () != FE_TONEAREST)
+  {
+    printf ("Rounding mode changed by cr_exp_interval or cr_exp_r for x=%la\n",
+            x);
+    exit (1);
+  }
+  if (!is_equal (lo, lo1) || !is_equal (hi, hi1))
+  {
+    printf ("FAIL x=%la cr_exp_interval=[%la,%la] cr_exp=[%la,%la]\n",
+            x, lo, hi, lo1, hi1);
+    exit (1);
+  }
+  if ((!is_nan (y1) && !(lo <= y1 && y1 <= hi)) ||
+      (rnd == 3 && !is_equal (lo, y1)) || (rnd == 2 && !is_equal (hi, y1)))
+  {
+    printf ("FAIL x=%la ref=%la cr_exp_interval=[%la,%la]\n", x, y1, lo, hi);
+    exit (1);
+  }
+  if (!is_equal (z, y1) || !is_equal (z, y2))
+  {
+    printf ("FAIL x=%la ref=%la cr_exp=%la cr_exp_r=%la\n", x, y1, y2, z);
+    exit (1);
+  }
+  if (flags3 != flags1)
+  {
+    printf ("FAIL x=%la cr_exp_r raises exceptions %#x instead of %#x\n",
+            x, flags3, flags1);
+    exit (1);
+  }
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  if (err3 != err1)
+  {
+    printf ("FAIL x=%la cr_exp_r sets errno=%d instead of %d\n", x, err3, err1);
+    exit (1);
+  }
+#else
+  (void) err1;
+  (void) err3;
+#endif
+  if ((flags2 & (FE_INVALID | FE_DIVBYZERO)) != flags0)
+  {
+    printf ("FAIL x=%la cr_exp_interval raises exceptions %#x instead of %#x\n",
+            x, flags2 & (FE_INVALID | FE_DIVBYZERO), flags0);
+    exit (1);
+  }
+#ifdef CORE_MATH_CHECK_INEXACT
+  if (((flags2 & FE_INEXACT) != 0) == is_equal (lo, hi))
+  {
+    printf ("%s inexact exception for x=%la cr_exp_interval=[%la,%la]\n",
+            (flags2 & FE_INEXACT) ? "Spurious" : "Missing", x, lo, hi);
+    exit (1);
+  }
+#endif
+}
+
+/* Check the error bound of cr_exp_dd(xh,xl,&l) given in exp.c: for |xh| < 693
+   the relative error of h + l is less than 2^-62.4, otherwise h = cr_exp(xh)
+   and l = 0. We assume the lsb of xl is not below 2^-200 |xh|. */
+static void
+check_dd (double xh, double xl)
+{
+  double l, h = cr_exp_dd (xh, xl, &l);
+  if (!(fabs (xh) < 693))
+  {
+    double y = cr_exp (xh);
+    if (!is_equal (h, y) || l != 0)
+    {
+      printf ("FAIL xh=%la xl=%la cr_exp=%la cr_exp_dd=%la,%la\n", xh, xl, y, h, l);
+      exit (1);
+    }
+    return;
+  }
+  // use the full exponent range, ref_init() sets that of binary64
+  mpfr_exp_t emin = mpfr_get_emin (), emax = mpfr_get_emax ();
+  mpfr_set_emin (mpfr_get_emin_min ());
+  mpfr_set_emax (mpfr_get_emax_max ());
+  mpfr_t t, y;
+  mpfr_inits2 (256, t, y, NULL);
+  mpfr_set_d (t, xh, MPFR_RNDN);
+  mpfr_add_d (t, t, xl, MPFR_RNDN); // exact
+  mpfr_exp (y, t, MPFR_RNDN);
+  mpfr_sub_d (t, y, h, MPFR_RNDN);
+  mpfr_sub_d (t, t, l, MPFR_RNDN);
+  mpfr_div (t, t, y, MPFR_RNDN);
+  double err = fabs (mpfr_get_d (t, MPFR_RNDN));
+  mpfr_clears (t, y, NULL);
+  mpfr_set_emin (emin);
+  mpfr_set_emax (emax);
+  if (err >= exp2 (-62.4))
+  {
+    printf ("FAIL xh=%la xl=%la cr_exp_dd=%la,%la relative error=%la\n",
+            xh, xl, h, l, err);
+    exit (1);
+  }
+}
+
+/* Check that cr_exp_inrange(x) = cr_exp(x), with the same exceptions (and
+   errno), for x in the domain of
+   cr_exp_inrange, -0x1.6232bdd7abcd2p+9 <= x <= 0x1.62e42fefa39efp+9. */
+static void
+check_inrange (double x)
+{
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  double y = cr_exp (x);
+  int flags1 = fetestexcept (CHECKED_FLAGS), err1 = errno;
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  double z = cr_exp_inrange (x);
+  int flags2 = fetestexcept (CHECKED_FLAGS), err2 = errno;
+  if (!is_equal (y, z))
+  {
+    printf ("FAIL x=%la cr_exp=%la cr_exp_inrange=%la\n", x, y, z);
+    exit (1);
+  }
+  if (flags2 != flags1)
+  {
+    printf ("FAIL x=%la cr_exp_inrange raises exceptions %#x instead of %#x\n",
+            x, flags2, flags1);
+    exit (1);
+  }
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  if (err2 != err1)
+  {
+    printf ("FAIL x=%la cr_exp_inrange sets errno=%d instead of %d\n",
+            x, err2, err1);
+    exit (1);
+  }
+#else
+  (void) err1;
+  (void) err2;
+#endif
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -196,9 +381,7 @@ main (int argc, char *argv[])
   for (int64_t n = n0; n < n1; n += skip)
     check (ldexp ((double) n, -43));
 
-  unsigned int seed = getpid ();
-  for (int i = 0; i < MAX_THREADS; i++)
-    Seed[i] = seed + i;
+  Seed = philox_seed ();
 
   printf ("Checking random values\n");
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
@@ -208,14 +391,93 @@ main (int argc, char *argv[])
   {
     ref_init ();
     ref_fesetround (rnd);
-    int tid;
+    philox_t s;
+    philox_init (&s, Seed, n);
+    double x = get_random (&s);
+    check (x);
+  }
+
+  printf ("Checking cr_exp_interval and cr_exp_r\n");
+  static const double T[] = {0x0p+0, 0x1p-1074, 0x1p-60, 0x1p-53, 0x1p-52,
+    0x1.62e42fefa39efp+9, 0x1.62e42fefa39fp+9, 0x1p+10, -0x1.74910d52d3051p+9,
+    -0x1.6232bdd7abcd2p+9, -0x1.74385446d71c3p+9, -0x1p+10, INFINITY, NAN};
+  for (unsigned i = 0; i < sizeof (T) / sizeof (T[0]); i++)
+  {
+    check_interval (T[i]);
+    check_interval (-T[i]);
+  }
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
-    tid = omp_get_thread_num ();
-#else
-    tid = 0;
+#pragma omp parallel for
 #endif
-    double x = get_random (tid);
-    check (x);
+  for (uint64_t n = 0; n < CORE_MATH_TESTS / 16; n++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    philox_t s;
+    // the counters n + CORE_MATH_TESTS are not used by the previous loop
+    philox_init (&s, Seed, n + CORE_MATH_TESTS);
+    b64u64_u v = {.f = get_random (&s)};
+    // for half of the values, |x| < 2^10, where exp(x) is finite and nonzero
+    if (v.u & 1)
+      v.u = (v.u & 0x800fffffffffffffull) | ((0x3c3 + (v.u >> 52) % 0x46) << 52);
+    check_interval (v.f);
+  }
+
+  printf ("Checking cr_exp_dd\n");
+  static const double D[] = {0x0p+0, 0x1p-1074, 0x1p-60, 0x1p-53, 0x1p+0,
+    0x1.5a7ffffffffffp+9, 0x1.5a8p+9, 0x1.62e42fefa39efp+9, INFINITY, NAN};
+  for (unsigned i = 0; i < sizeof (D) / sizeof (D[0]); i++)
+  {
+    check_dd (D[i], 0);
+    check_dd (-D[i], 0);
+  }
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t n = 0; n < CORE_MATH_TESTS / 16; n++)
+  {
+    fesetround (rnd1[rnd]);
+    philox_t s;
+    // the counters n + 2 * CORE_MATH_TESTS are not used by the other loops
+    philox_init (&s, Seed, n + 2 * CORE_MATH_TESTS);
+    b64u64_u v = {.f = get_random (&s)};
+    // for half of the values, |xh| < 2^10
+    if (v.u & 1)
+      v.u = (v.u & 0x800fffffffffffffull) | ((0x3c3 + (v.u >> 52) % 0x46) << 52);
+    double xh = v.f;
+    /* |xl| <= ulp(xh)/2, where xl is a multiple of ulp(xh)*2^-64, and xl = 0
+       when this would underflow */
+    double xl = (0x1p-958 <= fabs (xh) && fabs (xh) <= 0x1.fffffffffffffp+1023)
+      ? ldexp ((double) (int64_t) philox_u64 (&s) * 0x1p-63, ilogb (xh) - 53)
+      : 0;
+    check_dd (xh, xl);
+  }
+
+  printf ("Checking cr_exp_inrange\n");
+  static const double I[] = {-0x1.6232bdd7abcd2p+9, -0x1.6232bdd7abcd1p+9,
+    -0x1.c8127bf086551p-679, -0x1p-1074, 0x0p+0, 0x1p-1074, 0x1p-54,
+    0x1.0000000000001p-54, 0x1.62e42fefa39eep+9, 0x1.62e42fefa39efp+9};
+  fesetround (rnd1[rnd]);
+  for (unsigned i = 0; i < sizeof (I) / sizeof (I[0]); i++)
+    check_inrange (I[i]);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t n = 0; n < CORE_MATH_TESTS / 16; n++)
+  {
+    fesetround (rnd1[rnd]);
+    philox_t s;
+    // the counters n + 3 * CORE_MATH_TESTS are not used by the other loops
+    philox_init (&s, Seed, n + 3 * CORE_MATH_TESTS);
+    b64u64_u v;
+    // |x| < 2^10, rejecting x outside the domain of cr_exp_inrange
+    do
+    {
+      v.u = philox_u64 (&s);
+      v.u = (v.u & 0x800fffffffffffffull) | ((0x3c3 + (v.u >> 52) % 0x46) << 52);
+    }
+    while (!(-0x1.6232bdd7abcd2p+9 <= v.f && v.f <= 0x1.62e42fefa39efp+9));
+    check_inrange (v.f);
   }
 
   return 0;
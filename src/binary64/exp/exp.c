@@ -30,6 +30,21 @@ SOFTWARE.
 #if defined(__x86_64__)
 #include <x86intrin.h>
 #endif
+#ifdef CORE_MATH_DEBUG
+#include <assert.h>
+#endif
+
+/* With -DCORE_MATH_TABLE_SECTION, the tables below are put in the section
+   core_math_tables_exp, aligned on cache lines, see
+   src/generic/support/warmup.h. */
+#ifndef CORE_MATH_TABLE
+#ifdef CORE_MATH_TABLE_SECTION
+#define CORE_MATH_TABLE(family) \
+  __attribute__((section ("core_math_tables_" #family), aligned (64)))
+#else
+#define CORE_MATH_TABLE(family)
+#endif
+#endif
 
 // Warning: clang also defines __GNUC__
 #if defined(__GNUC__) && !defined(__clang__)
@@ -188,8 +203,16 @@ static double __attribute__((noinline)) as_exp_database(double x, double f){
   return f;
 }
 
+#ifdef CORE_MATH_SHARED_EXP_TABLES
+/* The tables t0 and t1 are identical in exp, exp2, exp10, expm1, sinh, cosh
+   and tanh: with -DCORE_MATH_SHARED_EXP_TABLES, a single copy is used,
+   defined in src/binary64/support/exp_tables.c. */
+extern const double core_math_exp_t0[64][2], core_math_exp_t1[64][2];
+#define t0 core_math_exp_t0
+#define t1 core_math_exp_t1
+#else
 // for 0 <= i < 2^6, t0[i] is a double-double approximation of 2^(i/2^6)
-static const double t0[][2] = {
+static const double t0[][2] CORE_MATH_TABLE (exp) = {
   {0x0p+0, 0x1p+0}, {-0x1.19083535b085ep-56, 0x1.02c9a3e778061p+0},
   {0x1.d73e2a475b466p-55, 0x1.059b0d3158574p+0}, {0x1.186be4bb285p-57, 0x1.0874518759bc8p+0},
   {0x1.8a62e4adc610ap-54, 0x1.0b5586cf9890fp+0}, {0x1.03a1727c57b52p-59, 0x1.0e3ec32d3d1a2p+0},
@@ -225,7 +248,7 @@ static const double t0[][2] = {
 };
 
 // for 0 <= i < 2^6, t1[i] is a double-double approximation of 2^(i/2^12)
-static const double t1[][2] = {
+static const double t1[][2] CORE_MATH_TABLE (exp) = {
   {0x0p+0, 0x1p+0}, {0x1.ae8e38c59c72ap-54, 0x1.000b175effdc7p+0},
   {-0x1.7b5d0d58ea8f4p-58, 0x1.00162f3904052p+0}, {0x1.4115cb6b16a8ep-54, 0x1.0021478e11ce6p+0},
   {-0x1.d7c96f201bb2ep-55, 0x1.002c605e2e8cfp+0}, {0x1.84711d4c35eap-54, 0x1.003779a95f959p+0},
@@ -259,6 +282,7 @@ static const double t1[][2] = {
   {0x1.64cbba902ca28p-58, 0x1.029ccf99d720ap+0}, {0x1.4383ef231d206p-54, 0x1.02a803f2d170dp+0},
   {0x1.4a47a505b3a46p-54, 0x1.02b338c811703p+0}, {0x1.e47120223468p-54, 0x1.02be6e199c811p+0},
 };
+#endif
 
 static double __attribute__((cold,noinline)) as_exp_accurate(double x){
   static const double ch[][2] =
@@ -315,6 +339,66 @@ static double __attribute__((cold,noinline)) as_exp_accurate(double x){
   return fh;
 }
 
+#ifdef CORE_MATH_MEMO
+/* With -DCORE_MATH_MEMO, the results of as_exp_accurate() are stored in a
+   thread-local direct-mapped cache of 2^CORE_MATH_MEMO_BITS entries, indexed
+   by the bits of x, and tagged with x and the rounding mode, so that hard
+   inputs which recur do not pay the accurate path again. The cache is only
+   consulted after the rounding test of the fast path failed. */
+#ifndef CORE_MATH_MEMO_BITS
+#define CORE_MATH_MEMO_BITS 8
+#endif
+typedef struct {u64 x; double r; int rnd;} memo_t; // rnd = 0: empty entry
+static __thread memo_t memo[1 << CORE_MATH_MEMO_BITS];
+static __thread u64 memo_hits, memo_misses;
+
+static double __attribute__((cold,noinline)) as_exp_accurate_memo(double x){
+  b64u64_u ix = {.f = x};
+  int rnd = fegetround() + 1;
+  memo_t *m = memo + ((ix.u*0x9e3779b97f4a7c15ull)>>(64 - CORE_MATH_MEMO_BITS));
+  if(m->x == ix.u && m->rnd == rnd){
+    memo_hits++;
+    return m->r;
+  }
+  memo_misses++;
+  double r = as_exp_accurate(x);
+  m->x = ix.u;
+  m->r = r;
+  m->rnd = rnd;
+  return r;
+}
+
+/* Put in *hits and *misses the numbers of calls of the accurate path of
+   cr_exp() found and not found in the cache, for the calling thread. */
+void cr_exp_memo_stats(u64 *hits, u64 *misses){
+  *hits = memo_hits;
+  *misses = memo_misses;
+}
+#else
+#define as_exp_accurate_memo as_exp_accurate
+#endif
+
+/* Fast path for exp(x), for |x| < 745: return fh, and put in fl and ie
+   values such that |exp(x)*2^-ie - (fh+fl)| < 1.64e-19, where 1 <= fh < 2 */
+static inline double as_exp_fast(double x, double *fl, i64 *ie){
+  const double s = 0x1.71547652b82fep+12;
+  double t = roundeven_finite(x*s);
+  i64 jt = t, i0 = (jt>>6)&0x3f, i1 = jt&0x3f;
+  *ie = jt>>12;
+  double t0h = t0[i0][1], t0l = t0[i0][0];
+  double t1h = t1[i1][1], t1l = t1[i1][0];
+  double tl, th = muldd(t0h,t0l, t1h,t1l, &tl);
+  const double l2h = 0x1.62e42ffp-13, l2l = 0x1.718432a1b0e26p-47;
+  /* Use Cody-Waite argument reduction: since |x| < 745, we have |t| < 2^23,
+     thus since l2h is exactly representable on 29 bits, l2h*t is exact. */
+  double dx = (x - l2h*t) + l2l*t, dx2 = dx*dx;
+  static const double ch[] = {0x1p+0, 0x1p-1, 0x1.55555557e54ffp-3, 0x1.55555553a12f4p-5};
+  double p = (ch[0] + dx*ch[1]) + dx2*(ch[2] + dx*ch[3]);
+  double tx = th*dx;
+  *fl = tl + tx*p;
+  return th;
+}
+
 double cr_exp(double x){
   b64u64_u ix = {.f = x};
   u64 aix = ix.u & (~(u64)0>>1);
@@ -340,22 +424,12 @@ double cr_exp(double x){
 #ifdef CORE_MATH_SUPPORT_ERRNO
       errno = ERANGE; // underflow
 #endif
-      return 0x1.8p-1022 * 0x1p-55;
+      volatile double z = 0x1.8p-1022; // prevents constant folding
+      return z * 0x1p-55;
     }
   }
-  const double s = 0x1.71547652b82fep+12;
-  double t = roundeven_finite(x*s);
-  i64 jt = t, i0 = (jt>>6)&0x3f, i1 = jt&0x3f, ie = jt>>12;
-  double t0h = t0[i0][1], t0l = t0[i0][0];
-  double t1h = t1[i1][1], t1l = t1[i1][0];
-  double tl, th = muldd(t0h,t0l, t1h,t1l, &tl);
-  const double l2h = 0x1.62e42ffp-13, l2l = 0x1.718432a1b0e26p-47;
-  /* Use Cody-Waite argument reduction: since |x| < 745, we have |t| < 2^23,
-     thus since l2h is exactly representable on 29 bits, l2h*t is exact. */
-  double dx = (x - l2h*t) + l2l*t, dx2 = dx*dx;
-  static const double ch[] = {0x1p+0, 0x1p-1, 0x1.55555557e54ffp-3, 0x1.55555553a12f4p-5};
-  double p = (ch[0] + dx*ch[1]) + dx2*(ch[2] + dx*ch[3]);
-  double fh = th, tx = th*dx, fl = tl + tx*p;
+  i64 ie;
+  double fl, fh = as_exp_fast(x, &fl, &ie);
   double eps = 1.64e-19;
   if(__builtin_expect(ix.u>0xc086232bdd7abcd2ull, 0)){
     // subnormal case: x < -0x1.6232bdd7abcd2p+9
@@ -371,8 +445,154 @@ double cr_exp(double x){
     fh = as_todenormal(lb);
   } else {
     double ub = fh + (fl + eps), lb = fh + (fl - eps);
-    if(__builtin_expect( ub != lb, 0)) return as_exp_accurate(x);
+    if(__builtin_expect( ub != lb, 0)) return as_exp_accurate_memo(x);
     fh = as_ldexp(lb, ie);
   }
   return fh;
 }
+
+/* Same as cr_exp(), for -0x1.6232bdd7abcd2p+9 <= x <= 0x1.62e42fefa39efp+9,
+   where exp(x) is in the normal range (in particular x is neither NaN nor
+   Inf): the tests of the special cases above are skipped, except that of
+   tiny |x|, for which dx*dx in as_exp_fast() would raise a spurious
+   underflow. The contract is checked with -DCORE_MATH_DEBUG only, other
+   inputs give unspecified results. */
+double cr_exp_inrange(double x){
+#ifdef CORE_MATH_DEBUG
+  assert(x >= -0x1.6232bdd7abcd2p+9 && x <= 0x1.62e42fefa39efp+9);
+#endif
+  b64u64_u ix = {.f = x};
+  if(__builtin_expect((ix.u & (~(u64)0>>1)) <= 0x3c90000000000000ull, 0))
+    return 1.0 + x; // |x| <= 0x1p-54, see cr_exp()
+  i64 ie;
+  double fl, fh = as_exp_fast(x, &fl, &ie);
+  double eps = 1.64e-19;
+  double ub = fh + (fl + eps), lb = fh + (fl - eps);
+  if(__builtin_expect( ub != lb, 0)) return as_exp_accurate_memo(x);
+  return as_ldexp(lb, ie);
+}
+
+/* Return h and put in l a double-double approximation h + l of exp(xh+xl),
+   from the fast path of cr_exp(), where |xl| <= ulp(xh)/2. For |xh| < 693,
+   the relative error is less than 2^-62.4: h + l = (fh+fl)*(1+xl)*2^ie,
+   where the error of as_exp_fast() is less than 1.64e-19 < 2^-62.403, the
+   neglected term xl^2/2 is less than 2^-88, and the other rounding errors
+   are less than 2^-87, including that of l*2^ie since exp(xh+xl) > 2^-1000.
+   Otherwise (including NaN and Inf), h is cr_exp(xh) and l is 0. */
+double cr_exp_dd(double xh, double xl, double *l){
+  b64u64_u ix = {.f = xh};
+  if(__builtin_expect((ix.u & (~(u64)0>>1)) >= 0x4085a80000000000ull, 0)){
+    // |xh| >= 693, NaN or Inf
+    *l = 0;
+    return cr_exp(xh);
+  }
+  i64 ie;
+  double fl, fh = as_exp_fast(xh, &fl, &ie);
+  fl += (fh + fl)*xl;
+  fh = fasttwosum(fh, fl, &fl);
+  b64u64_u s = {.u = (u64)(ie + 0x3ff)<<52}; // 2^ie, with -1000 <= ie < 1000
+  *l = fl*s.f;
+  return fh*s.f;
+}
+
+/* Set *lo and *hi to the roundings downwards and upwards of a number y
+   with |y - (h+l)| < err and |l| < ulp(h), and return 1, or return 0 when
+   y might be too close to a binary64 number (or equal to it).
+   Let v be h+l rounded with the current rounding mode. Since v-h is exact,
+   d = l-(v-h) is within 2^-52*|d| of h+l-v, where |d| <= ulp(v). Let v+ be
+   the next binary64 number after v away from zero, and v- the next one
+   towards zero. With s = 1 for v > 0 and s = -1 for v < 0, if s*d > m and
+   s*d + m < |v+ - v|, where the margin m = err + 2^-50*|v+ - v| accounts
+   for the above rounding errors, then |y| lies strictly between |v| and
+   |v+|, and similarly for |v-|. This does not depend on the rounding mode.
+*/
+static inline int as_interval(double h, double l, double err, double *lo, double *hi){
+  double v = h + l, d = l - (v - h);
+  b64u64_u t = {.f = v};
+  if(__builtin_expect(!(t.u<<1) || (t.u<<1) >= 0x7ffull<<53, 0)) return 0;
+  b64u64_u up = {.u = t.u + 1}, dn = {.u = t.u - 1};
+  double a = __builtin_fabs(up.f - v), b = __builtin_fabs(v - dn.f);
+  double m = err + a*0x1p-50, sd = (t.u>>63) ? -d : d;
+  if(sd > m && sd + m < a){ // |v| < |y| < |v+|
+    *lo = (t.u>>63) ? up.f : v;
+    *hi = (t.u>>63) ? v : up.f;
+  } else if(sd < -m && sd - m > -b){ // |v-| < |y| < |v|
+    *lo = (t.u>>63) ? v : dn.f;
+    *hi = (t.u>>63) ? dn.f : v;
+  } else
+    return 0;
+  return 1;
+}
+
+/* Slow path of cr_exp_interval(), also used for the special cases: call
+   cr_exp() twice with the corresponding rounding modes. */
+static void __attribute__((noinline)) as_exp_interval_slow(double x, double *lo, double *hi){
+  /* x is read from a volatile variable after each change of the rounding
+     mode, otherwise the compiler might evaluate cr_exp(x) only once */
+  volatile double vx = x;
+  int rm = fegetround();
+  fesetround(FE_DOWNWARD);
+  *lo = cr_exp(vx);
+  fesetround(FE_UPWARD);
+  *hi = cr_exp(vx);
+  fesetround(rm);
+}
+
+/* Set *lo and *hi to exp(x) rounded downwards and upwards, from a single
+   evaluation of the fast path of cr_exp(), and without changing the
+   rounding mode, except in the rare cases where the slow path is used
+   (about 0.2% of random inputs, and the subnormal and overflow ranges).
+   Inexact is raised when lo <> hi, overflow and underflow are unspecified
+   (see README.md). */
+void cr_exp_interval(double x, double *lo, double *hi){
+  b64u64_u ix = {.f = x};
+  u64 aix = ix.u & (~(u64)0>>1);
+  if(__builtin_expect(aix <= 0x3c90000000000000ull, 0)){ // |x| <= 0x1p-54
+    // 1 - 2^-54 < 1 + x < exp(x) < 1 + x + x^2 < 1 + 2^-53 for x <> 0
+    if(aix) feraiseexcept(FE_INEXACT);
+    *lo = (ix.u>>63 && aix) ? 0x1.fffffffffffffp-1 : 1.0;
+    *hi = (ix.u>>63 || !aix) ? 1.0 : 0x1.0000000000001p+0;
+    return;
+  }
+  // |x| >= 0x1.6232bdd7abcd2p+9: NaN, Inf, overflow or subnormal range
+  if(__builtin_expect(aix > 0x4086232bdd7abcd2ull, 0))
+    return as_exp_interval_slow(x, lo, hi);
+  i64 ie;
+  double fl, fh = as_exp_fast(x, &fl, &ie);
+  if(__builtin_expect(!as_interval(fh, fl, 1.64e-19, lo, hi), 0))
+    return as_exp_interval_slow(x, lo, hi);
+  *lo = as_ldexp(*lo, ie);
+  *hi = as_ldexp(*hi, ie);
+}
+
+/* Return cr_exp(x) evaluated in the rounding mode rnd, which raises the
+   same exceptions (and sets errno) as cr_exp() in that mode. */
+static double __attribute__((noinline)) as_exp_r_slow(double x, int rnd){
+  volatile double vx = x; // see as_exp_interval_slow()
+  int rm = fegetround();
+  fesetround(rnd);
+  volatile double r = cr_exp(vx);
+  fesetround(rm);
+  return r;
+}
+
+/* Return exp(x) rounded according to rnd (FE_TONEAREST, FE_DOWNWARD,
+   FE_UPWARD or FE_TOWARDZERO), assuming the current rounding mode is the
+   default one (to nearest), which is never changed, except in the rare
+   cases where cr_exp_interval() uses its slow path. The directed roundings
+   are derived from the fast path of cr_exp() by cr_exp_interval(), which
+   raises inexact like cr_exp() where exp(x) is in the normal range.
+   Elsewhere (NaN, Inf, overflow or subnormal range) cr_exp() is called in
+   the rounding mode rnd, so that the exceptions raised (and errno) are
+   always those of cr_exp() in that mode. */
+double cr_exp_r(double x, int rnd){
+  if(rnd != FE_DOWNWARD && rnd != FE_UPWARD && rnd != FE_TOWARDZERO)
+    return cr_exp(x); // FE_TONEAREST
+  b64u64_u ix = {.f = x};
+  // |x| > 0x1.6232bdd7abcd2p+9: NaN, Inf, overflow or subnormal range
+  if(__builtin_expect((ix.u & (~(u64)0>>1)) > 0x4086232bdd7abcd2ull, 0))
+    return as_exp_r_slow(x, rnd);
+  double lo, hi;
+  cr_exp_interval(x, &lo, &hi);
+  return (rnd == FE_UPWARD) ? hi : lo; // exp(x) > 0
+}
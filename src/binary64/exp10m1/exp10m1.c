@@ -956,7 +956,8 @@ cr_exp10m1 (double x)
     if ((ux >> 52) == 0xfff) // -NaN or -Inf
       return (ux > 0xfff0000000000000llu) ? x + x: -1.0;
     // for x <= -0x1.041704c068efp+4, exp10m1(x) rounds to -1 to nearest
-    return -1.0 + 0x1p-54;
+    volatile double one = 1.0; // prevents constant folding
+    return -one + 0x1p-54;
   }
   else if (__builtin_expect (ax > 0x40734413509f79fellu, 0))
   {
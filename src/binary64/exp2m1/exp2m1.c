@@ -851,7 +851,8 @@ cr_exp2m1 (double x)
     if ((ux >> 52) == 0xfff) // -NaN or -Inf
       return (ux > 0xfff0000000000000llu) ? x + x : -1.0;
     // for x <= -54, exp2m1(x) rounds to -1 to nearest
-    return -1.0 + 0x1p-54;
+    volatile double one = 1.0; // prevents constant folding
+    return -one + 0x1p-54;
   }
   else if (__builtin_expect (ax >= 0x4090000000000000llu, 0))
   {
@@ -861,7 +862,8 @@ cr_exp2m1 (double x)
     /* for x >= 1024, exp2m1(x) rounds to +Inf to nearest,
        but for RNDZ/RNDD, we should have no overflow for x=1024 */
 #ifdef CORE_MATH_SUPPORT_ERRNO
-    if (x > 1024.0 || (1.0 - 0x1p-54 == 1.0))
+    volatile double one = 1.0; // the rounding mode must be detected at run time
+    if (x > 1024.0 || (one - 0x1p-54 == one))
       errno = ERANGE; // overflow
 #endif
     return 0x1.fffffffffffffp+1023 + x * 0x1.fffffffffffffp+960;
@@ -176,6 +176,12 @@ static double __attribute__((noinline)) as_expm1_database(double x, double f){
   return f;
 }
 
+#ifdef CORE_MATH_SHARED_EXP_TABLES
+// t0 and t1 are shared with exp, see src/binary64/support/exp_tables.c
+extern const double core_math_exp_t0[64][2], core_math_exp_t1[64][2];
+#define t0 core_math_exp_t0
+#define t1 core_math_exp_t1
+#else
 static const double t0[][2] = {
   {0x0p+0, 0x1p+0}, {-0x1.19083535b085ep-56, 0x1.02c9a3e778061p+0},
   {0x1.d73e2a475b466p-55, 0x1.059b0d3158574p+0}, {0x1.186be4bb285p-57, 0x1.0874518759bc8p+0},
@@ -245,6 +251,7 @@ static const double t1[][2] = {
   {0x1.64cbba902ca28p-58, 0x1.029ccf99d720ap+0}, {0x1.4383ef231d206p-54, 0x1.02a803f2d170dp+0},
   {0x1.4a47a505b3a46p-54, 0x1.02b338c811703p+0}, {0x1.e47120223468p-54, 0x1.02be6e199c811p+0},
 };
+#endif
 static const double tz[][2] = {
   {-0x1.797d4686c5393p-57, -0x1.c5041854df7d4p-3}, {-0x1.ea1cb9d163339p-55, -0x1.b881a23aebb48p-3},
   {0x1.f483a3e8cd60fp-55, -0x1.abe60e1f21838p-3}, {0x1.dffd920f493dbp-56, -0x1.9f3129931fabp-3},
@@ -359,7 +366,8 @@ double cr_expm1(double x){
   u64 aix = ix.u & (~(u64)0>>1);
   if(__builtin_expect(aix < 0x3fd0000000000000ull, 1)){
     if( __builtin_expect(aix < 0x3ca0000000000000ull, 0)) {
-      if( !aix ) return x;
+      // x == 0 also holds for subnormal x in DAZ mode
+      if( x == 0 ) return __builtin_copysign(0.0, x);
       double res = __builtin_fma(0x1p-54, __builtin_fabs(x), x);
 #ifdef CORE_MATH_SUPPORT_ERRNO
       /* we have underflow for |x| < 2^-1022 and for x=-0x1p-1022 and
@@ -400,7 +408,10 @@ double cr_expm1(double x){
       }
     }
     if(__builtin_expect(ix.u>=0xc0425e4f7b2737faull, 0)){
-      if(ix.u>=0xc042b708872320e2ull) return -1.0 + 0x1p-55;
+      if(ix.u>=0xc042b708872320e2ull){
+	volatile double one = 1.0; // prevents constant folding
+	return -one + 0x1p-55;
+      }
       return (0x1.25e4f7b2737fap+5 + x + 0x1.8486612173c69p-51)*0x1.71547652b82fep-54 - 0x1.fffffffffffffp-1;
     }
 
@@ -146,7 +146,8 @@ static double __attribute__((noinline)) as_hypot_denorm(u64 a, u64 b){
   rm = tm >> 1; // truncate the low bit
   underflow = rm < 0x10000000000000ull;
   if(__builtin_expect(rb || sb, 1)){
-    double op = 1.0 + 0x1p-54, om = 1.0 - 0x1p-54;
+    volatile double one = 1.0; // the rounding mode must be detected at run time
+    double op = one + 0x1p-54, om = one - 0x1p-54;
     if(__builtin_expect(op == om, 1)){ // rounding to nearest
       if(__builtin_expect(sb, 1)) {
 	rm += rb;
@@ -182,7 +183,8 @@ static double __attribute__((noinline)) as_hypot_denorm(u64 a, u64 b){
    also fits in a 128-bit integer), compared and adjusted if necessary using
    the exact value of x^2+y^2. */
 static double  __attribute__((noinline)) as_hypot_hard(double x, double y, const fexcept_t flag){
-  double op = 1.0 + 0x1p-54, om = 1.0 - 0x1p-54;
+  volatile double one = 1.0; // the rounding mode must be detected at run time
+  double op = one + 0x1p-54, om = one - 0x1p-54;
   b64u64_u xi = {.f = x}, yi = {.f = y};
   u64 bm = (xi.u&(~0ull>>12))|1ll<<52;
   u64 lm = (yi.u&(~0ull>>12))|1ll<<52;
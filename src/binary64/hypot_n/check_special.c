@@ -0,0 +1,414 @@
+/* Generate special cases for hypot_n testing.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fenv.h>
+#include <mpfr.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+#include <unistd.h>
+#include <math.h>
+#include "../../generic/support/philox.h"
+
+extern double cr_hypot_n (const double *, size_t);
+extern double cr_norm3 (double, double, double);
+extern int ref_fesetround (int);
+extern void ref_init (void);
+extern double ref_hypot_n (const double *, size_t);
+
+int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
+
+int rnd;
+int verbose = 0;
+uint64_t Seed;
+
+typedef union {double f; uint64_t u;} b64u64_u;
+
+static inline uint64_t
+asuint64 (double f)
+{
+  b64u64_u u = {.f = f};
+  return u.u;
+}
+
+/* define our own is_nan function to avoid depending from math.h */
+static inline int
+is_nan (double x)
+{
+  uint64_t u = asuint64 (x);
+  int e = u >> 52;
+  return (e == 0x7ff || e == 0xfff) && (u << 12) != 0;
+}
+
+static inline int
+is_equal (double x, double y)
+{
+  if (is_nan (x))
+    return is_nan (y);
+  if (is_nan (y))
+    return is_nan (x);
+  return asuint64 (x) == asuint64 (y);
+}
+
+static void
+print_array (const double *x, size_t n)
+{
+  for (size_t i = 0; i < n && i < 20; i++)
+    printf ("x[%zu]=%la\n", i, x[i]);
+  if (n > 20)
+    printf ("...\n");
+}
+
+static void
+check_aux (const double *x, size_t n)
+{
+  double z1 = ref_hypot_n (x, n);
+  double z = cr_hypot_n (x, n);
+  if (!is_equal (z, z1))
+  {
+    printf ("cr_hypot_n and ref_hypot_n differ for n=%zu\n", n);
+    print_array (x, n);
+    printf ("ref_hypot_n gives %la\n", z1);
+    printf ("cr_hypot_n  gives %la\n", z);
+    exit (1);
+  }
+  if (n == 3)
+  {
+    z = cr_norm3 (x[0], x[1], x[2]);
+    if (!is_equal (z, z1))
+    {
+      printf ("cr_norm3 and ref_hypot_n differ for x=%la y=%la z=%la\n",
+              x[0], x[1], x[2]);
+      printf ("ref_hypot_n gives %la\n", z1);
+      printf ("cr_norm3    gives %la\n", z);
+      exit (1);
+    }
+  }
+}
+
+#define MAXN 20
+
+/* check x[0..n-1], the reversed array and the array with the signs of the
+   even entries changed */
+static void
+check (const double *x, size_t n)
+{
+  double y[MAXN];
+  check_aux (x, n);
+  for (size_t i = 0; i < n; i++)
+    y[i] = x[n - 1 - i];
+  check_aux (y, n);
+  for (size_t i = 0; i < n; i++)
+    y[i] = (i & 1) ? x[i] : -x[i];
+  check_aux (y, n);
+}
+
+#ifndef CORE_MATH_TESTS
+#define CORE_MATH_TESTS 10000000ul // total number of tests
+#endif
+
+static double
+get_random (philox_t *s)
+{
+  b64u64_u v = {.u = philox_u64 (s)};
+  return v.f;
+}
+
+/* Fill x[0..n-1] with random values for test number i: if close is
+   non-zero, the exponents differ by less than 64, otherwise they are
+   uniformly distributed (this includes NaN and Inf) */
+static size_t
+random_array (double *x, uint64_t i, int close)
+{
+  philox_t s;
+  philox_init (&s, Seed, i);
+  size_t n = 1 + philox_u64 (&s) % MAXN;
+  int e0 = philox_u64 (&s) % 2098 - 1074;
+  for (size_t j = 0; j < n; j++)
+  {
+    x[j] = get_random (&s);
+    if (close && !is_nan (x[j]))
+    {
+      int e;
+      x[j] = ldexp (frexp (x[j], &e), e0 - (int) (philox_u64 (&s) % 64));
+    }
+  }
+  return n;
+}
+
+static void
+check_random (int close)
+{
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t i = 0; i < CORE_MATH_TESTS; i++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround (rnd1[rnd]);
+    double x[MAXN];
+    size_t n = random_array (x, i, close);
+    check (x, n);
+  }
+}
+
+/* Given x[0..n-2], set x[n-1] such that the norm of x[0..n-1] is close
+   to the 54-bit number closest to the norm of x[0..n-1] (as for y_worst()
+   in ../cart2pol/check_special.c) */
+static void
+set_worst (double *x, size_t n)
+{
+  mpfr_t S, T, Z;
+  mpfr_init2 (S, 4300);
+  mpfr_init2 (T, 4300);
+  mpfr_init2 (Z, 54);
+  mpfr_set_ui (S, 0, MPFR_RNDN);
+  for (size_t i = 0; i < n - 1; i++)
+  {
+    mpfr_set_d (T, x[i], MPFR_RNDN);
+    mpfr_sqr (T, T, MPFR_RNDN);
+    mpfr_add (S, S, T, MPFR_RNDN);
+  }
+  mpfr_set_d (T, x[n - 1], MPFR_RNDN);
+  mpfr_sqr (T, T, MPFR_RNDN);
+  mpfr_add (T, S, T, MPFR_RNDN);
+  mpfr_sqrt (Z, T, MPFR_RNDN);
+  mpfr_prec_round (Z, 4300, MPFR_RNDN);
+  mpfr_sqr (Z, Z, MPFR_RNDN);
+  mpfr_sub (Z, Z, S, MPFR_RNDN);
+  mpfr_sqrt (Z, Z, MPFR_RNDN);
+  x[n - 1] = mpfr_get_d (Z, MPFR_RNDN);
+  mpfr_clear (S);
+  mpfr_clear (T);
+  mpfr_clear (Z);
+}
+
+/* check hard cases with n values of exponent e0 - (0..m-1), where the
+   last value is adjusted by set_worst() */
+static void
+check_worst (size_t n, int m, int e0)
+{
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < 1000; i++)
+  {
+    // the MPFR computations below need the full exponent range
+    mpfr_set_emin (mpfr_get_emin_min ());
+    mpfr_set_emax (mpfr_get_emax_max ());
+    philox_t s;
+    philox_init (&s, Seed, ((uint64_t) n << 48) + ((uint64_t) m << 32) + i);
+    double x[MAXN];
+    for (size_t j = 0; j < n; j++)
+    {
+      int e;
+      x[j] = frexp (get_random (&s), &e);
+      x[j] = ldexp (isfinite (x[j]) ? x[j] : 0.5,
+                    e0 - (int) (philox_u64 (&s) % m));
+    }
+    set_worst (x, n);
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround (rnd1[rnd]);
+    check (x, n);
+  }
+}
+
+/* check k Pythagorean quadruples (a*2^e,b*2^e,c*2^e) whose norm d*2^e is
+   exact, with a = m^2+n^2-p^2-q^2, b = 2(mq+np), c = 2(nq-mp) and
+   d = m^2+n^2+p^2+q^2: the inexact flag should not be raised */
+static void
+check_quadruples (int k)
+{
+  philox_t s;
+  philox_init (&s, Seed, 0);
+  while (k--)
+  {
+    // if m, n, p, q < 2^25 then d < 2^52
+    int64_t m = philox_u64 (&s) % (1 << 25), n = philox_u64 (&s) % (1 << 25);
+    int64_t p = philox_u64 (&s) % (1 << 25), q = philox_u64 (&s) % (1 << 25);
+    int e = philox_u64 (&s) % 1993 - 1022; // the values are normal
+    double x[3];
+    x[0] = ldexp ((double) (m * m + n * n - p * p - q * q), e);
+    x[1] = ldexp ((double) (2 * (m * q + n * p)), e);
+    x[2] = ldexp ((double) (2 * (n * q - m * p)), e);
+    check (x, 3);
+    feclearexcept (FE_INEXACT);
+    double z = cr_hypot_n (x, 3);
+    if (fetestexcept (FE_INEXACT))
+    {
+      printf ("Spurious inexact exception for x=%la y=%la z=%la\n",
+              x[0], x[1], x[2]);
+      exit (1);
+    }
+    if (z != ldexp ((double) (m * m + n * n + p * p + q * q), e))
+    {
+      printf ("Wrong result for x=%la y=%la z=%la\n", x[0], x[1], x[2]);
+      exit (1);
+    }
+  }
+}
+
+/* check values in the subnormal and overflow ranges, and with large
+   exponent differences */
+static void
+check_extreme (void)
+{
+  static const double x0[] = {0x1p-1074, 0x1p-1022, 0x1.fffffffffffffp+1023,
+                              0x1p+600};
+  static const int e0[] = {-1074, -1030, 1024, 0};
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < 100000; i++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround (rnd1[rnd]);
+    philox_t s;
+    philox_init (&s, Seed, i);
+    int k = i % 4;
+    size_t n = 1 + philox_u64 (&s) % MAXN;
+    double x[MAXN];
+    x[0] = x0[k];
+    for (size_t j = 1; j < n; j++)
+    {
+      int e;
+      x[j] = frexp (get_random (&s), &e);
+      // for k = 3, the exponents are between -1074 and 600
+      e = (k == 3) ? e0[k] - (int) (philox_u64 (&s) % 1675)
+        : e0[k] - (int) (philox_u64 (&s) % 53);
+      x[j] = isfinite (x[j]) ? ldexp (x[j], e) : 0;
+    }
+    check (x, n);
+  }
+}
+
+/* check arrays of size n with values in [1,2) */
+static void
+check_large (size_t n)
+{
+  double *x = malloc (n * sizeof (double));
+  philox_t s;
+  philox_init (&s, Seed, n);
+  for (size_t i = 0; i < n; i++)
+    x[i] = 1.0 + (philox_u64 (&s) >> 12) * 0x1p-52;
+  check_aux (x, n);
+  for (size_t i = 0; i < n; i++)
+    x[i] = 0x1p-1000 * x[i];
+  check_aux (x, n);
+  free (x);
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--rndn") == 0)
+        {
+          rnd = 0;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndz") == 0)
+        {
+          rnd = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndu") == 0)
+        {
+          rnd = 2;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndd") == 0)
+        {
+          rnd = 3;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--verbose") == 0)
+        {
+          verbose = 1;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  ref_init ();
+  ref_fesetround (rnd);
+  fesetround(rnd1[rnd]);
+  Seed = philox_seed ();
+
+  printf ("Checking special values\n");
+  static const double s[] = {0.0, 0x1p-1074, 0x1p-1022, 1.0, 0x1.fffffffffffffp+1023,
+                             INFINITY, NAN};
+#define NS (sizeof (s) / sizeof (s[0]))
+  for (unsigned i = 0; i < NS * NS * NS; i++)
+  {
+    double x[3] = {s[i % NS], s[(i / NS) % NS], s[i / (NS * NS)]};
+    check (x, 1);
+    check (x, 2);
+    check (x, 3);
+  }
+  check (s, 0);
+
+  printf ("Checking Pythagorean quadruples\n");
+  check_quadruples (100000);
+
+  printf ("Checking hard cases\n");
+  static const int e0[] = {0, -1000, -1022, -1060, 1023};
+  for (size_t n = 2; n <= MAXN; n++)
+    for (int m = 1; m <= 53; m += 4)
+      for (int i = 0; i < 5; i++)
+        check_worst (n, m, e0[i]);
+
+  printf ("Checking in subnormal and overflow ranges\n");
+  check_extreme ();
+
+  printf ("Checking large arrays\n");
+  check_large (1000);
+  check_large (100000);
+
+  printf ("Checking random values with close exponents\n");
+  check_random (1);
+
+  printf ("Checking random values\n");
+  check_random (0);
+  return 0;
+}
@@ -0,0 +1,263 @@
+/* Check correctness of hypot_n and norm3 on worst cases.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* The input contains arrays "x[0],...,x[n-1]" with 1 <= n <= MAXN, one per
+   line: hypot_n.wc, and the worst cases of hypot (see WORST_CASES in the
+   Makefile). Each array is checked with cr_hypot_n, and with cr_norm3 when
+   n = 3, together with the reversed array and its opposite. */
+
+#ifndef __APPLE__
+#define _POSIX_C_SOURCE 200809L  /* for getline */
+#endif /* !__APPLE */
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fenv.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+
+double cr_hypot_n (const double *, size_t);
+double cr_norm3 (double, double, double);
+double ref_hypot_n (const double *, size_t);
+int ref_fesetround (int);
+void ref_init (void);
+
+int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
+
+int rnd;
+
+#define MAXN 8
+
+typedef struct {
+  size_t n;
+  double x[MAXN];
+} testcase;
+
+typedef union { double f; uint64_t i; } d64u64;
+
+/* scanf %la from buf, allowing snan, +snan and -snan */
+static int
+sscanf_snan (char *buf, double *x)
+{
+  if (sscanf(buf, "%la", x) == 1)
+    return 1;
+  else if (strncmp (buf, "snan", 4) == 0 || strncmp (buf, "+snan", 5) == 0)
+  {
+    d64u64 u = {.i = 0x7ff4000000000000};
+    *x = u.f;
+    return 1;
+  }
+  else if (strncmp (buf, "-snan", 5) == 0)
+  {
+    d64u64 u = {.i = 0xfff4000000000000};
+    *x = u.f;
+    return 1;
+  }
+  return 0;
+}
+
+static void
+readstdin(testcase **result, int *count)
+{
+  char *buf = NULL;
+  size_t buflength = 0;
+  ssize_t n;
+  int allocated = 512;
+
+  *count = 0;
+  if (NULL == (*result = malloc(allocated * sizeof(testcase)))) {
+    fprintf(stderr, "malloc failed\n");
+    exit(1);
+  }
+
+  while ((n = getline(&buf, &buflength, stdin)) >= 0) {
+    if (n > 0 && buf[0] == '#') continue;
+    if (*count >= allocated) {
+      int newsize = 2 * allocated;
+      testcase *newresult = realloc(*result, newsize * sizeof(testcase));
+      if (NULL == newresult) {
+        fprintf(stderr, "realloc(%d) failed\n", newsize);
+        exit(1);
+      }
+      allocated = newsize;
+      *result = newresult;
+    }
+    testcase *item = *result + *count;
+    item->n = 0;
+    for (char *tbuf = buf; tbuf != NULL && item->n < MAXN; item->n++)
+    {
+      if (sscanf_snan (tbuf, item->x + item->n) != 1)
+        break;
+      tbuf = strchr (tbuf, ',');
+      if (tbuf != NULL)
+        tbuf++;
+    }
+    if (item->n > 0)
+      (*count)++;
+  }
+  free (buf);
+}
+
+static inline uint64_t
+asuint64 (double f)
+{
+  d64u64 u = {.f = f};
+  return u.i;
+}
+
+/* define our own is_nan function to avoid depending from math.h */
+static inline int
+is_nan (double x)
+{
+  uint64_t u = asuint64 (x);
+  uint64_t e = u >> 52;
+  return (e == 0x7ff || e == 0xfff) && (u << 12) != 0;
+}
+
+static inline int
+is_equal (double x, double y)
+{
+  if (is_nan (x))
+    return is_nan (y);
+  if (is_nan (y))
+    return is_nan (x);
+  return asuint64 (x) == asuint64 (y);
+}
+
+int tests = 0, failures = 0;
+
+static void
+fail (const char *name, const double *x, size_t n, double z1, double z)
+{
+  printf ("FAIL x=");
+  for (size_t i = 0; i < n; i++)
+    printf ("%s%la", (i > 0) ? "," : "", x[i]);
+  printf (" ref=%la %s=%la\n", z1, name, z);
+  fflush (stdout);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp atomic update
+#endif
+  failures ++;
+#ifndef DO_NOT_ABORT
+  exit (1);
+#endif
+}
+
+static void
+check (const double *x, size_t n)
+{
+  double z1 = ref_hypot_n (x, n);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp atomic update
+#endif
+  tests ++;
+  double z = cr_hypot_n (x, n);
+  if (!is_equal (z, z1))
+    fail ("cr_hypot_n", x, n, z1, z);
+  else if (n == 3)
+  {
+    z = cr_norm3 (x[0], x[1], x[2]);
+    if (!is_equal (z, z1))
+      fail ("cr_norm3", x, n, z1, z);
+  }
+}
+
+void
+doloop (void)
+{
+  testcase *items;
+  int count;
+
+  readstdin (&items, &count);
+
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < count; i++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround (rnd1[rnd]);
+    size_t n = items[i].n;
+    const double *x = items[i].x;
+    double y[MAXN];
+    check (x, n);
+    for (size_t j = 0; j < n; j++)
+      y[j] = x[n - 1 - j];
+    check (y, n);
+    for (size_t j = 0; j < n; j++)
+      y[j] = -y[j];
+    check (y, n);
+  }
+
+  free (items);
+  printf ("%d tests passed, %d failure(s)\n", tests, failures);
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--rndn") == 0)
+        {
+          rnd = 0;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndz") == 0)
+        {
+          rnd = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndu") == 0)
+        {
+          rnd = 2;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndd") == 0)
+        {
+          rnd = 3;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  doloop ();
+
+  return failures != 0;
+}
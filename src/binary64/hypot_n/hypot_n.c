@@ -0,0 +1,370 @@
+/* Correctly-rounded Euclidean norm of n binary64 values.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* cr_hypot_n(x,n) returns sqrt(x[0]^2+...+x[n-1]^2) correctly rounded, and
+   cr_norm3(x,y,z) is the same as cr_hypot_n for the array {x,y,z}.
+
+   As in ../hypot/hypot.c, the inputs are scaled by a power of 2 such that
+   the largest |x[i]| is in [1,2), the squares are accumulated in
+   double-double arithmetic, and the square root is refined by one Newton
+   iteration. The inputs less than 2^-400 times the largest one are ignored
+   in this first step, which avoids spurious underflow exceptions.
+
+   When the rounding test fails, or when the result is subnormal, the sum of
+   the squares is computed exactly as a big integer (in units of 2^-2152),
+   and compared with the square of the closest rounding boundary, which is
+   an integer multiple of half an ulp of the result. This extends the
+   integer approach of as_hypot_denorm() and as_hypot_hard() in hypot.c to
+   n terms and to any exponent range. */
+
+#include <stdint.h>
+#include <errno.h>
+#include <fenv.h> // for fexcept_t
+#include <stddef.h> // for size_t
+
+#ifdef __x86_64__
+#include <x86intrin.h>
+#endif
+
+// Warning: clang also defines __GNUC__
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#endif
+
+#pragma STDC FENV_ACCESS ON
+
+// This code emulates the _mm_getcsr SSE intrinsic by reading the FPCR register.
+// fegetexceptflag accesses the FPSR register, which seems to be much slower
+// than accessing FPCR, so it should be avoided if possible.
+// Adapted from sse2neon: https://github.com/DLTcollab/sse2neon
+#if (defined(__arm64__) || defined(_M_ARM64)) && !defined(__aarch64__)
+#if defined(_MSC_VER)
+#include <arm64intr.h>
+#endif
+
+typedef struct
+{
+  uint16_t res0;
+  uint8_t  res1  : 6;
+  uint8_t  bit22 : 1;
+  uint8_t  bit23 : 1;
+  uint8_t  bit24 : 1;
+  uint8_t  res2  : 7;
+  uint32_t res3;
+} fpcr_bitfield;
+
+inline static unsigned int _mm_getcsr(void)
+{
+  union
+  {
+    fpcr_bitfield field;
+    uint64_t value;
+  } r;
+
+#if defined(_MSC_VER) && !defined(__clang__)
+  r.value = _ReadStatusReg(ARM64_FPCR);
+#else
+  __asm__ __volatile__("mrs %0, FPCR" : "=r"(r.value));
+#endif
+  static const unsigned int lut[2][2] = {{0x0000, 0x2000}, {0x4000, 0x6000}};
+  return lut[r.field.bit22][r.field.bit23];
+}
+#endif  // (defined(__arm64__) || defined(_M_ARM64)) && !defined(__aarch64__)
+
+static inline fexcept_t get_flags (void)
+{
+  /* Warning: on __aarch64__ (for example cfarm103), FE_UPWARD=0x400000
+     instead of 0x800. */
+#if (defined(__x86_64__) || defined(__arm64__) || defined(_M_ARM64)) && !defined(__aarch64__)
+  return _mm_getcsr ();
+#else
+  fexcept_t flag;
+  fegetexceptflag (&flag, FE_ALL_EXCEPT);
+  return flag;
+#endif
+}
+
+static inline void set_flags (fexcept_t flag)
+{
+#if (defined(__x86_64__) || defined(__arm64__) || defined(_M_ARM64)) && !defined(__aarch64__)
+  _mm_setcsr (flag);
+#else
+  fesetexceptflag (&flag, FE_ALL_EXCEPT);
+#endif
+}
+
+typedef uint64_t u64;
+typedef int64_t i64;
+
+#if (defined(__clang__) && __clang_major__ >= 14) || (defined(__GNUC__) && __GNUC__ >= 14 && __BITINT_MAXWIDTH__ && __BITINT_MAXWIDTH__ >= 128)
+typedef unsigned _BitInt(128) u128;
+#else
+typedef unsigned __int128 u128;
+#endif
+typedef union {double f; u64 u;} b64u64_u;
+
+static inline double fasttwosum(double x, double y, double *e){
+  double s = x + y;
+  double z = s - x;
+  *e = y - z;
+  return s;
+}
+
+// case hypot_n(x,n) >= 2^1024 (same as in ../hypot/hypot.c)
+static double __attribute__((noinline)) as_hypot_overflow (void){
+  volatile double z = 0x1.fffffffffffffp1023;
+  double f = z + z;
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  errno = ERANGE; // always overflow, whatever the rounding mode
+#endif
+  return f;
+}
+
+/* Case where some x[i] is NaN or Inf. As for hypot(), the result is +Inf
+   when some x[i] is +/-Inf and no x[i] is a signaling NaN, otherwise it
+   is NaN (and invalid is raised for a signaling NaN). */
+static double __attribute__((noinline)) as_hypot_n_special (const double *x, size_t n){
+  int inf = 0, snan = 0;
+  double qn = 0, sn = 0;
+  for (size_t i = 0; i < n; i++){
+    b64u64_u t = {.f = x[i]};
+    u64 a = t.u & (~0ull>>1);
+    if (a == 0x7ffull<<52)
+      inf = 1;
+    else if (a > 0x7ffull<<52){
+      if ((a >> 51) & 1)
+        qn = x[i];
+      else {
+        snan = 1;
+        sn = x[i];
+      }
+    }
+  }
+  if (snan) return sn + sn;
+  if (inf) return __builtin_inf ();
+  return qn + qn;
+}
+
+/* The exact sum of the squares is stored in NW 64-bit words, in units of
+   2^-POS0. The square of x = m*2^e, with m < 2^53 and e >= -1074, is
+   m^2*2^(2e+POS0) with 2e+POS0 >= 4, and is less than 2^(2048+POS0).
+   With the carries of up to 2^64 terms, the sum fits in 4264 < 64*NW bits. */
+#define NW 67
+#define POS0 2152
+
+// write v*2^s as a[0] + a[1]*2^64 + a[2]*2^128, for v < 2^110 and s < 64
+static inline void acc_split (u64 a[3], u128 v, int s){
+  u64 v0 = v, v1 = v >> 64;
+  a[0] = v0 << s;
+  a[1] = s ? (v1 << s) | (v0 >> (64 - s)) : v1;
+  a[2] = s ? v1 >> (64 - s) : 0;
+}
+
+// W += v*2^pos, for v < 2^110
+static inline void acc_add (u64 *W, u128 v, int pos){
+  u64 a[3], c = 0;
+  int w = pos >> 6;
+  acc_split (a, v, pos & 63);
+  for (int i = 0; i < 3; i++){
+    u64 t = W[w+i] + c;
+    c = t < c;
+    W[w+i] = t + a[i];
+    c += W[w+i] < a[i];
+  }
+  for (int i = w + 3; c; i++) // propagate the carry
+    c = ++W[i] == 0;
+}
+
+// return the sign of W - v*2^pos, for v < 2^110
+static inline int acc_cmp (const u64 *W, u128 v, int pos){
+  u64 a[3];
+  int w = pos >> 6;
+  acc_split (a, v, pos & 63);
+  for (int i = NW - 1; i > w + 2; i--)
+    if (W[i]) return 1;
+  for (int i = 2; i >= 0; i--)
+    if (W[w+i] != a[i]) return (W[w+i] > a[i]) ? 1 : -1;
+  for (int i = w - 1; i >= 0; i--)
+    if (W[i]) return 1;
+  return 0;
+}
+
+/* Hard case: th+tl approximates the result divided by 2^k, with relative
+   error much less than 2^-54. The sum of the squares is computed exactly in
+   W, and compared with b^2, where b is the rounding boundary closest to
+   th*2^k: since the result is less than half the distance between two
+   boundaries away from b, the sign of the comparison and the rounding mode
+   give the correct rounding. The flags are restored if the result is
+   exact, and underflow is raised (after rounding) if needed. */
+static double __attribute__((noinline))
+as_hypot_n_hard (const double *x, size_t n, double th, double tl, int k,
+                 const fexcept_t flag){
+  u64 W[NW] = {0};
+  for (size_t i = 0; i < n; i++){
+    b64u64_u t = {.f = x[i]};
+    u64 m = t.u & (~0ull>>12);
+    int e = (t.u >> 52) & 0x7ff;
+    if (e) m |= 1ull<<52; else e = 1;
+    // |x[i]| = m*2^(e-1075)
+    if (m) acc_add (W, (u128) m * m, 2 * (e - 1075) + POS0);
+  }
+  /* The rounding boundaries near the result are the integer multiples of
+     2^q, with q = E-53 where 2^E <= th*2^k < 2^(E+1), and q = -1075 in the
+     subnormal range. Let b = c*2^q be the closest one to (th+tl)*2^k. */
+  b64u64_u v = {.f = th};
+  int E = (int) (v.u >> 52) - 0x3ff + k;
+  int q = ((E < -1022) ? -1022 : E) - 53;
+  v.u = (u64) (k - q + 0x3ff) << 52; // 2^(k-q), with k-q <= 53
+  double ch = th * v.f, cl = tl * v.f; // exact, with ch >= 2
+  u64 c = ch;
+  c += (i64) __builtin_floor ((ch - (double) c) + (cl + 0.5));
+  // s is the sign of x[0]^2+...+x[n-1]^2 - b^2, with c < 2^55
+  int s = acc_cmp (W, (u128) c * c, 2 * q + POS0);
+  // b = m*2^(q+1) if c is even, otherwise b is the middle of m*2^(q+1) and (m+1)*2^(q+1)
+  u64 m = c >> 1;
+  int half = c & 1;
+  volatile double one = 1.0; // the rounding mode must be detected at run time
+  double op = one + 0x1p-54, om = one - 0x1p-54;
+  if (op == om) // rounding to nearest
+    m += half && (s > 0 || (s == 0 && (m & 1)));
+  else if (op > 1.0) // rounding upwards
+    m += half || s > 0;
+  else // rounding downwards or towards zero
+    m -= !half && s < 0;
+  // the encoding of m*2^(q+1) is ((q+1075)<<52) + m - 2^52 if 2^52 <= m < 2^53,
+  // and m if q = -1075, and this formula also works across binades
+  v.u = ((u64) (q + 1075) << 52) + m;
+  if (!s && !half)
+    set_flags (flag); // exact result
+  else if (v.u <= 1ull<<52){
+    /* Underflow after rounding: the result rounded to 53 bits with
+       unbounded exponent is less than 2^-1022, i.e., the exact result is
+       less than 2^-1022*(1-2^-54) for rounding to nearest, at most
+       2^-1022*(1-2^-53) for rounding upwards, and less than 2^-1022
+       otherwise. */
+    int uf;
+    u64 t = (op == om) ? (1ull << 54) - 1 : (1ull << 53) - 1;
+    if (op == om) // compare with (2^54-1)^2*2^-2152
+      uf = acc_cmp (W, (u128) t * t, 2 * -1076 + POS0) < 0;
+    else if (op > 1.0) // compare with (2^53-1)^2*2^-2150
+      uf = acc_cmp (W, (u128) t * t, 2 * -1075 + POS0) <= 0;
+    else
+      uf = v.u < 1ull<<52;
+    if (uf){
+      volatile double trig_uf = 0x1p-1022;
+      trig_uf *= trig_uf; // triggers underflow
+#ifdef CORE_MATH_SUPPORT_ERRNO
+      errno = ERANGE; // underflow
+#endif
+    }
+  }
+  if (v.u >= 0x7ffull<<52) return as_hypot_overflow ();
+  return v.f;
+}
+
+/* Add y^2 to the double-double number h+l, where y = |x|*s1*s2 if the
+   encoding of |x| is at least thr, and y = 0 otherwise. Since h and y^2
+   are non-negative, the Fast2Sum of max(h,y^2) and min(h,y^2) is exact
+   for rounding to nearest, and e is within 2^-52*|e| of the error of the
+   addition for directed roundings. */
+static inline void as_add_square (double *h, double *l, double x, u64 thr,
+                                  double s1, double s2){
+  b64u64_u t = {.f = x};
+  t.u &= ~0ull>>1;
+  double y = (t.u >= thr) ? t.f : 0.0;
+  y = (y * s1) * s2;
+  double p = y * y, dp = __builtin_fma (y, y, -p), e;
+  double hi = (*h > p) ? *h : p, lo = (*h > p) ? p : *h;
+  *h = fasttwosum (hi, lo, &e);
+  *l += e + dp;
+}
+
+static inline double as_hypot_n (const double *x, size_t n){
+  volatile fexcept_t flag = get_flags();
+  // the encoding of max|x[i]|
+  u64 amax = 0;
+  for (size_t i = 0; i < n; i++){
+    b64u64_u t = {.f = x[i]};
+    u64 a = t.u & (~0ull>>1);
+    amax = (a > amax) ? a : amax;
+  }
+  if(__builtin_expect(amax >= 0x7ffull<<52, 0)) return as_hypot_n_special (x, n);
+  if(__builtin_expect(!amax, 0)) return 0;
+  /* 2^k <= max|x[i]| < 2^(k+1), and the inputs less than 2^(k-400) (whose
+     encoding is less than thr) are ignored: their squares sum to less than
+     n*2^-800 times the result */
+  int k = (amax >> 52) ? (int) (amax >> 52) - 0x3ff : -1011 - __builtin_clzll (amax);
+  u64 thr = (k >= -622) ? (u64) (k - 400 + 0x3ff) << 52 : 0;
+  /* the inputs are multiplied by 2^-k = s1*s2, where s1 and s2 are normal
+     numbers, thus the scaled inputs are exact, and at least 2^-452 */
+  int k1 = -k / 2;
+  b64u64_u s1 = {.u = (u64) (k1 + 0x3ff) << 52}, s2 = {.u = (u64) (-k - k1 + 0x3ff) << 52};
+  /* Sum the squares in 4 independent double-double accumulators (which
+     allows the compiler to vectorize the loop). For each of the n terms,
+     |e| and |dp| are less than 2^-52 times the sum, thus the error on e
+     and the rounding of e + dp are less than 3*2^-104 times the sum, and
+     the rounding of l + (e + dp) is less than i*2^-103 times the sum for
+     the i-th term: the relative error of the sum is less than
+     (n^2+10n+16)*2^-104, including the final additions, in all rounding
+     modes, and that of its square root is less than half that. */
+  double h[4] = {0, 0, 0, 0}, l[4] = {0, 0, 0, 0};
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    for (int j = 0; j < 4; j++)
+      as_add_square (h + j, l + j, x[i+j], thr, s1.f, s2.f);
+  for (; i < n; i++)
+    as_add_square (h, l, x[i], thr, s1.f, s2.f);
+  for (int j = 1; j < 4; j++){
+    double e, hi = (h[0] > h[j]) ? h[0] : h[j], lo = (h[0] > h[j]) ? h[j] : h[0];
+    h[0] = fasttwosum (hi, lo, &e);
+    l[0] += l[j] + e;
+  }
+  double dr2, r2 = fasttwosum (h[0], l[0], &dr2);
+  // one Newton iteration, as in cr_hypot(): the additional error is less than 2^-99
+  double th = __builtin_sqrt (r2), rsqrt = th * (0.5 / r2);
+  double dz = dr2 - __builtin_fma (th, th, -r2), tl = rsqrt * dz;
+  th = fasttwosum (th, tl, &tl);
+  double dn = n, eps = th * (__builtin_fma (dn, dn, 10.0 * dn + 16.0) * 0x1p-105 + 0x1p-99);
+  double lb = th + (tl - eps), ub = th + (tl + eps);
+  b64u64_u res = {.f = ub};
+  int e = (int) (res.u >> 52) - 0x3ff + k; // exponent of the result
+  /* tl = 0 happens in particular when the result is exact, in which case
+     the inexact flag should not be raised */
+  if(__builtin_expect(lb != ub || tl == 0 || e < -1022, 0))
+    return as_hypot_n_hard (x, n, th, tl, k, flag);
+  if(__builtin_expect(e > 1023, 0)) return as_hypot_overflow ();
+  res.u += (i64) k << 52;
+  return res.f;
+}
+
+double cr_hypot_n (const double *x, size_t n){
+  return as_hypot_n (x, n);
+}
+
+double cr_norm3 (double x, double y, double z){
+  const double t[3] = {x, y, z};
+  return as_hypot_n (t, 3);
+}
@@ -0,0 +1,76 @@
+/* Correctly-rounded mpfr-based Euclidean norm of n binary64 values.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stddef.h>
+#include <mpfr.h>
+#include "fenv_mpfr.h"
+#include <stdint.h>
+
+typedef uint64_t u64;
+typedef union {double f; u64 u;} b64u64_u;
+
+/* reference code using MPFR: return sqrt(x[0]^2+...+x[n-1]^2), with the
+   same rules as hypot() for NaN and Inf inputs */
+double ref_hypot_n (const double *x, size_t n){
+  int inf = 0, nan = 0;
+  for (size_t i = 0; i < n; i++){
+    b64u64_u t = {.f = x[i]};
+    u64 a = t.u & (~0ull>>1);
+    if (a > 0x7ffull<<52 && !((a >> 51) & 1)) // sNaN
+      return x[i] + x[i]; // will return qNaN
+    inf |= a == 0x7ffull<<52;
+    nan |= a > 0x7ffull<<52;
+  }
+  if (inf) return __builtin_inf ();
+  if (nan) return __builtin_nan ("");
+
+  /* The sum of the squares is computed exactly: each square has at most
+     106 bits, and is between 2^-2148 and 2^2048, thus 4300 bits are enough
+     for n < 2^100. */
+  mpfr_exp_t emin = mpfr_get_emin (), emax = mpfr_get_emax ();
+  mpfr_set_emin (mpfr_get_emin_min ());
+  mpfr_set_emax (mpfr_get_emax_max ());
+  mpfr_t s, t, z;
+  mpfr_init2 (s, 4300);
+  mpfr_init2 (t, 106);
+  mpfr_init2 (z, 53);
+  mpfr_set_ui (s, 0, MPFR_RNDN);
+  for (size_t i = 0; i < n; i++){
+    mpfr_set_d (t, x[i], MPFR_RNDN);
+    mpfr_sqr (t, t, MPFR_RNDN);
+    mpfr_add (s, s, t, MPFR_RNDN);
+  }
+  int inex = mpfr_sqrt (z, s, rnd2[rnd]);
+  mpfr_set_emin (emin);
+  mpfr_set_emax (emax);
+  inex = mpfr_check_range (z, inex, rnd2[rnd]);
+  mpfr_subnormalize (z, inex, rnd2[rnd]);
+  double ret = mpfr_get_d (z, MPFR_RNDN);
+  mpfr_clear (s);
+  mpfr_clear (t);
+  mpfr_clear (z);
+  return ret;
+}
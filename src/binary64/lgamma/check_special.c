@@ -36,6 +36,7 @@ SOFTWARE.
 #include <mpfr.h>
 #include <omp.h>
 #include "function_under_test.h"
+#include "../../generic/support/philox.h"
 
 int ref_init (void);
 int ref_fesetround (int);
@@ -50,9 +51,7 @@ int verbose = 0;
 unsigned long tested = 0;
 int nthreads;
 
-#define MAX_THREADS 192
-
-static unsigned int Seed[MAX_THREADS];
+static uint64_t Seed;
 
 typedef union {double f; uint64_t u;} b64u64_u;
 
@@ -71,12 +70,10 @@ asfloat64 (uint64_t n)
 }
 
 static double
-get_random (int tid)
+get_random (philox_t *s)
 {
   b64u64_u v;
-  v.u = rand_r (Seed + tid);
-  v.u |= (uint64_t) rand_r (Seed + tid) << 31;
-  v.u |= (uint64_t) rand_r (Seed + tid) << 62;
+  v.u = philox_u64 (s);
   return v.f;
 }
 
@@ -423,9 +420,7 @@ main (int argc, char *argv[])
   printf ("Check negative inputs\n");
   check_negative ();
 
-  long seed = getpid ();
-  for (int i = 0; i < MAX_THREADS; i++)
-    Seed[i] = seed + i;
+  Seed = philox_seed ();
   
   printf ("Checking random numbers...\n");
   /* this code should not be run in parallel, since the use of signgam is
@@ -434,7 +429,9 @@ main (int argc, char *argv[])
   {
     ref_init ();
     ref_fesetround (rnd);
-    double x = get_random (0);
+    philox_t s;
+    philox_init (&s, Seed, n);
+    double x = get_random (&s);
     check (x);
   }
 
@@ -236,7 +236,8 @@ static __attribute__((noinline)) double as_lgamma_accurate(double x){
     fh = fasttwosum(fh,fl,&fl);
     fl = fasttwosum(fl,fll,&fll);
     double e; fasttwosum(fh,2*fl,&e);
-    if(e==0 && 1 + 0x1p-54 == 1 - 0x1p-54) fl *= 1 + __builtin_copysign(0x1p-52, fl)*__builtin_copysign(1, fll);
+    volatile double one = 1.0; // the rounding mode must be detected at run time
+    if(e==0 && one + 0x1p-54 == one - 0x1p-54) fl *= 1 + __builtin_copysign(0x1p-52, fl)*__builtin_copysign(1, fll);
   } else if(x<0x1p-2){
     fh = polydddfst(sx, sizeof(c0)/sizeof(c0[0]), c0, &fl);
     fh = mulddd(sx, fh,fl, &fl);
@@ -245,7 +246,8 @@ static __attribute__((noinline)) double as_lgamma_accurate(double x){
     fh = twosum(-lh,fh, &fll);
     fl = twosum(fll,fl, &fll);
     double e; fasttwosum(fh,2*fl,&e);
-    if(e==0 && 1 + 0x1p-54 == 1 - 0x1p-54) fl *= 1 + __builtin_copysign(0x1p-52, fl)*__builtin_copysign(1, fll);
+    volatile double one = 1.0; // the rounding mode must be detected at run time
+    if(e==0 && one + 0x1p-54 == one - 0x1p-54) fl *= 1 + __builtin_copysign(0x1p-52, fl)*__builtin_copysign(1, fll);
   } else {
     if(__builtin_fabs(x-0.5)<0x1p-2){
       fh = polydddfst(x-0.5, sizeof(b)/sizeof(b[0]), b, &fl);
@@ -870,8 +872,9 @@ double cr_lgamma(double x){
   if(__builtin_expect(nx >= 0xfeaea9b24f16a34cull, 0)){
     // |x| >= 0x1.006df1bfac84ep+1015
     signgam = 1;
-    if(t.u == 0x7f5754d9278b51a6ull) return 0x1.ffffffffffffep+1023 - 0x1p+969;
-    if(t.u == 0x7f5754d9278b51a7ull) return 0x1.fffffffffffffp+1023 - 0x1p+969;
+    volatile double one = 1.0; // prevents constant folding
+    if(t.u == 0x7f5754d9278b51a6ull) return 0x1.ffffffffffffep+1023 - one*0x1p+969;
+    if(t.u == 0x7f5754d9278b51a7ull) return 0x1.fffffffffffffp+1023 - one*0x1p+969;
     if(__builtin_expect(nx>=(0x7ffull<<53), 0)){ /* x=NaN or +/-Inf */
       if(nx==(0x7ffull<<53)) /* x=+/-Inf */
 	return __builtin_fabs(x); /* +Inf */
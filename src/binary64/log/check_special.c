@@ -25,6 +25,7 @@ SOFTWARE.
 */
 
 #include <stdio.h>
+#include <errno.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
@@ -32,24 +33,29 @@ SOFTWARE.
 #include <math.h>
 #include <unistd.h>
 #include <inttypes.h>
+#include <mpfr.h>
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
 #include <omp.h>
 #endif
 
+#include "../../generic/support/philox.h"
+
 int ref_fesetround (int);
 void ref_init (void);
 
 double cr_log (double);
 double ref_log (double);
+double cr_log_inrange (double);
+double cr_log_dd (double, double, double *);
+void cr_log_interval (double, double *, double *);
+double cr_log_r (double, int);
 
 int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
 
 int rnd = 0;
 int verbose = 0;
 
-#define MAX_THREADS 192
-
-static unsigned int Seed[MAX_THREADS];
+static uint64_t Seed;
 
 typedef union { double f; uint64_t i; } d64u64;
 
@@ -93,14 +99,107 @@ check (double x)
   }
 }
 
+/* The exceptions compared between cr_log_r(x,rnd1[rnd]) and cr_log(x) in the
+   rounding mode rnd1[rnd], and between cr_log_inrange(x) and cr_log(x).
+   Inexact is only checked with CORE_MATH_CHECK_INEXACT. */
+#ifdef CORE_MATH_CHECK_INEXACT
+#define CHECKED_FLAGS (FE_INEXACT | FE_UNDERFLOW | FE_OVERFLOW | FE_INVALID \
+                       | FE_DIVBYZERO)
+#else
+#define CHECKED_FLAGS (FE_UNDERFLOW | FE_OVERFLOW | FE_INVALID | FE_DIVBYZERO)
+#endif
+
+/* Check cr_log_interval(x) and cr_log_r(x,rnd1[rnd]) in the rounding mode
+   to nearest they assume, with their exceptions and errno, see
+   check_interval() in ../exp/check_special.c. */
+static void
+check_interval (double x)
+{
+  double y1 = ref_log (x), lo, hi, lo1, hi1, y2, z;
+  int flags0, flags1, flags2, flags3, err1, err3;
+  fesetround (FE_DOWNWARD);
+  lo1 = cr_log (x);
+  fesetround (FE_UPWARD);
+  hi1 = cr_log (x);
+  fesetround (FE_TONEAREST);
+  feclearexcept (FE_ALL_EXCEPT);
+  cr_log (x);
+  flags0 = fetestexcept (FE_INVALID | FE_DIVBYZERO);
+  fesetround (rnd1[rnd]);
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  y2 = cr_log (x);
+  flags1 = fetestexcept (CHECKED_FLAGS);
+  err1 = errno;
+  fesetround (FE_TONEAREST);
+  feclearexcept (FE_ALL_EXCEPT);
+  cr_log_interval (x, &lo, &hi);
+  flags2 = fetestexcept (FE_ALL_EXCEPT);
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  z = cr_log_r (x, rnd1[rnd]);
+  flags3 = fetestexcept (CHECKED_FLAGS);
+  err3 = errno;
+  if (fegetround () != FE_TONEAREST)
+  {
+    printf ("Rounding mode changed by cr_log_interval or cr_log_r for x=%la\n",
+            x);
+    exit (1);
+  }
+  if (!is_equal (lo, lo1) || !is_equal (hi, hi1))
+  {
+    printf ("FAIL x=%la cr_log_interval=[%la,%la] cr_log=[%la,%la]\n",
+            x, lo, hi, lo1, hi1);
+    exit (1);
+  }
+  if ((!is_nan (y1) && !(lo <= y1 && y1 <= hi)) ||
+      (rnd == 3 && !is_equal (lo, y1)) || (rnd == 2 && !is_equal (hi, y1)))
+  {
+    printf ("FAIL x=%la ref=%la cr_log_interval=[%la,%la]\n", x, y1, lo, hi);
+    exit (1);
+  }
+  if (!is_equal (z, y1) || !is_equal (z, y2))
+  {
+    printf ("FAIL x=%la ref=%la cr_log=%la cr_log_r=%la\n", x, y1, y2, z);
+    exit (1);
+  }
+  if (flags3 != flags1)
+  {
+    printf ("FAIL x=%la cr_log_r raises exceptions %#x instead of %#x\n",
+            x, flags3, flags1);
+    exit (1);
+  }
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  if (err3 != err1)
+  {
+    printf ("FAIL x=%la cr_log_r sets errno=%d instead of %d\n", x, err3, err1);
+    exit (1);
+  }
+#else
+  (void) err1;
+  (void) err3;
+#endif
+  if ((flags2 & (FE_INVALID | FE_DIVBYZERO)) != flags0)
+  {
+    printf ("FAIL x=%la cr_log_interval raises exceptions %#x instead of %#x\n",
+            x, flags2 & (FE_INVALID | FE_DIVBYZERO), flags0);
+    exit (1);
+  }
+#ifdef CORE_MATH_CHECK_INEXACT
+  if (((flags2 & FE_INEXACT) != 0) == is_equal (lo, hi))
+  {
+    printf ("%s inexact exception for x=%la cr_log_interval=[%la,%la]\n",
+            (flags2 & FE_INEXACT) ? "Spurious" : "Missing", x, lo, hi);
+    exit (1);
+  }
+#endif
+}
 
 static double
-get_random (int tid)
+get_random (philox_t *s)
 {
   d64u64 v;
-  v.i = rand_r (Seed + tid);
-  v.i |= (uint64_t) rand_r (Seed + tid) << 31;
-  v.i |= (uint64_t) rand_r (Seed + tid) << 62;
+  v.i = philox_u64 (s);
   return v.f;
 }
 
@@ -249,6 +348,91 @@ check_invalid (void)
   }
 }
 
+#ifdef CORE_MATH_LATENCY
+#define LOG_DD_ERR 0x1.01p-68
+#else
+#define LOG_DD_ERR 0x1.b7p-69
+#endif
+
+/* Check the error bound of cr_log_dd(xh,xl,&l) given in log.c: for xh > 0
+   (and finite) the absolute error of h + l is less than 0x1.b7p-69 (0x1.01p-68
+   with CORE_MATH_LATENCY), otherwise h = cr_log(xh) and l = 0. We assume the
+   lsb of xl is not below 2^-200 |xh|. */
+static void
+check_dd (double xh, double xl)
+{
+  double l, h = cr_log_dd (xh, xl, &l);
+  if (!(xh > 0 && xh < INFINITY))
+  {
+    double y = cr_log (xh);
+    if (!is_equal (h, y) || l != 0)
+    {
+      printf ("FAIL xh=%la xl=%la cr_log=%la cr_log_dd=%la,%la\n", xh, xl, y, h, l);
+      exit (1);
+    }
+    return;
+  }
+  // use the full exponent range, ref_init() sets that of binary64
+  mpfr_exp_t emin = mpfr_get_emin (), emax = mpfr_get_emax ();
+  mpfr_set_emin (mpfr_get_emin_min ());
+  mpfr_set_emax (mpfr_get_emax_max ());
+  mpfr_t t, y;
+  mpfr_inits2 (256, t, y, NULL);
+  mpfr_set_d (t, xh, MPFR_RNDN);
+  mpfr_add_d (t, t, xl, MPFR_RNDN); // exact
+  mpfr_log (y, t, MPFR_RNDN);
+  mpfr_sub_d (t, y, h, MPFR_RNDN);
+  mpfr_sub_d (t, t, l, MPFR_RNDN);
+  double err = fabs (mpfr_get_d (t, MPFR_RNDN));
+  mpfr_clears (t, y, NULL);
+  mpfr_set_emin (emin);
+  mpfr_set_emax (emax);
+  if (err >= LOG_DD_ERR)
+  {
+    printf ("FAIL xh=%la xl=%la cr_log_dd=%la,%la absolute error=%la\n",
+            xh, xl, h, l, err);
+    exit (1);
+  }
+}
+
+/* Check that cr_log_inrange(x) = cr_log(x), with the same exceptions (and
+   errno), for x in the domain of
+   cr_log_inrange, 0x1p-1022 <= x <= 0x1.fffffffffffffp+1023. */
+static void
+check_inrange (double x)
+{
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  double y = cr_log (x);
+  int flags1 = fetestexcept (CHECKED_FLAGS), err1 = errno;
+  feclearexcept (FE_ALL_EXCEPT);
+  errno = 0;
+  double z = cr_log_inrange (x);
+  int flags2 = fetestexcept (CHECKED_FLAGS), err2 = errno;
+  if (!is_equal (y, z))
+  {
+    printf ("FAIL x=%la cr_log=%la cr_log_inrange=%la\n", x, y, z);
+    exit (1);
+  }
+  if (flags2 != flags1)
+  {
+    printf ("FAIL x=%la cr_log_inrange raises exceptions %#x instead of %#x\n",
+            x, flags2, flags1);
+    exit (1);
+  }
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  if (err2 != err1)
+  {
+    printf ("FAIL x=%la cr_log_inrange sets errno=%d instead of %d\n",
+            x, err2, err1);
+    exit (1);
+  }
+#else
+  (void) err1;
+  (void) err2;
+#endif
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -319,9 +503,7 @@ main (int argc, char *argv[])
 
   printf ("Checking random values\n");
 
-  unsigned int seed = getpid ();
-  for (int i = 0; i < MAX_THREADS; i++)
-    Seed[i] = seed + i;
+  Seed = philox_seed ();
 
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
 #pragma omp parallel for
@@ -330,16 +512,99 @@ main (int argc, char *argv[])
   {
     ref_init ();
     ref_fesetround (rnd);
-    int tid;
-#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
-    tid = omp_get_thread_num ();
-#else
-    tid = 0;
-#endif
+    philox_t s;
+    philox_init (&s, Seed, n);
     double x;
-    do x = get_random (tid); while (x < 0.0);
+    do x = get_random (&s); while (x < 0.0);
     check (x);
   }
 
+  printf ("Checking cr_log_interval and cr_log_r\n");
+  static const double T[] = {0x0p+0, 0x1p-1074, 0x1.fffffffffffffp-1023,
+    0x1p-1022, 0x1.fffffffffffffp-1, 0x1p+0, 0x1.0000000000001p+0, 0x1p+1,
+    0x1.fffffffffffffp+1023, INFINITY, NAN};
+  for (unsigned i = 0; i < sizeof (T) / sizeof (T[0]); i++)
+  {
+    check_interval (T[i]);
+    check_interval (-T[i]);
+  }
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t n = 0; n < CORE_MATH_TESTS / 16; n++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    philox_t s;
+    // the counters n + CORE_MATH_TESTS are not used by the previous loop
+    philox_init (&s, Seed, n + CORE_MATH_TESTS);
+    d64u64 v = {.f = get_random (&s)};
+    v.i &= 0x7fffffffffffffffull;
+    // for half of the values, 1/2 <= x < 2, where log(x) is close to 0
+    if (v.i & 1)
+      v.i = (v.i & 0xfffffffffffffull) | ((0x3fe + (v.i >> 52) % 2) << 52);
+    check_interval (v.f);
+  }
+
+  printf ("Checking cr_log_dd\n");
+  static const double D[] = {0x0p+0, 0x1p-1074, 0x1.fffffffffffffp-1023,
+    0x1p-1022, 0x1.fffffffffffffp-1, 0x1p+0, 0x1.0000000000001p+0, 0x1p+1,
+    0x1.fffffffffffffp+1023, INFINITY, NAN};
+  for (unsigned i = 0; i < sizeof (D) / sizeof (D[0]); i++)
+  {
+    check_dd (D[i], 0);
+    check_dd (-D[i], 0);
+  }
+  // for xh = 1, h = xl and l = 0
+  check_dd (0x1p+0, 0x1p-54);
+  check_dd (0x1p+0, -0x1p-54);
+  check_dd (0x1p+0, 0x1p-100);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t n = 0; n < CORE_MATH_TESTS / 16; n++)
+  {
+    fesetround (rnd1[rnd]);
+    philox_t s;
+    // the counters n + 2 * CORE_MATH_TESTS are not used by the other loops
+    philox_init (&s, Seed, n + 2 * CORE_MATH_TESTS);
+    d64u64 v = {.f = get_random (&s)};
+    v.i &= 0x7fffffffffffffffull;
+    // for half of the values, 1/2 <= xh < 2, where log(xh) is close to 0
+    if (v.i & 1)
+      v.i = (v.i & 0xfffffffffffffull) | ((0x3fe + (v.i >> 52) % 2) << 52);
+    double xh = v.f;
+    /* |xl| <= ulp(xh)/2, where xl is a multiple of ulp(xh)*2^-64, and xl = 0
+       when this would underflow */
+    double xl = (0x1p-958 <= fabs (xh) && fabs (xh) <= 0x1.fffffffffffffp+1023)
+      ? ldexp ((double) (int64_t) philox_u64 (&s) * 0x1p-63, ilogb (xh) - 53)
+      : 0;
+    check_dd (xh, xl);
+  }
+
+  printf ("Checking cr_log_inrange\n");
+  static const double I[] = {0x1p-1022, 0x1.0000000000001p-1022,
+    0x1.fffffffffffffp-1, 0x1p+0, 0x1.0000000000001p+0,
+    0x1.fffffffffffffp+1023};
+  fesetround (rnd1[rnd]);
+  for (unsigned i = 0; i < sizeof (I) / sizeof (I[0]); i++)
+    check_inrange (I[i]);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t n = 0; n < CORE_MATH_TESTS / 16; n++)
+  {
+    fesetround (rnd1[rnd]);
+    philox_t s;
+    // the counters n + 3 * CORE_MATH_TESTS are not used by the other loops
+    philox_init (&s, Seed, n + 3 * CORE_MATH_TESTS);
+    d64u64 v;
+    // x positive and normal
+    do
+      v.i = philox_u64 (&s) & 0x7fffffffffffffffull;
+    while ((v.i >> 52) == 0 || (v.i >> 52) == 0x7ff);
+    check_inrange (v.f);
+  }
+
   return 0;
 }
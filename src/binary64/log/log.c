@@ -27,8 +27,24 @@ SOFTWARE.
 
 #include <stdint.h>
 #include <errno.h>
+#include <fenv.h> // for fegetround, fesetround
+#ifdef CORE_MATH_DEBUG
+#include <assert.h>
+#endif
 #include "dint.h"
 
+/* With -DCORE_MATH_TABLE_SECTION, the tables below are put in the section
+   core_math_tables_log, aligned on cache lines, see
+   src/generic/support/warmup.h. */
+#ifndef CORE_MATH_TABLE
+#ifdef CORE_MATH_TABLE_SECTION
+#define CORE_MATH_TABLE(family) \
+  __attribute__((section ("core_math_tables_" #family), aligned (64)))
+#else
+#define CORE_MATH_TABLE(family)
+#endif
+#endif
+
 // Warning: clang also defines __GNUC__
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic ignored "-Wunknown-pragmas"
@@ -68,7 +84,15 @@ fast_two_sum (double *hi, double *lo, double a, double b)
    More precisely r[i] is a 10-bit value such that r[i]*y-1 is representable
    exactly on 53 bits for any y, i*2^-9 <= y < (i+1)*2^-9.
    Moreover |r[i]*y-1| <= 0.00212097167968735. */
-static const double _INVERSE[363]= {
+#ifdef CORE_MATH_SHARED_LOG_TABLES
+/* The tables _INVERSE and _LOG_INV are identical in log, log10, log2p1 and
+   log10p1: with -DCORE_MATH_SHARED_LOG_TABLES, a single copy is used,
+   defined in src/binary64/support/log_tables.c. */
+extern const double core_math_log_inverse[363], core_math_log_inv[363][2];
+#define _INVERSE core_math_log_inverse
+#define _LOG_INV core_math_log_inv
+#else
+static const double _INVERSE[363] CORE_MATH_TABLE (log) = {
     0x1.698p+0, 0x1.688p+0, 0x1.678p+0, 0x1.668p+0, 0x1.658p+0, 0x1.648p+0, 0x1.638p+0,
     0x1.63p+0, 0x1.62p+0, 0x1.61p+0, 0x1.6p+0, 0x1.5fp+0, 0x1.5ep+0, 0x1.5dp+0,
     0x1.5cp+0, 0x1.5bp+0, 0x1.5a8p+0, 0x1.598p+0, 0x1.588p+0, 0x1.578p+0, 0x1.568p+0,
@@ -127,7 +151,7 @@ static const double _INVERSE[363]= {
    approximation of -log(r) with r=INVERSE[i-362]), with h an integer multiple
    of 2^-42, and |l| < 2^-43. The maximal difference between -log(r) and h+l
    is bounded by 1/2 ulp(l) < 2^-97. */
-static const double _LOG_INV[363][2] = {
+static const double _LOG_INV[363][2] CORE_MATH_TABLE (log) = {
     {-0x1.615ddb4becp-2, -0x1.3c7ca90bc04b2p-46},
     {-0x1.5e87b20c29p-2, -0x1.527d18f7738fap-44},
     {-0x1.5baf846aa2p-2, 0x1.39ae8f873fa41p-44},
@@ -492,6 +516,7 @@ static const double _LOG_INV[363][2] = {
     {0x1.61965cdb03p-2, -0x1.f08ad603c488ep-45},
     {0x1.630030b3abp-2, -0x1.db623e731aep-45},
 };
+#endif
 
 /* The following is a degree-6 polynomial generated by Sollya over
    [-0.00202941894531250,0.00212097167968735],
@@ -506,6 +531,15 @@ static const double P[6] = {0x1p0,                 /* degree 1 */
                             -0x1.55362255e0f63p-3, /* degree 6 */
 };
 
+/* bound on the absolute error of cr_log_fast(), see the end of the function:
+   with CORE_MATH_LATENCY, the polynomial is evaluated with a shorter
+   dependency chain, for a slightly larger error */
+#ifdef CORE_MATH_LATENCY
+#define LOG_FAST_ERR 0x1p-68
+#else
+#define LOG_FAST_ERR 0x1.b6p-69
+#endif
+
 /* Given 1 <= x < 2, where x = v.f, put in h+l a double-double approximation
    of log(2^e*x), with absolute error bounded by 2^-68.22 (details below).
 */
@@ -531,6 +565,33 @@ cr_log_fast (double *h, double *l, int e, d64u64 v)
   double ph; /* will hold the value of P(z)-z */
   double z2 = z * z; /* |z2| < 4.5e-6 thus the rounding error on z2 is
                         bounded by ulp(4.5e-6) = 2^-70. */
+#ifdef CORE_MATH_LATENCY
+  /* Estrin-like evaluation of P(z)-z = z2*(P[1] + P[2]*z) + z4*(P[3] +
+     P[4]*z + P[5]*z2), with 3 dependent operations after z2 instead of 5
+     below. */
+  double p12 = __builtin_fma (P[2], z, P[1]);
+  /* |P[2]| < 0.34, |z| < 0.0022, |P[1]| = 0.5 thus |p12| < 0.501:
+     the rounding (and total) error on p12 is bounded by ulp(0.501) = 2^-53 */
+  double p34 = __builtin_fma (P[4], z, P[3]);
+  /* |P[4]| < 0.21, |z| < 0.0022, |P[3]| < 0.26 thus |p34| < 0.261:
+     the rounding (and total) error on p34 is bounded by ulp(0.261) = 2^-54 */
+  double p35 = __builtin_fma (P[5], z2, p34);
+  /* |P[5]*z2| < 7.6e-7 thus |p35| < 0.262: the rounding error on p35 is
+     bounded by ulp(0.262) = 2^-54, and the total error by
+     2^-54 + err(p34) + |P[5]|*err(z2) < 2^-52.99 */
+  double w = z2 * p12;
+  /* |w| < 4.5e-6 * 0.501 < 2.26e-6 thus the rounding error on w is bounded
+     by ulp(2.26e-6) = 2^-71, and the total error by
+     2^-71 + err(p12)*z2 + p12*err(z2) < 2^-71 + 2^-53*4.5e-6 + 0.501*2^-70
+     < 2^-69.33 */
+  double z4 = z2 * z2;
+  /* |z4| < 2.03e-11 thus the total error on z4 is bounded by
+     ulp(2.03e-11) + 2*|z2|*err(z2) = 2^-88 + 9e-6*2^-70 < 2^-86.25 */
+  ph = __builtin_fma (z4, p35, w);
+  /* |z4*p35| < 5.4e-12 thus |ph| < 2.27e-6: the rounding error on ph is
+     bounded by ulp(2.27e-6) = 2^-71, and the total error by
+     2^-71 + err(w) + |z4|*err(p35) + |p35|*err(z4) < 2^-68.93 */
+#else
   double p45 = __builtin_fma (P[5], z, P[4]);
   /* |P[5]| < 0.167, |z| < 0.0022, |P[4]| < 0.21 thus |p45| < 0.22:
      the rounding (and total) error on p45 is bounded by ulp(0.22) = 2^-55 */
@@ -560,6 +621,7 @@ cr_log_fast (double *h, double *l, int e, d64u64 v)
      multiplied by ph1, we get for the total error on ph2 the following bound:
      2^-71 + err(ph1)*z2 + ph1*err(z2) <
      2^-71 + 2^-52.99*4.5e-6 + 0.501*2^-70 < 2^-69.32. */
+#endif
 
   /* Add e*log(2) to (h,l), where -1074 <= e <= 1023, thus e has at most
      11 bits. log2_h is an integer multiple of 2^-42, so that e*log2_h
@@ -604,6 +666,9 @@ cr_log_fast (double *h, double *l, int e, d64u64 v)
      2^-70.99 from the *l = ph + (*l + l2) instruction
      2^-71 from the last __builtin_fma call.
      This gives an absolute error bounded by < 2^-68.22.
+     With CORE_MATH_LATENCY, the rounding errors in the polynomial
+     evaluation are bounded by 2^-68.93 instead of 2^-69.32, which gives
+     an absolute error bounded by 2^-68.02 < 2^-68 (LOG_FAST_ERR below).
   */
 
   /* Absolute error bounded by 2^-68.22 < 0x1.b8p-69.
@@ -644,6 +709,33 @@ cr_log_accurate (double x)
   return dint_tod (&Y);
 }
 
+/* return log(x) for x > 0, where the significand of v is that of x
+   (scaled to be normal if x is subnormal) and e is the exponent of x,
+   with -1074 <= e <= 1023 */
+static inline double
+log_normalized (double x, d64u64 v, int e)
+{
+  /* normalize v in [1,2) */
+  v.u = (0x3ffull << 52) | (v.u & 0xfffffffffffff);
+  /* now x = m*2^e with 1 <= m < 2 (m = v.f) and -1074 <= e <= 1023 */
+  if (__builtin_expect (v.u == 0x3ff0000000000000ull && e == 0, 0))
+    return 0;
+  double h, l;
+  cr_log_fast (&h, &l, e, v);
+
+  static const double err = LOG_FAST_ERR; /* maximal absolute error from
+                                             cr_log_fast */
+
+  /* Note: the error analysis is quite tight since if we replace the 0x1.b6p-69
+     bound by 0x1.3fp-69, it fails for x=0x1.71f7c59ede8ep+125 (rndz) */
+
+  double left = h + (l - err), right = h + (l + err);
+  if (left == right)
+    return left;
+  /* the probability of failure of the fast path is about 2^-11.5 */
+  return cr_log_accurate (x);
+}
+
 double
 cr_log (double x)
 {
@@ -677,25 +769,164 @@ cr_log (double x)
     }
   }
   /* now x > 0 */
-  /* normalize v in [1,2) */
-  v.u = (0x3ffull << 52) | (v.u & 0xfffffffffffff);
-  /* now x = m*2^e with 1 <= m < 2 (m = v.f) and -1074 <= e <= 1023 */
-  if (__builtin_expect (v.u == 0x3ff0000000000000ull && e == 0, 0))
+  return log_normalized (x, v, e);
+}
+
+/* Same as cr_log(), for 0x1p-1022 <= x <= 0x1.fffffffffffffp+1023, i.e.,
+   x is positive, normal and finite: the tests of the special cases of
+   cr_log() are skipped. The contract is checked with -DCORE_MATH_DEBUG
+   only, other inputs give unspecified results. */
+double
+cr_log_inrange (double x)
+{
+#ifdef CORE_MATH_DEBUG
+  assert (x >= 0x1p-1022 && x <= 0x1.fffffffffffffp+1023);
+#endif
+  d64u64 v = {.f = x};
+  return log_normalized (x, v, (v.u >> 52) - 0x3ff);
+}
+
+/* Set *lo and *hi to the roundings downwards and upwards of y, where
+   |y - (h+l)| < err and |l| < ulp(h), and return 1, or return 0 if y might
+   be too close to a binary64 number (same as as_interval() in
+   ../exp/exp.c, where the error analysis is given). */
+static inline int
+as_interval (double h, double l, double err, double *lo, double *hi)
+{
+  double v = h + l, d = l - (v - h);
+  d64u64 t = {.f = v};
+  if (__builtin_expect (!(t.u << 1) || (t.u << 1) >= 0x7ffull << 53, 0))
     return 0;
+  d64u64 up = {.u = t.u + 1}, dn = {.u = t.u - 1};
+  double a = __builtin_fabs (up.f - v), b = __builtin_fabs (v - dn.f);
+  double m = err + a * 0x1p-50, sd = (t.u >> 63) ? -d : d;
+  if (sd > m && sd + m < a) // |v| < |y| < |v+|
+  {
+    *lo = (t.u >> 63) ? up.f : v;
+    *hi = (t.u >> 63) ? v : up.f;
+  }
+  else if (sd < -m && sd - m > -b) // |v-| < |y| < |v|
+  {
+    *lo = (t.u >> 63) ? v : dn.f;
+    *hi = (t.u >> 63) ? dn.f : v;
+  }
+  else
+    return 0;
+  return 1;
+}
+
+/* Slow path of cr_log_interval(): call cr_log() with both directed
+   rounding modes. */
+static void __attribute__((noinline))
+cr_log_interval_slow (double x, double *lo, double *hi)
+{
+  volatile double vx = x; // see as_exp_interval_slow() in ../exp/exp.c
+  int rm = fegetround ();
+  fesetround (FE_DOWNWARD);
+  *lo = cr_log (vx);
+  fesetround (FE_UPWARD);
+  *hi = cr_log (vx);
+  fesetround (rm);
+}
+
+/* Set *lo and *hi to log(x) rounded downwards and upwards, with one
+   evaluation of cr_log_fast(). The rounding mode is only changed when the
+   slow path is used (for about 2^-10 of the inputs, and for x <= 0, x = 1,
+   Inf or NaN). Inexact is raised when lo <> hi (see README.md). */
+void
+cr_log_interval (double x, double *lo, double *hi)
+{
+  d64u64 v = {.f = x};
+  int e = (v.u >> 52) - 0x3ff;
+  if (__builtin_expect (e >= 0x400 || v.u == 0 || v.u == 0x3ff0000000000000ull, 0))
+    return cr_log_interval_slow (x, lo, hi); // x <= 0, NaN, Inf or x = 1
+  if (e == -0x3ff) /* subnormal */
+  {
+    v.f *= 0x1p52;
+    e = (v.u >> 52) - 0x3ff - 52;
+  }
+  v.u = (0x3ffull << 52) | (v.u & 0xfffffffffffff);
   double h, l;
   cr_log_fast (&h, &l, e, v);
+  if (__builtin_expect (!as_interval (h, l, LOG_FAST_ERR, lo, hi), 0))
+    cr_log_interval_slow (x, lo, hi);
+}
 
-  static const double err = 0x1.b6p-69; /* maximal absolute error from
-                                           cr_log_fast */
+/* Return cr_log(x) evaluated in the rounding mode rnd, which raises the
+   same exceptions (and sets errno) as cr_log() in that mode. */
+static double __attribute__((noinline))
+cr_log_r_slow (double x, int rnd)
+{
+  volatile double vx = x; // see as_exp_interval_slow() in ../exp/exp.c
+  int rm = fegetround ();
+  fesetround (rnd);
+  volatile double r = cr_log (vx);
+  fesetround (rm);
+  return r;
+}
 
-  /* Note: the error analysis is quite tight since if we replace the 0x1.b6p-69
-     bound by 0x1.3fp-69, it fails for x=0x1.71f7c59ede8ep+125 (rndz) */
+/* Return log(x) rounded according to rnd, assuming the current rounding
+   mode is to nearest (see cr_exp_r() in ../exp/exp.c). For x <= 0, x = 1,
+   Inf or NaN, cr_log() is called in the rounding mode rnd, so that the
+   exceptions are those of cr_log() in that mode (log(x) is never in the
+   subnormal or overflow range). */
+double
+cr_log_r (double x, int rnd)
+{
+  if (rnd != FE_DOWNWARD && rnd != FE_UPWARD && rnd != FE_TOWARDZERO)
+    return cr_log (x); // FE_TONEAREST
+  d64u64 v = {.f = x};
+  if (__builtin_expect (v.u - 1 >= 0x7fefffffffffffffull
+                        || v.u == 0x3ff0000000000000ull, 0))
+    return cr_log_r_slow (x, rnd); // x <= 0, NaN, Inf or x = 1
+  double lo, hi;
+  cr_log_interval (x, &lo, &hi);
+  if (rnd == FE_DOWNWARD)
+    return lo;
+  if (rnd == FE_UPWARD)
+    return hi;
+  return (v.u > 0x3ff0000000000000ull) ? lo : hi; // FE_TOWARDZERO
+}
 
-  double left = h + (l - err), right = h + (l + err);
-  if (left == right)
-    return left;
-  /* the probability of failure of the fast path is about 2^-11.5 */
-  return cr_log_accurate (x);
+/* Return h and put in l a double-double approximation h + l of
+   log(xh+xl), from the fast path of cr_log(), where xh > 0 and
+   |xl| <= ulp(xh)/2. The absolute error is less than 0x1.b7p-69
+   (0x1.01p-68 with CORE_MATH_LATENCY): that of cr_log_fast() is less than
+   LOG_FAST_ERR, and log(xh+xl) = log(xh) + xl/xh
+   with an error less than (xl/xh)^2/2 < 2^-107, and xl/xh is computed
+   with an error less than 2^-106. For xh <= 0, Inf or NaN, h is cr_log(xh)
+   and l is 0. */
+double
+cr_log_dd (double xh, double xl, double *l)
+{
+  d64u64 v = {.f = xh};
+  int e = (v.u >> 52) - 0x3ff;
+  if (__builtin_expect (e >= 0x400 || v.u == 0, 0)) // xh <= 0, NaN or Inf
+  {
+    *l = 0;
+    return cr_log (xh);
+  }
+  if (__builtin_expect (v.u == 0x3ff0000000000000ull, 0)) // xh = 1
+  {
+    *l = 0; // log(1+xl) = xl - xl^2/2 + ... with |xl| <= 2^-53
+    return xl;
+  }
+  if (e == -0x3ff) /* subnormal */
+  {
+    v.f *= 0x1p52;
+    e = (v.u >> 52) - 0x3ff - 52;
+  }
+  v.u = (0x3ffull << 52) | (v.u & 0xfffffffffffff);
+  double h, lo;
+  cr_log_fast (&h, &lo, e, v);
+  lo += xl / xh;
+  /* |h| might be smaller than |lo| for xh close to 1 */
+  if (__builtin_fabs (h) >= __builtin_fabs (lo))
+    fast_two_sum (&h, &lo, h, lo);
+  else
+    fast_two_sum (&h, &lo, lo, h);
+  *l = lo;
+  return h;
 }
 
 /* the following code was copied from Tom Hubrecht's implementation of
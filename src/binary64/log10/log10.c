@@ -68,6 +68,12 @@ fast_two_sum (double *hi, double *lo, double a, double b)
    More precisely r[i] is a 10-bit value such that r[i]*y-1 is representable
    exactly on 53 bits for any y, i*2^-9 <= y < (i+1)*2^-9.
    Moreover |r[i]*y-1| <= 0.00212097167968735. */
+#ifdef CORE_MATH_SHARED_LOG_TABLES
+// shared with log, see src/binary64/support/log_tables.c
+extern const double core_math_log_inverse[363], core_math_log_inv[363][2];
+#define _INVERSE core_math_log_inverse
+#define _LOG_INV core_math_log_inv
+#else
 static const double _INVERSE[363]= {
     0x1.698p+0, 0x1.688p+0, 0x1.678p+0, 0x1.668p+0, 0x1.658p+0, 0x1.648p+0, 0x1.638p+0,
     0x1.63p+0, 0x1.62p+0, 0x1.61p+0, 0x1.6p+0, 0x1.5fp+0, 0x1.5ep+0, 0x1.5dp+0,
@@ -492,6 +498,7 @@ static const double _LOG_INV[363][2] = {
     {0x1.61965cdb03p-2, -0x1.f08ad603c488ep-45},
     {0x1.630030b3abp-2, -0x1.db623e731aep-45},
 };
+#endif
 
 /* The following is a degree-6 polynomial approximating log(1+x) over
    [-0.00202941894531250,0.00212097167968735].
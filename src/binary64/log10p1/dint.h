@@ -327,6 +327,12 @@ static inline void div_dint (dint64_t *r, double b, double a)
   Approximation tables
 */
 
+#ifdef CORE_MATH_SHARED_LOG_TABLES
+// shared with log, see src/binary64/support/log_tables.c
+extern const dint64_t core_math_log_inverse_2[240], core_math_log_inv_2[240];
+#define _INVERSE_2 core_math_log_inverse_2
+#define _LOG_INV_2 core_math_log_inv_2
+#else
 static const dint64_t _INVERSE_2[] = {
     {.hi = 0x8000000000000000, .lo = 0x0,  .ex = 1, .sgn = 0x0},
     {.hi = 0xfe03f80fe03f80ff, .lo = 0x0,  .ex = 0, .sgn = 0x0},
@@ -812,6 +818,7 @@ static const dint64_t _LOG_INV_2[] = {
     {.hi = 0xb70475515d0f1c5e, .lo = 0x4c98c6b8be17818d,  .ex = -2, .sgn = 0x0},
     {.hi = 0xb86a1713c491aeaa, .lo = 0xd37ee2872a6f1cd6,  .ex = -2, .sgn = 0x0},
 };
+#endif
 
 static const dint64_t P_2[] = {
     {.hi = 0x99df88a0430813ca, .lo = 0xa1cffb6e966a70f6, .ex = -4, .sgn = 0x0},
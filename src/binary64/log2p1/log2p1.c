@@ -42,6 +42,12 @@ SOFTWARE.
   Approximation tables
 */
 
+#ifdef CORE_MATH_SHARED_LOG_TABLES
+// shared with log, see src/binary64/support/log_tables.c
+extern const dint64_t core_math_log_inverse_2[240], core_math_log_inv_2[240];
+#define _INVERSE_2 core_math_log_inverse_2
+#define _LOG_INV_2 core_math_log_inv_2
+#else
 static const dint64_t _INVERSE_2[] = {
     {.hi = 0x8000000000000000, .lo = 0x0,  .ex = 1, .sgn = 0x0},
     {.hi = 0xfe03f80fe03f80ff, .lo = 0x0,  .ex = 0, .sgn = 0x0},
@@ -527,6 +533,7 @@ static const dint64_t _LOG_INV_2[] = {
     {.hi = 0xb70475515d0f1c5e, .lo = 0x4c98c6b8be17818d,  .ex = -2, .sgn = 0x0},
     {.hi = 0xb86a1713c491aeaa, .lo = 0xd37ee2872a6f1cd6,  .ex = -2, .sgn = 0x0},
 };
+#endif
 
 static const dint64_t P_2[] = {
     {.hi = 0x99df88a0430813ca, .lo = 0xa1cffb6e966a70f6, .ex = -4, .sgn = 0x0},
@@ -576,6 +583,12 @@ fast_two_sum (double *hi, double *lo, double a, double b)
    More precisely r[i] is a 10-bit value such that r[i]*y-1 is representable
    exactly on 53 bits for any y, i*2^-9 <= y < (i+1)*2^-9.
    Moreover |r[i]*y-1| <= 0.00212097167968735. */
+#ifdef CORE_MATH_SHARED_LOG_TABLES
+// shared with log, see src/binary64/support/log_tables.c
+extern const double core_math_log_inverse[363], core_math_log_inv[363][2];
+#define _INVERSE core_math_log_inverse
+#define _LOG_INV core_math_log_inv
+#else
 static const double _INVERSE[363]= {
     0x1.698p+0, 0x1.688p+0, 0x1.678p+0, 0x1.668p+0, 0x1.658p+0, 0x1.648p+0, 0x1.638p+0,
     0x1.63p+0, 0x1.62p+0, 0x1.61p+0, 0x1.6p+0, 0x1.5fp+0, 0x1.5ep+0, 0x1.5dp+0,
@@ -1000,6 +1013,7 @@ static const double _LOG_INV[363][2] = {
     {0x1.61965cdb03p-2, -0x1.f08ad603c488ep-45},
     {0x1.630030b3abp-2, -0x1.db623e731aep-45},
 };
+#endif
 
 /* The following is a degree-7 polynomial generated by Sollya
    approximating log(1+x) for |x| < 0.00212097167968735,
@@ -1198,8 +1212,9 @@ cr_log2p1_accurate_tiny (double x)
 #ifdef CORE_MATH_SUPPORT_ERRNO
     errno = ERANGE; // underflow
 #endif
-    return (x > 0) ?__builtin_fma (0x1p-600, 0x1p-600, 0x1.fe0e7458ac1f8p-1025)
-      : __builtin_fma (-0x1p-600, 0x1p-600, -0x1.fe0e7458ac1f8p-1025);
+    volatile double t = 0x1p-600; // prevents constant folding
+    return (x > 0) ?__builtin_fma (t, 0x1p-600, 0x1.fe0e7458ac1f8p-1025)
+      : __builtin_fma (-t, 0x1p-600, -0x1.fe0e7458ac1f8p-1025);
   }
 
   /* first scale x to avoid truncation of l in the underflow region */
@@ -38,6 +38,9 @@ SOFTWARE.
 
 void doloop (int, int);
 extern double cr_pow (double, double);
+#ifndef cr_pow
+#include "pow_base.h"
+#endif
 extern int ref_fesetround (int);
 extern void ref_init (void);
 extern mpfr_rnd_t rnd2[];
@@ -113,6 +116,19 @@ check (double x, double y)
     printf ("ref_pow gives %la\n", t);
     exit (1);
   }
+#ifndef cr_pow
+  // the fixed-base interface should give the same result
+  cr_pow_base_t b;
+  cr_pow_prepare_base (x, &b);
+  t = cr_pow_with_base (&b, y);
+  if (!is_equal (z, t))
+  {
+    printf ("cr_pow and cr_pow_with_base differ for x=%la y=%la\n", x, y);
+    printf ("cr_pow           gives %la\n", z);
+    printf ("cr_pow_with_base gives %la\n", t);
+    exit (1);
+  }
+#endif
   mpfr_clear (X);
   mpfr_clear (Y);
   mpfr_clear (Z);
@@ -39,6 +39,18 @@ SOFTWARE.
 #include <inttypes.h>
 #include <stdio.h>
 
+/* With -DCORE_MATH_TABLE_SECTION, the tables below are put in the section
+   core_math_tables_pow, aligned on cache lines, see
+   src/generic/support/warmup.h. */
+#ifndef CORE_MATH_TABLE
+#ifdef CORE_MATH_TABLE_SECTION
+#define CORE_MATH_TABLE(family) \
+  __attribute__((section ("core_math_tables_" #family), aligned (64)))
+#else
+#define CORE_MATH_TABLE(family)
+#endif
+#endif
+
 /*
   Type and structure definitions
 */
@@ -594,7 +606,7 @@ static inline void div_dint (dint64_t *r, double b, double a)
    accompanying file dint.sage.
    There is no rounding error here, the only approximation error is in
    _LOG_INV_2_1[]. */
-static const dint64_t _INVERSE_2_1[] = {
+static const dint64_t _INVERSE_2_1[] CORE_MATH_TABLE (pow) = {
     {.hi = 0xb500000000000000, .lo = 0x0, .ex = 0, .sgn = 0x0}, /* i=90 */
     {.hi = 0xb300000000000000, .lo = 0x0, .ex = 0, .sgn = 0x0}, /* i=91 */     
     {.hi = 0xb100000000000000, .lo = 0x0, .ex = 0, .sgn = 0x0}, /* i=92 */     
@@ -698,7 +710,7 @@ static const dint64_t _INVERSE_2_1[] = {
    accompanying file dint.sage.
    There is no rounding error here, the only approximation error is in
    _LOG_INV_2_2[]. */
-static const dint64_t _INVERSE_2_2[] = {
+static const dint64_t _INVERSE_2_2[] CORE_MATH_TABLE (pow) = {
     {.hi = 0x8100000000000000, .lo = 0x0, .ex = 0, .sgn = 0x0}, /* j=8128 */
     {.hi = 0x80fc000000000000, .lo = 0x0, .ex = 0, .sgn = 0x0}, /* j=8129 */
     {.hi = 0x80f8000000000000, .lo = 0x0, .ex = 0, .sgn = 0x0}, /* j=8130 */
@@ -837,7 +849,7 @@ static const dint64_t _INVERSE_2_2[] = {
    If was generated with output_log_inv_2_1(7,9,90,181) from the
    accompanying file dint.sage.
    The approximation error is bounded by 2^-130 (absolute) and 2^-128 (rel). */
-static const dint64_t _LOG_INV_2_1[] = {
+static const dint64_t _LOG_INV_2_1[] CORE_MATH_TABLE (pow) = {
     {.hi = 0xb1641795ce3ca97b, .lo = 0x7af915300e517391, .ex = -2, .sgn = 0x1}, /* i=90 */
     {.hi = 0xabb3b8ba2ad362a4, .lo = 0xd5b6506cc17a01f1, .ex = -2, .sgn = 0x1}, /* i=91 */
     {.hi = 0xa5f2fcabbbc506da, .lo = 0x64ca4fb7ec323d73, .ex = -2, .sgn = 0x1}, /* i=92 */
@@ -940,7 +952,7 @@ static const dint64_t _LOG_INV_2_1[] = {
    accompanying file dint.sage.
    The approximation error is bounded by 2^-136 (absolute, attained for j=8256)
    and 2^-128 (relative, attained for j=8209). */
-static const dint64_t _LOG_INV_2_2[] = {
+static const dint64_t _LOG_INV_2_2[] CORE_MATH_TABLE (pow) = {
     {.hi = 0xff015358833c47e1, .lo = 0xbb481c8ee141695a, .ex = -8, .sgn = 0x1}, /* j=8128 */
     {.hi = 0xfb0933b732572a6d, .lo = 0x214cca3dd1d4796a, .ex = -8, .sgn = 0x1}, /* j=8129 */
     {.hi = 0xf710f492711d9d26, .lo = 0xfbc7b38b17b2019, .ex = -8, .sgn = 0x1}, /* j=8130 */
@@ -1075,7 +1087,7 @@ static const dint64_t _LOG_INV_2_2[] = {
 /* for 0 <= i < 64, T1_2[i] is a 128-bit nearest approximation of 2^(i/64),
    with error bounded by 2^-128 (both absolutely and relatively).
    Table generated by output_T1_2() from the accompanying dint.sage file. */
-static const dint64_t T1_2[] = {
+static const dint64_t T1_2[] CORE_MATH_TABLE (pow) = {
     {.hi = 0x8000000000000000, .lo = 0x0, .ex = 0, .sgn = 0x0},
     {.hi = 0x8164d1f3bc030773, .lo = 0x7be56527bd14def5, .ex = 0, .sgn = 0x0},
     {.hi = 0x82cd8698ac2ba1d7, .lo = 0x3e2a475b46520bff, .ex = 0, .sgn = 0x0},
@@ -1145,7 +1157,7 @@ static const dint64_t T1_2[] = {
 /* for 0 <= i < 64, T2_2[i] is a 128-bit nearest approximation of 2^(i/2^12),
    with error bounded by 2^-128 (both absolutely and relatively).
    Table generated by output_T2_2() from the accompanying dint.sage file. */
-static const dint64_t T2_2[] = {
+static const dint64_t T2_2[] CORE_MATH_TABLE (pow) = {
     {.hi = 0x8000000000000000, .lo = 0x0, .ex = 0, .sgn = 0x0},
     {.hi = 0x80058baf7fee3b5d, .lo = 0x1c718b38e549cb93, .ex = 0, .sgn = 0x0},
     {.hi = 0x800b179c82028fd0, .lo = 0x945e54e2ae18f2f0, .ex = 0, .sgn = 0x0},
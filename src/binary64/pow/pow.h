@@ -55,6 +55,18 @@ static inline void fast_extract (int64_t *e, uint64_t *m, double x) {
 #include "dint.h"
 #include "qint.h"
 
+/* With -DCORE_MATH_TABLE_SECTION, the tables below are put in the section
+   core_math_tables_pow, aligned on cache lines, see
+   src/generic/support/warmup.h. */
+#ifndef CORE_MATH_TABLE
+#ifdef CORE_MATH_TABLE_SECTION
+#define CORE_MATH_TABLE(family) \
+  __attribute__((section ("core_math_tables_" #family), aligned (64)))
+#else
+#define CORE_MATH_TABLE(family)
+#endif
+#endif
+
 double cr_pow(double x, double y);
 
 /* __builtin_roundeven was introduced in gcc 10:
@@ -491,7 +503,7 @@ static inline double qint_tod(qint64_t *a) {
    Moreover |r[i]*y-1| < 0.0040283203125.
    Table generated with the accompanying pow.sage file,
    with l=inverse_centered(k=8,prec=9,maxbits=53,verbose=false) */
-static const double _INVERSE[182]= {
+static const double _INVERSE[182] CORE_MATH_TABLE (pow) = {
     0x1.69p+0, 0x1.67p+0, 0x1.65p+0, 0x1.63p+0, 0x1.61p+0, 0x1.5fp+0, 0x1.5ep+0,
     0x1.5cp+0, 0x1.5ap+0, 0x1.58p+0, 0x1.56p+0, 0x1.54p+0, 0x1.53p+0, 0x1.51p+0,
     0x1.4fp+0, 0x1.4ep+0, 0x1.4cp+0, 0x1.4ap+0, 0x1.48p+0, 0x1.47p+0, 0x1.45p+0,
@@ -524,7 +536,7 @@ static const double _INVERSE[182]= {
    approximation of -log(r) for r=_INVERSE[i-181], h being an integer
    multiple of 2^-42.
    Since |l| < 2^-43, the maximal error is 1/2 ulp(l) <= 2^-97. */
-static const double _LOG_INV[182][2] = {
+static const double _LOG_INV[182][2] CORE_MATH_TABLE (pow) = {
     {-0x1.5ff3070a79p-2, -0x1.e9e439f105039p-45},
     {-0x1.5a42ab0f4dp-2, 0x1.e63af2df7ba69p-50},
     {-0x1.548a2c3addp-2, -0x1.3167e63081cf7p-45},
@@ -712,7 +724,7 @@ static const double _LOG_INV[182][2] = {
 /* For 0 <= i < 64, T1[i] = (h,l) such that h+l is the best double-double
    approximation of 2^(i/64). The approximation error is bounded as follows:
    |h + l - 2^(i/64)| < 2^-107. */
-static const double T1[][2] = {
+static const double T1[][2] CORE_MATH_TABLE (pow) = {
     {              0x1p+0,                 0x0p+0},
     {0x1.02c9a3e778061p+0, -0x1.19083535b085dp-56},
     {0x1.059b0d3158574p+0,  0x1.d73e2a475b465p-55},
@@ -782,7 +794,7 @@ static const double T1[][2] = {
 /* For 0 <= i < 64, T2[i] = (h,l) such that h+l is the best double-double
    approximation of 2^(i/2^12). The approximation error is bounded as follows:
    |h + l - 2^(i/2^12)| < 2^-107. */
-static const double T2[][2] = {
+static const double T2[][2] CORE_MATH_TABLE (pow) = {
     {              0x1p+0,                 0x0p+0},
     {0x1.000b175effdc7p+0,  0x1.ae8e38c59c72ap-54},
     {0x1.00162f3904052p+0, -0x1.7b5d0d58ea8f4p-58},
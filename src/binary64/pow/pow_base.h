@@ -0,0 +1,58 @@
+/* Fixed-base interface to the correctly-rounded power function.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* When x^y is computed for many y and the same x, the logarithm of x can be
+   computed once:
+
+     cr_pow_base_t b;
+     cr_pow_prepare_base (x, &b);
+     for (i = 0; i < n; i++)
+       z[i] = cr_pow_with_base (&b, y[i]);
+
+   cr_pow_with_base (&b, y) returns exactly cr_pow (x, y), with the same
+   exceptions and errno values, in the current rounding mode. The first
+   (double-double) and second (dint64_t) approximations of log|x| are stored
+   in b, the third one (qint64_t, used for very rare hard-to-round cases) is
+   recomputed when needed. The content of b should be considered opaque. */
+
+#ifndef CORE_MATH_POW_BASE_H
+#define CORE_MATH_POW_BASE_H
+
+#include <stdint.h>
+
+typedef struct {
+  double x;               /* the base */
+  double lh, ll;          /* log|x| from log_1() */
+  int cancel;             /* return value of log_1() */
+  uint64_t l2_hi, l2_lo;  /* log|x| from log_2(), as a dint64_t */
+  int64_t l2_ex;
+  uint64_t l2_sgn;
+} cr_pow_base_t;
+
+void cr_pow_prepare_base (double x, cr_pow_base_t *b);
+double cr_pow_with_base (const cr_pow_base_t *b, double y);
+
+#endif /* CORE_MATH_POW_BASE_H */
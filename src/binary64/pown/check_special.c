@@ -0,0 +1,247 @@
+/* Additional tests for the binary64 integer power function.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fenv.h>
+#include <math.h>
+#include <mpfr.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+#include <unistd.h>
+
+#include "../../generic/support/philox.h"
+
+extern double cr_pown (double, long long);
+extern int ref_fesetround (int);
+extern void ref_init (void);
+extern mpfr_rnd_t rnd2[];
+extern double ref_pown (double, long long);
+
+int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
+
+int rnd;
+int verbose = 0;
+
+static uint64_t Seed;
+
+typedef union {double f; uint64_t u;} b64u64_u;
+
+static inline uint64_t
+asuint64 (double f)
+{
+  b64u64_u u = {.f = f};
+  return u.u;
+}
+
+/* define our own is_nan function to avoid depending from math.h */
+static inline int
+is_nan (double x)
+{
+  uint64_t u = asuint64 (x);
+  int e = u >> 52;
+  return (e == 0x7ff || e == 0xfff) && (u << 12) != 0;
+}
+
+static inline int
+is_equal (double x, double y)
+{
+  if (is_nan (x))
+    return is_nan (y);
+  if (is_nan (y))
+    return is_nan (x);
+  return asuint64 (x) == asuint64 (y);
+}
+
+static void
+check (double x, long long n)
+{
+  double z, t;
+  z = cr_pown (x, n);
+  t = ref_pown (x, n);
+  if (!is_equal (z, t))
+  {
+    printf ("cr_pown and ref_pown differ for x=%la n=%lld\n", x, n);
+    printf ("cr_pown  gives %la\n", z);
+    printf ("ref_pown gives %la\n", t);
+    exit (1);
+  }
+}
+
+#ifndef CORE_MATH_TESTS
+#define CORE_MATH_TESTS 100000000ul // total number of tests
+#endif
+
+/* Random x, with n uniformly distributed in [-2^k,2^k] for random k,
+   and x either random, or close to 1 so that x^n does not overflow
+   for large |n|. */
+static void
+check_random (void)
+{
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t i = 0; i < CORE_MATH_TESTS; i++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround(rnd1[rnd]);
+    philox_t s;
+    philox_init (&s, Seed, i);
+    uint64_t u = philox_u64 (&s);
+    uint64_t v = philox_u64 (&s);
+    int k = v % 64;
+    long long n = (k == 63) ? (long long) v
+      : (long long) ((v >> 6) % (2ull << k)) - (1ll << k);
+    b64u64_u x = {.u = u};
+    if (i & 1) {
+      // |x| in [1-2^-d, 1+2^-d] with 2^d about |n|
+      int d = (k < 51) ? k + 1 : 52;
+      x.f = 1.0 + ldexp ((double) (int64_t) (u >> 11) * 0x1p-52 - 1.0, -d);
+      x.u |= u & 0x8000000000000000ull;
+    }
+    check (x.f, n);
+  }
+}
+
+/* Check exact and midpoint values x = m*2^e with m odd, where m^n fits in
+   54 bits. For each n, at most 1024 values of m are tried, and all values
+   of e such that x^n is near the underflow or overflow thresholds. */
+static void
+check_exact_or_midpoint (void)
+{
+  // max_pow[n] is the largest x such that x^n fits in 54 bits
+  int64_t max_pow[] = {0, 0, 134217727, 262143, 11585, 1782, 511, 210, 107, 63, 42, 30, 22, 17, 14, 12, 10, 9, 7, 7, 6, 5, 5, 5, 4, 4, 4, 3, 3, 3, 3, 3, 3, 3, 3};
+  for (int n = 34; n >= 2; n--)
+  {
+    int64_t dm = 2 * (1 + max_pow[n] / 2048); // should be even
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+    for (int64_t m = 3; m <= max_pow[n]; m += dm)
+    {
+      ref_init();
+      ref_fesetround(rnd);
+      fesetround(rnd1[rnd]);
+      int b = 64 - __builtin_clzll (m); // number of bits of m
+      // for e < emin, x^n < 2^-1076, for e > emax, x^n > 2^1024
+      int emin = -1076 / n - b, emax = 1024 / n + 1;
+      for (int e = emin; e <= emax; e += (e < emin + 16 || e > emax - 16) ? 1 : 37)
+      {
+        check (ldexp ((double) m, e), n);
+        check (ldexp (-(double) m, e), n);
+      }
+    }
+  }
+}
+
+/* Check integer powers of 2 and of values just above and below. */
+static void
+check_powers_of_two (void)
+{
+  static const long long N[] = {3, 7, 10, 53, 54, 1023, 1024, 1025, 1074, 1075, 2700, 2701, 1ll << 40, 0x7fffffffffffffffll};
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int e = -1074; e <= 1023; e++)
+  {
+    ref_init();
+    ref_fesetround(rnd);
+    fesetround(rnd1[rnd]);
+    double x = ldexp (1.0, e);
+    for (unsigned i = 0; i < sizeof (N) / sizeof (N[0]); i++)
+      for (int s = 0; s < 2; s++)
+      {
+        long long n = s ? -N[i] : N[i];
+        check (x, n);
+        check (-x, n);
+        check (nextafter (x, 0), n);
+        check (nextafter (x, INFINITY), n);
+      }
+  }
+  check (1.0, 0x7fffffffffffffffll);
+  check (-1.0, 0x7fffffffffffffffll);
+  check (-1.0, -0x7fffffffffffffffll - 1);
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--rndn") == 0)
+        {
+          rnd = 0;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndz") == 0)
+        {
+          rnd = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndu") == 0)
+        {
+          rnd = 2;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndd") == 0)
+        {
+          rnd = 3;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--verbose") == 0)
+        {
+          verbose = 1;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  printf ("Checking powers of 2\n");
+  check_powers_of_two ();
+
+  printf ("Checking exact/midpoint values\n");
+  check_exact_or_midpoint ();
+
+  Seed = philox_seed ();
+
+  printf ("Checking random values\n");
+  check_random ();
+
+  return 0;
+}
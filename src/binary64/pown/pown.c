@@ -0,0 +1,424 @@
+/* Correctly-rounded integer power function for a binary64 value.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* cr_pown(x,n) computes x^n for a binary64 value x and an integer n, as the
+   pown function from IEEE 754-2019 and C23. Since every integer n with
+   |n| <= 2^53 is exactly representable, pown(x,n) = pow(x,n) in that range,
+   but n might be larger, thus cr_pow() cannot be used directly.
+
+   |x|^|n| is computed by left-to-right binary exponentiation: the squarings
+   and the multiplications by x do not need the logarithm and exponential
+   of cr_pow(), and their error only grows linearly with |n|.
+   - the first phase uses double-double arithmetic, with relative error
+     less than (|n|+1)*2^-101, and a rounding test as in cr_pow();
+   - the second phase uses the 256-bit qint64_t arithmetic from ../pow,
+     with relative error less than 29*|n|*2^-255 < 2^-186. Before that, the
+     cases where x^n is exact or the middle of two binary64 numbers are
+     detected exactly, as in exact_pow() from ../pow/pow.c: since they are
+     rounding boundaries, no rounding test can decide them.
+
+   The result overflows or underflows as soon as |n*log2|x|| > 1100, which
+   happens for |n| > 2700 unless 0.75 <= |x| < 1.5, thus the exponents of
+   all intermediate values fit easily in an int64_t.
+*/
+
+#include <stdio.h> // needed in case of rounding-test failure
+#include <stdint.h>
+#include <stdlib.h> // for exit
+#include <errno.h>
+#include <math.h> // needed to define pown since it is not in glibc < 2.41
+#include <fenv.h>
+
+#include "qint.h"
+
+// Warning: clang also defines __GNUC__
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#endif
+
+#pragma STDC FENV_ACCESS ON
+
+/* Return 2^F, for |F| <= 1023, as a binary64 number */
+static inline double
+pow2 (int64_t F)
+{
+  f64_u r = {.u = (uint64_t) (F + 0x3ff) << 52};
+  return r.f;
+}
+
+/* Return the rounding of s*2^e, where |e| is large, with overflow (e > 0)
+   or underflow (e < 0). */
+static double
+out_of_range (double s, int64_t e)
+{
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  errno = ERANGE;
+#endif
+  volatile double t = s; // prevents constant folding when s is known
+  return (e > 0) ? (t * 0x1p1023) * 2.0 : (t * 0x1p-1074) * 0.25;
+}
+
+/* Return the rounding of s*2^F, with s = +1 or -1 and |F| <= 1074*2700. */
+static double
+pow2_result (double s, int64_t F)
+{
+  if (F > 1023)
+    return out_of_range (s, 1);
+  if (F >= -1022)
+    return s * pow2 (F);
+  if (F >= -1074) {
+    f64_u r = {.u = 1ull << (F + 1074)};
+    return s * r.f;
+  }
+  if (F < -1075)
+    return out_of_range (s, -1);
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  errno = ERANGE;
+#endif
+  volatile double t = s; // prevents constant folding when s is known
+  return (t * 0x1p-1074) * 0.5; // 2^-1075 is the middle of 0 and 2^-1074
+}
+
+/* Put in h+l an approximation of (h+l)^2, with relative error less than
+   5*2^-104, and |l| <= ulp(h), assuming |l| <= ulp(h) on input.
+   The error comes from the rounding of the fma, the neglected term l^2 and
+   the final fast_two_sum (valid in any rounding mode, see reference [1] in
+   ../pow/pow.c). */
+static inline void
+d_sqr (double *h, double *l)
+{
+  double hi = *h * *h;
+  double e = __builtin_fma (*h, *h, -hi); // exact
+  double lo = __builtin_fma (*h + *h, *l, e);
+  *h = hi + lo;
+  *l = lo - (*h - hi);
+}
+
+/* Put in h+l an approximation of (h+l)*m, with relative error less than
+   3*2^-104, and |l| <= ulp(h), assuming |l| <= ulp(h) on input. */
+static inline void
+d_mul1 (double *h, double *l, double m)
+{
+  double hi = *h * m;
+  double e = __builtin_fma (*h, m, -hi); // exact
+  double lo = __builtin_fma (*l, m, e);
+  *h = hi + lo;
+  *l = lo - (*h - hi);
+}
+
+/* Round a qint64_t approximation z of x^n to binary64, assuming the rounding
+   test succeeded or z is exact. */
+static double
+qint_result (qint64_t *z)
+{
+  if (z->ex < -1074) {
+    /* |z| < 2^-1074: qint_tod() cannot deal with these values. For
+       z->ex = -1075, z is the middle of 0 and 2^-1074 iff it is exactly
+       2^-1075. */
+    double s = z->sgn ? -1.0 : 1.0;
+    if (z->ex < -1075)
+      return out_of_range (s, -1);
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    errno = ERANGE;
+#endif
+    int mid = z->hh == (1ull << 63) && z->hl == 0 && z->lh == 0 && z->ll == 0;
+    volatile double t = s; // prevents constant folding
+    return (t * 0x1p-1074) * (mid ? 0.5 : 0.75);
+  }
+  /* |z| >= 2^1024: the overflow branch of qint_tod() loses the sign */
+  if (z->ex > 1023)
+    return out_of_range (z->sgn ? -1.0 : 1.0, 1);
+  double r = qint_tod (z);
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  if (__builtin_fabs (r) > 0x1.fffffffffffffp+1023)
+    errno = ERANGE; // overflow
+#endif
+  return r;
+}
+
+/* Accurate phase: x is finite, non-zero and not a power of 2, |n| >= 2. */
+static __attribute__((noinline)) double
+pown_accurate (double x, long long n)
+{
+  f64_u t = {.f = x};
+  uint64_t N = (n < 0) ? -(uint64_t) n : (uint64_t) n;
+  double s = ((t.u >> 63) && (N & 1)) ? -1.0 : 1.0;
+
+  // write |x| = M*2^(e-52) with 2^52 <= M < 2^53
+  int64_t e = ((t.u >> 52) & 0x7ff) - 0x3ff;
+  uint64_t M = t.u & 0xfffffffffffffull;
+  if (e == -0x3ff) { // x is subnormal
+    int k = __builtin_clzll (M) - 11;
+    M <<= k;
+    e = -1022 - k;
+  }
+  else
+    M |= 1ull << 52;
+
+  qint64_t z;
+
+  /* Exact and midpoint cases. If n < 0, x^n is never exact nor the
+     middle of two binary64 numbers, since x is not a power of 2. If n > 0,
+     write |x| = mo*2^f with mo odd: x^n = mo^n*2^(f*n) is exact or a
+     midpoint iff mo^n < 2^54, which implies n <= 34 since mo >= 3. */
+  if (n > 0 && N <= 34) {
+    int k = __builtin_ctzll (M);
+    uint64_t mo = M >> k, P = mo;
+    int64_t f = e - 52 + k;
+    for (uint64_t i = 1; i < N && P < (1ull << 54); i++)
+      P = (P <= (1ull << 54) / mo) ? P * mo : (1ull << 54);
+    if (P < (1ull << 54)) {
+      int64_t F = f * (int64_t) N; // x^n = s*P*2^F
+      int b = 64 - __builtin_clzll (P); // P has b bits
+      if (P < (1ull << 53) && F >= -1074 && F + b - 1 <= 1023) {
+        /* x^n is exactly representable: both products below are exact
+           since |F/2| <= 537 */
+        int64_t F1 = F / 2;
+        return (s * (double) P) * pow2 (F1) * pow2 (F - F1);
+      }
+      z.hh = P << (64 - b);
+      z.hl = z.lh = z.ll = 0;
+      z.ex = F + b - 1;
+      z.sgn = s < 0;
+      return qint_result (&z);
+    }
+  }
+
+  qint64_t X;
+  if (n > 0) {
+    X.hh = M << 11;
+    X.hl = X.lh = X.ll = 0;
+    X.ex = e;
+  }
+  else {
+    /* 1/|x| = 2^53/M * 2^(-e-1) with 1 < 2^53/M < 2: we compute the
+       first 255 bits of the fractional part of 2^53/M by long division,
+       thus with relative error less than 2^-255. */
+    u128 r = (1ull << 53) - M;
+    uint64_t q[4];
+    for (int i = 0; i < 4; i++) {
+      r <<= 64;
+      q[i] = r / M;
+      r = r % M;
+    }
+    X.hh = 1ull << 63 | q[0] >> 1;
+    X.hl = q[0] << 63 | q[1] >> 1;
+    X.lh = q[1] << 63 | q[2] >> 1;
+    X.ll = q[2] << 63 | q[3] >> 1;
+    X.ex = -e - 1;
+  }
+  X.sgn = 0;
+
+  /* Each mul_qint() call has relative error less than 14*2^-255. If z
+     approximates |x|^k (or |x|^-k) with relative error eta_k, then after
+     the squaring and the optional multiplication by X, the relative error
+     is less than 2*eta_k + 29*2^-255 (taking into account the error on X),
+     thus eta_N < 29*N*2^-255 by induction on the bit-length of N. */
+  z = X;
+  int i = 63 - __builtin_clzll (N);
+  while (i--) {
+    mul_qint (&z, &z, &z);
+    if ((N >> i) & 1)
+      mul_qint (&z, &z, &X);
+    /* |X|^k is monotonous in k, thus if |z| > 2^1100 or |z| < 2^-1100
+       for some prefix k of N, x^n overflows or underflows */
+    if (__builtin_expect (z.ex > 1100 || z.ex < -1100, 0))
+      return out_of_range (s, z.ex);
+  }
+
+  /* The relative error 29*N*2^-255 is less than 58*N ulp_256 of z, thus
+     less than B = N/16+2 in units of 2^10 ulp_256. The rounding test is
+     the same as in the third phase of cr_pow(). */
+  uint64_t B = (N >> 4) + 2;
+  uint64_t r1 = z.hh << 54 | z.hl >> 10;
+  uint64_t r2 = z.hl << 54 | z.lh >> 10;
+  uint64_t r3 = z.lh << 54 | z.ll >> 10;
+  if (__builtin_expect ((r1 == 0 && r2 == 0 && r3 <= B) ||
+                        (~r1 == 0 && ~r2 == 0 && ~r3 <= B), 0)) {
+    printf ("Unexpected worst-case found.\n");
+    printf ("Please report to core-math@inria.fr:\n");
+    printf ("Worst-case of pown found: x,n=%la,%lld\n", x, n);
+    exit (1);
+  }
+
+  z.sgn = s < 0;
+  z.ll = z.ll & (~0ull << 10);
+  return qint_result (&z);
+}
+
+double
+cr_pown (double x, long long n)
+{
+  f64_u t = {.f = x};
+  uint64_t ax = t.u & 0x7fffffffffffffffull;
+  uint64_t N = (n < 0) ? -(uint64_t) n : (uint64_t) n;
+  double s = ((t.u >> 63) & N & 1) ? -1.0 : 1.0; // sign of x^n
+
+  if (__builtin_expect (ax - 1 >= 0x7fefffffffffffffull, 0)) {
+    // x = +/-0, +/-Inf or NaN
+    if (ax > 0x7ff0000000000000ull) {
+      // IEEE 754-2019: pown(x,0) = 1 for any x, even a quiet NaN
+      if (n == 0 && (t.u & (1ull << 51)))
+        return 1.0;
+      return x + x; // returns qNaN and raises invalid for sNaN
+    }
+    if (n == 0)
+      return 1.0;
+    if (ax == 0x7ff0000000000000ull) // x = +/-Inf
+      return (n > 0) ? s * __builtin_inf () : s * 0.0;
+    // x = +/-0
+    if (n > 0)
+      return s * 0.0;
+    feraiseexcept (FE_DIVBYZERO);
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    errno = ERANGE; // pole error
+#endif
+    return s * __builtin_inf ();
+  }
+
+  if (__builtin_expect (N <= 2, 0)) {
+    if (n == 0)
+      return 1.0;
+    if (n == 1)
+      return x;
+    /* For n = -1 and 2^-1022 <= |x| < 2^1022, 1/x is a normal number,
+       and for n = 2 and 2^-511 <= |x| < 2^511, x*x is a normal number,
+       thus a single operation is correctly rounded, with no overflow
+       nor underflow to care about. */
+    if (n == -1 && ax - 0x0010000000000000ull < 0x7fd0000000000000ull - 0x0010000000000000ull)
+      return 1.0 / x;
+    if (n == 2 && ax - 0x2000000000000000ull < 0x5ff0000000000000ull - 0x2000000000000000ull)
+      return x * x;
+  }
+
+  // write |x| = m*2^e with 0.75 <= m < 1.5
+  int64_t e = (ax >> 52) - 0x3ff;
+  uint64_t mant = ax & 0xfffffffffffffull;
+  if (__builtin_expect (e == -0x3ff, 0)) { // x is subnormal
+    int k = __builtin_clzll (mant) - 11;
+    mant = (mant << k) & 0xfffffffffffffull;
+    e = -1022 - k;
+  }
+
+  if (__builtin_expect (mant == 0, 0)) { // |x| = 2^e
+    if (e == 0)
+      return s;
+    if (N > 2700)
+      return out_of_range (s, (e > 0) == (n > 0) ? 1 : -1);
+    return pow2_result (s, (n > 0) ? e * (int64_t) N : -e * (int64_t) N);
+  }
+
+  f64_u v = {.u = mant | 0x3ff0000000000000ull};
+  // branchless, since v.f >= 1.5 is hard to predict
+  uint64_t adj = v.f >= 1.5;
+  v.u -= adj << 52;
+  e += adj;
+
+  /* If e <> 0, |log2|x|| >= log2(4/3) > 0.415, thus for |n| > 2700,
+     |n*log2|x|| > 1120. */
+  if (__builtin_expect (e != 0 && N > 2700, 0))
+    return out_of_range (s, (e > 0) == (n > 0) ? 1 : -1);
+
+  /* For |n| >= 2^40, the double-double approximation is not accurate
+     enough to be worth it. */
+  if (__builtin_expect (N >> 40, 0))
+    return pown_accurate (x, n);
+
+  /* Left-to-right binary exponentiation: (h+l)*2^E approximates m^k for
+     the prefixes k of N. If h+l approximates m^k with relative error eta_k,
+     then after the squaring and the optional multiplication by m, the
+     relative error is less than 2*eta_k + 8*2^-104 = 2*eta_k + 2^-101,
+     thus by induction on the bit-length of N, the final relative error is
+     less than N*2^-101. */
+  double h = v.f, l = 0;
+  int64_t E = 0;
+  int i = 63 - __builtin_clzll (N);
+  while (i--) {
+    d_sqr (&h, &l);
+    E *= 2;
+    // multiplying by 1.0 is exact, and avoids a hard-to-predict branch
+    d_mul1 (&h, &l, ((N >> i) & 1) ? v.f : 1.0);
+    if (__builtin_expect (h > 0x1p+256 || h < 0x1p-256, 0)) {
+      /* 2^-513 < h < 2^514: scale h+l (exactly) into [1,2) */
+      f64_u w = {.f = h};
+      int64_t k = ((w.u >> 52) & 0x7ff) - 0x3ff;
+      double c = pow2 (-k);
+      E += k;
+      h *= c;
+      l *= c;
+      /* If e = 0, m^k is monotonous in k and |log2(m^k)| > 2047 thus
+         x^n overflows or underflows. If e <> 0, |log2(m^k)| <= 2700*0.585
+         thus |E| <= 1580. */
+      if (E > 2048 || E < -2048)
+        return out_of_range (s, (E > 0) == (n > 0) ? 1 : -1);
+    }
+  }
+
+  /* If all operations were exact, x^n might be exact, which the rounding
+     test cannot decide (and we do not want to raise inexact) */
+  if (__builtin_expect (l == 0 && n > 0, 0))
+    return pown_accurate (x, n);
+
+  int64_t S = E + e * (int64_t) N; // |x|^N ~ (h+l)*2^S
+  if (n < 0) {
+    /* 1/(h+l) = rh*(1 + eps - rh*l) + O(2^-102), where eps = 1 - rh*h is
+       exact. The rounding errors are bounded by 2^-103 each, thus the
+       relative error is less than (N+1)*2^-101 in total. */
+    double rh = 1.0 / h;
+    double eps = __builtin_fma (-rh, h, 1.0);
+    l = rh * __builtin_fma (-rh, l, eps);
+    h = rh;
+    S = -S;
+  }
+  h *= s;
+  l *= s;
+
+  /* we use the error bound (N+1)*2^-99 to account for second-order terms */
+  double err = ((double) N + 1.0) * 0x1p-99;
+  double res_min = h + __builtin_fma (err, -h, l);
+  double res_max = h + __builtin_fma (err, h, l);
+  if (__builtin_expect (res_min == res_max, 1)) {
+    f64_u r = {.f = res_max};
+    int64_t k = ((r.u >> 52) & 0x7ff) - 0x3ff + S; // exponent of x^n
+    if (__builtin_expect (-1022 <= k && k <= 1023, 1)) {
+      /* 2^-514 < |res_max| < 2^514 thus |S| <= 1023 + 514, both factors
+         are normal numbers, and res_max*2^(S/2) too: the products are
+         exact */
+      int64_t S1 = S / 2;
+      return res_max * pow2 (S1) * pow2 (S - S1);
+    }
+    if (k > 1100 || k < -1100)
+      return out_of_range (s, k);
+  }
+  return pown_accurate (x, n);
+}
+
+#ifndef SKIP_C_FUNC_REDEF
+/* just to compile since glibc < 2.41 does not contain this function */
+double pown (double x, long long n){
+  return pow (x, (double) n);
+}
+#endif
@@ -0,0 +1,273 @@
+/* Arithmetic on 256-bit significands for the binary64 integer power function.
+
+Copyright (c) 2022, 2023 CERN and Inria
+Authors: Tom Hubrecht and Paul Zimmermann
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+  This file contains the subset of ../pow/qint.h (and of qint_tod from
+  ../pow/pow.h) used by pown.c: the qint64_t type, whose significand is
+  composed of four uint64_t values and whose exponent is a signed int64_t
+  value, the multiplication, and the conversion to double. Unlike the
+  original, the sticky bit of subnormalize_qint takes into account all the
+  bits of hh below the round bit (they are not always zero for the exact
+  values of pown), and qint_tod raises inexact for subnormal results.
+*/
+
+#ifndef QINT_H
+#define QINT_H
+
+#include <stdint.h>
+#include <fenv.h>
+#include <errno.h>
+
+#ifndef UINT128_T
+#define UINT128_T
+
+#if (defined(__clang__) && __clang_major__ >= 14) || (defined(__GNUC__) && __GNUC__ >= 14)
+typedef unsigned _BitInt(128) u128;
+#else
+typedef unsigned __int128 u128;
+#endif
+
+#endif
+
+// Add two 128-bit integers and return 1 if a carry occured
+static inline int addu128 (u128 a, u128 b, u128 *r) {
+  *r = a + b;
+  // Return the carry
+  return *r < a;
+}
+
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+typedef union {
+  /* Use a little-endian representation.
+     FIXME: adapt for big-endian processors. */
+  struct {
+    u128 rl;
+    u128 rh;
+    int64_t _ex;
+    uint64_t _sgn;
+  };
+  struct {
+    uint64_t ll; /* lower low part */
+    uint64_t lh; /* upper low part */
+    uint64_t hl; /* lower high part */
+    uint64_t hh; /* upper high part */
+    int64_t ex;
+    uint64_t sgn;
+  };
+} qint64_t;
+#else
+typedef union {
+  struct {
+    u128 rl;
+    u128 rh;
+    int64_t _ex;
+    uint64_t _sgn;
+  };
+  struct {
+    uint64_t lh; /* upper low part */
+    uint64_t ll; /* lower low part */
+    uint64_t hh; /* upper high part */
+    uint64_t hl; /* lower high part */
+    int64_t ex;
+    uint64_t sgn;
+  };
+} qint64_t;
+#endif
+
+
+// Multiply two dint64_t numbers, with error < 14 ulps
+static inline void
+mul_qint (qint64_t *r, const qint64_t *a, const qint64_t *b) {
+  u128 r33 = (u128)(a->hh) * (u128)(b->hh);
+
+  u128 r32 = (u128)(a->hh) * (u128)(b->hl);
+  u128 r23 = (u128)(a->hl) * (u128)(b->hh);
+
+  u128 r31 = (u128)(a->hh) * (u128)(b->lh);
+  u128 r13 = (u128)(a->lh) * (u128)(b->hh);
+  u128 r22 = (u128)(a->hl) * (u128)(b->hl);
+
+  u128 r30 = (u128)(a->hh) * (u128)(b->ll);
+  u128 r03 = (u128)(a->ll) * (u128)(b->hh);
+  u128 r21 = (u128)(a->hl) * (u128)(b->lh);
+  u128 r12 = (u128)(a->lh) * (u128)(b->hl);
+
+  u128 t6, t5, t4, t3;
+  u128 c5, c4;
+
+  t3 = (r12 >> 64) + (r21 >> 64) + (r03 >> 64) + (r30 >> 64);
+  /* no overflow since each term is < 2^64, thus the sum < 2^66 */
+
+  /* t3 is the sum of the terms of "degree" 3 divided by 2^64 */
+
+  c4 = addu128 (r22, t3, &t4);
+  c4 += addu128 (r13, t4, &t4);
+  c4 += addu128 (r31, t4, &t4);
+
+  /* (c4:1,t4:128) is the sum of the terms of "degree" 3 and 4 */
+
+  c5 = addu128 (r23, t4 >> 64, &t5);
+  c5 += addu128 (r32, t5, &t5);
+
+  /* (c5:1,t5:128,low(t4):64) is the sum of the terms of "degree" 3 to 5 */
+
+  t6 = r33 + ((c5 << 64) | (t5 >> 64)) + c4;
+
+  /* (t6:128,low(t5):64,low(t4):64) is the sum of the terms of "degree" 3-6 */
+
+  /* No carry can happen since the full product of the significands is
+     bounded by 2^512.
+     The approximated sum is:
+     t6 (128 bits) + low(t5) (64 bits) + low(t4) (64 bits) + low(t3) (64 bits)
+     with error bounded by:
+     * 3*(B-1)^2/B^2 ulp for the neglected terms of "degree" 2: r20 + r11 + r02
+     * 2*(B-1)^2/B^3 ulp for the neglected terms of "degree" 1: r10 + r01
+     * 1*(B-1)^2/B^4 ulp for the neglected term of "degree" 0: r00
+     * 1 ulp for each of the neglected low parts of r12, r21, r03 and r30
+       thus 4 ulps in total
+     The sum of the first three terms is less than 3, thus bounded by 3 ulps.
+     This yields an error bound of 7 ulps so far.
+  */
+
+  uint64_t ex = !(t6 >> 127);
+
+  t5 = (t5 << 64) | (t4 & (u128) 0xffffffffffffffff);
+  if (ex) { /* ex=1 */
+    r->rh = (t6 << 1) | (t5 >> 127);
+    r->rl = t5 << 1;
+    /* the previous rounding error is multiplied by 2, thus < 14 ulps now */
+  }
+  else { /* ex=0 */
+    r->rh = t6;
+    r->rl = t5;
+    /* error < 7 ulps */
+  }
+
+  r->ex = a->ex + b->ex + 1 - ex;
+
+  r->sgn = a->sgn ^ b->sgn;
+}
+
+/* same as mul_qint, but considering only the upper 3 limbs from a and b,
+   and with error < 6 ulps */
+
+typedef union {
+  double f;
+  uint64_t u;
+} f64_u;
+
+static inline void subnormalize_qint(qint64_t *a) {
+  if (a->ex > -1023)
+    return;
+
+  uint64_t ex = -(1011 + a->ex);
+
+  uint64_t hi = a->hh >> ex;
+  uint64_t md = (a->hh >> (ex - 1)) & 0x1;
+  // sticky bit: bits of hh below the round bit, and the lower limbs
+  uint64_t lo = (a->hh & (~0ull >> (65 - ex))) || a->hl || a->lh || a->ll;
+
+  switch (fegetround()) {
+  case FE_TONEAREST:
+    hi += lo ? md : hi & md;
+    break;
+  case FE_DOWNWARD:
+    hi += a->sgn & (md | lo);
+    break;
+  case FE_UPWARD:
+    hi += (!a->sgn) & (md | lo);
+    break;
+  }
+
+  a->hh = hi << ex;
+  a->hl = 0;
+  a->lh = 0;
+  a->ll = 0;
+
+  if (!a->hh) {
+    a->ex++;
+    a->hh = (1ull << 63);
+  }
+}
+
+// Convert a dint64_t value to a double
+static inline double qint_tod(qint64_t *a) {
+  subnormalize_qint(a);
+
+  f64_u r = {.u = (a->hh >> 11) | (0x3ffll << 52)};
+
+  double rd = 0.0;
+  if (a->hh & 0x400)
+    rd += 0x1p-53;
+
+  if (a->hh & 0x3ff || a->hl || a->lh || a->ll)
+    rd += 0x1p-54;
+
+  if (a->sgn)
+    rd = -rd;
+
+  r.u = r.u | a->sgn << 63;
+  r.f += rd;
+
+  f64_u e;
+
+  if (a->ex > -1023) { // The result is a normal double
+    if (a->ex > 1023)
+      if (a->ex == 1024) {
+        r.f = r.f * 0x1p+1;
+        e.f = 0x1p+1023;
+      } else {
+        r.f = 0x1.fffffffffffffp+1023;
+        e.f = 0x1.fffffffffffffp+1023;
+      }
+    else
+      e.u = ((a->ex + 1023) & 0x7ff) << 52;
+  } else { // subnormal case
+    /* exact values are never converted here (see pown_accurate), thus the
+       result is inexact */
+    feraiseexcept (FE_UNDERFLOW | FE_INEXACT); // raise underflow and inexact
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    errno = ERANGE; // underflow
+#endif
+    if (a->ex < -1074) {
+      if (a->ex == -1075) {
+        r.f = r.f * 0x1p-1;
+        e.f = 0x1p-1074;
+      } else {
+        r.f = 0x0.0000000000001p-1022;
+        e.f = 0x0.0000000000001p-1022;
+      }
+    } else {
+      e.u = 1ll << (a->ex + 1074);
+    }
+  }
+
+  return r.f * e.f;
+}
+
+#endif
@@ -0,0 +1,253 @@
+/* Additional tests for the binary64 n-th root function.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fenv.h>
+#include <math.h>
+#include <mpfr.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+#include <unistd.h>
+
+#include "../../generic/support/philox.h"
+
+extern double cr_rootn (double, long long);
+extern int ref_fesetround (int);
+extern void ref_init (void);
+extern mpfr_rnd_t rnd2[];
+extern double ref_rootn (double, long long);
+
+int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
+
+int rnd;
+int verbose = 0;
+
+static uint64_t Seed;
+
+typedef union {double f; uint64_t u;} b64u64_u;
+
+static inline uint64_t
+asuint64 (double f)
+{
+  b64u64_u u = {.f = f};
+  return u.u;
+}
+
+/* define our own is_nan function to avoid depending from math.h */
+static inline int
+is_nan (double x)
+{
+  uint64_t u = asuint64 (x);
+  int e = u >> 52;
+  return (e == 0x7ff || e == 0xfff) && (u << 12) != 0;
+}
+
+static inline int
+is_equal (double x, double y)
+{
+  if (is_nan (x))
+    return is_nan (y);
+  if (is_nan (y))
+    return is_nan (x);
+  return asuint64 (x) == asuint64 (y);
+}
+
+static void
+check (double x, long long n)
+{
+  double z, t;
+  z = cr_rootn (x, n);
+  t = ref_rootn (x, n);
+  if (!is_equal (z, t))
+  {
+    printf ("cr_rootn and ref_rootn differ for x=%la n=%lld\n", x, n);
+    printf ("cr_rootn  gives %la\n", z);
+    printf ("ref_rootn gives %la\n", t);
+    exit (1);
+  }
+}
+
+#ifndef CORE_MATH_TESTS
+#define CORE_MATH_TESTS 100000000ul // total number of tests
+#endif
+
+/* Random x, with n uniformly distributed in [-2^k,2^k] for random k,
+   and x either random, or close to 1 for large |n|. */
+static void
+check_random (void)
+{
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t i = 0; i < CORE_MATH_TESTS; i++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround(rnd1[rnd]);
+    philox_t s;
+    philox_init (&s, Seed, i);
+    uint64_t u = philox_u64 (&s);
+    uint64_t v = philox_u64 (&s);
+    int k = v % 64;
+    long long n = (k == 63) ? (long long) v
+      : (long long) ((v >> 6) % (2ull << k)) - (1ll << k);
+    b64u64_u x = {.u = u};
+    if (i & 1) {
+      // |x| in [1-2^-d, 1+2^-d] for random d
+      int d = (v >> 58) % 53;
+      x.f = 1.0 + ldexp ((double) (int64_t) (u >> 11) * 0x1p-52 - 1.0, -d);
+      x.u |= u & 0x8000000000000000ull;
+    }
+    check (x.f, n);
+  }
+}
+
+/* Check exact values x = t^n with t = m*2^e and m odd, where m^n fits in
+   53 bits, together with their neighbours. For each n, at most 1024 values
+   of m are tried, with all values of e such that t^n is near the underflow
+   or overflow thresholds. */
+static void
+check_exact (void)
+{
+  // max_root[n] is the largest m such that m^n fits in 53 bits
+  int64_t max_root[] = {0, 0, 94906265, 208063, 9741, 1552, 456, 190, 98, 59, 39, 28, 21, 16, 13, 11, 9, 8, 7, 6, 6, 5, 5, 4, 4, 4, 4, 3, 3, 3, 3, 3, 3, 3};
+  for (int n = 33; n >= 2; n--)
+  {
+    int64_t dm = 2 * (1 + max_root[n] / 2048); // should be even
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+    for (int64_t m = 3; m <= max_root[n]; m += dm)
+    {
+      ref_init();
+      ref_fesetround(rnd);
+      fesetround(rnd1[rnd]);
+      int64_t p = m;
+      for (int i = 1; i < n; i++)
+        p *= m;
+      int b = 64 - __builtin_clzll (p); // number of bits of m^n
+      // x = m^n*2^(e*n) is in the binary64 range for emin <= e <= emax
+      int emin = (-1074 + n - 1) / n, emax = (1024 - b) / n;
+      for (int e = emin; e <= emax; e += (e < emin + 8 || e > emax - 8) ? 1 : 13)
+      {
+        double x = ldexp ((double) p, e * n);
+        for (int s = 0; s < 2; s++)
+        {
+          check (x, s ? -n : n);
+          check (-x, s ? -n : n);
+          check (nextafter (x, 0), s ? -n : n);
+          check (nextafter (x, INFINITY), s ? -n : n);
+        }
+      }
+    }
+  }
+}
+
+/* Check integer powers of 2 and of values just above and below. */
+static void
+check_powers_of_two (void)
+{
+  static const long long N[] = {0, 1, 2, 3, 7, 10, 53, 54, 1023, 1024, 1025, 1074, 1075, 2700, 2701, 1ll << 40, 0x7fffffffffffffffll, -0x7fffffffffffffffll - 1};
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int e = -1074; e <= 1023; e++)
+  {
+    ref_init();
+    ref_fesetround(rnd);
+    fesetround(rnd1[rnd]);
+    double x = ldexp (1.0, e);
+    for (unsigned i = 0; i < sizeof (N) / sizeof (N[0]); i++)
+      for (int s = 0; s < 2; s++)
+      {
+        long long n = s ? -N[i] : N[i];
+        check (x, n);
+        check (-x, n);
+        check (nextafter (x, 0), n);
+        check (nextafter (x, INFINITY), n);
+      }
+  }
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--rndn") == 0)
+        {
+          rnd = 0;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndz") == 0)
+        {
+          rnd = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndu") == 0)
+        {
+          rnd = 2;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndd") == 0)
+        {
+          rnd = 3;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--verbose") == 0)
+        {
+          verbose = 1;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  printf ("Checking powers of 2\n");
+  check_powers_of_two ();
+
+  printf ("Checking exact values\n");
+  check_exact ();
+
+  Seed = philox_seed ();
+
+  printf ("Checking random values\n");
+  check_random ();
+
+  return 0;
+}
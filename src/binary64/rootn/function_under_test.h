@@ -0,0 +1,26 @@
+/* The generic bivariate checks give the integer index n of rootn as a
+   binary64 value, which is converted back below. */
+#define cr_function_under_test cr_rootn_d
+#define ref_function_under_test ref_rootn_d
+#define mpfr_function_under_test mpfr_rootn_d
+
+double cr_rootn (double, long long);
+double ref_rootn (double, long long);
+
+/* y is NaN only in the checks of signaling NaN inputs: the addition is done
+   on the result of cr_rootn, which the compiler cannot fold */
+static inline double cr_rootn_d (double x, double y)
+{
+  return (y != y) ? cr_rootn (x, 0) + y : cr_rootn (x, (long long) y);
+}
+
+static inline double ref_rootn_d (double x, double y)
+{
+  return (y != y) ? x + y : ref_rootn (x, (long long) y);
+}
+
+static inline int
+mpfr_rootn_d (mpfr_ptr r, mpfr_srcptr x, mpfr_srcptr y, mpfr_rnd_t rnd)
+{
+  return mpfr_rootn_si (r, x, mpfr_get_si (y, MPFR_RNDN), rnd);
+}
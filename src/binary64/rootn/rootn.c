@@ -0,0 +1,398 @@
+/* Correctly-rounded n-th root function for a binary64 value.
+
+Copyright (c) 2022-2025 CERN and Inria
+Authors: Tom Hubrecht and Paul Zimmermann
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* cr_rootn(x,n) computes x^(1/n) for a binary64 x and an integer n, as the
+   rootn function from IEEE 754-2019 and C23.
+
+   It reuses the three phases of cr_pow() from ../pow/pow.c (shared through
+   ../pow/pow_engine.h), where the product
+   y*log|x| is replaced by the quotient log|x|/n:
+   - in the first phase, log_1() is followed by a double-double division
+     by n, and exp_1();
+   - in the accurate phases, the dint64_t and qint64_t approximations of
+     log|x| from log_2() and log_3() are divided by |n| with integer
+     divisions, followed by exp_2() and exp_3().
+   Since |log|x|| < 745 and |n| >= 2 in the main path, the result lies in
+   [2^-538, 2^512]: there is no overflow nor underflow. The result is exact
+   when |x| = t^n for a binary64 number t, which is only possible for
+   |x| = 2^e and n dividing e, or for 3 <= n <= 33 (since 3^34 > 2^53),
+   and it cannot be a midpoint: if t has 54 significant bits with an odd
+   last bit, t^n has more than 53 significant bits. */
+
+/* References:
+   [1] Note on FastTwoSum with Directed Rounding, Paul Zimmermann,
+       https://hal.inria.fr/hal-03798376/, 2022.
+   [2] An efficient rounding boundary test for pow(x,y) in double precision,
+       Christoph Lauter, Vincent Lefèvre,
+       https://hal-ens-lyon.archives-ouvertes.fr/ensl-00169409, 2007.
+   [3] Arrondi correct de fonctions mathématiques, Fonctions univariées et
+       bivariées, certification et automatisation, Christoph Quirin Lauter,
+       PhD thesis, 2008, in french,
+       http://www.ens-lyon.fr/LIP/Pub/Rapports/PhD/PhD2008/PhD2008-07.pdf
+   [4] An efficient rounding boundary test for pow(x,y) in double precision,
+       Christoph Lauter, Vincent Lefèvre, IEEE Transactions on Computers,
+       volume 58, number 2, 197-207, 2009.
+   [5] Towards a correctly-rounded and fast power function in binary64
+       arithmetic, Tom Hubrecht, Claude-Pierre Jeannerod, Paul Zimmermann,
+       ARITH 2023 - 30th IEEE Symposium on Computer Arithmetic, 2023.
+       Detailed version (with full proofs) available at
+       https://inria.hal.science/hal-04159652.
+   [6] On Ziv's rounding test, F. De Dinechin, C. Lauter, J.-M. Muller,
+       S. Torres, ACM Trans. Math. Soft., volume 39, number 3, 2013.
+
+   The routines from ../pow/pow_engine.h correspond to reference [5].
+*/
+
+#include <stdio.h> // needed in case of rounding-test failure
+#include <stdint.h>
+#include <stdlib.h> // for exit
+#include <errno.h>
+#include <fenv.h> // for fegetround, FE_TONEAREST, FE_DOWNWARD, FE_UPWARD, ...
+#include <math.h> // needed to define rootn since it is not in glibc < 2.41
+
+double cr_rootn (double x, long long n);
+
+// Warning: clang also defines __GNUC__
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#endif
+
+#pragma STDC FENV_ACCESS ON
+
+/* the three phases of cr_pow() */
+#include "../pow/pow_engine.h"
+
+/************************** rootn-specific code ******************************/
+
+/* Put in r the quotient a/N truncated to 128 bits, for 1 <= N <= 2^63.
+   Since a->hi >= 2^63 >= N, the first quotient limb is non-zero, and the
+   relative error is less than 2^-127. */
+static inline void
+div_dint_u64 (dint64_t *r, const dint64_t *a, uint64_t N)
+{
+  uint64_t q0 = a->hi / N, rem = a->hi % N;
+  u128 t = (u128) rem << 64 | a->lo;
+  uint64_t q1 = t / N;
+  rem = t % N;
+  uint64_t q2 = ((u128) rem << 64) / N;
+  int c = __builtin_clzll (q0);
+  r->hi = c ? q0 << c | q1 >> (64 - c) : q0;
+  r->lo = c ? q1 << c | q2 >> (64 - c) : q1;
+  r->ex = a->ex - c;
+  r->sgn = a->sgn;
+}
+
+/* Put in r the quotient a/N truncated to 256 bits, for 1 <= N <= 2^63,
+   with relative error less than 2^-255. */
+static inline void
+div_qint_u64 (qint64_t *r, const qint64_t *a, uint64_t N)
+{
+  uint64_t q[5], rem = 0;
+  const uint64_t l[5] = {a->hh, a->hl, a->lh, a->ll, 0};
+  for (int i = 0; i < 5; i++) {
+    u128 t = (u128) rem << 64 | l[i];
+    q[i] = t / N;
+    rem = t % N;
+  }
+  int c = __builtin_clzll (q[0]);
+  if (c) {
+    for (int i = 0; i < 4; i++)
+      q[i] = q[i] << c | q[i + 1] >> (64 - c);
+  }
+  r->hh = q[0];
+  r->hl = q[1];
+  r->lh = q[2];
+  r->ll = q[3];
+  r->ex = a->ex - c;
+  r->sgn = a->sgn;
+}
+
+/* Return non-zero iff t = mt*2^et is the n-th root of |x|, with mt odd:
+   writing |x| = mx*2^ex with mx odd, this is mt^n = mx and et*n = ex. */
+static inline int
+is_root (uint64_t mt, int64_t et, double x, long long n)
+{
+  int64_t ex;
+  uint64_t mx;
+  extract (&ex, &mx, x);
+  if (et * n != ex)
+    return 0;
+  uint64_t p = mt;
+  for (long long i = 1; i < n; i++)
+    if (__builtin_mul_overflow (p, mt, &p) || p > mx)
+      return 0;
+  return p == mx;
+}
+
+/* Special cases: x = +/-0, +/-Inf or NaN, n = 0, n = 1, n = -1, or x < 0
+   with n even. */
+static __attribute__((noinline)) double
+rootn_special (double x, long long n)
+{
+  if (x != x) // NaN
+    return x + x; // returns qNaN and raises invalid for sNaN
+
+  f64_u t = {.f = x};
+  uint64_t ax = t.u & 0x7fffffffffffffffull;
+  /* x < 0 is tested on the encoding, since a subnormal x compares equal
+     to 0 in DAZ mode */
+  if (n == 0 || ((t.u >> 63) && ax != 0 && !(n & 1))) {
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    errno = EDOM;
+#endif
+    feraiseexcept (FE_INVALID);
+    return NAN;
+  }
+
+  // for x = +/-0, +/-Inf, the result is +/-0 or +/-Inf, with sign + for n even
+  double r = (n & 1) ? x : __builtin_fabs (x);
+  if (ax == 0 || ax == 0x7ff0000000000000ull) {
+    if (n > 0)
+      return r;
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    if (ax == 0)
+      errno = ERANGE; // pole error
+#endif
+    return 1.0 / r; // raises divbyzero for x = +/-0
+  }
+
+  if (n == 1)
+    return x;
+
+  // n = -1: 1/x is correctly rounded
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  /* 1/x overflows for |x| <= 2^-1024, and underflows for |x| > 2^1022
+     unless |x| is a power of 2 */
+  if (ax <= 0x0004000000000000ull
+      || (ax > 0x7fd0000000000000ull && (ax & 0xfffffffffffffull)))
+    errno = ERANGE;
+#endif
+  return 1.0 / x;
+}
+
+/* Second and third phases, when the rounding test of the first phase fails.
+   Here x > 0, s = +1 or -1 is the sign of the result, 2 <= |n| and
+   flag is the inexact flag on entry to cr_rootn(). */
+static __attribute__((noinline)) double
+rootn_accurate (double x, long long n, double s, FLAG_T flag)
+{
+  uint64_t N = (n < 0) ? -(uint64_t) n : (uint64_t) n;
+  uint64_t rd; // used in the 2nd and 3rd phases
+
+  dint64_t X, R;
+  dint_fromd (&X, x); /* exact */
+  log_2 (&R, &X); /* relative error bounded by 2^-122.88 */
+  div_dint_u64 (&R, &R, N);
+  R.sgn ^= n < 0;
+  /* R = log(x)/n * (1+eps1) with |eps1| < 2^-122.88 + 2^-127 < 2^-122.82 */
+
+  exp_2 (&R, &R); /* relative error < 2^-121.70 */
+
+  /* Since |log(x)/n| < 745/2 < 2^8.55, the relative error is bounded by
+     exp(2^8.55*2^-122.82)*(1+2^-121.70)-1 < 2^-114.26, which corresponds
+     to an error of at most 2^-114.26*2^128 < 13680 ulps.
+     The result lies in [2^-538, 2^512], thus R is in the normal range. */
+#define ERR_BND_2 14 /* ceil(13680/2^10) */
+  uint64_t lo = R.lo >> 10 | R.hi << 54;
+  rd = lo + ERR_BND_2 > (2*ERR_BND_2);
+
+  R.sgn = s < 0;
+  if (rd)
+    return dint_tod (&R, 0);
+
+  /* Exact cases: for 3 <= n <= 33, x might be t^n for a binary64 number t,
+     then R approximates t with relative error less than 2^-114, thus t is
+     R rounded to 54 bits. */
+  if (n >= 3 && n <= 33) {
+    int64_t G, k;
+    round_54 (&G, &k, &R); /* R is rounded to k*2^G */
+    int c = __builtin_ctzll (k);
+    if (is_root (k >> c, G + c, x, n)) {
+      double r = s * (double) (k >> c); // exact since k >> c < 2^53
+      pow2 (&r, G + c);
+      set_flag (flag); // the accurate phases only use integer operations
+      return r;
+    }
+  }
+
+  qint64_t qX, qR;
+  qint_fromd (&qX, x); /* exact */
+  log_3 (&qR, &qX); /* relative error bounded by 2^-250.74 */
+  div_qint_u64 (&qR, &qR, N);
+  qR.sgn ^= n < 0;
+  /* qR = log(x)/n * (1+eps1) with |eps1| < 2^-250.74 + 2^-255 < 2^-250.65 */
+
+  qint64_t qZ;
+  exp_3 (&qZ, &qR); /* relative error < 2^-241.10 */
+
+  /* The relative error is bounded by exp(2^8.55*2^-250.65)*(1+2^-241.10)-1
+     < 2^-240.50, which corresponds to at most 2^-240.50*2^256 < 46400 ulps */
+
+#define ERR_BND_3 46 /* ceil(46400/2^10) */
+  uint64_t r1 = qZ.hh << 54 | qZ.hl >> 10;
+  uint64_t r2 = qZ.hl << 54 | qZ.lh >> 10;
+  uint64_t r3 = qZ.lh << 54 | qZ.ll >> 10;
+  // the rounding test fails for r1:r2:r3 in [-ERR_BND_3, ERR_BND_3] mod 2^192
+  rd = !((r1 == 0 && r2 == 0 && r3 <= ERR_BND_3) ||
+         (~r1 == 0 && ~r2 == 0 && r3 + ERR_BND_3 < ERR_BND_3));
+
+  if (rd)
+  {
+    qZ.sgn = s < 0;
+    qZ.ll = qZ.ll & (~0ull << 10);
+    return qint_tod (&qZ);
+  }
+
+  /* For |qR| < 2^-55, x^(1/n) rounds either to nextbelow(1), to 1 or to
+     nextabove(1), see cr_pow() */
+  if (qR.ex < -56) {
+    volatile double t = s; // prevents constant folding when s is known
+    return (qR.sgn == 0x0) ? t + t * 0x1p-100 : t - t * 0x1p-100;
+  }
+
+  printf ("Unexpected worst-case found.\n");
+  printf ("Please report to core-math@inria.fr:\n");
+  printf ("Worst-case of rootn found: x,n=%la,%lld\n", x, n);
+  exit (1);
+}
+
+double
+cr_rootn (double x, long long n)
+{
+  f64_u t = {.f = x};
+  uint64_t ax = t.u & 0x7fffffffffffffffull;
+  uint64_t N = (n < 0) ? -(uint64_t) n : (uint64_t) n;
+
+  // x = +/-0, +/-Inf or NaN, x < 0 with n even, or |n| <= 1
+  if (__builtin_expect (ax - 1 >= 0x7fefffffffffffffull
+                        || ((t.u >> 63) && !(N & 1)) || N <= 1, 0))
+    return rootn_special (x, n);
+
+  if (n == 2) // x > 0 here
+    return __builtin_sqrt (x);
+
+  double s = (t.u >> 63) ? -1.0 : 1.0; // sign of the result
+  t.u = ax;
+  x = t.f;
+
+  // |x| = 2^e: the result is exact when n divides e
+  if (__builtin_expect ((ax & 0xfffffffffffffull) == 0 || ax < 0x0010000000000000ull, 0)) {
+    int64_t e;
+    uint64_t m;
+    extract (&e, &m, x);
+    if (m == 1) {
+      if (e == 0)
+        return s;
+      if (N <= 1074 && e % (int64_t) N == 0) {
+        int64_t f = e / (int64_t) N;
+        f64_u r = {.u = (uint64_t) ((n < 0) ? 0x3ff - f : 0x3ff + f) << 52};
+        return s * r.f; // |f| <= 537
+      }
+    }
+  }
+
+  /* The result can be exact for 3 <= n <= 33 (see above): in that case we
+     make x depend on the inexact flag, so that the compiler does not move
+     the reading of the flag after the first floating-point operations below
+     (which might raise inexact). On x86_64 the empty asm statement does this
+     at no cost, elsewhere we use a volatile copy of x. */
+  FLAG_T flag = get_flag ();
+#ifdef __x86_64__
+  __asm__ ("" : "+x" (x) : "r" (flag));
+#else
+  if (n >= 3 && n <= 33) {
+    volatile double vx = x;
+    x = vx;
+  }
+#endif
+
+  // approximate log(x), with relative error less than elog
+  double lh, ll;
+  log_1 (&lh, &ll, x);
+  double elog = (x > 0x1.6a09e667f3bcdp-1 && x < 0x1.6a09e667f3bcdp+0)
+    ? 0x1.f0p-68  // 2^-67.0544 < 0x1.f0p-68
+    : 0x1.64p-74; // 2^-73.527 < 0x1.64p-74
+
+  /* Divide lh+ll by n: N = nh + nl exactly, with |nl| <= 2^10 (nl = 0 for
+     N <= 2^53). The division 1/nh does not depend on log_1(), rh approximates
+     lh/nh within a few ulps, the remainder lh - rh*nh is computed with an
+     error less than 2^-104*|lh|, and rl is its quotient by nh (plus the
+     contributions of ll and nl) with relative error about 2^-52: the
+     relative error on rh+rl is less than 2^-95. */
+  double nh = (double) N;
+  double nl = (double) (int64_t) (N - (uint64_t) nh);
+  double ih = 1.0 / nh;
+  double rh = lh * ih;
+  double rl = (__builtin_fma (-rh, nh, lh) - rh * nl + ll) * ih;
+  if (n < 0) {
+    rh = -rh;
+    rl = -rl;
+  }
+
+  /* For |log(x)/n| < 2^-55, we have 1-2^-54 < x^(1/n) < 1+2^-53, thus
+     x^(1/n) rounds to nextbelow(1), 1 or nextabove(1). Since the relative
+     error on rh is less than 2^-51, |rh| < 2^-56 implies
+     |log(x)/n| < 2^-55. This also ensures |rh| > 2^-117 below. */
+  if (__builtin_expect (__builtin_fabs (rh) < 0x1p-56, 0)) {
+    volatile double st = s; // prevents constant folding when s is known
+    return (rh > 0) ? st + st * 0x1p-100 : st - st * 0x1p-100;
+  }
+
+  double res_h, res_l;
+  exp_1 (&res_h, &res_l, rh, rl, s);
+
+  /* The relative error of exp_1() is less than 2^-63.786, and the error on
+     rh+rl is less than |rh|*(elog+2^-95) (up to a factor 1+2^-50), thus
+     the relative error on res_h+res_l is less than
+     (1+2^-63.786)*exp(|rh|*elog*1.01)-1 < 0x1.29p-64 + |rh|*elog*1.01
+     since |rh| < 373. */
+  double err = __builtin_fma (__builtin_fabs (rh), elog * 1.01, 0x1.29p-64);
+  double res_min = res_h + __builtin_fma (err, -res_h, res_l);
+  double res_max = res_h + __builtin_fma (err, res_h, res_l);
+
+  if (__builtin_expect (res_min == res_max, 1)) {
+    if (n >= 3 && n <= 33) {
+      int64_t et;
+      uint64_t mt;
+      extract (&et, &mt, res_max);
+      /* restore the inexact flag only now, so that the computation of
+         res_min and res_max cannot be scheduled after it */
+      if (is_root (mt, et, x, n))
+        set_flag (flag);
+    }
+    return res_max;
+  }
+
+  return rootn_accurate (x, n, s, flag);
+}
+
+#ifndef SKIP_C_FUNC_REDEF
+/* just to compile since glibc < 2.41 does not contain this function */
+double rootn (double x, long long n){
+  return pow (x, 1.0 / (double) n);
+}
+#endif
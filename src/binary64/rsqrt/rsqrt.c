@@ -152,6 +152,8 @@ double cr_rsqrt(double x){
   double r;
   if(__builtin_expect(ix.u < 1ll<<52, 0)){ // 0 <= x < 0x1p-1022
     if(__builtin_expect(ix.u, 1)){ // x <> +0
+      // subnormal x in DAZ mode: return 1/+0
+      if(__builtin_expect(x == 0, 0)) return 1.0 / 0.0;
       r = __builtin_sqrt(x)/x;
     } else {
 #ifdef CORE_MATH_SUPPORT_ERRNO
@@ -28,6 +28,21 @@ SOFTWARE.
 #include <inttypes.h>
 #include <fenv.h> // for fegetround, FE_TONEAREST, FE_DOWNWARD, FE_UPWARD
 #include <errno.h>
+#ifdef CORE_MATH_DEBUG
+#include <assert.h>
+#endif
+
+/* With -DCORE_MATH_TABLE_SECTION, the tables below are put in the section
+   core_math_tables_trig, aligned on cache lines, see
+   src/generic/support/warmup.h. */
+#ifndef CORE_MATH_TABLE
+#ifdef CORE_MATH_TABLE_SECTION
+#define CORE_MATH_TABLE(family) \
+  __attribute__((section ("core_math_tables_" #family), aligned (64)))
+#else
+#define CORE_MATH_TABLE(family)
+#endif
+#endif
 
 // Warning: clang also defines __GNUC__
 #if defined(__GNUC__) && !defined(__clang__)
@@ -420,7 +435,7 @@ typedef union {double f; uint64_t u;} b64u64_u;
 /* This table approximates 1/(2pi) downwards with precision 1280:
    1/(2*pi) ~ T[0]/2^64 + T[1]/2^128 + ... + T[i]/2^((i+1)*64) + ...
    Computed with computeT() from sin.sage. */
-static const uint64_t T[20] = {
+static const uint64_t T[20] CORE_MATH_TABLE (trig) = {
   0x28be60db9391054a, // i=0
    0x7f09d5f47d4d3770,
    0x36d8a5664f10e410,
@@ -447,7 +462,7 @@ static const uint64_t T[20] = {
    (to nearest).
    Each entry is to be interpreted as (hi/2^64+lo/2^128)*2^ex*(-1)*sgn.
    Generated with computeS() from sin.sage. */
-static const dint64_t S[256] = {
+static const dint64_t S[256] CORE_MATH_TABLE (trig) = {
   {.hi = 0x0, .lo = 0x0, .ex = 128, .sgn=0},
   {.hi = 0xc90fc5f66525d257, .lo = 0x480f7956b6470765, .ex = -8, .sgn=0},
   {.hi = 0xc90f87f3380388d5, .lo = 0xcb3ff35bd4d81baa, .ex = -7, .sgn=0},
@@ -710,7 +725,7 @@ static const dint64_t S[256] = {
    (to nearest).
    Each entry is to be interpreted as (hi/2^64+lo/2^128)*2^ex*(-1)*sgn.
    Generated with computeC() from sin.sage. */
-static const dint64_t C[256] = {
+static const dint64_t C[256] CORE_MATH_TABLE (trig) = {
   {.hi = 0x8000000000000000, .lo = 0x0, .ex = 1, .sgn=0},
   {.hi = 0xffffb10b10e80e95, .lo = 0x3031437d7eccb9df, .ex = 0, .sgn=0},
   {.hi = 0xfffec42c7454926b, .lo = 0x38e310779edfec68, .ex = 0, .sgn=0},
@@ -1019,7 +1034,7 @@ static const dint64_t PC[] = {
    For each i, 0 <= i < 256, xi=i/2^11+SC[i][0], with
    SC[i][1] and SC[i][2] approximating sin2pi(xi) and cos2pi(xi)
    respectively, both with 53+15 bits of accuracy. */
-static const double SC[256][3] = {
+static const double SC[256][3] CORE_MATH_TABLE (trig) = {
    {0x0p+0, 0x0p+0, 0x1p+0}, /* 0 */
    {-0x1.c0f6cp-35, 0x1.921f892b900fep-9, 0x1.ffff621623fap-1}, /* 1 */
    {-0x1.9c7935ep-35, 0x1.921f0ea27ce01p-8, 0x1.fffd8858eca2ep-1}, /* 2 */
@@ -2026,6 +2041,72 @@ sin_accurate (double x)
   return y;
 }
 
+#ifdef CORE_MATH_MEMO
+/* With -DCORE_MATH_MEMO, the results of sin_accurate() are stored in a
+   thread-local direct-mapped cache of 2^CORE_MATH_MEMO_BITS entries, indexed
+   by the bits of x, and tagged with x and the rounding mode (see exp.c). */
+#ifndef CORE_MATH_MEMO_BITS
+#define CORE_MATH_MEMO_BITS 8
+#endif
+typedef struct { uint64_t x; double r; int rnd; } memo_t; // rnd = 0: empty
+static __thread memo_t memo[1 << CORE_MATH_MEMO_BITS];
+static __thread uint64_t memo_hits, memo_misses;
+
+__attribute__((cold))
+static double
+sin_accurate_memo (double x)
+{
+  b64u64_u t = {.f = x};
+  int rnd = fegetround () + 1;
+  memo_t *m = memo + ((t.u * 0x9e3779b97f4a7c15ull)
+                      >> (64 - CORE_MATH_MEMO_BITS));
+  if (m->x == t.u && m->rnd == rnd)
+    {
+      memo_hits++;
+      return m->r;
+    }
+  memo_misses++;
+  double r = sin_accurate (x);
+  m->x = t.u;
+  m->r = r;
+  m->rnd = rnd;
+  return r;
+}
+
+/* Put in *hits and *misses the numbers of calls of the accurate path of
+   cr_sin() found and not found in the cache, for the calling thread. */
+void
+cr_sin_memo_stats (uint64_t *hits, uint64_t *misses)
+{
+  *hits = memo_hits;
+  *misses = memo_misses;
+}
+#else
+#define sin_accurate_memo sin_accurate
+#endif
+
+/* Same as cr_sin(), for 0x1.7137449123ef6p-26 < |x| < 2^1024, i.e., x is
+   finite and not tiny: the tests of the special cases of cr_sin() are
+   skipped. The contract is checked with -DCORE_MATH_DEBUG only, other
+   inputs give unspecified results. */
+double
+cr_sin_inrange (double x)
+{
+#ifdef CORE_MATH_DEBUG
+  assert (__builtin_fabs (x) > 0x1.7137449123ef6p-26
+          && __builtin_fabs (x) <= 0x1.fffffffffffffp+1023);
+#endif
+  double h, l, err;
+  err = sin_fast (&h, &l, x);
+  double left  = h + (l - err), right = h + (l + err);
+  /* With SC[] from ./buildSC 15 we get 1100 failures out of 50000000
+     random tests, i.e., about 0.002%. */
+  if (__builtin_expect (left == right, 1))
+    return left;
+
+  return sin_accurate_memo (x);
+}
+
 double
 cr_sin (double x)
 {
@@ -2063,8 +2144,9 @@ cr_sin (double x)
   uint64_t ux = t.u & 0x7fffffffffffffff;
   // 0x3e57137449123ef6 = 0x1.7137449123ef6p-26
   if (ux <= 0x3e57137449123ef6) {
+    // x == 0 also holds for subnormal x in DAZ mode
     if (x == 0)
-      return x;
+      return __builtin_copysign (0.0, x);
     // Taylor expansion of sin(x) is x - x^3/6 around zero
     // for x=-0, fma (x, -0x1p-54, x) returns +0
     /* We have underflow when 0 < |x| < 2^-1022 or when |x| = 2^-1022
@@ -2077,13 +2159,149 @@ cr_sin (double x)
     return res;
   }
 
+  return cr_sin_inrange (x);
+}
+
+/* Return h and put in l a double-double approximation h + l of sin(x),
+   from the fast path of cr_sin(). For |x| > 0x1.7137449123ef6p-26, the
+   absolute error is less than 0x1.84p-69 (the error of sin_fast() is at
+   most 0x1.81p-69 plus the reduction error err1 < 0x1.01p-76), otherwise
+   h + l = x - x^3/6 with relative error less than 2^-100. For x = NaN or
+   Inf, h is cr_sin(x) and l is 0. */
+double
+cr_sin_dd (double x, double *l)
+{
+  b64u64_u t = {.f = x};
+  int e = (t.u >> 52) & 0x7ff;
+
+  if (__builtin_expect (e == 0x7ff, 0)) /* NaN, +Inf and -Inf. */
+  {
+    *l = 0;
+    return cr_sin (x);
+  }
+
+  uint64_t ux = t.u & 0x7fffffffffffffff;
+  if (ux <= 0x3e57137449123ef6) {
+    /* |x^5/120| < 2^-104 |x| and the rounding error on l is less than
+       2^-52 |l| < 2^-54 |x|^3 */
+    *l = x * x * (x * -0x1.5555555555555p-3);
+    return x;
+  }
+
+  double h, lo;
+  sin_fast (&h, &lo, x);
+  fast_two_sum (&h, l, h, lo); // we might have |lo| > ulp(h)/2
+  return h;
+}
+
+/* Set *lo and *hi to the roundings downwards and upwards of y, where
+   |y - (h+l)| < err and |l| < ulp(h), and return 1, or return 0 if y might
+   be too close to a binary64 number (same as as_interval() in
+   ../exp/exp.c, where the error analysis is given). */
+static inline int
+as_interval (double h, double l, double err, double *lo, double *hi)
+{
+  double v = h + l, d = l - (v - h);
+  b64u64_u t = {.f = v};
+  if (__builtin_expect (!(t.u << 1) || (t.u << 1) >= 0x7ffull << 53, 0))
+    return 0;
+  b64u64_u up = {.u = t.u + 1}, dn = {.u = t.u - 1};
+  double a = __builtin_fabs (up.f - v), b = __builtin_fabs (v - dn.f);
+  double m = err + a * 0x1p-50, sd = (t.u >> 63) ? -d : d;
+  if (sd > m && sd + m < a) // |v| < |y| < |v+|
+  {
+    *lo = (t.u >> 63) ? up.f : v;
+    *hi = (t.u >> 63) ? v : up.f;
+  }
+  else if (sd < -m && sd - m > -b) // |v-| < |y| < |v|
+  {
+    *lo = (t.u >> 63) ? v : dn.f;
+    *hi = (t.u >> 63) ? dn.f : v;
+  }
+  else
+    return 0;
+  return 1;
+}
+
+/* Slow path of cr_sin_interval(): call cr_sin() with both directed
+   rounding modes. */
+static void __attribute__((noinline))
+sin_interval_slow (double x, double *lo, double *hi)
+{
+  volatile double vx = x; // see as_exp_interval_slow() in ../exp/exp.c
+  int rm = fegetround ();
+  fesetround (FE_DOWNWARD);
+  *lo = cr_sin (vx);
+  fesetround (FE_UPWARD);
+  *hi = cr_sin (vx);
+  fesetround (rm);
+}
+
+/* Set *lo and *hi to sin(x) rounded downwards and upwards, with one
+   evaluation of sin_fast(). The rounding mode is only changed when the
+   slow path is used (for about 0.002% of random inputs, and for NaN
+   or Inf). Inexact is raised when lo <> hi, underflow is unspecified (see
+   README.md). */
+void
+cr_sin_interval (double x, double *lo, double *hi)
+{
+  b64u64_u t = {.f = x};
+  int e = (t.u >> 52) & 0x7ff;
+
+  if (__builtin_expect (e == 0x7ff, 0)) /* NaN, +Inf and -Inf. */
+    return sin_interval_slow (x, lo, hi);
+
+  uint64_t ux = t.u & 0x7fffffffffffffff;
+  if (ux <= 0x3e57137449123ef6) {
+    /* As shown in cr_sin(), for 0 < x <= 0x1.7137449123ef6p-26 we have
+       x - ulp(x)/2 < x - x^3/6 < sin(x) < x, where x - ulp(x)/2 is at most
+       the predecessor of x, and symmetrically for x < 0. */
+    if (ux)
+      feraiseexcept (FE_INEXACT);
+    b64u64_u p = {.u = t.u - (ux != 0)}; // next number towards zero
+    *lo = (t.u >> 63) ? x : p.f;
+    *hi = (t.u >> 63) ? p.f : x;
+    return;
+  }
+
   double h, l, err;
   err = sin_fast (&h, &l, x);
-  double left  = h + (l - err), right = h + (l + err);
-  /* With SC[] from ./buildSC 15 we get 1100 failures out of 50000000
-     random tests, i.e., about 0.002%. */
-  if (__builtin_expect (left == right, 1))
-    return left;
+  if (__builtin_expect (!as_interval (h, l, err, lo, hi), 0))
+    sin_interval_slow (x, lo, hi);
+}
 
-  return sin_accurate (x);
+/* Return cr_sin(x) evaluated in the rounding mode rnd, which raises the
+   same exceptions (and sets errno) as cr_sin() in that mode. */
+static double __attribute__((noinline))
+sin_r_slow (double x, int rnd)
+{
+  volatile double vx = x; // see as_exp_interval_slow() in ../exp/exp.c
+  int rm = fegetround ();
+  fesetround (rnd);
+  volatile double r = cr_sin (vx);
+  fesetround (rm);
+  return r;
+}
+
+/* Return sin(x) rounded according to rnd, assuming the current rounding
+   mode is to nearest (see cr_exp_r() in ../exp/exp.c). For NaN, Inf and
+   |x| < 2^-1021, where sin(x) might underflow, cr_sin() is called in the
+   rounding mode rnd, so that the exceptions are those of cr_sin() in that
+   mode. */
+double
+cr_sin_r (double x, int rnd)
+{
+  if (rnd != FE_DOWNWARD && rnd != FE_UPWARD && rnd != FE_TOWARDZERO)
+    return cr_sin (x); // FE_TONEAREST
+  b64u64_u t = {.f = x};
+  int e = (t.u >> 52) & 0x7ff;
+  if (__builtin_expect (e == 0x7ff || e < 2, 0)) // NaN, Inf or |x| < 2^-1021
+    return sin_r_slow (x, rnd);
+  double lo, hi;
+  cr_sin_interval (x, &lo, &hi);
+  if (rnd == FE_DOWNWARD)
+    return lo;
+  if (rnd == FE_UPWARD)
+    return hi;
+  return __builtin_signbit (lo) ? hi : lo; // FE_TOWARDZERO
 }
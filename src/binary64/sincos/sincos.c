@@ -1997,7 +1997,9 @@ sin_accurate (double x)
   /* check the upper 54 bits are equal */
   if ((hi0 >> 10) != (hi1 >> 10))
     {
-      static const double exceptions[][3] = {
+      /* exceptions is volatile, otherwise once the loop below is unrolled,
+         the compiler might evaluate the sums at compile time (to nearest) */
+      static const volatile double exceptions[][3] = {
         {0x1.e0000000001c2p-20, 0x1.dfffffffff02ep-20, 0x1.dcba692492527p-146},
         /* the following worst case was reported by Erik E., it has 68
            identical bits after the round bit */
@@ -2160,7 +2162,9 @@ cos_accurate (double x)
   /* check the upper 54 bits are equal */
   if ((hi0 >> 10) != (hi1 >> 10))
     {
-      static const double exceptions[][3] = {
+      /* exceptions is volatile, otherwise once the loop below is unrolled,
+         the compiler might evaluate the sums at compile time (to nearest) */
+      static const volatile double exceptions[][3] = {
         {0x1.8000000000009p-23, 0x1.fffffffffff7p-1, 0x1.b56666666666cp-143},
         {0x1.8000000000024p-22, 0x1.ffffffffffdcp-1, 0x1.b56666666667ep-137},
         {0x1.800000000009p-21,  0x1.ffffffffff7p-1,  0x1.b5666666666c4p-131},
@@ -2214,7 +2218,8 @@ cr_sincos (double x, double *s, double *c)
     // Taylor expansion of sin(x) is x - x^3/6 around zero
     // for x=-0, fma (x, -0x1p-54, x) returns +0
     *s = (x == 0) ? x : __builtin_fma (x, -0x1p-54, x);
-    *c = (x == 0) ? 1.0 : 1.0 - 0x1p-54;
+    volatile double one = 1.0; // prevents constant folding
+    *c = (x == 0) ? 1.0 : one - 0x1p-54;
 
 #ifdef CORE_MATH_SUPPORT_ERRNO
     if (x != 0 && (__builtin_fabs (x) < 0x1p-1022 || __builtin_fabs (*s) < 0x1p-1022))
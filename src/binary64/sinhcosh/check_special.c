@@ -0,0 +1,316 @@
+/* Check sinhcosh on special and random inputs.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fenv.h>
+#include <math.h>
+#include <errno.h>
+#include <mpfr.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+
+#include "../../generic/support/philox.h"
+
+int ref_init (void);
+int ref_fesetround (int);
+
+void cr_sinhcosh (double, double*, double*);
+void ref_sinhcosh (double, double*, double*);
+
+int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
+
+int rnd = 0;
+int verbose = 0;
+
+static uint64_t Seed;
+
+typedef union {double f; uint64_t u;} b64u64_u;
+
+static inline uint64_t
+asuint64 (double f)
+{
+  b64u64_u u = {.f = f};
+  return u.u;
+}
+
+static inline double
+asfloat64 (uint64_t i)
+{
+  b64u64_u u = {.u = i};
+  return u.f;
+}
+
+/* define our own is_nan function to avoid depending from math.h */
+static inline int
+is_nan (double x)
+{
+  uint64_t u = asuint64 (x);
+  uint64_t e = u >> 52;
+  return (e == 0x7ff || e == 0xfff) && (u << 12) != 0;
+}
+
+// When x is a NaN, returns 1 if x is an sNaN and 0 if it is a qNaN
+static inline int
+is_signaling (double x)
+{
+  return !(asuint64 (x) & (1ull << 51));
+}
+
+static inline int
+is_equal (double x, double y)
+{
+  if (is_nan (x))
+    return is_nan (y);
+  if (is_nan (y))
+    return is_nan (x);
+  return asuint64 (x) == asuint64 (y);
+}
+
+/* Random x: for half of the values, |x| is in [2^-63, 2^10), which covers
+   both polynomial approximations and the overflow threshold |x| ~ 710.47,
+   otherwise x has random bits (mostly tiny or huge values, Inf and NaN). */
+static double
+get_random (philox_t *s)
+{
+  uint64_t u = philox_u64 (s);
+  if (u & 1)
+    u = (u & 0x800fffffffffffffull) | ((0x3c0 + ((u >> 52) & 0x7ff) % 74) << 52);
+  return asfloat64 (u);
+}
+
+static void
+fail (void)
+{
+  fflush (stdout);
+#ifndef DO_NOT_ABORT
+  exit (1);
+#endif
+}
+
+/* Check the values of sinh(x) and cosh(x), the overflow, underflow and
+   inexact exceptions, and errno, against MPFR. */
+static void
+check (double x)
+{
+  double s1, c1, s2, c2;
+  ref_init ();
+  ref_fesetround (rnd);
+  mpfr_flags_clear (MPFR_FLAGS_INEXACT | MPFR_FLAGS_OVERFLOW);
+  ref_sinhcosh (x, &s1, &c1);
+  int overflow1 = mpfr_flags_test (MPFR_FLAGS_OVERFLOW) != 0;
+#ifdef CORE_MATH_CHECK_INEXACT
+  int inex1 = mpfr_flags_test (MPFR_FLAGS_INEXACT) != 0;
+#endif
+  /* sinh(x) underflows exactly when 0 < |x| < 2^-1022 (see sinhcosh.c),
+     for any rounding mode and underflow before or after rounding,
+     and cosh(x) never underflows (this comparison raises invalid for NaN,
+     thus it is done before clearing the exceptions) */
+  int underflow1 = x != 0 && fabs (x) < 0x1p-1022;
+  fesetround (rnd1[rnd]);
+  feclearexcept (FE_INEXACT | FE_UNDERFLOW | FE_OVERFLOW | FE_INVALID);
+  errno = 0;
+  cr_sinhcosh (x, &s2, &c2);
+  int err = errno;
+  if (!is_equal (s1, s2))
+  {
+    printf ("FAIL x=%la sinh: ref=%la z=%la\n", x, s1, s2);
+    fail ();
+  }
+  if (!is_equal (c1, c2))
+  {
+    printf ("FAIL x=%la cosh: ref=%la z=%la\n", x, c1, c2);
+    fail ();
+  }
+
+  if (!fetestexcept (FE_OVERFLOW) != !overflow1)
+  {
+    printf ("%s overflow exception for x=%la (s=%la c=%la)\n",
+            overflow1 ? "Missing" : "Spurious", x, s1, c1);
+    fail ();
+  }
+
+  if (!fetestexcept (FE_UNDERFLOW) != !underflow1)
+  {
+    printf ("%s underflow exception for x=%la (s=%la c=%la)\n",
+            underflow1 ? "Missing" : "Spurious", x, s1, c1);
+    fail ();
+  }
+
+  // the invalid exception is only raised for sNaN
+  int invalid1 = is_nan (x) && is_signaling (x);
+  if (!fetestexcept (FE_INVALID) != !invalid1)
+  {
+    printf ("%s invalid exception for x=%la\n",
+            invalid1 ? "Missing" : "Spurious", x);
+    fail ();
+  }
+
+#ifdef CORE_MATH_CHECK_INEXACT
+  if (!fetestexcept (FE_INEXACT) != !inex1)
+  {
+    printf ("%s inexact exception for x=%la (s=%la c=%la)\n",
+            inex1 ? "Missing" : "Spurious", x, s1, c1);
+    fail ();
+  }
+#endif
+
+#ifdef CORE_MATH_SUPPORT_ERRNO
+  // errno = ERANGE for overflow or underflow, and there is no domain error
+  if ((overflow1 || underflow1) && err != ERANGE)
+  {
+    printf ("Missing errno=ERANGE for x=%la (s=%la c=%la)\n", x, s1, c1);
+    fail ();
+  }
+  if (!(overflow1 || underflow1) && err != 0)
+  {
+    printf ("Spurious errno=%d for x=%la (s=%la c=%la)\n", err, x, s1, c1);
+    fail ();
+  }
+#else
+  (void) err;
+#endif
+}
+
+static void
+check_special (void)
+{
+  double inf = asfloat64 (0x7ff0000000000000ull);
+  double sNan = asfloat64 (0x7ff0000000000001ull);
+  double qNan = asfloat64 (0x7ff8000000000000ull);
+  double s, c;
+
+  /* sinh(+/-Inf) = +/-Inf and cosh(+/-Inf) = +Inf, without any exception
+     (check() verifies the exceptions) */
+  for (int i = 0; i < 2; i++)
+  {
+    double x = i ? -inf : inf;
+    cr_sinhcosh (x, &s, &c);
+    if (asuint64 (s) != asuint64 (x) || asuint64 (c) != asuint64 (inf))
+    {
+      printf ("Error, sinhcosh(%la) should be (%la,%la), got (%la,%la)\n",
+              x, x, inf, s, c);
+      fail ();
+    }
+  }
+
+  // sinh(NaN) and cosh(NaN) are qNaN
+  double T[] = { qNan, -qNan, sNan, -sNan };
+  for (unsigned i = 0; i < sizeof (T) / sizeof (T[0]); i++)
+  {
+    cr_sinhcosh (T[i], &s, &c);
+    if (!is_nan (s) || is_signaling (s) || !is_nan (c) || is_signaling (c))
+    {
+      printf ("Error, sinhcosh(%la) should be (qNaN,qNaN), got (%la,%la)\n",
+              T[i], s, c);
+      fail ();
+    }
+  }
+
+  double U[] = {
+    0, 0x1p-1074, 0x1.ffffffffffffep-1023, 0x1.fffffffffffffp-1023, 0x1p-1022,
+    0x1.0000000000001p-1022, 0x1.7137449123ef6p-26, 0x1.7137449123ef7p-26,
+    0x1p-3, 0x1p-2,
+    // sinh(x) and cosh(x) overflow for |x| > 0x1.633ce8fb9f87dp+9
+    0x1.633ce8fb9f87cp+9, 0x1.633ce8fb9f87dp+9, 0x1.633ce8fb9f87ep+9,
+    0x1.633ce8fb9f87fp+9, 0x1p+10, 0x1.fffffffffffffp+1023,
+    inf, qNan, sNan };
+  for (unsigned i = 0; i < sizeof (U) / sizeof (U[0]); i++)
+  {
+    check (U[i]);
+    check (-U[i]);
+  }
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--rndn") == 0)
+        {
+          rnd = 0;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndz") == 0)
+        {
+          rnd = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndu") == 0)
+        {
+          rnd = 2;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndd") == 0)
+        {
+          rnd = 3;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--verbose") == 0)
+        {
+          verbose = 1;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+  ref_init ();
+  ref_fesetround (rnd);
+
+  printf ("Checking special values\n");
+  check_special ();
+
+#ifndef CORE_MATH_TESTS
+#define CORE_MATH_TESTS 1000000000UL /* total number of tests */
+#endif
+
+  printf ("Checking random values\n");
+  Seed = philox_seed ();
+
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t n = 0; n < CORE_MATH_TESTS; n++)
+  {
+    philox_t s;
+    philox_init (&s, Seed, n);
+    check (get_random (&s));
+  }
+
+  return 0;
+}
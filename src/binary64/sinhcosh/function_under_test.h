@@ -0,0 +1,7 @@
+#define cr_function_under_test cr_sinhcosh
+#define ref_function_under_test ref_sinhcosh
+#define mpfr_function_under_test mpfr_sinh_cosh
+
+/* WORST_SYMMETRIC means that if x is a worst-case of f(x),
+   then -x is a worst case too */
+#define WORST_SYMMETRIC
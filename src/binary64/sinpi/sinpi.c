@@ -184,6 +184,8 @@ double cr_sinpi(double x){
     double zh, zl;
     if(__builtin_expect(__builtin_fabs(x)<0x1p-54, 0)){
       if(__builtin_expect(__builtin_fabs(x)<0x1p-970, 0)){
+	// subnormal x in DAZ mode
+	if(__builtin_expect(x == 0, 0)) return __builtin_copysign(0.0, x);
 #ifdef CORE_MATH_SUPPORT_ERRNO
           /* For all rounding modes, we have underflow (before or after
              rounding) for |x| <= 0x1.45f306dc9c882p-1024. */
@@ -42,6 +42,8 @@ SOFTWARE.
 #include <errno.h>
 
 #include "function_under_test.h"
+#include "../../generic/support/wc_bin.h"
+#include "../../generic/support/fenv_ftz.h"
 
 double cr_function_under_test (double, double);
 double ref_function_under_test (double, double);
@@ -96,9 +98,26 @@ sscanf_snan (char *buf, double *x)
   return 0;
 }
 
+/* worst cases mapped from a binary .wcb file, if any */
+static wc_bin_t wc_bin;
+
+/* if non-NULL, only check the given shard "k/n" of the worst cases */
+static const char *shard = NULL;
+
+/* if non-zero, check in FTZ/DAZ mode (option --ftz) */
+static int ftz = 0;
+
 static void
 readstdin(testcase **result, int *count)
 {
+  // binary worst-case files are used in place, without any parsing
+  if (wc_bin_map (0, sizeof (double), 2, &wc_bin))
+  {
+    *result = (testcase *) wc_bin.data;
+    *count = wc_bin.count;
+    return;
+  }
+
   char *buf = NULL;
   size_t buflength = 0;
   ssize_t n;
@@ -248,6 +267,69 @@ fix_underflow (double x, double y, double z)
   mpfr_clear (u);
 }
 
+/* return y, or zero with the sign of y if y is subnormal */
+static double
+flush (double y)
+{
+  return (__builtin_fabs (y) < 0x1p-1022) ? __builtin_copysign (0.0, y) : y;
+}
+
+/* return non-zero if z is a possible value of the function in FTZ/DAZ mode
+   when the reference value is y, see fenv_ftz.h */
+static int
+is_equal_ftz (double y, double z)
+{
+  return is_equal (y, z) || is_equal (flush (y), z)
+    || (__builtin_fabs (y) == 0x1p-1022
+        && is_equal (__builtin_copysign (0.0, y), z));
+}
+
+/* Check ts in FTZ/DAZ mode, where only the value is checked: a subnormal
+   input might be seen as zero, thus we accept the reference values of
+   (x,y), (0,y), (x,0) and (0,0) with the zeros signed like x and y. */
+static void
+check_ftz (testcase ts)
+{
+  ref_init();
+  ref_fesetround(rnd);
+  double z1 = ref_function_under_test(ts.x, ts.y);
+  fesetround(rnd1[rnd]);
+  ftz_set (1);
+  double z2 = cr_function_under_test(ts.x, ts.y);
+  ftz_set (0);
+  int ok = is_equal_ftz (z1, z2);
+  for (int i = 1; i < 4 && !ok; i++)
+  {
+    double x = (i & 1) ? flush (ts.x) : ts.x;
+    double y = (i & 2) ? flush (ts.y) : ts.y;
+    if (x != ts.x || y != ts.y)
+      ok = is_equal_ftz (ref_function_under_test(x, y), z2);
+  }
+  if (!ok) {
+#ifndef EXCHANGE_X_Y
+    printf("FAIL x,y=");
+#else
+    printf("FAIL y,x=");
+#endif
+    print_binary64 (ts.x);
+    printf (",");
+    print_binary64 (ts.y);
+    printf (" ref=");
+    print_binary64 (flush (z1));
+    printf (" z=");
+    print_binary64 (z2);
+    printf (" (ftz)\n");
+    fflush(stdout);
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp atomic update
+#endif
+    failures ++;
+#ifndef DO_NOT_ABORT
+    exit(1);
+#endif
+  }
+}
+
 static void
 check (testcase ts)
 {
@@ -255,6 +337,11 @@ check (testcase ts)
 #pragma omp atomic update
 #endif
   tests ++;
+  if (ftz)
+  {
+    check_ftz (ts);
+    return;
+  }
   ref_init();
   ref_fesetround(rnd);
   mpfr_flags_clear (MPFR_FLAGS_INEXACT | MPFR_FLAGS_UNDERFLOW | MPFR_FLAGS_OVERFLOW);
@@ -495,10 +582,19 @@ doloop(void)
 
   readstdin(&items, &count);
 
+  int begin = 0, end = count;
+  if (shard != NULL)
+  {
+    uint64_t b, e;
+    wc_bin_shard (shard, count, &b, &e);
+    begin = b;
+    end = e;
+  }
+
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
 #pragma omp parallel for
 #endif
-  for (int i = 0; i < count; i++) {
+  for (int i = begin; i < end; i++) {
     testcase ts = items[i];
     double x = ts.x, y = ts.y;
 
@@ -544,7 +640,10 @@ doloop(void)
 #endif
   }
 
-  free(items);
+  if (wc_bin.map != NULL)
+    wc_bin_unmap (&wc_bin);
+  else
+    free(items);
   printf("%d tests passed, %d failure(s)\n", tests, failures);
 }
 
@@ -769,6 +868,23 @@ main (int argc, char *argv[])
           argc --;
           argv ++;
         }
+      else if (strcmp (argv[1], "--ftz") == 0)
+        {
+          if (!ftz_supported ())
+            {
+              fprintf (stderr, "Error, --ftz is not supported on this processor\n");
+              exit (1);
+            }
+          ftz = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--shard") == 0 && argc >= 3)
+        {
+          shard = argv[2];
+          argc -= 2;
+          argv += 2;
+        }
       else
         {
           fprintf (stderr, "Error, unknown option %s\n", argv[1]);
@@ -43,6 +43,8 @@ SOFTWARE.
 #include <errno.h>
 
 #include "function_under_test.h"
+#include "../../generic/support/wc_bin.h"
+#include "../../generic/support/fenv_ftz.h"
 
 double cr_function_under_test (double);
 double ref_function_under_test (double);
@@ -56,9 +58,26 @@ int rnd = 0;
 
 typedef union { double f; uint64_t i; } d64u64;
 
+/* worst cases mapped from a binary .wcb file, if any */
+static wc_bin_t wc_bin;
+
+/* if non-NULL, only check the given shard "k/n" of the worst cases */
+static const char *shard = NULL;
+
+/* if non-zero, check in FTZ/DAZ mode (option --ftz) */
+static int ftz = 0;
+
 static void
 readstdin(double **result, int *count)
 {
+  // binary worst-case files are used in place, without any parsing
+  if (wc_bin_map (0, sizeof (double), 1, &wc_bin))
+  {
+    *result = (double *) wc_bin.data;
+    *count = wc_bin.count;
+    return;
+  }
+
   char *buf = NULL;
   size_t buflength = 0;
   ssize_t n;
@@ -202,10 +221,58 @@ fix_underflow (double x, double y)
   mpfr_clear (t);
 }
 
+/* return y, or zero with the sign of y if y is subnormal */
+static double
+flush (double y)
+{
+  return (__builtin_fabs (y) < 0x1p-1022) ? __builtin_copysign (0.0, y) : y;
+}
+
+/* return non-zero if z is a possible value of the function in FTZ/DAZ mode
+   when the reference value is y, see fenv_ftz.h */
+static int
+is_equal_ftz (double y, double z)
+{
+  return is_equal (y, z) || is_equal (flush (y), z)
+    || (__builtin_fabs (y) == 0x1p-1022
+        && is_equal (__builtin_copysign (0.0, y), z));
+}
+
+/* Check x in FTZ/DAZ mode, where only the value is checked.
+   Return 1 if failure, 0 otherwise. */
+static int
+check_ftz (double x)
+{
+  ref_init();
+  ref_fesetround(rnd);
+  double z1 = ref_function_under_test(x);
+  // for a subnormal x, the reference value for x seen as zero under DAZ
+  double z0 = z1;
+  if (flush (x) != x)
+    z0 = ref_function_under_test(flush (x));
+  fesetround(rnd1[rnd]);
+  ftz_set (1);
+  double z2 = cr_function_under_test(x);
+  ftz_set (0);
+  if (!is_equal_ftz (z1, z2) && !is_equal_ftz (z0, z2)) {
+    printf("FAIL x=%la ref=%la z=%la (ftz)\n", x, flush (z1), z2);
+    fflush(stdout);
+#ifdef DO_NOT_ABORT
+    return 1;
+#else
+    exit(1);
+#endif
+  }
+  return 0;
+}
+
 // return 1 if failure, 0 otherwise
 static int
 check (double x)
 {
+  if (ftz)
+    return check_ftz (x);
+
   ref_init();
   ref_fesetround(rnd);
   mpfr_flags_clear (MPFR_FLAGS_INEXACT | MPFR_FLAGS_UNDERFLOW | MPFR_FLAGS_OVERFLOW);
@@ -429,10 +496,19 @@ doloop(void)
 
   readstdin(&items, &count);
 
+  int begin = 0, end = count;
+  if (shard != NULL)
+  {
+    uint64_t b, e;
+    wc_bin_shard (shard, count, &b, &e);
+    begin = b;
+    end = e;
+  }
+
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
 #pragma omp parallel for reduction(+: failures,tests)
 #endif
-  for (int i = 0; i < count; i++) {
+  for (int i = begin; i < end; i++) {
     double x = items[i];
     tests ++;
     if (check (x))
@@ -445,7 +521,10 @@ doloop(void)
 #endif
   }
 
-  free(items);
+  if (wc_bin.map != NULL)
+    wc_bin_unmap (&wc_bin);
+  else
+    free(items);
   printf("%d tests passed, %d failure(s)\n", tests, failures);
 }
 
@@ -598,6 +677,23 @@ main (int argc, char *argv[])
           argc --;
           argv ++;
         }
+      else if (strcmp (argv[1], "--ftz") == 0)
+        {
+          if (!ftz_supported ())
+            {
+              fprintf (stderr, "Error, --ftz is not supported on this processor\n");
+              exit (1);
+            }
+          ftz = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--shard") == 0 && argc >= 3)
+        {
+          shard = argv[2];
+          argc -= 2;
+          argv += 2;
+        }
       else
         {
           fprintf (stderr, "Error, unknown option %s\n", argv[1]);
@@ -0,0 +1,151 @@
+/* Benchmark of the binary64 _inrange entry points.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Usage: ./perf_inrange [--count n] [--repeat m] [--latency]
+
+   For exp, log, sin and cos, this program times a tight loop calling
+   cr_f, then cr_f_inrange, on the same inputs, which satisfy the contract
+   of cr_f_inrange (finite inputs whose result is in the normal range, see
+   ../exp/exp.c, ../log/log.c, ../sin/sin.c, ../cos/cos.c). The difference
+   is the cost of the tests of the special cases in cr_f. With --latency,
+   each input depends on the previous result.
+   Timings are in cycles (rdtsc) per call on x86_64, in nanoseconds
+   per call otherwise. */
+
+#define _XOPEN_SOURCE 600 /* for drand48 and clock_gettime */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#ifdef __x86_64__
+#include <x86intrin.h>
+#endif
+
+typedef double function_type (double);
+
+function_type cr_exp, cr_exp_inrange, cr_log, cr_log_inrange;
+function_type cr_sin, cr_sin_inrange, cr_cos, cr_cos_inrange;
+
+#define NFUN 4
+
+/* inputs are in [lo,hi], with a uniform distribution */
+static const struct {
+  const char *name;
+  function_type *f, *f_inrange;
+  double lo, hi;
+} fun[NFUN] = {
+  {"exp", cr_exp, cr_exp_inrange, -700.0, 700.0},
+  {"log", cr_log, cr_log_inrange, 0x1p-10, 0x1p10},
+  {"sin", cr_sin, cr_sin_inrange, -8.0, 8.0},
+  {"cos", cr_cos, cr_cos_inrange, -8.0, 8.0},
+};
+
+static uint64_t
+ticks (void)
+{
+#ifdef __x86_64__
+  return __rdtsc ();
+#else
+  struct timespec t;
+  clock_gettime (CLOCK_MONOTONIC, &t);
+  return (uint64_t) t.tv_sec * 1000000000 + t.tv_nsec;
+#endif
+}
+
+static double *randoms;
+static int count = 1000000, repeat = 100, latency = 0;
+
+/* return the number of ticks per call of f on randoms[] */
+static double
+time_function (function_type *f)
+{
+  volatile double sink;
+  double accu = 0;
+  uint64_t start = ticks ();
+  for (int r = 0; r < repeat; r++)
+    if (latency)
+      for (int i = 0; i < count; i++)
+        accu = f (randoms[i] + 0 * accu);
+    else
+      for (int i = 0; i < count; i++)
+        accu += f (randoms[i]);
+  uint64_t stop = ticks ();
+  sink = accu;
+  (void) sink;
+  return (double) (stop - start) / ((double) count * repeat);
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--count") == 0 && argc >= 3)
+        {
+          count = atoi (argv[2]);
+          argc -= 2;
+          argv += 2;
+        }
+      else if (strcmp (argv[1], "--repeat") == 0 && argc >= 3)
+        {
+          repeat = atoi (argv[2]);
+          argc -= 2;
+          argv += 2;
+        }
+      else if (strcmp (argv[1], "--latency") == 0)
+        {
+          latency = 1;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  randoms = malloc ((size_t) count * sizeof (double));
+  if (randoms == NULL)
+    {
+      fprintf (stderr, "malloc failed\n");
+      exit (1);
+    }
+  printf ("%-8s %10s %10s\n", "", "cr_f", "_inrange");
+  srand48 (1);
+  for (int j = 0; j < NFUN; j++)
+    {
+      for (int i = 0; i < count; i++)
+        randoms[i] = fun[j].lo + (fun[j].hi - fun[j].lo) * drand48 ();
+      double t = time_function (fun[j].f);
+      double t_inrange = time_function (fun[j].f_inrange);
+      printf ("%-8s %10.3f %10.3f\n", fun[j].name, t, t_inrange);
+    }
+  free (randoms);
+  return 0;
+}
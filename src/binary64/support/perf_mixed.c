@@ -0,0 +1,209 @@
+/* Mixed-workload benchmark of the binary64 exponential and logarithm families.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Usage: ./perf_exp_mixed [--count n] [--repeat m] [--latency]
+          ./perf_log_mixed [--count n] [--repeat m] [--latency]
+
+   This program is built by the Makefile in this directory for the
+   exponential family (exp, exp2, exp10, expm1, sinh, cosh, tanh) and, with
+   -DLOG_FAMILY, for the logarithm family (log, log10, log1p, log2p1,
+   log10p1), each time with the static tables of each function
+   (perf_exp_mixed, perf_log_mixed) and with -DCORE_MATH_SHARED_EXP_TABLES
+   or -DCORE_MATH_SHARED_LOG_TABLES (perf_exp_mixed_shared,
+   perf_log_mixed_shared, see exp_tables.c and log_tables.c).
+   It first times each function alone, then a mixed workload where all
+   functions of the family are called in turn, as in an application using
+   several of them in the same loop.
+   Timings are in cycles (rdtsc) per call on x86_64, in nanoseconds
+   per call otherwise. */
+
+#define _XOPEN_SOURCE 600 /* for drand48 and clock_gettime */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#ifdef __x86_64__
+#include <x86intrin.h>
+#endif
+
+typedef double function_type (double);
+
+#ifdef LOG_FAMILY
+function_type cr_log, cr_log10, cr_log1p, cr_log2p1, cr_log10p1;
+
+#define NFUN 5
+
+/* inputs are in [lo,hi], with a logarithmic distribution */
+static const struct {
+  const char *name;
+  function_type *f;
+  double lo, hi;
+} fun[NFUN] = {
+  {"log", cr_log, 0x1p-100, 0x1p100},
+  {"log10", cr_log10, 0x1p-100, 0x1p100},
+  {"log1p", cr_log1p, 0x1p-30, 0x1p30},
+  {"log2p1", cr_log2p1, 0x1p-30, 0x1p30},
+  {"log10p1", cr_log10p1, 0x1p-30, 0x1p30},
+};
+#else
+function_type cr_exp, cr_exp2, cr_exp10, cr_expm1, cr_sinh, cr_cosh, cr_tanh;
+
+#define NFUN 7
+
+/* inputs are in [lo,hi], with a uniform distribution */
+static const struct {
+  const char *name;
+  function_type *f;
+  double lo, hi;
+} fun[NFUN] = {
+  {"exp", cr_exp, -700.0, 700.0},
+  {"exp2", cr_exp2, -1000.0, 1000.0},
+  {"exp10", cr_exp10, -300.0, 300.0},
+  {"expm1", cr_expm1, -700.0, 700.0},
+  {"sinh", cr_sinh, -700.0, 700.0},
+  {"cosh", cr_cosh, -700.0, 700.0},
+  {"tanh", cr_tanh, -20.0, 20.0},
+};
+#endif
+
+static uint64_t
+ticks (void)
+{
+#ifdef __x86_64__
+  return __rdtsc ();
+#else
+  struct timespec t;
+  clock_gettime (CLOCK_MONOTONIC, &t);
+  return (uint64_t) t.tv_sec * 1000000000 + t.tv_nsec;
+#endif
+}
+
+/* inputs for function j are in randoms[j*count..(j+1)*count-1] */
+static double *randoms;
+static int count = 1000000, repeat = 100, latency = 0;
+
+/* return the number of ticks per call of function j alone */
+static double
+time_alone (int j)
+{
+  const double *x = randoms + (size_t) j * count;
+  function_type *f = fun[j].f;
+  volatile double sink;
+  double accu = 0;
+  uint64_t start = ticks ();
+  for (int r = 0; r < repeat; r++)
+    if (latency)
+      for (int i = 0; i < count; i++)
+        accu = f (x[i] + 0 * accu);
+    else
+      for (int i = 0; i < count; i++)
+        accu += f (x[i]);
+  uint64_t stop = ticks ();
+  sink = accu;
+  (void) sink;
+  return (double) (stop - start) / ((double) count * repeat);
+}
+
+/* return the number of ticks per call when all functions are called
+   in turn on their own inputs */
+static double
+time_mixed (void)
+{
+  volatile double sink;
+  double accu = 0;
+  uint64_t start = ticks ();
+  for (int r = 0; r < repeat; r++)
+    if (latency)
+      for (int i = 0; i < count; i++)
+        for (int j = 0; j < NFUN; j++)
+          accu = fun[j].f (randoms[(size_t) j * count + i] + 0 * accu);
+    else
+      for (int i = 0; i < count; i++)
+        for (int j = 0; j < NFUN; j++)
+          accu += fun[j].f (randoms[(size_t) j * count + i]);
+  uint64_t stop = ticks ();
+  sink = accu;
+  (void) sink;
+  return (double) (stop - start) / ((double) count * repeat * NFUN);
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--count") == 0 && argc >= 3)
+        {
+          count = atoi (argv[2]);
+          argc -= 2;
+          argv += 2;
+        }
+      else if (strcmp (argv[1], "--repeat") == 0 && argc >= 3)
+        {
+          repeat = atoi (argv[2]);
+          argc -= 2;
+          argv += 2;
+        }
+      else if (strcmp (argv[1], "--latency") == 0)
+        {
+          latency = 1;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  randoms = malloc ((size_t) NFUN * count * sizeof (double));
+  if (randoms == NULL)
+    {
+      fprintf (stderr, "malloc failed\n");
+      exit (1);
+    }
+  srand48 (1);
+  for (int j = 0; j < NFUN; j++)
+    for (int i = 0; i < count; i++)
+    {
+      double u = drand48 ();
+#ifdef LOG_FAMILY
+      randoms[(size_t) j * count + i] = fun[j].lo * pow (fun[j].hi / fun[j].lo, u);
+#else
+      randoms[(size_t) j * count + i] = fun[j].lo + (fun[j].hi - fun[j].lo) * u;
+#endif
+    }
+
+  for (int j = 0; j < NFUN; j++)
+    printf ("%-8s %.3f\n", fun[j].name, time_alone (j));
+  printf ("mixed    %.3f\n", time_mixed ());
+  free (randoms);
+  return 0;
+}
@@ -2216,7 +2216,9 @@ tan_accurate (double x)
   /* check the upper 54 bits are equal */
   if ((hi0 >> 10) != (hi1 >> 10))
     {
-      static const double exceptions[2][3] = {
+      /* exceptions is volatile, otherwise once the loop below is unrolled,
+         the compiler might evaluate the sums at compile time (to nearest) */
+      static const volatile double exceptions[2][3] = {
         /* the following has 78 identical bits after the round bit */
         {0x1.dffffffffff1fp-22, 0x1.e000000000151p-22, 0x1.fffffffffffffp-76},
         /* the following has 72 identical bits after the round bit */
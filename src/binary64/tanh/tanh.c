@@ -160,6 +160,13 @@ static __attribute__((noinline)) double as_tanh_database(double x, double f){
   return f;
 }
 
+#ifdef CORE_MATH_SHARED_EXP_TABLES
+// t0 and t1 are shared with exp, see src/binary64/support/exp_tables.c
+extern const double core_math_exp_t0[64][2], core_math_exp_t1[64][2];
+#define t0 core_math_exp_t0
+#define t1 core_math_exp_t1
+#endif
+
 double cr_tanh(double x){
   /*
     The function tanh(x) is approximated by minimax polynomial for
@@ -168,6 +175,7 @@ double cr_tanh(double x){
     2*exp(-2*|x|)/(1 + exp(-2*|x|)) becomes small and we can use less
     precise formula for exponent.
   */
+#ifndef CORE_MATH_SHARED_EXP_TABLES
   static const double t0[][2] = {
     {0x0p+0, 0x1p+0}, {-0x1.19083535b085ep-56, 0x1.02c9a3e778061p+0},
       {0x1.d73e2a475b466p-55, 0x1.059b0d3158574p+0}, {0x1.186be4bb285p-57, 0x1.0874518759bc8p+0},
@@ -236,6 +244,7 @@ double cr_tanh(double x){
     {0x1.64cbba902ca28p-58, 0x1.029ccf99d720ap+0}, {0x1.4383ef231d206p-54, 0x1.02a803f2d170dp+0},
     {0x1.4a47a505b3a46p-54, 0x1.02b338c811703p+0}, {0x1.e47120223468p-54, 0x1.02be6e199c811p+0},
   };
+#endif
   double ax = __builtin_fabs(x);
   b64u64_u ix = {.f = ax};
   u64 aix = ix.u;
@@ -270,7 +279,8 @@ double cr_tanh(double x){
     if(__builtin_expect(aix<0x3fd0000000000000ull, 0)){ // |x| < 0x1p-2
       if(__builtin_expect(aix<0x3e10000000000000ull, 0)){ // |x| < 0x1p-30
 	if(__builtin_expect(aix<0x3df0000000000000ull, 0)){ // |x| < 0x1p-32
-	  if(__builtin_expect(!aix, 0)) return x;
+	  // x == 0 also holds for subnormal x in DAZ mode
+	  if(__builtin_expect(x == 0, 0)) return __builtin_copysign(0.0, x);
           /* We have underflow when 0 < |x| < 2^-1022 or when |x| = 2^-1022
              and rounding towards zero. */
           double res = __builtin_fma (x, -0x1p-55, x);
@@ -332,7 +332,8 @@ double cr_tanpi(double x){
     th = fasttwosum(th,tl,&tl);
     res = th;
   } else { // |x| < 0x1p-12
-    if(__builtin_expect(ax==0, 0)) return x;
+    // x == 0 also holds for subnormal x in DAZ mode
+    if(__builtin_expect(x == 0, 0)) return __builtin_copysign(0.0, x);
     const double pi0 = 0x1.921fb54442d18p+1, pi1 = 0x1.1a62633145c07p-53;
     if(__builtin_expect(ax<((uint64_t)0x3ca<<52), 0)) { // |x| < 0x1p-53
       if(__builtin_expect(ax<((uint64_t)0x36<<52), 0)) { // |x| < 0x1p-969
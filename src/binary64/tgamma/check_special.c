@@ -38,6 +38,7 @@ SOFTWARE.
 #include <errno.h>
 #include <omp.h>
 #include "function_under_test.h"
+#include "../../generic/support/philox.h"
 
 int ref_init (void);
 int ref_fesetround (int);
@@ -52,9 +53,7 @@ int verbose = 0;
 unsigned long tested = 0;
 int nthreads;
 
-#define MAX_THREADS 192
-
-static unsigned int Seed[MAX_THREADS];
+static uint64_t Seed;
 
 typedef union {double f; uint64_t u;} b64u64_u;
 
@@ -73,12 +72,10 @@ asfloat64 (uint64_t n)
 }
 
 static double
-get_random (int tid)
+get_random (philox_t *s)
 {
   b64u64_u v;
-  v.u = rand_r (Seed + tid);
-  v.u |= (uint64_t) rand_r (Seed + tid) << 31;
-  v.u |= (uint64_t) rand_r (Seed + tid) << 62;
+  v.u = philox_u64 (s);
   return v.f;
 }
 
@@ -537,22 +534,16 @@ main (int argc, char *argv[])
   printf ("Check negative inputs\n");
   check_negative ();
 
-  long seed = getpid ();
-  for (int i = 0; i < MAX_THREADS; i++)
-    Seed[i] = seed + i;
+  Seed = philox_seed ();
   
   printf ("Checking random numbers...\n");
   for (uint64_t i = 0; i < CORE_MATH_TESTS; i++)
   {
     ref_init ();
     ref_fesetround (rnd);
-    int tid;
-#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
-    tid = omp_get_thread_num ();
-#else
-    tid = 0;
-#endif
-    double x = get_random (tid);
+    philox_t s;
+    philox_init (&s, Seed, i);
+    double x = get_random (&s);
     check (x);
   }
 
@@ -586,11 +586,12 @@ static __attribute__((noinline)) double as_tgamma_accurate(double x){
   }
 
   double crr = 0;
+  volatile double tiny = 0x1p-107; // the rounding mode must be detected at run time
   if(jm<=0){
-    crr = ((0x1p-54+0x1p-107)-0x1p-54) + ((0x1p-53-0x1p-107)-0x1p-53);
+    crr = ((0x1p-54+tiny)-0x1p-54) + ((0x1p-53-tiny)-0x1p-53);
     fl += fh*(jm*crr);
   } else {
-    double op = 0x1p-53 - 0x1p-107, om = -0x1p-53 + 0x1p-107;
+    double op = 0x1p-53 - tiny, om = -0x1p-53 + tiny;
     if(op == -om) crr = 0x1p-53 - op;
     fl -= fh*((jm-5)*crr*1.04);
   }
@@ -35,6 +35,8 @@ SOFTWARE.
 #include <omp.h>
 #endif
 
+#include "../../generic/support/philox.h"
+
 int ref_fesetround (int);
 void ref_init (void);
 
@@ -58,9 +60,7 @@ int verbose = 0;
 // -snan has encoding m=2^63+2^62-1, e=65535
 typedef union {long double f; struct {uint64_t m; uint16_t e;};} b80u80_t;
 
-#define MAX_THREADS 192
-
-static unsigned int Seed[MAX_THREADS];
+static uint64_t Seed;
 
 static int
 is_nan (long double x)
@@ -94,14 +94,14 @@ check (long double x)
 }
 
 static long double
-get_random (int tid)
+get_random (philox_t *s)
 {
   b80u80_t v;
-  v.m = rand_r (Seed + tid);
-  v.m |= (uint64_t) rand_r (Seed + tid) << 31;
-  v.m |= (uint64_t) (rand_r (Seed + tid) & 1) << 62;
+  uint64_t r[2];
+  philox_next (s, r);
+  v.m = r[0] & 0x7fffffffffffffffull;
   // the low 63 bits of m are random
-  v.e = rand_r (Seed + tid) & 0xffff;
+  v.e = r[1] & 0xffff;
   // if e is not 0 nor 0x8000 (0 or subnormal), m should have its most
   // significant bit set, otherwise it should be cleared
   // cf https://en.wikipedia.org/wiki/Extended_precision
@@ -155,9 +155,7 @@ main (int argc, char *argv[])
   ref_init();
   ref_fesetround (rnd);
 
-  unsigned int seed = getpid ();
-  for (int i = 0; i < MAX_THREADS; i++)
-    Seed[i] = seed + i;
+  Seed = philox_seed ();
 
 #ifndef CORE_MATH_TESTS
 #define CORE_MATH_TESTS 1000000000UL /* total number of tests */
@@ -173,7 +171,7 @@ main (int argc, char *argv[])
   long double ulp = 0x1p-50L; // ulp = ulp(x0) = ulp(x1)
   long double dx = (x1 - x0) / (long double) CORE_MATH_TESTS; // total numbers in [x0,x1]
   unsigned long skip = dx / ulp; // distance between two checked numbers
-  int n0 = seed % skip;
+  int n0 = Seed % skip;
   x0 += (long double) n0 * ulp;  // we start at a random x0
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
 #pragma omp parallel for
@@ -200,7 +198,7 @@ main (int argc, char *argv[])
   dx             = 0x0.0000000010000000p+13L/ (long double) CORE_MATH_TESTS;
   ulp = 0x1p-50L;
   skip = dx / ulp;
-  n0 = seed % skip;
+  n0 = Seed % skip;
   x3 += (long double) n0 * ulp - (skip/2) * ulp;
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
 #pragma omp parallel for
@@ -219,13 +217,10 @@ main (int argc, char *argv[])
   {
     ref_init ();
     ref_fesetround (rnd);
-    int tid;
-#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
-    tid = omp_get_thread_num ();
-#else
-    tid = 0;
-#endif
-    long double x = get_random (tid);
+    philox_t s;
+    // the counters n + CORE_MATH_TESTS are not used by the next loop
+    philox_init (&s, Seed, n + CORE_MATH_TESTS);
+    long double x = get_random (&s);
     int e;
     x = frexpl (x, &e);
     check (ldexpl (x, -20));
@@ -239,13 +234,9 @@ main (int argc, char *argv[])
   {
     ref_init ();
     ref_fesetround (rnd);
-    int tid;
-#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
-    tid = omp_get_thread_num ();
-#else
-    tid = 0;
-#endif
-    long double x = get_random (tid);
+    philox_t s;
+    philox_init (&s, Seed, n);
+    long double x = get_random (&s);
     check (x);
   }
 
@@ -588,7 +588,8 @@ fastpath(long double x, redinfo* ri, bool* need_accurate) {
 			eps = 1;
 			mh = 0;
 			if(__builtin_expect(shiftby > 65, 0)) {	
-					return 0x1p-16445L * .25L;
+					volatile long double tiny = 0x1p-16445L; // prevents constant folding
+					return tiny * .25L;
 			}
 		} else {
 			ml = (uint64_t)ml >> shiftby;
@@ -600,7 +601,8 @@ fastpath(long double x, redinfo* ri, bool* need_accurate) {
 	}
 
 	uint64_t oldmh = mh;
-	float op = 1.0f + 0x1p-25f, om = 1.0f - 0x1p-25f;
+	volatile float one = 1.0f; // the rounding mode must be detected at run time
+	float op = one + 0x1p-25f, om = one - 0x1p-25f;
 	if(op==om){ // round to nearest
 		mh += (uint64_t)ml>>63;
 		ml ^= (1ul << 63);
@@ -1082,18 +1084,22 @@ long double accurate_path(long double x, const redinfo* ri) {
 	if(final->ex <= 0) {
 		int shiftby = 1 - final->ex;
 		if(__builtin_expect(shiftby == 64, 0)) {
-			return 0x1p-16445L * .75L;
+			volatile long double tiny = 0x1p-16445L; // prevents constant folding
+			return tiny * .75L;
 		}
 
 		if(__builtin_expect(shiftby > 64, 0)) {	
-				return 0x1p-16445L * .25L;
+				volatile long double tiny = 0x1p-16445L; // prevents constant folding
+				return tiny * .25L;
 		}
 		rshift (final, final, shiftby);
 
 		final->ex = 0;
 	}
 
-	float op = 1.0f + 0x1p-25f, om = 1.0f - 0x1p-25f;
+	volatile float one = 1.0f; // the rounding mode must be detected at run time
+
+	float op = one + 0x1p-25f, om = one - 0x1p-25f;
 	if(op == om) {
 		final->h += final->m >> 63;
 		final->m ^= 1ul << 63;
@@ -1228,7 +1234,8 @@ long double cr_expl(long double x) {
 #ifdef CORE_MATH_SUPPORT_ERRNO
             errno = ERANGE; // underflow
 #endif
-	      return 0x1p-16445L * 0.25L;
+	      volatile long double tiny = 0x1p-16445L; // prevents constant folding
+	      return tiny * 0.25L;
 	  } else {
 #ifdef CORE_MATH_SUPPORT_ERRNO
             errno = ERANGE; // overflow
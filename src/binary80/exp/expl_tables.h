@@ -1,8 +1,20 @@
 #pragma once
 
+/* With -DCORE_MATH_TABLE_SECTION, the tables below are put in the section
+   core_math_tables_exp, aligned on cache lines, see
+   src/generic/support/warmup.h. */
+#ifndef CORE_MATH_TABLE
+#ifdef CORE_MATH_TABLE_SECTION
+#define CORE_MATH_TABLE(family) \
+  __attribute__((section ("core_math_tables_" #family), aligned (64)))
+#else
+#define CORE_MATH_TABLE(family)
+#endif
+#endif
+
 /* t0[i] is a double-double approximation of 2^(i/2^20)
    with absolute error less than 2^-107 */
-_Alignas(16) static const double t0[32][2] = {
+_Alignas(16) static const double t0[32][2] CORE_MATH_TABLE (exp) = {
    {0x1p+0, 0x0p+0},
    {0x1.00000b1721bdp+0, -0x1.b31303b78afcbp-55},
    {0x1.0000162e43f5p+0, -0x1.f3be7c7f49f19p-54},
@@ -40,7 +52,7 @@ _Alignas(16) static const double t0[32][2] = {
 
 /* t1[i] is a double-double approximation of 2^(i/2^15)
    with absolute error less than 2^-107 */
-_Alignas(16) static const double t1[32][2] = {
+_Alignas(16) static const double t1[32][2] CORE_MATH_TABLE (exp) = {
    {0x1p+0, 0x0p+0},
    {0x1.000162e525eep+0, 0x1.51d5115f56655p-54},
    {0x1.0002c5cc37da9p+0, 0x1.247426170d232p-54},
@@ -77,7 +89,7 @@ _Alignas(16) static const double t1[32][2] = {
 
 /* t2[i] is a double-double approximation of 2^(i/2^10)
    with absolute error less than 2^-107 */
-_Alignas(16) static const double t2[32][2] = {
+_Alignas(16) static const double t2[32][2] CORE_MATH_TABLE (exp) = {
    {0x1p+0, 0x0p+0},
    {0x1.002c605e2e8cfp+0, -0x1.d7c96f201bb2fp-55},
    {0x1.0058c86da1c0ap+0, -0x1.5e00e62d6b30dp-56},
@@ -116,7 +128,7 @@ _Alignas(16) static const double t2[32][2] = {
 /* t3[i] is a double-double approximation of 2^(i/2^5)
    with absolute error less than 2^-107 */
 _Alignas(16)
-static const double t3[32][2] = {
+static const double t3[32][2] CORE_MATH_TABLE (exp) = {
    {0x1p+0, 0x0p+0},
    {0x1.059b0d3158574p+0, 0x1.d73e2a475b465p-55},
    {0x1.0b5586cf9890fp+0, 0x1.8a62e4adc610bp-54},
@@ -155,7 +167,7 @@ static const double t3[32][2] = {
    2^(i/2^20) * exp(t0_corr[i]/2^168 + err) = t0[i]
    with |err| < 2^-169.005.
 */
-static const int64_t t0_corr[32] = {
+static const int64_t t0_corr[32] CORE_MATH_TABLE (exp) = {
    0L,
    1074279887023622254L,
    1598373953055596707L,
@@ -194,7 +206,7 @@ static const int64_t t0_corr[32] = {
    2^(i/2^15) * exp(t1_corr[i]/2^168 + err) = t1[i]
    with |err| < 2^-169.049.
 */
-static const int64_t t1_corr[32] = {
+static const int64_t t1_corr[32] CORE_MATH_TABLE (exp) = {
    0L,
    1648239880730689508L,
    1664093406581123357L,
@@ -233,7 +245,7 @@ static const int64_t t1_corr[32] = {
    2^(i/2^10 + t2_corr[i]/2^168 + err) = t2[i]
    with |err| < 2^-169.031.
 */
-static const int64_t t2_corr[32] = {
+static const int64_t t2_corr[32] CORE_MATH_TABLE (exp) = {
    0L,
    -261050157068178213L,
    42835667410629421L,
@@ -272,7 +284,7 @@ static const int64_t t2_corr[32] = {
    2^(i/2^5) * exp(t3_corr[i]/2^168 + err) = t3[i]
    with |err| < 2^-169.024.
 */
-static const int64_t t3_corr[32] = {
+static const int64_t t3_corr[32] CORE_MATH_TABLE (exp) = {
    0L,
    -288663039380764376L,
    1551644157496909205L,
@@ -375,12 +375,13 @@ tint_tod (const tint_t *a, uint64_t err)
     return a->sgn ? -0x1p1023 - 0x1p1023 : 0x1p1023 + 0x1p1023;
   if (a->ex <= -1074) // underflow: |a| < 2^-1074
   {
+    volatile double tiny = a->sgn ? -0x1p-1074 : 0x1p-1074; // prevents constant folding
     if (a->ex < -1074) // |a| < 2^-1075
-      return (a->sgn ? -0x1p-1074 : 0x1p-1074) * 0.5;
+      return tiny * 0.5;
     // 2^-1075 <= |a| < 2^-1074
     int mid = a->h == (1ul << 63) && a->m == 0 && a->l == 0;
     // if mid, |a| = 2^-1075
-    return (a->sgn ? -0x1p-1074 : 0x1p-1074) * (mid ? 0.5 : 0.75);
+    return tiny * (mid ? 0.5 : 0.75);
   }
 #define MASK53 0x1ffffffffffffful
   uint64_t hh = a->h, mm = a->m, ll = a->l;
@@ -158,8 +158,10 @@ static void
 Pacc (long double *h, long double *l, long double x)
 {
   /* the following degree-6 polynomial generated by exp2acc.sollya has absolute
-     error bounded by 2^-133.987 for |x| < 2^-16 */
-  static const long double p[] = {1.0L, // degree 0
+     error bounded by 2^-133.987 for |x| < 2^-16.
+     p is volatile, otherwise gcc might load p[1] with the fldln2 instruction,
+     which rounds log(2) according to the current rounding mode */
+  static const volatile long double p[] = {1.0L, // degree 0
                                   0x1.62e42fefa39ef358p-1L, -0x1.b0e2633fe0676a9cp-67L, // degree 1
                                   0x1.ebfbdff82c58ea86p-3L, 0x1.e2d60dd936b9ba5ep-68L,  // degree 2
                                   0x1.c6b08d704a0bf8b4p-5L, -0x1.8b4ba2fbcf44117p-70L,  // degree 3
@@ -605,7 +607,8 @@ fast_path(long double x, int* needmoreaccuracy) {
 			eps = 1;
 			mh = 0;
 			if(__builtin_expect(shiftby > 65, 0)) {
-					return 0x1p-16445L * .25L;
+					volatile long double tiny = 0x1p-16445L; // prevents constant folding
+					return tiny * .25L;
 			}
 		} else {
 			ml = (uint64_t)ml >> shiftby;
@@ -617,7 +620,8 @@ fast_path(long double x, int* needmoreaccuracy) {
 	}
 
 	uint64_t oldmh = mh;
-	float op = 1.0f + 0x1p-25f, om = 1.0f - 0x1p-25f;
+	volatile float one = 1.0f; // the rounding mode must be detected at run time
+	float op = one + 0x1p-25f, om = one - 0x1p-25f;
 	if(op==om){ // round to nearest
 		mh += (uint64_t)ml>>63;
 		ml ^= (1ull << 63);
@@ -909,7 +913,8 @@ cr_exp2l (long double x)
 #ifdef CORE_MATH_SUPPORT_ERRNO
         errno = ERANGE; // underflow
 #endif
-        return 0x1p-16445L * 0.25L;
+        volatile long double tiny = 0x1p-16445L; // prevents constant folding
+        return tiny * 0.25L;
       }
     } else {
 #ifdef CORE_MATH_SUPPORT_ERRNO
@@ -935,7 +940,8 @@ cr_exp2l (long double x)
 #ifdef CORE_MATH_SUPPORT_ERRNO
           errno = ERANGE; // underflow
 #endif
-          return 0x1p-16445L*.5L;
+          volatile long double tiny = 0x1p-16445L; // prevents constant folding
+          return tiny*.5L;
         }
         cvt_x.m = (uint64_t)1<<shiftamnt;
         cvt_x.e = 0;
@@ -171,7 +171,8 @@ cr_hypotl (long double x, long double y)
      thus y^2 >= 2^126/2^62 = 2^64 > m+1/4.
   */
   if (d >= 32) { // hypot(x,y) = |x| or nextabove(|x|)
-    double z = 1.0;
+    // z is volatile: z + 0x1p-53 must be rounded at run time
+    volatile double z = 1.0;
     if (d == 32) {
       u128 yy = (u128) my * (u128) my;
       uint64_t h = yy >> 64, l = yy, m = mx;
@@ -320,7 +321,8 @@ cr_hypotl (long double x, long double y)
     exact = 1;
   }
 
-  double eps = 0x1p-53;
+  // eps is volatile: 1.0 + eps must be rounded at run time
+  volatile double eps = 0x1p-53;
 
   /* In the midpoint case, we have hh + ll = (th+1/2)^2 thus
      r = th and ll = 2^126. */
@@ -341,13 +343,14 @@ cr_hypotl (long double x, long double y)
        and for RNDN when hypot(x,y) >= (th+3/4)^2, which corresponds to
        r = 0xbfffffffffffffff and ll = 2^112. */
     if (__builtin_expect (res.e == 0 && th == 0x7fffffffffffffffull, 0)) {
-      if (1.0 + 0x1p-53 == 1.0) { // to nearest
+      volatile double one = 1.0; // the rounding mode must be detected at run time
+      if (one + 0x1p-53 == one) { // to nearest
         const u128 thres_r = 0xbfffffffffffffffull;
         const u128 thres_ll = (u128) 1 << 112;
         if (r > thres_r || (r == thres_r && ll >= thres_ll))
           underflow = 0;
       }
-      if (1.0 + 0x1p-53 > 1.0) // RNDU
+      if (one + 0x1p-53 > one) // RNDU
         /* to r = th and ll = 2^126 is exactly the same threshold than for
            rounding upwards for RNDN, since we know th is odd */
         if (eps == 0x1.8p-53)
@@ -619,8 +619,10 @@ Pacc (long double *ph, long double *pl, long double xh, long double xl)
 {
   /* the following is a degree-9 minimax polynomial generated by Sollya
      for log2(1+x) for -0.00012305879499763337 <= x <= 0.00012315926142036915,
-     with relative error bounded by 2^-128.092 */
-  static const long double p[] = {
+     with relative error bounded by 2^-128.092.
+     p is volatile, otherwise gcc might load p[0] with the fldl2e instruction,
+     which rounds 1/log(2) according to the current rounding mode */
+  static const volatile long double p[] = {
     0x1.71547652b82fe178p+0L, -0x1.05e004be5b8b05dcp-65L, // degree 1
     -0x1.71547652b82fe178p-1L, 0x1.05e004be5b90945cp-66L, // degree 2
     0x1.ec709dc3a03fd74ap-2L, -0x1.f556ea2e7fe9068p-73L,  // degree 3
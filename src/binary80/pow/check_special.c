@@ -37,6 +37,8 @@ SOFTWARE.
 #include <math.h>
 #include <assert.h>
 
+#include "../../generic/support/philox.h"
+
 #ifndef CORE_MATH_TESTS
 #define CORE_MATH_TESTS 1000000000UL /* total number of tests */
 #endif
@@ -55,19 +57,17 @@ int verbose = 0;
 
 typedef union {long double f; struct {uint64_t m; uint16_t e;};} b80u80_t;
 
-#define MAX_THREADS 192
-
-static unsigned int Seed[MAX_THREADS];
+static uint64_t Seed;
 
 static long double
-get_random (int tid)
+get_random (philox_t *s)
 {
   b80u80_t v;
-  v.m = rand_r (Seed + tid);
-  v.m |= (uint64_t) rand_r (Seed + tid) << 31;
-  v.m |= (uint64_t) (rand_r (Seed + tid) & 1) << 62;
+  uint64_t r[2];
+  philox_next (s, r);
+  v.m = r[0] & 0x7fffffffffffffffull;
   // the low 63 bits of m are random
-  v.e = rand_r (Seed + tid) & 0xffff;
+  v.e = r[1] & 0xffff;
   // if e is not 0 nor 0x8000 (0 or subnormal), m should have its most
   // significant bit set, otherwise it should be cleared
   // cf https://en.wikipedia.org/wiki/Extended_precision
@@ -207,7 +207,9 @@ check_near_underflow (uint64_t N)
   long double threshold3 = -16382.0L; // smallest normal
   for (uint64_t n = 0; n < N / 3; n++)
   {
-    long double x = get_random (0);
+    philox_t s;
+    philox_init (&s, Seed + 1, n);
+    long double x = get_random (&s);
     x = fabsl (x);
     long double y = threshold1 / log2l (x);
     check (x, y);
@@ -226,7 +228,9 @@ check_near_overflow (uint64_t N)
   long double threshold2 = 16383.0L;
   for (uint64_t n = 0; n < N / 2; n++)
   {
-    long double x = get_random (0);
+    philox_t s;
+    philox_init (&s, Seed + 2, n);
+    long double x = get_random (&s);
     x = fabsl (x);
     long double y = threshold1 / log2l (x);
     check (x, y);
@@ -243,7 +247,9 @@ check_near_one (int N)
   long double threshold2 = 0x1.0000000000000002p+0L; // nextabove(1) = 1+2^-63
   for (int n = 0; n < N / 4; n++)
   {
-    long double x = get_random (0);
+    philox_t s;
+    philox_init (&s, Seed + 3, n);
+    long double x = get_random (&s);
     x = fabsl (x);
     long double y = threshold1 / log2l (x);
     check (x, y);
@@ -384,6 +390,8 @@ main (int argc, char *argv[])
   ref_fesetround(rnd);
   fesetround(rnd1[rnd]);
 
+  Seed = philox_seed ();
+
   printf ("Checking exact/midpoint squares\n");
   check_exact_or_midpoint_2 (CORE_MATH_TESTS / 10);
 
@@ -407,10 +415,6 @@ main (int argc, char *argv[])
 
   printf ("Checking random values\n");
 
-  unsigned int seed = getpid ();
-  for (int i = 0; i < MAX_THREADS; i++)
-    Seed[i] = seed + i;
-
 #if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
 #pragma omp parallel for
 #endif
@@ -418,13 +422,9 @@ main (int argc, char *argv[])
 		ref_init();
 		ref_fesetround(rnd);
 		fesetround(rnd1[rnd]);
-                int tid;
-#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
-                tid = omp_get_thread_num ();
-#else
-                tid = 0;
-#endif
-		long double x = get_random(tid), y = get_random(tid);
+                philox_t s;
+                philox_init (&s, Seed, n);
+		long double x = get_random(&s), y = get_random(&s);
 		check(x, y);
 	}
 
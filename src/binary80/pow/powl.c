@@ -1063,7 +1063,8 @@ long double fastpath_roundtest(double rh, double rl, int extra_exp,
 		if(__builtin_expect(shiftby >= 64, 0)) {	
 			ml = mh >> (shiftby - 64); mh = 0; eps = 1;
 			if(__builtin_expect(shiftby > 65, 0)) {
-				*fail = false; return invert ? -0x1p-16445L*.25L : 0x1p-16445L*0.25L;
+				volatile long double tiny = 0x1p-16445L; // prevents constant folding
+				*fail = false; return invert ? -tiny*.25L : tiny*0.25L;
 			}
 			// This overestimates epsilon, which is safe
 		} else {
@@ -1564,7 +1565,8 @@ long double accurate_path(long double x, long double y, FLAG_T inex, bool invert
 	if(q_r->ex >= 15) {
 		// |q_r| >= 2^15 thus |y*log2|x|| >= 2^15/(1 + 2^-249.334) > 32767
 		if(q_r->sgn) { // y*log2|x| < -32768: underflow
-			return (invert ? -0x1p-16445L : 0x1p-16445L)*.25L;
+			volatile long double tiny = 0x1p-16445L; // prevents constant folding
+			return (invert ? -tiny : tiny)*.25L;
 		} else { // y*log2|x| > 32767: overflow
 			return (invert ? -0x1p16383L : 0x1p16383L) * 2L;
 		}
@@ -1589,7 +1591,8 @@ long double accurate_path(long double x, long double y, FLAG_T inex, bool invert
 		/* If q_r->ex = -16447 we may still really have exponent -16446 because
 		   of errors, then round to 1p-16445.
 		*/
-		return (invert ? -0x1p-16445L : 0x1p-16445L) * .25L;
+		volatile long double tiny = 0x1p-16445L; // prevents constant folding
+		return (invert ? -tiny : tiny) * .25L;
 	}
 
 	uint64_t extralow[1] = {0};
@@ -1775,7 +1778,8 @@ long double cr_powl(long double x, long double y) {
 #ifdef CORE_MATH_SUPPORT_ERRNO
 		  errno = ERANGE; // overflow
 #endif
-			return lt1 ? (sign*0x1p-16445L)*.25L : (sign*0x1p16383L)*2L;
+			volatile long double tiny = 0x1p-16445L; // prevents constant folding
+			return lt1 ? (sign*tiny)*.25L : (sign*0x1p16383L)*2L;
 		}
 	} else if(__builtin_expect(y_exp <= -81, 0)) {
 		/* For y_exp <= -81, we have |y| < 2^-80,
@@ -1785,7 +1789,8 @@ long double cr_powl(long double x, long double y) {
 		if(!cvt_y.m || x == 1.L) {
 			return 1.L;
 		} else { // Here we know sign == 1.
-				return lt1 ? 1. - 0x1p-16445L : 1. + 0x1p-16445L; 
+				volatile long double tiny = 0x1p-16445L; // prevents constant folding
+				return lt1 ? 1. - tiny : 1. + tiny;
 		}
 	}
 
@@ -1814,7 +1819,10 @@ long double cr_powl(long double x, long double y) {
 		   sign of rh we can deduce the correctly rounded result.
 		*/
 			if(rh > 0) {return sign*0x1p16383L + sign*0x1p16383L;}
-			else {return (sign*0x1p-16445L)*.25L;}
+			else {
+				volatile long double tiny = 0x1p-16445L; // prevents constant folding
+				return (sign*tiny)*.25L;
+			}
 		} else {
 			// rh + rl approximates y*log2(x)
 			double resh, resl;
@@ -1,5 +1,17 @@
 #pragma once
 
+/* With -DCORE_MATH_TABLE_SECTION, the tables below are put in the section
+   core_math_tables_pow, aligned on cache lines, see
+   src/generic/support/warmup.h. */
+#ifndef CORE_MATH_TABLE
+#ifdef CORE_MATH_TABLE_SECTION
+#define CORE_MATH_TABLE(family) \
+  __attribute__((section ("core_math_tables_" #family), aligned (64)))
+#else
+#define CORE_MATH_TABLE(family)
+#endif
+#endif
+
 typedef struct {
 	double r;
 	double mlogrh, mlogrl;
@@ -24,7 +36,7 @@ typedef struct {
    from file powl.sage.
 */
 static const _Alignas(16)
-lut_t coarse[128] = {
+lut_t coarse[128] CORE_MATH_TABLE (pow) = {
 {0x1p+0, 0x0p+0, 0x0p+0,0},//0x1p-7
 {0x1.fap-1, 0x1.16a21e20a0a45p-6, 0x1.79268271cbde1p-63,0},//0x1.06p-8
 {0x1.f6p-1, 0x1.d23afc49139f9p-6, -0x1.90c94610afb5fp-60,0},//0x1.14p-8
@@ -169,7 +181,7 @@ lut_t coarse[128] = {
    and the value of i.
 */
 static const _Alignas(16)
-lut_t fine[128] = {
+lut_t fine[128] CORE_MATH_TABLE (pow) = {
 {0x1p+0, 0x0p+0, 0x0p+0, 0}, //0x1p+0,0x1.001p+0(0x0)
 {0x1.ffdp-1, 0x1.150c5586012b8p-11, 0x1.09d379fa18c5dp-67, 0}, //0x1.001p+0,0x1.002p+0(0x1)
 {0x1.ffbp-1, 0x1.cdcda8e93107fp-11, 0x1.f183ca5b21bfep-65, 0}, //0x1.002p+0,0x1.003p+0(0x2)
@@ -302,7 +314,7 @@ lut_t fine[128] = {
 
 /* acc_coarsetbl[i] holds a tint approximating -log2(coarsetbl[i].r * 2^z[i])
    with relative error at most 2^-256, where z[i] = coarsetbl[i].z */
-static const qint64_t acc_coarsetbl[128] = {
+static const qint64_t acc_coarsetbl[128] CORE_MATH_TABLE (pow) = {
     {.hh = 0x0, .hl = 0x0, .lh = 0x0, .ll = 0x0, .ex = 0, .sgn = 0x0},
     {.hh = 0x8b510f105052285e, .hl = 0x49a09c72f783d310, .lh = 0x4c914d6a61f49b08, .ll = 0xfc7d870b752b078d, .ex = -6, .sgn = 0x0},
     {.hh = 0xe91d7e2489cfc4de, .hl = 0x6d73dea0942a7bca, .lh = 0xeda21a30e2f3919f, .ll = 0x2a2fa6a536f0a452, .ex = -6, .sgn = 0x0},
@@ -437,7 +449,7 @@ static const qint64_t acc_coarsetbl[128] = {
 /* acc_finetbl[i] holds a tint approximating -log2(finetbl[i].r) with
 relative error at most 2^-256.
 */
-static const qint64_t acc_finetbl[128] = {
+static const qint64_t acc_finetbl[128] CORE_MATH_TABLE (pow) = {
     {.hh = 0x0, .hl = 0x0, .lh = 0x0, .ll = 0x0, .ex = 0, .sgn = 0x0},
     {.hh = 0x8a862ac30095c084, .hl = 0xe9bcfd0c62eaa2ca, .lh = 0x6c5f92c172efd68a, .ll = 0x502850f96434c589, .ex = -11, .sgn = 0x0},
     {.hh = 0xe6e6d4749883fbe3, .hl = 0x794b6437fb56343, .lh = 0xade811ee20b6fe4d, .ll = 0xd617a08e3d85ccd8, .ex = -11, .sgn = 0x0},
@@ -570,7 +582,7 @@ static const qint64_t acc_finetbl[128] = {
 
 /* t0[i] is a double-double approximation of 2^(i/2^20)
    with absolute error less than 2^-107 */
-_Alignas(16) static const double t0[32][2] = {
+_Alignas(16) static const double t0[32][2] CORE_MATH_TABLE (pow) = {
    {0x1p+0, 0x0p+0},
    {0x1.00000b1721bdp+0, -0x1.b31303b78afcbp-55},
    {0x1.0000162e43f5p+0, -0x1.f3be7c7f49f19p-54},
@@ -607,7 +619,7 @@ _Alignas(16) static const double t0[32][2] = {
 
 /* t1[i] is a double-double approximation of 2^(i/2^15)
    with absolute error less than 2^-107 */
-_Alignas(16) static const double t1[32][2] = {
+_Alignas(16) static const double t1[32][2] CORE_MATH_TABLE (pow) = {
    {0x1p+0, 0x0p+0},
    {0x1.000162e525eep+0, 0x1.51d5115f56655p-54},
    {0x1.0002c5cc37da9p+0, 0x1.247426170d232p-54},
@@ -644,7 +656,7 @@ _Alignas(16) static const double t1[32][2] = {
 
 /* t2[i] is a double-double approximation of 2^(i/2^10)
    with absolute error less than 2^-107 */
-_Alignas(16) static const double t2[32][2] = {
+_Alignas(16) static const double t2[32][2] CORE_MATH_TABLE (pow) = {
    {0x1p+0, 0x0p+0},
    {0x1.002c605e2e8cfp+0, -0x1.d7c96f201bb2fp-55},
    {0x1.0058c86da1c0ap+0, -0x1.5e00e62d6b30dp-56},
@@ -683,7 +695,7 @@ _Alignas(16) static const double t2[32][2] = {
 /* t3[i] is a double-double approximation of 2^(i/2^5)
    with absolute error less than 2^-107 */
 _Alignas(16)
-static const double t3[32][2] = {
+static const double t3[32][2] CORE_MATH_TABLE (pow) = {
    {0x1p+0, 0x0p+0},
    {0x1.059b0d3158574p+0, 0x1.d73e2a475b465p-55},
    {0x1.0b5586cf9890fp+0, 0x1.8a62e4adc610bp-54},
@@ -728,7 +740,7 @@ static const double t3[32][2] = {
 	   - |l| < 2^126
   Table generated by corr_tk(k=0) from powl.sage.
 */
-static const corr_t t0_corr[32] = {
+static const corr_t t0_corr[32] CORE_MATH_TABLE (pow) = {
    {.h=0L,.lh=0UL,.ll=0UL},
    {.h=774929132767867848L,.lh=1877417623945036096UL,.ll=2946102060019946640UL},
    {.h=1152983087779699084L,.lh=2854112676240020970UL,.ll=3486792221048696928UL},
@@ -773,7 +785,7 @@ static const corr_t t0_corr[32] = {
 	   - |l| < 2^126
   Table generated by corr_tk(k=1) from powl.sage.
 */
-static const corr_t t1_corr[32] = {
+static const corr_t t1_corr[32] CORE_MATH_TABLE (pow) = {
    {.h=0L,.lh=0UL,.ll=0UL},
    {.h=1188953751062791134L,.lh=2086390938573950067UL,.ll=4826928784532323317UL},
    {.h=1200389652625304084L,.lh=2685434046295363506UL,.ll=15420523437626342UL},
@@ -817,7 +829,7 @@ static const corr_t t1_corr[32] = {
 	   - |l| < 2^126
   Table generated by corr_tk(k=2) from powl.sage.
 */
-static const corr_t t2_corr[32] = {
+static const corr_t t2_corr[32] CORE_MATH_TABLE (pow) = {
    {.h=0L,.lh=0UL,.ll=0UL},
    {.h=-188307883512772844L,.lh=2410844611908356161UL,.ll=3259474191313504333UL},
    {.h=30899402473242025L,.lh=99506931431156031UL,.ll=9115491649412450447UL},
@@ -862,7 +874,7 @@ static const corr_t t2_corr[32] = {
 	   - |l| < 2^126
   Table generated by corr_tk(k=3) from powl.sage.
 */
-static const corr_t t3_corr[32] = {
+static const corr_t t3_corr[32] CORE_MATH_TABLE (pow) = {
    {.h=0L,.lh=0UL,.ll=0UL},
    {.h=-208226367701282158L,.lh=1881570934240644082UL,.ll=15338819650725614653UL},
    {.h=1119274665622562301L,.lh=2517131680502636761UL,.ll=9378771030972421185UL},
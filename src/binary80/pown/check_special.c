@@ -0,0 +1,245 @@
+/* Additional tests for the binary80 integer power function.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fenv.h>
+#include <math.h>
+#include <mpfr.h>
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#include <omp.h>
+#endif
+#include <unistd.h>
+
+#include "../../generic/support/philox.h"
+
+extern long double cr_pownl (long double, long long);
+extern int ref_fesetround (int);
+extern void ref_init (void);
+extern mpfr_rnd_t rnd2[];
+extern long double ref_pown (long double, long long);
+
+int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
+
+int rnd;
+int verbose = 0;
+
+static uint64_t Seed;
+
+typedef union {long double f; struct {uint64_t m; uint16_t e;};} b80u80_t;
+
+/* define our own is_nan function to avoid depending from math.h */
+static inline int
+is_nan (long double x)
+{
+  b80u80_t v = {.f = x};
+  return ((v.e == 0x7fff || v.e == 0xffff) && (v.m != (1ul << 63)));
+}
+
+static inline int
+is_equal (long double x, long double y)
+{
+  if (is_nan (x))
+    return is_nan (y);
+  if (is_nan (y))
+    return is_nan (x);
+  b80u80_t v = {.f = x}, w = {.f = y};
+  return v.e == w.e && v.m == w.m;
+}
+
+static void
+check (long double x, long long n)
+{
+  long double z, t;
+  z = cr_pownl (x, n);
+  t = ref_pown (x, n);
+  if (!is_equal (z, t))
+  {
+    printf ("cr_pownl and ref_pown differ for x=%La n=%lld\n", x, n);
+    printf ("cr_pownl gives %La\n", z);
+    printf ("ref_pown gives %La\n", t);
+    exit (1);
+  }
+}
+
+#ifndef CORE_MATH_TESTS
+#define CORE_MATH_TESTS 100000000ul // total number of tests
+#endif
+
+/* Random x, with n uniformly distributed in [-2^k,2^k] for random k,
+   and x either random, or close to 1 so that x^n does not overflow
+   for large |n|. */
+static void
+check_random (void)
+{
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (uint64_t i = 0; i < CORE_MATH_TESTS; i++)
+  {
+    ref_init ();
+    ref_fesetround (rnd);
+    fesetround(rnd1[rnd]);
+    philox_t s;
+    philox_init (&s, Seed, i);
+    uint64_t r[2];
+    philox_next (&s, r);
+    uint64_t u = r[0], v = philox_u64 (&s);
+    int k = v % 64;
+    long long n = (k == 63) ? (long long) v
+      : (long long) ((v >> 6) % (2ull << k)) - (1ll << k);
+    b80u80_t x;
+    x.m = u & 0x7fffffffffffffffull;
+    x.e = r[1] & 0xffff;
+    // the explicit integer bit is set for normal numbers only
+    x.m |= (uint64_t) ((x.e & 0x7fff) != 0) << 63;
+    if (i & 1) {
+      // |x| in [1-2^-d, 1+2^-d] with 2^d about |n|
+      int d = (k < 62) ? k + 1 : 63;
+      x.f = 1.0L + ldexpl ((long double) (u >> 1) * 0x1p-62L - 1.0L, -d);
+      x.e |= r[1] & 0x8000;
+    }
+    check (x.f, n);
+  }
+}
+
+/* Check exact and midpoint values x = m*2^e with m odd, where m^n fits in
+   65 bits. For each n, at most 1024 values of m are tried, and all values
+   of e such that x^n is near the underflow or overflow thresholds. */
+static void
+check_exact_or_midpoint (void)
+{
+  // max_pow[n] is the largest x such that x^n fits in 65 bits
+  int64_t max_pow[] = {0, 0, 6074000999, 3329021, 77935, 8191, 1824, 624, 279, 149, 90, 60, 42, 31, 24, 20, 16, 14, 12, 10, 9, 8, 7, 7, 6, 6, 5, 5, 4, 4, 4, 4, 4, 3, 3, 3, 3, 3, 3, 3, 3, 3};
+  for (int n = 41; n >= 2; n--)
+  {
+    int64_t dm = 2 * (1 + max_pow[n] / 2048); // should be even
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+    for (int64_t m = 3; m <= max_pow[n]; m += dm)
+    {
+      ref_init();
+      ref_fesetround(rnd);
+      fesetround(rnd1[rnd]);
+      int b = 64 - __builtin_clzll (m); // number of bits of m
+      // for e < emin, x^n < 2^-16446, for e > emax, x^n > 2^16384
+      int emin = -16446 / n - b, emax = 16384 / n + 1;
+      for (int e = emin; e <= emax; e += (e < emin + 16 || e > emax - 16) ? 1 : 37)
+      {
+        check (ldexpl ((long double) m, e), n);
+        check (ldexpl (-(long double) m, e), n);
+      }
+    }
+  }
+}
+
+/* Check integer powers of 2 and of values just above and below. */
+static void
+check_powers_of_two (void)
+{
+  static const long long N[] = {3, 7, 10, 64, 65, 16383, 16384, 16385, 16445, 16446, 40000, 40001, 1ll << 40, 0x7fffffffffffffffll};
+#if (defined(_OPENMP) && !defined(CORE_MATH_NO_OPENMP))
+#pragma omp parallel for
+#endif
+  for (int e = -16445; e <= 16383; e++)
+  {
+    ref_init();
+    ref_fesetround(rnd);
+    fesetround(rnd1[rnd]);
+    long double x = ldexpl (1.0L, e);
+    for (unsigned i = 0; i < sizeof (N) / sizeof (N[0]); i++)
+      for (int s = 0; s < 2; s++)
+      {
+        long long n = s ? -N[i] : N[i];
+        check (x, n);
+        check (-x, n);
+        check (nextafterl (x, 0), n);
+        check (nextafterl (x, INFINITY), n);
+      }
+  }
+  check (1.0L, 0x7fffffffffffffffll);
+  check (-1.0L, 0x7fffffffffffffffll);
+  check (-1.0L, -0x7fffffffffffffffll - 1);
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--rndn") == 0)
+        {
+          rnd = 0;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndz") == 0)
+        {
+          rnd = 1;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndu") == 0)
+        {
+          rnd = 2;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--rndd") == 0)
+        {
+          rnd = 3;
+          argc --;
+          argv ++;
+        }
+      else if (strcmp (argv[1], "--verbose") == 0)
+        {
+          verbose = 1;
+          argc --;
+          argv ++;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  printf ("Checking powers of 2\n");
+  check_powers_of_two ();
+
+  printf ("Checking exact/midpoint values\n");
+  check_exact_or_midpoint ();
+
+  Seed = philox_seed ();
+
+  printf ("Checking random values\n");
+  check_random ();
+
+  return 0;
+}
@@ -0,0 +1,26 @@
+/* The generic bivariate checks give the integer exponent n of pownl as a
+   binary80 value, which is converted back below. */
+#define cr_function_under_test cr_pownl_ld
+#define ref_function_under_test ref_pown_ld
+#define mpfr_function_under_test mpfr_pown_ld
+
+long double cr_pownl (long double, long long);
+long double ref_pown (long double, long long);
+
+/* y is NaN only in the checks of signaling NaN inputs: the addition is done
+   on the result of cr_pownl, which the compiler cannot fold */
+static inline long double cr_pownl_ld (long double x, long double y)
+{
+  return (y != y) ? cr_pownl (x, 0) + y : cr_pownl (x, (long long) y);
+}
+
+static inline long double ref_pown_ld (long double x, long double y)
+{
+  return (y != y) ? x + y : ref_pown (x, (long long) y);
+}
+
+static inline int
+mpfr_pown_ld (mpfr_ptr r, mpfr_srcptr x, mpfr_srcptr y, mpfr_rnd_t rnd)
+{
+  return mpfr_pow_si (r, x, mpfr_get_si (y, MPFR_RNDN), rnd);
+}
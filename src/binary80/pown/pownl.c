@@ -0,0 +1,258 @@
+/* Correctly-rounded integer power function for a binary80 value.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* This code assumes "long double" corresponds to the 80-bit double extended
+   format.
+
+   Every integer n of type long long is exactly representable in binary80,
+   thus pownl(x,n) = powl(x,n), and the special cases, the exact and
+   midpoint cases, and the large values of |n| are delegated to cr_powl()
+   from ../pow/powl.c (which detects the exact cases with powl_exact.h).
+   For |x| normal and 2 <= |n| < 2^20, a fast path computes |x|^|n| by
+   left-to-right binary exponentiation in double-double arithmetic, with
+   relative error less than (|n|+1)*2^-99, and rounds it to binary80 when
+   the result is far enough from a rounding boundary and in the normal range.
+*/
+
+#include <stdint.h>
+#include <errno.h>
+#include <math.h> // needed to define pownl since it is not in glibc < 2.41
+
+// Warning: clang also defines __GNUC__
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#endif
+
+#pragma STDC FENV_ACCESS ON
+
+typedef union {double f; uint64_t u;} b64u64_u;
+typedef union {long double f; struct {uint64_t m; uint16_t e;};} b80u80_t;
+
+long double cr_powl (long double, long double);
+
+/* Return 2^F, for |F| <= 1023, as a binary64 number */
+static inline double
+pow2 (int64_t F)
+{
+  b64u64_u r = {.u = (uint64_t) (F + 0x3ff) << 52};
+  return r.f;
+}
+
+/* Return 2^F, for |F| <= 16383, as a binary80 number */
+static inline long double
+pow2l (int64_t F)
+{
+  b80u80_t r = {.m = 1ull << 63, .e = F + 16383};
+  return r.f;
+}
+
+/* Put in h+l an approximation of (h+l)^2, with relative error less than
+   5*2^-104, and |l| <= ulp(h), assuming |l| <= ulp(h) on input
+   (see d_sqr() in ../../binary64/pown/pown.c). */
+static inline void
+d_sqr (double *h, double *l)
+{
+  double hi = *h * *h;
+  double e = __builtin_fma (*h, *h, -hi); // exact
+  double lo = __builtin_fma (*h + *h, *l, e);
+  *h = hi + lo;
+  *l = lo - (*h - hi);
+}
+
+/* Put in h+l an approximation of (h+l)*(bh+bl), with relative error less
+   than 5*2^-104, and |l| <= ulp(h), assuming |l| <= ulp(h) and
+   |bl| <= ulp(bh) on input: the neglected term l*bl is less than 2^-104
+   relative to the result, and each of the two fma operations and of the
+   final fast_two_sum adds an error less than 2^-104 in relative terms. */
+static inline void
+d_mul (double *h, double *l, double bh, double bl)
+{
+  double hi = *h * bh;
+  double e = __builtin_fma (*h, bh, -hi); // exact
+  double lo = __builtin_fma (*h, bl, __builtin_fma (*l, bh, e));
+  *h = hi + lo;
+  *l = lo - (*h - hi);
+}
+
+/* Return the rounding of s*2^F, with s = +1 or -1 and |F| <= 16383*2^20.
+   This is not delegated to cr_powl(), which rounds 2^-16446 (the middle of
+   0 and 2^-16445) to 2^-16445 instead of 0 when rounding to nearest. */
+static long double
+pow2_result (long double s, int64_t F)
+{
+  if (F > 16383 || F < -16445) {
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    errno = ERANGE; // overflow or underflow
+#endif
+    if (F > 16383)
+      return (s * 0x1p16383L) * 2.0L;
+    volatile long double tiny = 0x1p-16445L; // prevents constant folding
+    return (s * tiny) * ((F == -16446) ? 0.5L : 0.25L);
+  }
+  if (F >= -16382)
+    return s * pow2l (F);
+  b80u80_t r = {.m = 1ull << (F + 16445), .e = 0}; // subnormal
+  return s * r.f;
+}
+
+long double
+cr_pownl (long double x, long long n)
+{
+  b80u80_t t = {.f = x};
+  int64_t e = (t.e & 0x7fff) - 16383;
+  uint64_t N = (n < 0) ? -(uint64_t) n : (uint64_t) n;
+  long double s = ((t.e >> 15) & N & 1) ? -1.0L : 1.0L; // sign of x^n
+
+  // |x| = 2^e with x normal (not infinite) and n <> 0
+  if (__builtin_expect (t.m == 1ull << 63 && e != -16383 && e != 0x7fff - 16383
+                        && n != 0, 0)) {
+    if (e == 0)
+      return s;
+    if (N >> 20) // |e*n| >= 2^20 thus x^n overflows or underflows
+      return pow2_result (s, (e > 0) == (n > 0) ? 16384 : -16447);
+    return pow2_result (s, (n > 0) ? e * (int64_t) N : -e * (int64_t) N);
+  }
+
+  if (__builtin_expect (e == -16383 && t.m != 0 && (N >> 1), 0)) {
+    /* x is subnormal and |n| >= 2: since |x| < 2^-16382, x^n underflows for
+       n >= 2 and overflows for n <= -2 */
+    return pow2_result (s, (n > 0) ? -16447 : 16384);
+  }
+
+  // special inputs (x = 0, subnormal, Inf or NaN) and |n| < 2
+  if (__builtin_expect (e == -16383 || e == 0x7fff - 16383 || N < 2, 0))
+    return cr_powl (x, (long double) n);
+
+  /* x^n might be exact or a midpoint: mo^n fits in 65 bits, where
+     |x| = mo*2^f with mo odd, is only possible for n > 0 and (b-1)*n < 65,
+     where b is the number of significant bits of x */
+  int b = 64 - __builtin_ctzll (t.m);
+  if (__builtin_expect (n > 0 && (b - 1) * N < 65, 0)) {
+    long double r = cr_powl (x, (long double) n);
+#ifdef CORE_MATH_SUPPORT_ERRNO
+    /* cr_powl does not set errno on overflow; since n >= 2 and 2^64-1 is
+       not a perfect power, |r| = LDBL_MAX can only come from an overflow */
+    if (__builtin_fabsl (r) >= 0xf.fffffffffffffffp+16380L)
+      errno = ERANGE;
+#endif
+    return r;
+  }
+
+  // write |x| = m*2^e with 0.75 <= m < 1.5, and m = mh + ml exactly
+  b80u80_t v = {.m = t.m, .e = 16383};
+  if (v.f >= 1.5L) {
+    v.f *= 0.5L;
+    e ++;
+  }
+  /* if e <> 0, |log2|x|| > 0.415, thus x^n overflows or underflows for
+     |n| >= 2^20; if e = 0, x^n might be in range (for x close to 1) */
+  if (__builtin_expect (N >> 20, 0))
+    return (e != 0) ? pow2_result (s, (e > 0) == (n > 0) ? 16384 : -16447)
+      : cr_powl (x, (long double) n);
+
+  double mh = v.f;
+  double ml = v.f - (long double) mh; // both operations are exact
+
+  /* Left-to-right binary exponentiation: (h+l)*2^E approximates m^k for
+     the prefixes k of N. After the squaring and the optional
+     multiplication by m, the relative error grows from eta_k to less than
+     2*eta_k + 10*2^-104 < 2*eta_k + 2^-100, thus the final relative error
+     is less than N*2^-100. */
+  double h = mh, l = ml;
+  int64_t E = 0;
+  int i = 63 - __builtin_clzll (N);
+  while (i--) {
+    d_sqr (&h, &l);
+    E *= 2;
+    if ((N >> i) & 1)
+      d_mul (&h, &l, mh, ml);
+    if (__builtin_expect (h > 0x1p+256 || h < 0x1p-256, 0)) {
+      // scale h+l (exactly) into [1,2)
+      b64u64_u w = {.f = h};
+      int64_t k = ((w.u >> 52) & 0x7ff) - 0x3ff;
+      double c = pow2 (-k);
+      E += k;
+      h *= c;
+      l *= c;
+      /* if e = 0 and |log2(m^k)| > 17000, then x^n overflows or underflows
+         (for e <> 0, |E| < 2^20*0.585 since |n| < 2^20, and the exponent
+         of x^n is checked below) */
+      if (e == 0 && (E > 17000 || E < -17000))
+        return pow2_result (s, (E > 0) == (n > 0) ? 16384 : -16447);
+    }
+  }
+
+  int64_t S = E + e * (int64_t) N; // |x|^N ~ (h+l)*2^S
+  if (n < 0) {
+    // 1/(h+l) with an additional relative error less than 2^-101
+    double rh = 1.0 / h;
+    double eps = __builtin_fma (-rh, h, 1.0);
+    l = rh * __builtin_fma (-rh, l, eps);
+    h = rh;
+    S = -S;
+  }
+  h *= (double) s;
+  l *= (double) s;
+
+  /* detect overflow and underflow before the rounding test, which might fail
+     near 2^16384 (for example for x = 2^16384*(1-2^-64) and n = 2):
+     2^k <= |h| < 2^(k+1), thus |x^n| > 2^16384 for k > 16384, and
+     |x^n| < 2^-16447 for k < -16448 */
+  b64u64_u hv = {.f = h};
+  int64_t kh = ((hv.u >> 52) & 0x7ff) - 0x3ff + S;
+  if (__builtin_expect (kh > 16384 || kh < -16448, 0))
+    return pow2_result (s, (kh > 0) ? 16384 : -16447);
+
+  /* The error bound (N+1)*2^-99 accounts for the reciprocal, for
+     second-order terms, and for the rounding of the fma operations below.
+     Since h and the fma results are exact in binary80, res_min and res_max
+     are the roundings of the (double-double) bounds of the interval
+     containing x^n*2^-S. */
+  double err = ((double) N + 1.0) * 0x1p-99;
+  long double res_min = (long double) h + (long double) __builtin_fma (err, -h, l);
+  long double res_max = (long double) h + (long double) __builtin_fma (err, h, l);
+  if (__builtin_expect (res_min == res_max, 1)) {
+    b80u80_t r = {.f = res_max};
+    int64_t k = (r.e & 0x7fff) - 16383 + S; // exponent of x^n
+    if (__builtin_expect (-16382 <= k && k <= 16383, 1)) {
+      /* 2^-514 < |res_max| < 2^514 thus |S| <= 16383 + 514, both factors
+         are normal numbers, and res_max*2^(S/2) too: the products are
+         exact */
+      int64_t S1 = S / 2;
+      return res_max * pow2l (S1) * pow2l (S - S1);
+    }
+    if (k > 16383) // x^n rounds to 2^16384 or more: overflow
+      return pow2_result (s, 16384);
+  }
+  return cr_powl (x, (long double) n);
+}
+
+#ifndef SKIP_C_FUNC_REDEF
+/* just to compile since glibc < 2.41 does not contain this function */
+long double pownl (long double x, long long n){
+  return powl (x, (long double) n);
+}
+#endif
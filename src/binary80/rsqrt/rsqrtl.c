@@ -91,7 +91,8 @@ long double cr_rsqrtl (long double x){
     v.e = 16383 + (16383 - e) / 2;
     return v.f;
   }
-  float op = 1.0f + 0x1p-25f, om = 1.0f - 0x1p-25f;
+  volatile float one = 1.0f; // the rounding mode must be detected at run time
+  float op = one + 0x1p-25f, om = one - 0x1p-25f;
   long rn = op==om, ru = op>1.0f; // figure out a rounding mode
   rn <<= 25;
   // cubic approximation of 1/sqrt(x) in 64 regions in [1,2]
@@ -58,8 +58,9 @@ static __bf16
 float_to_bf16 (float x)
 {
   b32u32_u w = {.f = x};
-  int a = 1.0f - 0x1p-25f == 1.0f;   // true for RNDN and RNDU
-  int b = -1.0f + 0x1p-25f == -1.0f; // true for RNDN and RNDD
+  volatile float one = 1.0f; // the rounding mode must be detected at run time
+  int a = one - 0x1p-25f == one;   // true for RNDN and RNDU
+  int b = -one + 0x1p-25f == -one; // true for RNDN and RNDD
   b16u16_u v;
   uint16_t frac = w.u; // trailing bits
   switch ((a<<1) | b) {
@@ -51,8 +51,9 @@ __bf16 cr_hypot_bf16(__bf16 x, __bf16 y){
      for z <= 0x1.fep-127 for rndu
      (there is no underflow if z is exact) */
   if (z != 0 && (double) ret != z && z < 0x1p-126) {
-    int t = 1.0f + 0x1p-24f > 1.0f; // true for rndu only
-    int u = 1.0f - 0x1p-25f < 1.0f; // true for rndz/rndd only
+    volatile float one = 1.0f; // the rounding mode must be detected at run time
+    int t = one + 0x1p-24f > one; // true for rndu only
+    int u = one - 0x1p-25f < one; // true for rndz/rndd only
     if (u || (z < 0x1.ffp-127 && !t) || (z <= 0x1.fep-127 && t))
       errno = ERANGE; // underflow
   }
@@ -62,8 +63,9 @@ __bf16 cr_hypot_bf16(__bf16 x, __bf16 y){
      We limit z to 2^129, otherwise for x,y=inf,0x0p+0 we get a spurious
      inexact due to the computation of t and u. */
   if (z > 0x1.fep+127 && z < 0x1p129) {
-    int t = 1.0f + 0x1p-24f > 1.0f; // true for rndu only
-    int u = 1.0f - 0x1p-25f < 1.0f; // true for rndz/rndd only
+    volatile float one = 1.0f; // the rounding mode must be detected at run time
+    int t = one + 0x1p-24f > one; // true for rndu only
+    int u = one - 0x1p-25f < one; // true for rndz/rndd only
     if (t || (z >= 0x1.ffp+127 && !u) || (z >= 0x1p+128 && u))
       errno = ERANGE; // overflow
   }
@@ -352,10 +352,11 @@ exp_accurate (double ylogx, uint64_t sign, fexcept_t flag)
   expr.f *= T4[i1] * T5[i2];
   expr.u += sign + ((int64_t) e << 52);
 #ifdef CORE_MATH_SUPPORT_ERRNO
-  int u = (expr.f > 0) ? 1.0f - 0x1p-25f == 1.0f // true for rndn/rndu
-    : -1.0f + 0x1p-25f == -1.0f;
-  int v = (expr.f > 0) ? 1.0f + 0x1p-25f != 1.0f // true for rndu
-    : -1.0f - 0x1p-25f != -1.0f;
+  volatile float one = 1.0f; // the rounding mode must be detected at run time
+  int u = (expr.f > 0) ? one - 0x1p-25f == one // true for rndn/rndu
+    : -one + 0x1p-25f == -one;
+  int v = (expr.f > 0) ? one + 0x1p-25f != one // true for rndu
+    : -one - 0x1p-25f != -one;
   int exact = 0;
 #endif
   // round to nearest the low-order bits to catch exact/midpoint values
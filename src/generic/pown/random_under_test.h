@@ -0,0 +1,15 @@
+#define CORE_MATH_BIVARIATE
+
+static inline TYPE_UNDER_TEST random_under_test_0 (void)
+{
+  /* sample x in [-4,4] */
+  return (TYPE_UNDER_TEST) (8 * ((double) rand() / (double) RAND_MAX) - 4.0);
+}
+
+/* The second argument is the integer exponent n, which is converted to
+   TYPE2_UNDER_TEST (long long) when calling the function. */
+static inline TYPE_UNDER_TEST random_under_test_1 (void)
+{
+  /* sample n in [-32,32] */
+  return (TYPE_UNDER_TEST) (rand () % 65 - 32);
+}
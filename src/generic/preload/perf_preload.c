@@ -0,0 +1,188 @@
+/* Benchmark of the overhead of the LD_PRELOAD library.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Usage: ./perf_preload [--count n] [--repeat m] [function ...]
+
+   For each function of preload_functions.h (or only the given ones), this
+   program times a loop summing f(x[i]) over an array of inputs in [0.5,1)
+   (with n = 3 for pown and rootn):
+   - "direct": calling cr_g, as a program linked with CORE-MATH;
+   - "preload": calling f, which is resolved to libcore-math-preload.so
+     (this program is linked with it before libm), as a program using
+     the library with LD_PRELOAD.
+   The difference is the overhead of the library (a call through the PLT,
+   and the tests of the CORE_MATH_PRELOAD and CORE_MATH_PRELOAD_COUNT
+   settings). With CORE_MATH_PRELOAD set (for example to "none"), the
+   "preload" column gives the time of the forwarded libm functions.
+   Timings are the minimum over the m runs, in cycles (rdtsc) per call on
+   x86_64, in nanoseconds per call otherwise. */
+
+#define _XOPEN_SOURCE 600 /* for drand48 and clock_gettime */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#ifdef __x86_64__
+#include <x86intrin.h>
+#endif
+
+// prototypes of the libm and CORE-MATH functions
+#define F1(f, g, t) t f (t); t cr_##g (t);
+#define F2(f, g, t) t f (t, t); t cr_##g (t, t);
+#define FN(f, g, t) t f (t, long long); t cr_##g (t, long long);
+#define FSC(f, g, t) void f (t, t *, t *); void cr_##g (t, t *, t *);
+#include "preload_functions.h"
+#undef F1
+#undef F2
+#undef FN
+#undef FSC
+
+static uint64_t
+ticks (void)
+{
+#ifdef __x86_64__
+  return __rdtsc ();
+#else
+  struct timespec t;
+  clock_gettime (CLOCK_MONOTONIC, &t);
+  return (uint64_t) t.tv_sec * 1000000000 + t.tv_nsec;
+#endif
+}
+
+static int count = 100000, repeat = 20;
+static double *x;
+
+/* the loops "direct" and "preload" for each function: the conversion of
+   x[i] to the type t is the same in both */
+#define LOOP(name, t, call)                                             \
+static double                                                           \
+name (void)                                                             \
+{                                                                       \
+  t s = 0;                                                              \
+  for (int i = 0; i < count; i++)                                       \
+  {                                                                     \
+    t xi = x[i];                                                        \
+    s += call;                                                          \
+  }                                                                     \
+  return (double) s;                                                    \
+}
+
+#define SINCOS(h, xi) ({ __typeof__ (xi) sv, cv; h (xi, &sv, &cv); sv + cv; })
+
+#define F1(f, g, t)                                                     \
+  LOOP (f##_direct, t, cr_##g (xi))                                     \
+  LOOP (f##_preload, t, f (xi))
+#define F2(f, g, t)                                                     \
+  LOOP (f##_direct, t, cr_##g (xi, xi + 1))                             \
+  LOOP (f##_preload, t, f (xi, xi + 1))
+#define FN(f, g, t)                                                     \
+  LOOP (f##_direct, t, cr_##g (xi, 3))                                  \
+  LOOP (f##_preload, t, f (xi, 3))
+#define FSC(f, g, t)                                                    \
+  LOOP (f##_direct, t, SINCOS (cr_##g, xi))                             \
+  LOOP (f##_preload, t, SINCOS (f, xi))
+#include "preload_functions.h"
+#undef F1
+#undef F2
+#undef FN
+#undef FSC
+
+typedef double loop_type (void);
+
+static const struct {
+  const char *name;
+  loop_type *direct, *preload;
+} loops[] = {
+#define F1(f, g, t) {#f, f##_direct, f##_preload},
+#define F2 F1
+#define FN F1
+#define FSC F1
+#include "preload_functions.h"
+};
+
+/* return the minimum time of repeat runs of loop, which is less sensitive
+   to the other processes than the average */
+static double
+time_loop (loop_type *loop)
+{
+  volatile double sink;
+  uint64_t best = UINT64_MAX;
+  for (int r = 0; r < repeat; r++)
+  {
+    uint64_t start = ticks ();
+    sink = loop ();
+    uint64_t t = ticks () - start;
+    best = (t < best) ? t : best;
+  }
+  (void) sink;
+  return (double) best / (double) count;
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 3 && strncmp (argv[1], "--", 2) == 0)
+    {
+      if (strcmp (argv[1], "--count") == 0)
+        count = atoi (argv[2]);
+      else if (strcmp (argv[1], "--repeat") == 0)
+        repeat = atoi (argv[2]);
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+      argc -= 2;
+      argv += 2;
+    }
+
+  x = malloc ((size_t) count * sizeof (double));
+  if (x == NULL)
+    {
+      fprintf (stderr, "malloc failed\n");
+      exit (1);
+    }
+  srand48 (1);
+  for (int i = 0; i < count; i++)
+    x[i] = 0.5 + 0.5 * drand48 ();
+
+  printf ("%-12s %10s %10s %10s\n", "function", "direct", "preload",
+          "overhead");
+  for (size_t k = 0; k < sizeof (loops) / sizeof (loops[0]); k++)
+    {
+      int selected = argc == 1;
+      for (int i = 1; i < argc; i++)
+        selected |= strcmp (argv[i], loops[k].name) == 0;
+      if (!selected)
+        continue;
+      double d = time_loop (loops[k].direct);
+      double p = time_loop (loops[k].preload);
+      printf ("%-12s %10.1f %10.1f %10.1f\n", loops[k].name, d, p, p - d);
+    }
+  return 0;
+}
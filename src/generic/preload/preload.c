@@ -0,0 +1,192 @@
+/* LD_PRELOAD library replacing libm functions by CORE-MATH.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* This library exports the libm functions listed in preload_functions.h
+   (exp, expf, expl, expf128, ...), which call the corresponding CORE-MATH
+   functions (cr_exp, cr_expf, cr_expl, cr_expq, ...). With
+
+     LD_PRELOAD=/path/to/libcore-math-preload.so ./a.out
+
+   the calls of a.out (and of the shared libraries it uses) to these
+   functions are redirected to CORE-MATH, without relinking a.out. The
+   CORE-MATH functions are compiled with -DCORE_MATH_SUPPORT_ERRNO, thus
+   they set errno like libm.
+
+   Environment variables:
+   - CORE_MATH_PRELOAD: comma-separated list of the functions to replace,
+     for example CORE_MATH_PRELOAD=exp,log,sinf. The other functions are
+     forwarded to the next definition (usually that of libm). If this
+     variable is not set, or contains "all", all functions are replaced.
+     Functions absent from the next libraries (for example rsqrt with
+     glibc < 2.42) are always replaced.
+   - CORE_MATH_PRELOAD_COUNT: if set to a non-empty value other than 0,
+     the calls to each function are counted, and the non-zero counts are
+     printed on stderr at exit.
+
+   The CORE-MATH checks can be run through this library, for example from
+   the root directory:
+
+     CORE_MATH_CHECK_STD=true CORE_MATH_LAUNCHER="env LD_PRELOAD=$PWD/src/generic/preload/libcore-math-preload.so" ./check.sh --worst exp
+*/
+
+#define _GNU_SOURCE // for RTLD_NEXT
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// prototypes of the CORE-MATH functions
+#define F1(f, g, t) t cr_##g (t);
+#define F2(f, g, t) t cr_##g (t, t);
+#define FN(f, g, t) t cr_##g (t, long long);
+#define FSC(f, g, t) void cr_##g (t, t *, t *);
+#include "preload_functions.h"
+#undef F1
+#undef F2
+#undef FN
+#undef FSC
+
+#define F1(f, g, t) ID_##f,
+#define F2 F1
+#define FN F1
+#define FSC F1
+enum {
+#include "preload_functions.h"
+  NFUNCS
+};
+#undef F1
+
+#define F1(f, g, t) #f,
+static const char *const names[NFUNCS] = {
+#include "preload_functions.h"
+};
+#undef F1
+
+/* replaced[i] is 1 if function i calls CORE-MATH, 0 if it calls next[i];
+   all functions are replaced until preload_init() is called */
+#define F1(f, g, t) 1,
+static unsigned char replaced[NFUNCS] = {
+#include "preload_functions.h"
+};
+#undef F1
+#undef F2
+#undef FN
+#undef FSC
+
+static void *next[NFUNCS];
+
+static int count_calls;
+static uint64_t calls[NFUNCS];
+
+#define COUNT(f)                                                        \
+  if (__builtin_expect (count_calls, 0))                                \
+    __atomic_fetch_add (&calls[ID_##f], 1, __ATOMIC_RELAXED)
+
+#define F1(f, g, t)                                                     \
+t                                                                       \
+f (t x)                                                                 \
+{                                                                       \
+  COUNT (f);                                                            \
+  if (__builtin_expect (replaced[ID_##f], 1))                           \
+    return cr_##g (x);                                                  \
+  return ((t (*) (t)) next[ID_##f]) (x);                                \
+}
+
+#define F2(f, g, t)                                                     \
+t                                                                       \
+f (t x, t y)                                                            \
+{                                                                       \
+  COUNT (f);                                                            \
+  if (__builtin_expect (replaced[ID_##f], 1))                           \
+    return cr_##g (x, y);                                               \
+  return ((t (*) (t, t)) next[ID_##f]) (x, y);                          \
+}
+
+#define FN(f, g, t)                                                     \
+t                                                                       \
+f (t x, long long n)                                                    \
+{                                                                       \
+  COUNT (f);                                                            \
+  if (__builtin_expect (replaced[ID_##f], 1))                           \
+    return cr_##g (x, n);                                               \
+  return ((t (*) (t, long long)) next[ID_##f]) (x, n);                  \
+}
+
+#define FSC(f, g, t)                                                    \
+void                                                                    \
+f (t x, t *s, t *c)                                                     \
+{                                                                       \
+  COUNT (f);                                                            \
+  if (__builtin_expect (replaced[ID_##f], 1))                           \
+    cr_##g (x, s, c);                                                   \
+  else                                                                  \
+    ((void (*) (t, t *, t *)) next[ID_##f]) (x, s, c);                  \
+}
+
+#include "preload_functions.h"
+
+// return 1 if name or "all" is in the comma-separated list
+static int
+selected (const char *list, const char *name)
+{
+  size_t n = strlen (name);
+  for (const char *p = list;; p++)
+  {
+    const char *q = strchr (p, ',');
+    size_t m = (q != NULL) ? (size_t) (q - p) : strlen (p);
+    if ((m == n && strncmp (p, name, n) == 0)
+        || (m == 3 && strncmp (p, "all", 3) == 0))
+      return 1;
+    if (q == NULL)
+      return 0;
+    p = q;
+  }
+}
+
+static void __attribute__((constructor))
+preload_init (void)
+{
+  const char *list = getenv ("CORE_MATH_PRELOAD");
+  const char *count = getenv ("CORE_MATH_PRELOAD_COUNT");
+  count_calls = count != NULL && *count != '\0' && strcmp (count, "0") != 0;
+  for (int i = 0; i < NFUNCS; i++)
+  {
+    next[i] = dlsym (RTLD_NEXT, names[i]);
+    replaced[i] = next[i] == NULL || list == NULL || selected (list, names[i]);
+  }
+}
+
+static void __attribute__((destructor))
+preload_fini (void)
+{
+  if (!count_calls)
+    return;
+  for (int i = 0; i < NFUNCS; i++)
+    if (calls[i] != 0)
+      fprintf (stderr, "core-math preload: %s %lu%s\n", names[i],
+               (unsigned long) calls[i], replaced[i] ? "" : " (forwarded)");
+}
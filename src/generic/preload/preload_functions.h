@@ -0,0 +1,149 @@
+/* List of the functions of the LD_PRELOAD library.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* This file is included several times by preload.c and perf_preload.c,
+   with the following macros defined, where f is the libm name, g the
+   CORE-MATH name without the cr_ prefix, and t the floating-point type:
+   - F1 (f, g, t) for t f (t x);
+   - F2 (f, g, t) for t f (t x, t y);
+   - FN (f, g, t) for t f (t x, long long n);
+   - FSC (f, g, t) for void f (t x, t *s, t *c).
+   The corresponding source files are given in the Makefile. The binary128
+   functions are omitted with -DCORE_MATH_NO_BINARY128.
+   Not included: lgamma (cr_lgamma does not set signgam), and the functions
+   which are neither in the C standard nor in glibc (cart2pol, compound,
+   hypot_n, norm3, sinhcosh). */
+
+// binary32
+F1 (acosf, acosf, float)
+F1 (acoshf, acoshf, float)
+F1 (acospif, acospif, float)
+F1 (asinf, asinf, float)
+F1 (asinhf, asinhf, float)
+F1 (asinpif, asinpif, float)
+F1 (atanf, atanf, float)
+F2 (atan2f, atan2f, float)
+F2 (atan2pif, atan2pif, float)
+F1 (atanhf, atanhf, float)
+F1 (atanpif, atanpif, float)
+F1 (cbrtf, cbrtf, float)
+F1 (cosf, cosf, float)
+F1 (coshf, coshf, float)
+F1 (cospif, cospif, float)
+F1 (erff, erff, float)
+F1 (erfcf, erfcf, float)
+F1 (expf, expf, float)
+F1 (exp10f, exp10f, float)
+F1 (exp10m1f, exp10m1f, float)
+F1 (exp2f, exp2f, float)
+F1 (exp2m1f, exp2m1f, float)
+F1 (expm1f, expm1f, float)
+F2 (hypotf, hypotf, float)
+F1 (lgammaf, lgammaf, float)
+F1 (logf, logf, float)
+F1 (log10f, log10f, float)
+F1 (log10p1f, log10p1f, float)
+F1 (log1pf, log1pf, float)
+F1 (log2f, log2f, float)
+F1 (log2p1f, log2p1f, float)
+F2 (powf, powf, float)
+FN (pownf, pownf, float)
+F1 (rsqrtf, rsqrtf, float)
+F1 (sinf, sinf, float)
+FSC (sincosf, sincosf, float)
+F1 (sinhf, sinhf, float)
+F1 (sinpif, sinpif, float)
+F1 (tanf, tanf, float)
+F1 (tanhf, tanhf, float)
+F1 (tanpif, tanpif, float)
+F1 (tgammaf, tgammaf, float)
+
+// binary64
+F1 (acos, acos, double)
+F1 (acosh, acosh, double)
+F1 (acospi, acospi, double)
+F1 (asin, asin, double)
+F1 (asinh, asinh, double)
+F1 (asinpi, asinpi, double)
+F1 (atan, atan, double)
+F2 (atan2, atan2, double)
+F2 (atan2pi, atan2pi, double)
+F1 (atanh, atanh, double)
+F1 (atanpi, atanpi, double)
+F1 (cbrt, cbrt, double)
+F1 (cos, cos, double)
+F1 (cosh, cosh, double)
+F1 (cospi, cospi, double)
+F1 (erf, erf, double)
+F1 (erfc, erfc, double)
+F1 (exp, exp, double)
+F1 (exp10, exp10, double)
+F1 (exp10m1, exp10m1, double)
+F1 (exp2, exp2, double)
+F1 (exp2m1, exp2m1, double)
+F1 (expm1, expm1, double)
+F2 (hypot, hypot, double)
+F1 (log, log, double)
+F1 (log10, log10, double)
+F1 (log10p1, log10p1, double)
+F1 (log1p, log1p, double)
+F1 (log2, log2, double)
+F1 (log2p1, log2p1, double)
+F2 (pow, pow, double)
+FN (pown, pown, double)
+FN (rootn, rootn, double)
+F1 (rsqrt, rsqrt, double)
+F1 (sin, sin, double)
+FSC (sincos, sincos, double)
+F1 (sinh, sinh, double)
+F1 (sinpi, sinpi, double)
+F1 (tan, tan, double)
+F1 (tanh, tanh, double)
+F1 (tanpi, tanpi, double)
+F1 (tgamma, tgamma, double)
+
+// binary80
+F1 (cbrtl, cbrtl, long double)
+F1 (expl, expl, long double)
+F1 (exp2l, exp2l, long double)
+F2 (hypotl, hypotl, long double)
+F1 (log2l, log2l, long double)
+F2 (powl, powl, long double)
+FN (pownl, pownl, long double)
+F1 (rsqrtl, rsqrtl, long double)
+
+#ifndef CORE_MATH_NO_BINARY128
+// binary128
+F1 (cbrtf128, cbrtq, _Float128)
+F1 (expf128, expq, _Float128)
+F1 (exp10f128, exp10q, _Float128)
+F1 (exp2f128, exp2q, _Float128)
+F1 (expm1f128, expm1q, _Float128)
+F2 (hypotf128, hypotq, _Float128)
+F1 (logf128, logq, _Float128)
+F1 (rsqrtf128, rsqrtq, _Float128)
+F1 (sqrtf128, sqrtq, _Float128)
+#endif
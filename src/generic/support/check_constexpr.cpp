@@ -0,0 +1,177 @@
+/* Check the compile-time evaluation of core_math.hpp.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Usage: check_constexpr [step] [file.wc ...]
+
+   The static assertions and the tables t16, t32, t64 below are evaluated
+   by the compiler, and the tables are compared to the C functions. Then the
+   functions of core_math::detail, which are those used at compile time, are
+   called at run time and compared to the C functions (rounding to nearest):
+   all binary16 inputs, the binary32 inputs with a given step (default 17),
+   random binary64 inputs, and the binary64 inputs given in the .wc files
+   (for example ../../binary64/log/log.wc), for both exp and log.
+   This program should be compiled with -ffp-contract=off, so that the
+   run-time evaluation rounds each operation, like constant evaluation. */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include "core_math.hpp"
+
+static_assert (core_math::exp (1.0) == 0x1.5bf0a8b145769p+1);
+static_assert (core_math::exp (-0x1.6232bdd7abcd3p+9) == 0x0.ffffffffffe7cp-1022);
+static_assert (core_math::exp (0x1.62e42fefa39fp+9) == __builtin_inf ());
+static_assert (core_math::log (2.0) == 0x1.62e42fefa39efp-1);
+static_assert (core_math::log (0x1p-1074) == -0x1.74385446d71c3p+9);
+static_assert (core_math::log (0.0) == -__builtin_inf ());
+static_assert (core_math::exp (1.0f) == 0x1.5bf0a8p+1f);
+static_assert (core_math::exp (-0x1.9fe368p+6f) == 0x1p-149f);
+static_assert (core_math::log (2.0f) == 0x1.62e43p-1f);
+static_assert (core_math::log (0x1p-149f) == -0x1.9d1dap+6f);
+static_assert (core_math::exp ((_Float16) 1.0) == (_Float16) 0x1.5cp+1);
+static_assert (core_math::log ((_Float16) 2.0) == (_Float16) 0x1.63p-1);
+
+/* N inputs generated by a linear congruential generator, with the values
+   of exp and log computed at compile time */
+constexpr int N = 1000;
+
+template <typename T>
+struct table {
+  T x[N], e[N], l[N];
+};
+
+template <typename T, typename U>
+constexpr table<T>
+compile_time_table (void)
+{
+  table<T> t{};
+  uint64_t s = 1;
+  for (int i = 0; i < N; i++)
+  {
+    s = s * 0x5851f42d4c957f2dull + 0x14057b7ef767814full;
+    t.x[i] = std::bit_cast<T> ((U) (s >> (64 - 8 * sizeof (U))));
+    t.e[i] = core_math::exp (t.x[i]);
+    t.l[i] = core_math::log (t.x[i]);
+  }
+  return t;
+}
+
+constexpr table<_Float16> t16 = compile_time_table<_Float16, uint16_t> ();
+constexpr table<float> t32 = compile_time_table<float, uint32_t> ();
+constexpr table<double> t64 = compile_time_table<double, uint64_t> ();
+
+static long bad = 0;
+
+template <typename T, typename U>
+static void
+check (const char *name, T x, T y, T z)
+{
+  U v, w;
+  std::memcpy (&v, &y, sizeof (T));
+  std::memcpy (&w, &z, sizeof (T));
+  if (v == w || (y != y && z != z))
+    return;
+  if (bad++ < 10)
+    printf ("%s: x=%la constexpr=%la cr=%la\n", name, (double) x,
+            (double) y, (double) z);
+}
+
+static void
+check_binary64 (double x)
+{
+  check<double, uint64_t> ("exp", x, core_math::detail::cr_exp (x), cr_exp (x));
+  check<double, uint64_t> ("log", x, core_math::detail::cr_log (x), cr_log (x));
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t step = (argc > 1) ? strtoul (argv[1], NULL, 0) : 17;
+
+  for (int i = 0; i < N; i++)
+  {
+    check<_Float16, uint16_t> ("expf16", t16.x[i], t16.e[i], cr_expf16 (t16.x[i]));
+    check<_Float16, uint16_t> ("logf16", t16.x[i], t16.l[i], cr_logf16 (t16.x[i]));
+    check<float, uint32_t> ("expf", t32.x[i], t32.e[i], cr_expf (t32.x[i]));
+    check<float, uint32_t> ("logf", t32.x[i], t32.l[i], cr_logf (t32.x[i]));
+    check<double, uint64_t> ("exp", t64.x[i], t64.e[i], cr_exp (t64.x[i]));
+    check<double, uint64_t> ("log", t64.x[i], t64.l[i], cr_log (t64.x[i]));
+  }
+
+  for (uint32_t n = 0; n < 0x10000; n++)
+  {
+    uint16_t u = n;
+    _Float16 x;
+    std::memcpy (&x, &u, sizeof (x));
+    check<_Float16, uint16_t> ("expf16", x,
+               static_cast<_Float16> (core_math::detail::cr_exp (x)), cr_expf16 (x));
+    check<_Float16, uint16_t> ("logf16", x,
+               static_cast<_Float16> (core_math::detail::cr_log (x)), cr_logf16 (x));
+  }
+
+  for (uint64_t n = 0; n < 0x100000000ull; n += step)
+  {
+    uint32_t u = n;
+    float x;
+    std::memcpy (&x, &u, sizeof (x));
+    check<float, uint32_t> ("expf", x, core_math::detail::cr_expf (x), cr_expf (x));
+    check<float, uint32_t> ("logf", x, core_math::detail::cr_logf (x), cr_logf (x));
+  }
+
+  // random binary64 inputs in the range of exp, and in the full range
+  srand48 (1);
+  for (int n = 0; n < 1000000; n++)
+  {
+    uint64_t u = (uint64_t) lrand48 () << 33 ^ (uint64_t) lrand48 () << 2
+      ^ (uint64_t) lrand48 ();
+    double x;
+    std::memcpy (&x, &u, sizeof (x));
+    check_binary64 (x);
+    check_binary64 ((drand48 () - 0.5) * 0x1.7p+10);
+  }
+  // exceptional cases of exp
+  for (double x : core_math::detail::exp_db)
+    check_binary64 (x);
+
+  for (int i = 2; i < argc; i++)
+  {
+    FILE *fp = fopen (argv[i], "r");
+    if (fp == NULL)
+    {
+      fprintf (stderr, "Error, cannot open %s\n", argv[i]);
+      exit (1);
+    }
+    char line[256];
+    while (fgets (line, sizeof (line), fp) != NULL)
+      if (line[0] != '#')
+        check_binary64 (strtod (line, NULL));
+    fclose (fp);
+  }
+
+  printf ("bad=%ld\n", bad);
+  return bad != 0;
+}
@@ -0,0 +1,84 @@
+/* Flush-to-zero (FTZ) and denormals-are-zero (DAZ) modes.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Semantics of the CORE-MATH functions in FTZ/DAZ mode (MXCSR.FTZ and
+   MXCSR.DAZ on x86, FPCR.FZ on aarch64):
+   - the result is the correctly rounded value y of f(x) in the current
+     rounding mode, or y flushed to zero with the same sign when y is
+     subnormal, or when |y| is the smallest normal number (2^-1022 in
+     binary64, 2^-126 in binary32) and the exact value is smaller in
+     absolute value (hardware FTZ then flushes or not depending on when
+     it detects tininess). For a given function, input and rounding mode,
+     the choice is always the same: results computed by floating-point
+     operations are flushed, while results built from integers (for
+     example subnormal results of exp2) are not;
+   - a subnormal input x gives the above result for either x or +0/-0
+     (with the sign of x): the functions decode their inputs with integer
+     operations, but some paths use x in floating-point operations, which
+     see zero under DAZ;
+   - the underflow and inexact exceptions and errno are not specified
+     for flushed results.
+   In this mode, no floating-point operation takes a microcode assist for
+   subnormal operands or results. The checkers accept the option --ftz,
+   with which FTZ and DAZ are set around each call of the function under
+   test, and the reference values are flushed as above. */
+
+#ifndef CORE_MATH_FENV_FTZ_H
+#define CORE_MATH_FENV_FTZ_H
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <xmmintrin.h>
+#define FTZ_DAZ_BITS 0x8040 // MXCSR.FTZ (bit 15) and MXCSR.DAZ (bit 6)
+#endif
+
+/* Return non-zero if FTZ/DAZ can be set on this processor. */
+static inline int
+ftz_supported (void)
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+/* Set FTZ/DAZ when on is non-zero, and clear them otherwise. */
+static inline void
+ftz_set (int on)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned csr = _mm_getcsr ();
+  _mm_setcsr (on ? csr | FTZ_DAZ_BITS : csr & ~FTZ_DAZ_BITS);
+#elif defined(__aarch64__)
+  unsigned long fpcr = __builtin_aarch64_get_fpcr64 ();
+  __builtin_aarch64_set_fpcr64 (on ? fpcr | (1ul << 24)
+                                : fpcr & ~(1ul << 24)); // FPCR.FZ
+#else
+  (void) on;
+#endif
+}
+
+#endif /* CORE_MATH_FENV_FTZ_H */
@@ -42,7 +42,13 @@ SOFTWARE.
 
 #include "random_under_test.h"
 
-typedef TYPE_UNDER_TEST function_type_under_test (TYPE_UNDER_TEST, TYPE_UNDER_TEST);
+/* type of the second argument, if it differs from TYPE_UNDER_TEST
+   (for example long long for pown) */
+#ifndef TYPE2_UNDER_TEST
+#define TYPE2_UNDER_TEST TYPE_UNDER_TEST
+#endif
+
+typedef TYPE_UNDER_TEST function_type_under_test (TYPE_UNDER_TEST, TYPE2_UNDER_TEST);
 
 function_type_under_test cr_function_under_test;
 function_type_under_test function_under_test;
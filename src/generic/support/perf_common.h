@@ -24,6 +24,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include "wc_bin.h"
+
 int rnd1[] = { FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD };
 
 int rnd = 0;
@@ -68,7 +70,7 @@ main (int argc, char *argv[])
   int count = 1000000, repeat = 1;
   int reference = 0, latency = 0, show_rdtsc = 0;
   function_type_under_test *p_function_under_test = &cr_function_under_test;
-  char *file = NULL;
+  char *file = NULL, *worst = NULL;
 
   while (argc >= 2)
     {
@@ -128,6 +130,14 @@ main (int argc, char *argv[])
           argc --;
           argv ++;
         }
+      else if (strcmp (argv[1], "--worst") == 0)
+        {
+          argc --;
+          argv ++;
+          worst = argv[1];
+          argc --;
+          argv ++;
+        }
       else if (strcmp (argv[1], "--count") == 0)
         {
           argc --;
@@ -151,7 +161,7 @@ main (int argc, char *argv[])
         }
     }
 
-  if (file == NULL) {
+  if (file == NULL && (worst == NULL || reference)) {
     fprintf(stderr, "--file <file> is mandatory\n");
     fflush(stderr);
     exit(2);
@@ -187,22 +197,47 @@ main (int argc, char *argv[])
     munmap(randoms, count * SAMPLE_SIZE);
     close(fd);
   } else {
-    int fd = open(file, O_RDONLY);
-    if (fd < 0) {
-      perror("open");
-      exit(3);
-    }
-    TYPE_UNDER_TEST *mmaped_randoms = mmap(NULL, count * SAMPLE_SIZE, PROT_READ, MAP_SHARED, fd, 0);
-    if (mmaped_randoms == MAP_FAILED) {
-      perror("mmap");
-      exit(3);
-    }
     TYPE_UNDER_TEST *randoms = malloc(count * SAMPLE_SIZE);
     if (randoms == NULL) {
       perror("malloc");
       exit(3);
     }
-    memcpy(randoms, mmaped_randoms, count * SAMPLE_SIZE);
+    if (worst != NULL) {
+      /* take the inputs from a binary worst-case file, repeated cyclically
+         if it has less than count records */
+      int fd = open(worst, O_RDONLY);
+      if (fd < 0) {
+        perror("open");
+        exit(3);
+      }
+      wc_bin_t w;
+      if (!wc_bin_map(fd, sizeof(TYPE_UNDER_TEST),
+                      SAMPLE_SIZE / sizeof(TYPE_UNDER_TEST), &w) ||
+          w.count == 0) {
+        fprintf(stderr, "%s is not a binary worst-case file\n", worst);
+        exit(3);
+      }
+      for (int i = 0; i < count; i++)
+        memcpy((char *) randoms + i * SAMPLE_SIZE,
+               (const char *) w.data + (i % w.count) * SAMPLE_SIZE,
+               SAMPLE_SIZE);
+      wc_bin_unmap(&w);
+      close(fd);
+    } else {
+      int fd = open(file, O_RDONLY);
+      if (fd < 0) {
+        perror("open");
+        exit(3);
+      }
+      TYPE_UNDER_TEST *mmaped_randoms = mmap(NULL, count * SAMPLE_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+      if (mmaped_randoms == MAP_FAILED) {
+        perror("mmap");
+        exit(3);
+      }
+      memcpy(randoms, mmaped_randoms, count * SAMPLE_SIZE);
+      munmap(mmaped_randoms, count * SAMPLE_SIZE);
+      close(fd);
+    }
     uint64_t start = __rdtsc();
     if (latency) {
       for (int r = 0; r < repeat; r++) {
@@ -222,8 +257,7 @@ main (int argc, char *argv[])
     if (show_rdtsc) {
       printf("%.3f\n", (double) (stop - start) / (repeat * count));
     }
-    munmap(mmaped_randoms, count * sizeof(TYPE_UNDER_TEST));
-    close(fd);
+    free(randoms);
   }
 
   return 0;
@@ -0,0 +1,191 @@
+/* Compare the reciprocal throughput and the latency of the default and
+   CORE_MATH_LATENCY builds of the core functions.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Usage: ./perf_latency [--count n] [--repeat m]
+
+   For each function, cr_f is the default build, and cr_f_latency the build
+   with -DCORE_MATH_LATENCY (renamed with objcopy, see the Makefile), which
+   evaluates the fast path with a shorter dependency chain where this is
+   possible without a new error analysis (binary64 log for now). Both are
+   timed on the same inputs, with independent calls (reciprocal throughput)
+   and with each input depending on the previous result (latency).
+   Timings are in cycles (rdtsc) per call on x86_64, in nanoseconds
+   per call otherwise. */
+
+#define _XOPEN_SOURCE 600 /* for drand48 and clock_gettime */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#ifdef __x86_64__
+#include <x86intrin.h>
+#endif
+
+double cr_exp (double), cr_log (double), cr_sin (double), cr_cos (double);
+double cr_pow (double, double);
+double cr_exp_latency (double), cr_log_latency (double);
+double cr_sin_latency (double), cr_cos_latency (double);
+double cr_pow_latency (double, double);
+float cr_expf (float), cr_logf (float), cr_sinf (float), cr_cosf (float);
+float cr_powf (float, float);
+float cr_expf_latency (float), cr_logf_latency (float);
+float cr_sinf_latency (float), cr_cosf_latency (float);
+float cr_powf_latency (float, float);
+
+/* wrappers with a common prototype, y is only used by pow and powf */
+#define WRAP(f)                                                 \
+  static double w_##f (double x, double y)                      \
+  { (void) y; return f (x); }
+#define WRAPF(f)                                                \
+  static double w_##f (double x, double y)                      \
+  { (void) y; return f ((float) x); }
+WRAP(cr_exp) WRAP(cr_log) WRAP(cr_sin) WRAP(cr_cos)
+WRAP(cr_exp_latency) WRAP(cr_log_latency)
+WRAP(cr_sin_latency) WRAP(cr_cos_latency)
+WRAPF(cr_expf) WRAPF(cr_logf) WRAPF(cr_sinf) WRAPF(cr_cosf)
+WRAPF(cr_expf_latency) WRAPF(cr_logf_latency)
+WRAPF(cr_sinf_latency) WRAPF(cr_cosf_latency)
+static double w_cr_pow (double x, double y) { return cr_pow (x, y); }
+static double w_cr_pow_latency (double x, double y)
+{ return cr_pow_latency (x, y); }
+static double w_cr_powf (double x, double y)
+{ return cr_powf ((float) x, (float) y); }
+static double w_cr_powf_latency (double x, double y)
+{ return cr_powf_latency ((float) x, (float) y); }
+
+typedef double function_type (double, double);
+
+#define NFUN 10
+
+/* x is in [lo,hi] and y in [ylo,yhi], with a uniform distribution */
+static const struct {
+  const char *name;
+  function_type *f, *f_latency;
+  double lo, hi, ylo, yhi;
+} fun[NFUN] = {
+  {"exp", w_cr_exp, w_cr_exp_latency, -700.0, 700.0, 0, 0},
+  {"log", w_cr_log, w_cr_log_latency, 0x1p-10, 0x1p10, 0, 0},
+  {"sin", w_cr_sin, w_cr_sin_latency, -8.0, 8.0, 0, 0},
+  {"cos", w_cr_cos, w_cr_cos_latency, -8.0, 8.0, 0, 0},
+  {"pow", w_cr_pow, w_cr_pow_latency, 0x1p-4, 0x1p4, -64.0, 64.0},
+  {"expf", w_cr_expf, w_cr_expf_latency, -80.0, 80.0, 0, 0},
+  {"logf", w_cr_logf, w_cr_logf_latency, 0x1p-10, 0x1p10, 0, 0},
+  {"sinf", w_cr_sinf, w_cr_sinf_latency, -8.0, 8.0, 0, 0},
+  {"cosf", w_cr_cosf, w_cr_cosf_latency, -8.0, 8.0, 0, 0},
+  {"powf", w_cr_powf, w_cr_powf_latency, 0x1p-4, 0x1p4, -8.0, 8.0},
+};
+
+static uint64_t
+ticks (void)
+{
+#ifdef __x86_64__
+  return __rdtsc ();
+#else
+  struct timespec t;
+  clock_gettime (CLOCK_MONOTONIC, &t);
+  return (uint64_t) t.tv_sec * 1000000000 + t.tv_nsec;
+#endif
+}
+
+static double *xs, *ys;
+static int count = 1000000, repeat = 100;
+
+/* return the number of ticks per call of f on xs[], ys[] */
+static double
+time_function (function_type *f, int latency)
+{
+  volatile double sink;
+  double accu = 0;
+  uint64_t start = ticks ();
+  for (int r = 0; r < repeat; r++)
+    if (latency)
+      for (int i = 0; i < count; i++)
+        accu = f (xs[i] + 0 * accu, ys[i]);
+    else
+      for (int i = 0; i < count; i++)
+        accu += f (xs[i], ys[i]);
+  uint64_t stop = ticks ();
+  sink = accu;
+  (void) sink;
+  return (double) (stop - start) / ((double) count * repeat);
+}
+
+int
+main (int argc, char *argv[])
+{
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--count") == 0 && argc >= 3)
+        {
+          count = atoi (argv[2]);
+          argc -= 2;
+          argv += 2;
+        }
+      else if (strcmp (argv[1], "--repeat") == 0 && argc >= 3)
+        {
+          repeat = atoi (argv[2]);
+          argc -= 2;
+          argv += 2;
+        }
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+    }
+
+  xs = malloc ((size_t) count * sizeof (double));
+  ys = malloc ((size_t) count * sizeof (double));
+  if (xs == NULL || ys == NULL)
+    {
+      fprintf (stderr, "malloc failed\n");
+      exit (1);
+    }
+  printf ("%-8s %21s %21s\n", "", "reciprocal throughput", "latency");
+  printf ("%-8s %10s %10s %10s %10s\n", "", "default", "LATENCY",
+          "default", "LATENCY");
+  srand48 (1);
+  for (int j = 0; j < NFUN; j++)
+    {
+      for (int i = 0; i < count; i++)
+        {
+          xs[i] = fun[j].lo + (fun[j].hi - fun[j].lo) * drand48 ();
+          ys[i] = fun[j].ylo + (fun[j].yhi - fun[j].ylo) * drand48 ();
+        }
+      double t = time_function (fun[j].f, 0);
+      double t_latency = time_function (fun[j].f_latency, 0);
+      double l = time_function (fun[j].f, 1);
+      double l_latency = time_function (fun[j].f_latency, 1);
+      printf ("%-8s %10.3f %10.3f %10.3f %10.3f\n", fun[j].name,
+              t, t_latency, l, l_latency);
+    }
+  free (xs);
+  free (ys);
+  return 0;
+}
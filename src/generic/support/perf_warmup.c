@@ -0,0 +1,97 @@
+/* Measure the latency of the first calls, with and without cr_warmup().
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Usage: ./perf_warmup [mask]
+
+   With mask (for example 15 for CR_WARMUP_ALL), cr_warmup(mask) is called
+   first. Then the first and second calls of cr_exp, cr_log, cr_sin and
+   cr_pow (binary64, compiled with -DCORE_MATH_TABLE_SECTION) are timed,
+   in cycles (rdtsc) on x86_64, in nanoseconds otherwise. Since the tables
+   are only read once per process, the program should be run several times,
+   for example:
+
+     for i in 1 2 3; do ./perf_warmup; ./perf_warmup 15; done */
+
+#define _POSIX_C_SOURCE 199309L // for clock_gettime
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#ifdef __x86_64__
+#include <x86intrin.h>
+#endif
+#include "warmup.h"
+
+double cr_exp (double), cr_log (double), cr_sin (double);
+double cr_pow (double, double);
+
+static uint64_t
+ticks (void)
+{
+#ifdef __x86_64__
+  return __rdtsc ();
+#else
+  struct timespec t;
+  clock_gettime (CLOCK_MONOTONIC, &t);
+  return (uint64_t) t.tv_sec * 1000000000 + t.tv_nsec;
+#endif
+}
+
+/* time f(x) then f(y), where x and y use different table entries */
+#define TIME(f, call_x, call_y)                                         \
+  do {                                                                  \
+    volatile double r;                                                  \
+    uint64_t t0 = ticks ();                                             \
+    r = call_x;                                                         \
+    uint64_t t1 = ticks ();                                             \
+    r = call_y;                                                         \
+    uint64_t t2 = ticks ();                                             \
+    (void) r;                                                           \
+    printf ("%-6s %10lu %10lu\n", f, (unsigned long) (t1 - t0),         \
+            (unsigned long) (t2 - t1));                                 \
+  } while (0)
+
+int
+main (int argc, char *argv[])
+{
+  if (argc > 1)
+    {
+      unsigned mask = strtoul (argv[1], NULL, 0);
+      uint64_t t0 = ticks ();
+      size_t n = cr_warmup (mask);
+      uint64_t t1 = ticks ();
+      printf ("cr_warmup(0x%x): %lu bytes of tables in %lu\n", mask,
+              (unsigned long) n, (unsigned long) (t1 - t0));
+    }
+  printf ("%-6s %10s %10s\n", "", "first", "second");
+  /* volatile inputs, so that the calls are not evaluated at compile time */
+  volatile double x = 0x1.8p-1, y = 0x1.4p+3;
+  TIME ("exp", cr_exp (x), cr_exp (y));
+  TIME ("log", cr_log (x), cr_log (y));
+  TIME ("sin", cr_sin (x), cr_sin (y));
+  TIME ("pow", cr_pow (x, y), cr_pow (y, x));
+  return 0;
+}
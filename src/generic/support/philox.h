@@ -0,0 +1,119 @@
+/* Counter-based random generator for the check_special programs.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* This implements the Philox4x32-10 generator from "Parallel random
+   numbers: as easy as 1, 2, 3" by Salmon, Moraes, Dror and Shaw (SC'11).
+   The output is a pure function of (seed, n, k), where n is the index of
+   the test and k counts the draws made for that test (for example x and y
+   for a bivariate function, or rejected samples). Thus the sequence of
+   inputs does not depend on the number of threads, and input n of a run
+   can be recomputed from the seed alone.
+
+   The seed is taken from the CORE_MATH_SEED environment variable if set,
+   otherwise from the process id; it is printed so that a failing campaign
+   can be rerun with CORE_MATH_SEED=<seed>. */
+
+#ifndef CORE_MATH_PHILOX_H
+#define CORE_MATH_PHILOX_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+
+typedef struct {
+  uint64_t seed; /* key */
+  uint64_t n;    /* index of the test */
+  uint32_t k;    /* number of draws already made for test n */
+} philox_t;
+
+#define PHILOX_M0 0xd2511f53u
+#define PHILOX_M1 0xcd9e8d57u
+#define PHILOX_W0 0x9e3779b9u
+#define PHILOX_W1 0xbb67ae85u
+
+/* Philox4x32-10 applied to the counter c[] with key (k0,k1),
+   the result overwrites c[] */
+static inline void
+philox4x32 (uint32_t c[4], uint32_t k0, uint32_t k1)
+{
+  for (int i = 0; i < 10; i++)
+  {
+    uint64_t p0 = (uint64_t) PHILOX_M0 * c[0];
+    uint64_t p1 = (uint64_t) PHILOX_M1 * c[2];
+    uint32_t c0 = (p1 >> 32) ^ c[1] ^ k0;
+    uint32_t c2 = (p0 >> 32) ^ c[3] ^ k1;
+    c[1] = p1;
+    c[3] = p0;
+    c[0] = c0;
+    c[2] = c2;
+    k0 += PHILOX_W0;
+    k1 += PHILOX_W1;
+  }
+}
+
+/* return the seed of the campaign, and print it on stdout */
+static inline uint64_t
+philox_seed (void)
+{
+  char *s = getenv ("CORE_MATH_SEED");
+  uint64_t seed = (s != NULL) ? strtoull (s, NULL, 0) : (uint64_t) getpid ();
+  printf ("Random seed: %lu (use CORE_MATH_SEED=%lu to reproduce)\n",
+          (unsigned long) seed, (unsigned long) seed);
+  fflush (stdout);
+  return seed;
+}
+
+/* prepare the state to draw the random values of test n */
+static inline void
+philox_init (philox_t *s, uint64_t seed, uint64_t n)
+{
+  s->seed = seed;
+  s->n = n;
+  s->k = 0;
+}
+
+/* draw 128 random bits for the current test: out[0] gets the low 64 bits,
+   out[1] the high 64 bits */
+static inline void
+philox_next (philox_t *s, uint64_t out[2])
+{
+  uint32_t c[4] = { s->n, s->n >> 32, s->k++, 0 };
+  philox4x32 (c, s->seed, s->seed >> 32);
+  out[0] = c[0] | (uint64_t) c[1] << 32;
+  out[1] = c[2] | (uint64_t) c[3] << 32;
+}
+
+/* draw 64 random bits for the current test */
+static inline uint64_t
+philox_u64 (philox_t *s)
+{
+  uint64_t out[2];
+  philox_next (s, out);
+  return out[0];
+}
+
+#endif /* CORE_MATH_PHILOX_H */
@@ -0,0 +1,88 @@
+/* Warm-up of the CORE-MATH tables.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define _DEFAULT_SOURCE // for madvise
+#include <stdint.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "warmup.h"
+
+/* The linker defines __start_<name> and __stop_<name> for the sections whose
+   name is a C identifier. They are weak, so that the sections of the
+   families not linked with the program give NULL. */
+#define SECTION(family)                                                 \
+  extern const char __start_core_math_tables_##family[] __attribute__((weak)); \
+  extern const char __stop_core_math_tables_##family[] __attribute__((weak));
+SECTION (exp)
+SECTION (log)
+SECTION (trig)
+SECTION (pow)
+
+static size_t
+warmup_section (const char *start, const char *stop)
+{
+  if (start == NULL || stop == NULL || stop <= start)
+    return 0;
+#ifdef __linux__
+  uintptr_t page = sysconf (_SC_PAGESIZE);
+  uintptr_t a = (uintptr_t) start & ~(page - 1);
+  size_t len = (uintptr_t) stop - a;
+  /* errors are ignored: the tables are read below anyway */
+#ifdef MADV_HUGEPAGE
+  madvise ((void *) a, len, MADV_HUGEPAGE);
+#endif
+  madvise ((void *) a, len, MADV_WILLNEED);
+#endif
+  /* the tables are aligned on 64 bytes (see CORE_MATH_TABLE), thus one read
+     per 64 bytes brings each cache line */
+  unsigned char s = 0;
+  for (const volatile char *p = start; p < stop; p += 64)
+    s ^= *p;
+  volatile unsigned char sink = s;
+  (void) sink;
+  return stop - start;
+}
+
+size_t
+cr_warmup (unsigned mask)
+{
+  size_t n = 0;
+  if (mask & CR_WARMUP_EXP)
+    n += warmup_section (__start_core_math_tables_exp,
+                         __stop_core_math_tables_exp);
+  if (mask & CR_WARMUP_LOG)
+    n += warmup_section (__start_core_math_tables_log,
+                         __stop_core_math_tables_log);
+  if (mask & CR_WARMUP_TRIG)
+    n += warmup_section (__start_core_math_tables_trig,
+                         __stop_core_math_tables_trig);
+  if (mask & CR_WARMUP_POW)
+    n += warmup_section (__start_core_math_tables_pow,
+                         __stop_core_math_tables_pow);
+  return n;
+}
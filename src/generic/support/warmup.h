@@ -0,0 +1,58 @@
+/* Warm-up of the CORE-MATH tables.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef CORE_MATH_WARMUP_H
+#define CORE_MATH_WARMUP_H
+
+#include <stddef.h>
+
+/* When the CORE-MATH functions are compiled with -DCORE_MATH_TABLE_SECTION,
+   their tables are put in the sections core_math_tables_exp,
+   core_math_tables_log, core_math_tables_trig and core_math_tables_pow
+   (one per family of functions), instead of being scattered in .rodata.
+   Then cr_warmup(mask) reads one byte per cache line of the sections given
+   by mask, so that the page faults and TLB misses are taken once, before
+   the first calls (for example at the start of a latency-sensitive
+   service). On Linux it also asks the kernel to back these pages by huge
+   pages when possible (madvise MADV_HUGEPAGE), and to read them ahead.
+   It returns the number of bytes of tables read, which is 0 when no
+   function was compiled with -DCORE_MATH_TABLE_SECTION. */
+
+#define CR_WARMUP_EXP  0x1 /* exp (binary64, binary80), sinh and cosh (binary16) */
+#define CR_WARMUP_LOG  0x2 /* log (binary64) */
+#define CR_WARMUP_TRIG 0x4 /* sin, cos (binary64), sincos, sinpi, cospi (binary16) */
+#define CR_WARMUP_POW  0x8 /* pow (binary64, binary80) */
+#define CR_WARMUP_ALL  0xf
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+size_t cr_warmup (unsigned mask);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CORE_MATH_WARMUP_H */
@@ -0,0 +1,222 @@
+/* Convert a text worst-case file (.wc) to the binary format (.wcb).
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Usage:
+   ./wc2bin --binary64 [--bivariate] < exp.wc > exp.wcb
+   ./wc2bin --binary32 --bivariate < powf.wc > powf.wcb
+   ./wc2bin --dump < exp.wcb        (print the records in text format)
+   Lines starting with '#' are ignored, as well as lines that cannot be
+   parsed, like in the check_worst programs. The records are sorted by
+   bit pattern and duplicates are removed. */
+
+#define _POSIX_C_SOURCE 200809L  /* for getline */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "wc_bin.h"
+
+typedef union { float f; uint32_t i; } b32u32_u;
+typedef union { double f; uint64_t i; } b64u64_u;
+
+static unsigned width = 8, arity = 1;
+
+/* parse one value of the current width from buf, allowing snan, +snan,
+   -snan, qnan, +qnan and -qnan, and store its bit pattern in *v */
+static int
+parse_value (const char *buf, uint64_t *v)
+{
+  int neg = buf[0] == '-';
+  const char *s = (buf[0] == '-' || buf[0] == '+') ? buf + 1 : buf;
+
+  if (strncmp (s, "snan", 4) == 0 || strncmp (s, "qnan", 4) == 0)
+  {
+    int q = s[0] == 'q';
+    if (width == 4)
+      *v = (uint64_t) neg << 31 | (q ? 0x7fc00000 : 0x7f800001);
+    else
+      *v = (uint64_t) neg << 63
+        | (q ? 0x7ff8000000000000ull : 0x7ff4000000000000ull);
+    return 1;
+  }
+  if (width == 4)
+  {
+    b32u32_u u;
+    if (sscanf (buf, "%a", &u.f) != 1)
+      return 0;
+    *v = u.i;
+  }
+  else
+  {
+    b64u64_u u;
+    if (sscanf (buf, "%la", &u.f) != 1)
+      return 0;
+    *v = u.i;
+  }
+  return 1;
+}
+
+static int
+cmp_record (const void *a, const void *b)
+{
+  const uint64_t *x = a, *y = b;
+  for (unsigned j = 0; j < arity; j++)
+    if (x[j] != y[j])
+      return (x[j] < y[j]) ? -1 : 1;
+  return 0;
+}
+
+static void
+convert (void)
+{
+  char *buf = NULL;
+  size_t buflength = 0, allocated = 512, count = 0;
+  uint64_t *r = malloc (allocated * arity * sizeof (uint64_t));
+
+  if (r == NULL)
+  {
+    fprintf (stderr, "malloc failed\n");
+    exit (1);
+  }
+  while (getline (&buf, &buflength, stdin) >= 0)
+  {
+    if (buf[0] == '#')
+      continue;
+    if (count >= allocated)
+    {
+      allocated *= 2;
+      r = realloc (r, allocated * arity * sizeof (uint64_t));
+      if (r == NULL)
+      {
+        fprintf (stderr, "realloc failed\n");
+        exit (1);
+      }
+    }
+    uint64_t *item = r + count * arity;
+    if (!parse_value (buf, item))
+      continue;
+    if (arity == 2)
+    {
+      char *t = strchr (buf, ',');
+      if (t == NULL || !parse_value (t + 1, item + 1))
+        continue;
+    }
+    count++;
+  }
+  free (buf);
+
+  qsort (r, count, arity * sizeof (uint64_t), cmp_record);
+  size_t n = 0;
+  for (size_t i = 0; i < count; i++)
+    if (n == 0 || cmp_record (r + (n - 1) * arity, r + i * arity) != 0)
+      memmove (r + (n++) * arity, r + i * arity, arity * sizeof (uint64_t));
+
+  wc_bin_header_t h;
+  memset (&h, 0, sizeof (h));
+  memcpy (h.magic, WC_BIN_MAGIC, sizeof (h.magic));
+  h.width = width;
+  h.arity = arity;
+  h.count = n;
+  fwrite (&h, sizeof (h), 1, stdout);
+  for (size_t i = 0; i < n * arity; i++)
+  {
+    if (width == 4)
+    {
+      uint32_t v = r[i];
+      fwrite (&v, sizeof (v), 1, stdout);
+    }
+    else
+      fwrite (r + i, sizeof (uint64_t), 1, stdout);
+  }
+  free (r);
+  fprintf (stderr, "%zu records (%zu duplicates removed)\n", n, count - n);
+}
+
+static void
+dump (void)
+{
+  wc_bin_t w;
+  wc_bin_header_t h;
+
+  if (pread (0, &h, sizeof (h), 0) != (ssize_t) sizeof (h)
+      || !wc_bin_map (0, h.width, h.arity, &w))
+  {
+    fprintf (stderr, "Error, stdin is not a binary worst-case file\n");
+    exit (1);
+  }
+  for (uint64_t i = 0; i < w.count; i++)
+    for (unsigned j = 0; j < h.arity; j++)
+    {
+      const char *p = (const char *) w.data + (i * h.arity + j) * h.width;
+      if (h.width == 4)
+      {
+        b32u32_u u;
+        memcpy (&u.i, p, 4);
+        printf ("%a", (double) u.f);
+      }
+      else
+      {
+        b64u64_u u;
+        memcpy (&u.i, p, 8);
+        printf ("%la", u.f);
+      }
+      printf ((j + 1 < h.arity) ? "," : "\n");
+    }
+  wc_bin_unmap (&w);
+}
+
+int
+main (int argc, char *argv[])
+{
+  int do_dump = 0;
+
+  while (argc >= 2)
+    {
+      if (strcmp (argv[1], "--binary32") == 0)
+        width = 4;
+      else if (strcmp (argv[1], "--binary64") == 0)
+        width = 8;
+      else if (strcmp (argv[1], "--bivariate") == 0)
+        arity = 2;
+      else if (strcmp (argv[1], "--dump") == 0)
+        do_dump = 1;
+      else
+        {
+          fprintf (stderr, "Error, unknown option %s\n", argv[1]);
+          exit (1);
+        }
+      argc --;
+      argv ++;
+    }
+
+  if (do_dump)
+    dump ();
+  else
+    convert ();
+  return 0;
+}
@@ -0,0 +1,137 @@
+/* Binary format for worst-case files.
+
+Copyright (c) 2024 Paul Zimmermann, Inria.
+
+This file is part of the CORE-MATH project
+(https://core-math.gitlabpages.inria.fr/).
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* A binary worst-case file (.wcb) is a 32-byte header followed by
+   count records. Each record is made of arity values of width bytes,
+   stored in the native byte order, with the first argument first: this
+   is exactly the layout of the inputs of the perf programs, and of the
+   float2/double2/testcase arrays of the check_worst programs, so that
+   the records can be used in place once the file is mapped in memory.
+   Records are sorted by bit pattern and contain no duplicates.
+
+   A .wcb file is produced from a text .wc file by wc2bin (see wc2bin.c
+   in this directory). */
+
+#ifndef CORE_MATH_WC_BIN_H
+#define CORE_MATH_WC_BIN_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#define WC_BIN_MAGIC "CMWCB\0\0\1" /* includes the format version */
+
+typedef struct {
+  char magic[8];
+  uint16_t width;    /* size in bytes of each value: 4 or 8 */
+  uint16_t arity;    /* number of values per record: 1 or 2 */
+  uint32_t reserved;
+  uint64_t count;    /* number of records */
+  uint64_t reserved2;
+} wc_bin_header_t;
+
+typedef struct {
+  const void *data;  /* first record */
+  uint64_t count;    /* number of records */
+  void *map;         /* NULL if data was not obtained by wc_bin_map */
+  size_t length;     /* length of the mapping */
+} wc_bin_t;
+
+/* If the file open on fd is a binary worst-case file, map it in memory,
+   check it has the given width and arity, and return 1. Return 0 if fd
+   is not a binary worst-case file (for example a text .wc file or a pipe),
+   without consuming any data from fd. */
+static inline int
+wc_bin_map (int fd, unsigned width, unsigned arity, wc_bin_t *w)
+{
+  struct stat st;
+  wc_bin_header_t h;
+
+  w->data = NULL;
+  w->count = 0;
+  w->map = NULL;
+  w->length = 0;
+  if (fstat (fd, &st) != 0 || !S_ISREG (st.st_mode)
+      || (size_t) st.st_size < sizeof (h))
+    return 0;
+  if (pread (fd, &h, sizeof (h), 0) != (ssize_t) sizeof (h)
+      || memcmp (h.magic, WC_BIN_MAGIC, sizeof (h.magic)) != 0)
+    return 0;
+  if (h.width != width || h.arity != arity)
+  {
+    fprintf (stderr, "Error, worst-case file has width %u and arity %u, "
+             "expected %u and %u\n", h.width, h.arity, width, arity);
+    exit (1);
+  }
+  if (sizeof (h) + h.count * width * arity != (uint64_t) st.st_size)
+  {
+    fprintf (stderr, "Error, truncated worst-case file\n");
+    exit (1);
+  }
+  w->length = st.st_size;
+  w->map = mmap (NULL, w->length, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (w->map == MAP_FAILED)
+  {
+    perror ("mmap");
+    exit (1);
+  }
+  w->data = (const char *) w->map + sizeof (h);
+  w->count = h.count;
+  return 1;
+}
+
+static inline void
+wc_bin_unmap (wc_bin_t *w)
+{
+  if (w->map != NULL)
+    munmap (w->map, w->length);
+  w->map = NULL;
+}
+
+/* Parse a shard specification "k/n" (0 <= k < n) and restrict [0,count)
+   to the k-th of n contiguous and balanced ranges, in [*begin,*end). */
+static inline void
+wc_bin_shard (const char *spec, uint64_t count, uint64_t *begin,
+              uint64_t *end)
+{
+  unsigned long k, n;
+  if (sscanf (spec, "%lu/%lu", &k, &n) != 2 || n == 0 || k >= n)
+  {
+    fprintf (stderr, "Error, invalid shard %s (expected k/n with k < n)\n",
+             spec);
+    exit (1);
+  }
+  *begin = (count * k) / n;
+  *end = (count * (k + 1)) / n;
+}
+
+#endif /* CORE_MATH_WC_BIN_H */